@@ -4,13 +4,13 @@
 #include "assembler/homogeneous_dirichlet.hpp"
 #include "solver/linear/linear_solver.hpp"
 #include "numeric/doublet.hpp"
+#include "numeric/float_compare.hpp"
 #include "io/json.hpp"
+#include "telemetry.hpp"
 
 #include <termcolor/termcolor.hpp>
 #include <tbb/parallel_for.h>
 
-#include <chrono>
-
 namespace neon::diffusion
 {
 dynamic_matrix::dynamic_matrix(mesh_type& mesh, json const& simulation_data)
@@ -46,27 +46,54 @@ void dynamic_matrix::solve()
     compute_external_force();
 
     sparse_matrix A;
-    vector b;
+    vector b, d_next;
+
+    // Time step size of the last factorised coefficient matrix
+    double factorised_time_step_size{0.0};
+
+    auto const theta = time_solver.implicit_factor();
 
     while (time_solver.loop())
     {
-        auto const start = std::chrono::steady_clock::now();
+        {
+            telemetry::scoped_timer timer("Time step");
+
+            bool is_accepted{false};
+
+            do
+            {
+                auto const time_step_size = time_solver.current_time_step_size();
+
+                std::cout << std::string(4, ' ') << termcolor::blue << termcolor::bold
+                          << "Time step " << time_solver.iteration()
+                          << ", simulation time: " << time_solver.current_time()
+                          << termcolor::reset << std::endl;
 
-        std::cout << std::string(4, ' ') << termcolor::blue << termcolor::bold << "Time step "
-                  << time_solver.iteration() << ", simulation time: " << time_solver.current_time()
-                  << termcolor::reset << std::endl;
+                A = M + theta * time_step_size * K;
 
-        A = M + time_solver.current_time_step_size() * K;
+                b = M * d - (1.0 - theta) * time_step_size * (K * d) + time_step_size * f;
 
-        b = M * d + time_solver.current_time_step_size() * f;
+                d_next = d;
 
-        apply_dirichlet_conditions(A, d, b, mesh);
+                apply_dirichlet_conditions(A, d_next, b, mesh);
 
-        solver->solve(A, d, b);
+                // The coefficient matrix only changes with the time step size
+                if (is_approx(time_step_size, factorised_time_step_size))
+                {
+                    solver->reuse_factorisation();
+                }
+                factorised_time_step_size = time_step_size;
+
+                solver->solve(A, d_next, b);
+
+                is_accepted = time_solver.update_time_step(d, d_next);
 
-        auto const end = std::chrono::steady_clock::now();
-        std::chrono::duration<double> const elapsed_seconds = end - start;
-        std::cout << std::string(6, ' ') << "Time step took " << elapsed_seconds.count() << "s\n";
+                if (!is_accepted) telemetry::count("Cutbacks");
+            } while (!is_accepted);
+
+            d = d_next;
+        }
+        telemetry::complete_step(time_solver.iteration(), time_solver.current_time());
 
         // mesh.write(time_solver.iteration(), time_solver.current_time());
     }
@@ -99,7 +126,7 @@ void dynamic_matrix::assemble_mass()
 
     doublets.clear();
 
-    auto const start = std::chrono::steady_clock::now();
+    telemetry::scoped_timer timer("Mass assembly");
 
     for (auto const& submesh : mesh.meshes())
     {
@@ -116,10 +143,5 @@ void dynamic_matrix::assemble_mass()
             }
         }
     }
-
-    auto const end = std::chrono::steady_clock::now();
-    std::chrono::duration<double> const elapsed_seconds = end - start;
-
-    std::cout << std::string(6, ' ') << "Mass assembly took " << elapsed_seconds.count() << "s\n";
 }
 }
@@ -6,11 +6,10 @@
 #include "assembler/homogeneous_dirichlet.hpp"
 #include "numeric/doublet.hpp"
 #include "io/json.hpp"
+#include "telemetry.hpp"
 
 #include <tbb/parallel_for.h>
 
-#include <chrono>
-
 namespace neon::diffusion
 {
 static_matrix::static_matrix(mesh_type& mesh, json const& simulation_data)
@@ -53,7 +52,7 @@ void static_matrix::compute_sparsity_pattern()
 
 void static_matrix::compute_external_force(double const load_factor)
 {
-    auto const start = std::chrono::steady_clock::now();
+    telemetry::scoped_timer timer("External forces assembly");
 
     f.setZero();
 
@@ -90,12 +89,6 @@ void static_matrix::compute_external_force(double const load_factor)
             }
         }
     }
-    auto const end = std::chrono::steady_clock::now();
-
-    std::chrono::duration<double> const elapsed_seconds = end - start;
-
-    std::cout << std::string(6, ' ') << "External forces assembly took " << elapsed_seconds.count()
-              << "s\n";
 }
 
 void static_matrix::solve()
@@ -124,7 +117,7 @@ void static_matrix::assemble_stiffness()
 {
     if (!is_sparsity_computed) compute_sparsity_pattern();
 
-    auto const start = std::chrono::steady_clock::now();
+    telemetry::scoped_timer timer("Stiffness assembly");
 
     K.coeffs() = 0.0;
 
@@ -142,12 +135,5 @@ void static_matrix::assemble_stiffness()
             }
         });
     }
-
-    auto const end = std::chrono::steady_clock::now();
-
-    std::chrono::duration<double> const elapsed_seconds = end - start;
-
-    std::cout << std::string(6, ' ') << "Stiffness assembly took " << elapsed_seconds.count()
-              << "s\n";
 }
 }
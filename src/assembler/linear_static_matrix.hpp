@@ -8,10 +8,10 @@
 #include "io/json.hpp"
 #include "solver/adaptive_time_step.hpp"
 #include "solver/linear/linear_solver_factory.hpp"
+#include "telemetry.hpp"
 
 #include <tbb/parallel_for.h>
 
-#include <chrono>
 #include <iostream>
 #include <variant>
 
@@ -95,7 +95,7 @@ void linear_static_matrix<fem_mesh_type>::solve()
 template <typename fem_mesh_type>
 void linear_static_matrix<fem_mesh_type>::compute_external_force(double const load_factor)
 {
-    auto const start = std::chrono::steady_clock::now();
+    telemetry::scoped_timer timer("External forces assembly");
 
     // auto const step_time = adaptive_load.step_time();
 
@@ -124,16 +124,12 @@ void linear_static_matrix<fem_mesh_type>::compute_external_force(double const lo
             }
         }
     }
-    auto const end = std::chrono::steady_clock::now();
-    std::chrono::duration<double> elapsed_seconds = end - start;
-    std::cout << std::string(6, ' ') << "External forces assembly took " << elapsed_seconds.count()
-              << "s\n";
 }
 
 template <typename fem_mesh_type>
 void linear_static_matrix<fem_mesh_type>::assemble_stiffness()
 {
-    auto const start = std::chrono::steady_clock::now();
+    telemetry::scoped_timer timer("Tangent stiffness assembly");
 
     if (!is_sparsity_computed)
     {
@@ -157,11 +153,5 @@ void linear_static_matrix<fem_mesh_type>::assemble_stiffness()
             }
         });
     }
-
-    auto const end = std::chrono::steady_clock::now();
-    std::chrono::duration<double> const elapsed_seconds = end - start;
-
-    std::cout << std::string(6, ' ') << "Tangent stiffness assembly took "
-              << elapsed_seconds.count() << "s\n";
 }
 }
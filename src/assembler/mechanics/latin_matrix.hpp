@@ -5,25 +5,35 @@
 #include "numeric/float_compare.hpp"
 #include "exceptions.hpp"
 #include "numeric/sparse_matrix.hpp"
-#include "solver/adaptive_time_step.hpp"
-#include "solver/linear/linear_solver_factory.hpp"
+#include "solver/svd/svd.hpp"
 #include "io/json.hpp"
+#include "telemetry.hpp"
 
-#include <chrono>
-#include <memory>
-#include <string>
+#include <algorithm>
+#include <cmath>
 #include <iostream>
-#include <variant>
+#include <string>
+#include <vector>
 
 #include <termcolor/termcolor.hpp>
 #include <tbb/parallel_for.h>
 
 namespace neon::mechanics
 {
-/// Generic static matrix designed for solid mechanics problems using the
-/// Newton-Raphson method for the solution of nonlinear equations.
-/// This class is responsible for the assembly of the process stiffness matrix,
-/// residual force vector and solution of the incremental displacement.
+/// latin_matrix solves the quasi-static nonlinear problem over the complete
+/// time interval using the LArge Time INcrement (LATIN) method
+/// \cite Ladeveze1999.  Instead of performing Newton-Raphson iterations for
+/// each load increment, the method alternates between two stages over the
+/// entire space-time history:
+///   - a local stage where the constitutive model is integrated at every
+///     quadrature point along the current displacement history, and
+///   - a global stage where equilibrium is restored along a constant search
+///     direction (the initial stiffness) which is factorised only once.
+/// The space-time displacement correction is represented in a separated
+/// (proper generalised decomposition) form as a sum of spatial modes
+/// multiplied by temporal functions.  The residual history is compressed
+/// with a randomised singular value decomposition so each global stage
+/// requires one back substitution per mode instead of one per time step.
 template <class MeshType>
 class latin_matrix
 {
@@ -33,45 +43,54 @@ public:
 public:
     explicit latin_matrix(mesh_type& fem_mesh, json const& simulation);
 
-    /// Solve the nonlinear system of equations
+    /// Solve the nonlinear system of equations over the time history
     void solve();
 
 protected:
+    /// Allocate the discrete times from the time increment and the boundary
+    /// condition history
+    void allocate_time_history(json const& time_data);
+
+    /// Assemble the stiffness at the undeformed configuration with the
+    /// Dirichlet conditions and factorise it as the search direction
+    void factorise_search_direction();
+
+    /// Local stage integrating the constitutive model along the displacement
+    /// history from the initial state and storing the equilibrium residual of
+    /// each time step.  The results are written out if \p write_output is set
+    void perform_local_stage(bool const write_output);
+
+    /// Global stage adding the low rank displacement correction
+    void perform_global_stage();
+
+    /// Recompress the separated representation when the number of modes
+    /// exceeds the maximum number of modes
+    void compress_modes();
+
     /// Gathers the internal force vector using the Cauchy stress
     void compute_internal_force();
 
     /// Gathers the external force contributions to the system of equations
-    void compute_external_force();
+    void compute_external_force(double const time);
 
-    /// Assembles the material and geometric stiffness matrices
-    void assemble_stiffness();
+    /// \return displacement vector at the time step \p step
+    [[nodiscard]] vector displacement(std::size_t const step) const;
 
-    /// Apply dirichlet conditions to the system defined by A, x, and b.
-    /// This method sets the incremental displacements to zero for the given
-    /// load increment such that incremental displacements are zero
-    void enforce_dirichlet_conditions(sparse_matrix& A, vector& b) const;
+    /// \return displacement vector with only the prescribed values at \p time
+    [[nodiscard]] vector prescribed_displacement(double const time) const;
 
-    /// Move the nodes on the mesh for the Dirichlet boundary
-    void apply_displacement_boundaries();
+    /// LATIN iteration convergence criteria
+    [[nodiscard]] bool is_iteration_converged() const;
 
-    /// Equilibrium iteration convergence criteria
-    bool is_iteration_converged() const;
-
-    /// Pretty printer for the convergence of the Newton-Raphson solver
+    /// Pretty printer for the convergence of the LATIN iterations
     void print_convergence_progress() const;
 
-    void update_relative_norms();
-
-private:
-    void perform_equilibrium_iterations();
-
 protected:
     mesh_type& fem_mesh;
 
-    adaptive_time_step adaptive_load;
+    /// Discrete times of the history excluding the initial time
+    std::vector<double> times;
 
-    /// Cache the sparsity pattern
-    bool is_sparsity_computed{false};
     /// Flag for norm computation
     bool use_relative_norm{true};
 
@@ -80,35 +99,45 @@ protected:
 
     double displacement_norm;
     double force_norm;
-    /// Norm of the residual vector at the first iteration
-    double norm_initial_residual = 1;
 
-    /// Maximum number of Newton Raphson iterations before cutback
-    int maximum_iterations = 10;
+    /// Maximum number of LATIN iterations
+    int maximum_iterations{50};
+    /// Number of modes added in each global stage
+    std::int64_t modes_per_iteration{4};
+    /// Maximum number of modes before recompression
+    std::int64_t maximum_modes{20};
+
+    /// Search direction stiffness matrix
+    sparse_matrix K;
+    /// Factorisation of the search direction
+    Eigen::SimplicialLDLT<Eigen::SparseMatrix<double>> search_direction;
 
-    /// Tangent sparse stiffness matrix
-    sparse_matrix Kt;
     /// Internal force vector
     vector f_int;
     /// External force vector
     vector f_ext;
-    /// Displacement vector
-    vector displacement;
-    /// Last displacement vector
-    vector displacement_old;
-    /// Incremental displacement vector
-    vector delta_d;
-    /// Minus residual vector
-    vector minus_residual;
-
-    std::unique_ptr<linear_solver> solver;
+
+    /// Equilibrium residual with a column for each time step
+    col_matrix residuals;
+    /// Norm of the space-time residual
+    double residual_norm;
+    /// Norm of the space-time external and internal forces
+    double reference_force_norm;
+    /// Norm of the space-time displacement
+    double history_norm;
+
+    /// Spatial modes of the displacement correction
+    col_matrix spatial_modes;
+    /// Temporal functions of the displacement correction
+    col_matrix temporal_modes;
+
+    /// Degrees of freedom with a prescribed displacement
+    std::vector<std::int32_t> fixed_dofs;
 };
 
 template <class MeshType>
 latin_matrix<MeshType>::latin_matrix(mesh_type& fem_mesh, json const& simulation)
-    : fem_mesh(fem_mesh),
-      adaptive_load(simulation["time"], fem_mesh.time_history()),
-      solver(make_linear_solver(simulation["linear_solver"], fem_mesh.is_symmetric()))
+    : fem_mesh(fem_mesh)
 {
     auto const& nonlinear_options = simulation["nonlinear_options"];
 
@@ -120,347 +149,397 @@ latin_matrix<MeshType>::latin_matrix(mesh_type& fem_mesh, json const& simulation
     {
         throw std::domain_error("residual_tolerance not specified in nonlinear_options");
     }
-    if (nonlinear_options.find("newton_raphson_iterations") != nonlinear_options.end())
+    if (nonlinear_options.find("latin_iterations") != nonlinear_options.end())
+    {
+        maximum_iterations = nonlinear_options["latin_iterations"];
+    }
+    if (nonlinear_options.find("modes_per_iteration") != nonlinear_options.end())
+    {
+        modes_per_iteration = nonlinear_options["modes_per_iteration"];
+    }
+    if (nonlinear_options.find("maximum_modes") != nonlinear_options.end())
     {
-        maximum_iterations = nonlinear_options["newton_raphson_iterations"];
+        maximum_modes = nonlinear_options["maximum_modes"];
     }
     if (nonlinear_options.find("absolute_tolerance") != nonlinear_options.end())
     {
         use_relative_norm = false;
     }
+    if (modes_per_iteration < 1 || maximum_modes < modes_per_iteration)
+    {
+        throw std::domain_error("\"modes_per_iteration\" must be positive and not greater than "
+                                "\"maximum_modes\"");
+    }
 
     residual_tolerance = nonlinear_options["residual_tolerance"];
     displacement_tolerance = nonlinear_options["displacement_tolerance"];
 
-    f_int = f_ext = displacement = displacement_old = delta_d = vector::Zero(fem_mesh.active_dofs());
+    allocate_time_history(simulation["time"]);
 
-    // Perform Newton-Raphson iterations
-    std::cout << "\n"
-              << std::string(4, ' ') << "Non-linear equation system has " << fem_mesh.active_dofs()
-              << " degrees of freedom\n";
-}
-
-template <class MeshType>
-void latin_matrix<MeshType>::solve()
-{
-    try
+    for (auto const& [name, boundaries] : fem_mesh.dirichlet_boundaries())
     {
-        // Initialise the mesh with zero displacements
-        fem_mesh.update_internal_variables(displacement);
-        fem_mesh.update_internal_forces(f_int);
-
-        fem_mesh.write(adaptive_load.step(), adaptive_load.time());
-
-        while (!adaptive_load.is_fully_applied())
+        for (auto const& boundary : boundaries)
         {
-            std::cout << "\n"
-                      << std::string(4, ' ') << termcolor::magenta << termcolor::bold
-                      << "Performing equilibrium iterations for time " << adaptive_load.step_time()
-                      << termcolor::reset << std::endl;
-
-            compute_external_force();
-
-            perform_equilibrium_iterations();
+            fixed_dofs.insert(end(fixed_dofs),
+                              begin(boundary.dof_view()),
+                              end(boundary.dof_view()));
         }
     }
-    catch (computational_error& comp_error)
-    {
-        // A numerical error has been reported that is able to be recovered
-        // by resetting the state
-        std::cout << std::endl
-                  << std::string(6, ' ') << termcolor::bold << termcolor::yellow
-                  << comp_error.what() << termcolor::reset << std::endl;
 
-        adaptive_load.update_convergence_state(false);
-        fem_mesh.save_internal_variables(false);
+    f_int = f_ext = vector::Zero(fem_mesh.active_dofs());
 
-        displacement = displacement_old;
+    spatial_modes.resize(fem_mesh.active_dofs(), 0);
+    temporal_modes.resize(times.size(), 0);
 
-        this->solve();
-    }
-    catch (...)
-    {
-        throw;
-    }
+    std::cout << "\n"
+              << std::string(4, ' ') << "Space-time system has " << fem_mesh.active_dofs()
+              << " degrees of freedom and " << times.size() << " time steps\n";
 }
 
 template <class MeshType>
-void latin_matrix<MeshType>::compute_internal_force()
+void latin_matrix<MeshType>::allocate_time_history(json const& time_data)
 {
-    f_int.setZero();
+    double const period = time_data["period"];
+    double const increment = time_data["increments"]["initial"];
 
-    for (auto const& submesh : fem_mesh.meshes())
-    {
-        for (std::int64_t element{0}; element < submesh.elements(); ++element)
-        {
-            auto const [dofs, fe_int] = submesh.internal_force(element);
+    times = fem_mesh.time_history();
 
-            f_int(dofs) += fe_int;
-        }
+    for (auto step = 1; step * increment < period; ++step)
+    {
+        times.push_back(step * increment);
     }
+    times.push_back(period);
+
+    std::sort(begin(times), end(times));
+
+    // Remove the initial time, times outside the period and duplicates
+    times.erase(std::remove_if(begin(times),
+                               end(times),
+                               [&](auto const time) {
+                                   return time <= 0.0 || is_approx(time, 0.0) || time > period;
+                               }),
+                end(times));
+
+    times.erase(std::unique(begin(times),
+                            end(times),
+                            [](auto const left, auto const right) {
+                                return is_approx(left, right);
+                            }),
+                end(times));
 }
 
 template <class MeshType>
-void latin_matrix<MeshType>::compute_external_force()
+void latin_matrix<MeshType>::solve()
 {
-    auto const start = std::chrono::steady_clock::now();
+    // Converged state at the beginning of the time history
+    std::vector<decltype(fem_mesh.meshes().front().checkpoint_internal_variables())> initial_state;
 
-    auto const step_time = adaptive_load.step_time();
+    for (auto const& submesh : fem_mesh.meshes())
+    {
+        initial_state.push_back(submesh.checkpoint_internal_variables());
+    }
 
-    f_ext.setZero();
+    // Initialise the mesh with zero displacements
+    fem_mesh.update_internal_variables(vector::Zero(fem_mesh.active_dofs()));
+    fem_mesh.update_internal_forces(f_int);
+    fem_mesh.write(0, 0.0);
 
-    for (auto const& [name, boundaries] : fem_mesh.nonfollower_boundaries())
+    factorise_search_direction();
+
+    auto current_iteration{0};
+    while (current_iteration < maximum_iterations)
     {
-        for (auto const& boundary : boundaries.natural_interface())
-        {
-            std::visit(
-                [&](auto const& boundary_mesh) {
-                    for (std::int64_t element{0}; element < boundary_mesh.elements(); ++element)
-                    {
-                        auto const [dofs, fe_ext] = boundary_mesh.external_force(element, step_time);
-
-                        f_ext(dofs) += fe_ext;
-                    }
-                },
-                boundary);
-        }
-        for (auto const& boundary : boundaries.nodal_interface())
+        telemetry::scoped_timer timer("LATIN iteration", telemetry::timer_output::required);
+
+        telemetry::count("LATIN iterations");
+
+        std::cout << std::string(4, ' ') << termcolor::blue << termcolor::bold
+                  << "LATIN iteration " << current_iteration << termcolor::reset << "\n";
+
+        for (std::size_t index{0}; index < initial_state.size(); ++index)
         {
-            for (auto dof_index : boundary.dof_view())
-            {
-                f_ext(dof_index) += boundary.value_view();
-            }
+            fem_mesh.meshes()[index].restore_internal_variables(initial_state[index]);
         }
+
+        perform_local_stage(false);
+
+        // The displacement norm is only available after a correction
+        if (current_iteration == 0) displacement_norm = use_relative_norm ? 1.0 : history_norm;
+
+        force_norm = use_relative_norm ? residual_norm / std::max(reference_force_norm, 1.0e-12)
+                                       : residual_norm;
+
+        print_convergence_progress();
+
+        if (is_iteration_converged() && current_iteration > 0) break;
+
+        perform_global_stage();
+
+        current_iteration++;
+    }
+    if (current_iteration == maximum_iterations)
+    {
+        throw computational_error("Reached LATIN iteration limit");
+    }
+
+    // Integrate the converged history again to write out the results
+    for (std::size_t index{0}; index < initial_state.size(); ++index)
+    {
+        fem_mesh.meshes()[index].restore_internal_variables(initial_state[index]);
     }
-    auto const end = std::chrono::steady_clock::now();
-    std::chrono::duration<double> elapsed_seconds = end - start;
-    std::cout << std::string(6, ' ') << "External forces assembly took " << elapsed_seconds.count()
-              << "s\n";
+    perform_local_stage(true);
 }
 
 template <class MeshType>
-void latin_matrix<MeshType>::assemble_stiffness()
+void latin_matrix<MeshType>::factorise_search_direction()
 {
-    if (!is_sparsity_computed)
-    {
-        fem::compute_sparsity_pattern(Kt, fem_mesh);
-        is_sparsity_computed = true;
-    }
+    telemetry::scoped_timer timer("Search direction factorisation");
 
-    auto const start = std::chrono::steady_clock::now();
+    fem::compute_sparsity_pattern(K, fem_mesh);
 
-    Kt.coeffs() = 0.0;
+    K.coeffs() = 0.0;
 
     for (auto const& submesh : fem_mesh.meshes())
     {
         tbb::parallel_for(std::int64_t{0}, submesh.elements(), [&](auto const element) {
-            auto const [dofs, ke] = submesh.tangent_stiffness(element);
+            auto const& [dofs, ke] = submesh.tangent_stiffness(element);
 
             for (std::int64_t b{0}; b < dofs.size(); b++)
             {
                 for (std::int64_t a{0}; a < dofs.size(); a++)
                 {
-                    Kt.coefficient_update(dofs(a), dofs(b), ke(a, b));
+                    K.coefficient_update(dofs(a), dofs(b), ke(a, b));
                 }
             }
         });
     }
 
-    auto const end = std::chrono::steady_clock::now();
-    std::chrono::duration<double> const elapsed_seconds = end - start;
+    // Remove the coupling to the prescribed degrees of freedom such that the
+    // corrections are zero for the Dirichlet boundaries
+    for (auto const fixed_dof : fixed_dofs)
+    {
+        auto const diagonal_entry = K.coeff(fixed_dof, fixed_dof);
 
-    std::cout << std::string(6, ' ') << "Tangent stiffness assembly took "
-              << elapsed_seconds.count() << "s\n";
+        for (sparse_matrix::InnerIterator it(K, fixed_dof); it; ++it)
+        {
+            it.valueRef() = 0.0;
+
+            K.coeffRef(it.col(), fixed_dof) = 0.0;
+        }
+        K.coeffRef(fixed_dof, fixed_dof) = diagonal_entry;
+    }
+
+    search_direction.compute(K);
+
+    if (search_direction.info() != Eigen::Success)
+    {
+        throw computational_error("Factorisation of the LATIN search direction failed");
+    }
 }
 
 template <class MeshType>
-void latin_matrix<MeshType>::enforce_dirichlet_conditions(sparse_matrix& A, vector& b) const
+void latin_matrix<MeshType>::perform_local_stage(bool const write_output)
 {
-    for (auto const& [name, boundaries] : fem_mesh.dirichlet_boundaries())
+    residuals.resize(fem_mesh.active_dofs(), times.size());
+
+    residual_norm = reference_force_norm = history_norm = 0.0;
+
+    auto last_time{0.0};
+
+    // The history dependence requires the time steps to be integrated in
+    // order while the quadrature points are updated in parallel
+    for (std::size_t step{0}; step < times.size(); ++step)
     {
-        for (auto const& boundary : boundaries)
-        {
-            if (boundary.is_not_active(adaptive_load.step_time()))
-            {
-                continue;
-            }
+        vector const u = displacement(step);
 
-            for (auto const& fixed_dof : boundary.dof_view())
-            {
-                auto const diagonal_entry = A.coeff(fixed_dof, fixed_dof);
+        fem_mesh.update_internal_variables(u, times[step] - last_time);
 
-                b(fixed_dof) = 0.0;
+        compute_internal_force();
+        compute_external_force(times[step]);
 
-                std::vector<std::int32_t> non_zero_visitor;
+        residuals.col(step) = f_ext - f_int;
 
-                // Zero the rows and columns
-                for (sparse_matrix::InnerIterator it(A, fixed_dof); it; ++it)
-                {
-                    // Set the value of the col or row resp. to zero
-                    it.valueRef() = 0.0;
-                    non_zero_visitor.push_back(A.IsRowMajor ? it.col() : it.row());
-                }
+        for (auto const fixed_dof : fixed_dofs) residuals(fixed_dof, step) = 0.0;
 
-                // Zero the row or col respectively
-                for (auto const& non_zero : non_zero_visitor)
-                {
-                    const auto row = A.IsRowMajor ? non_zero : fixed_dof;
-                    const auto col = A.IsRowMajor ? fixed_dof : non_zero;
+        residual_norm += residuals.col(step).squaredNorm();
+        reference_force_norm += std::max(f_ext.squaredNorm(), f_int.squaredNorm());
+        history_norm += u.squaredNorm();
 
-                    A.coeffRef(row, col) = 0.0;
-                }
-                // Reset the diagonal to the same value to preserve conditioning
-                A.coeffRef(fixed_dof, fixed_dof) = diagonal_entry;
-            }
+        fem_mesh.save_internal_variables(true);
+
+        if (write_output)
+        {
+            fem_mesh.update_internal_forces(f_int);
+            fem_mesh.write(step + 1, times[step]);
         }
+        last_time = times[step];
     }
+    residual_norm = std::sqrt(residual_norm);
+    reference_force_norm = std::sqrt(reference_force_norm);
+    history_norm = std::sqrt(history_norm);
 }
 
 template <class MeshType>
-void latin_matrix<MeshType>::apply_displacement_boundaries()
+void latin_matrix<MeshType>::perform_global_stage()
 {
-    Eigen::SparseVector<double> prescribed_increment(displacement.size());
+    // Separated approximation of the residual history R ~ P S Q^T
+    randomised_svd residual_modes;
+    residual_modes.compute(residuals, modes_per_iteration);
 
-    for (auto const& [name, boundaries] : fem_mesh.dirichlet_boundaries())
-    {
-        for (auto const& boundary : boundaries)
-        {
-            if (boundary.is_not_active(adaptive_load.step_time()))
-            {
-                continue;
-            }
+    auto const modes = residual_modes.values().size();
 
-            auto const delta_u = boundary.value_view(adaptive_load.step_time())
-                                 - boundary.value_view(adaptive_load.last_step_time());
+    // Each spatial mode requires only a back substitution with the constant
+    // search direction and is paired with the right singular vector in time
+    col_matrix corrections(fem_mesh.active_dofs(), modes);
 
-            for (auto const& dof : boundary.dof_view())
-            {
-                prescribed_increment.coeffRef(dof) = delta_u;
-            }
-        }
-    }
+    tbb::parallel_for(std::int64_t{0}, std::int64_t{modes}, [&](auto const mode) {
+        corrections.col(mode) = search_direction.solve(
+            vector(residual_modes.values()(mode) * residual_modes.left().col(mode)));
+    });
+
+    // The temporal functions are orthonormal and so the norm of the
+    // space-time correction is the norm of the spatial modes
+    auto const correction_norm = corrections.norm();
 
-    // A sparse matrix - sparse vector multiplication is more efficient for a
-    // relatively small vector size with the exception of allocation
-    minus_residual -= Kt * prescribed_increment;
+    displacement_norm = use_relative_norm && history_norm > 0.0 ? correction_norm / history_norm
+                                                                : correction_norm;
 
-    displacement += prescribed_increment;
+    spatial_modes.conservativeResize(Eigen::NoChange, spatial_modes.cols() + modes);
+    temporal_modes.conservativeResize(Eigen::NoChange, temporal_modes.cols() + modes);
+
+    spatial_modes.rightCols(modes) = corrections;
+    temporal_modes.rightCols(modes) = residual_modes.right();
+
+    if (spatial_modes.cols() > maximum_modes) compress_modes();
+
+    std::cout << std::string(6, ' ') << "Displacement history represented by "
+              << spatial_modes.cols() << " modes\n";
 }
 
 template <class MeshType>
-bool latin_matrix<MeshType>::is_iteration_converged() const
+void latin_matrix<MeshType>::compress_modes()
 {
-    return displacement_norm <= displacement_tolerance && force_norm <= residual_tolerance;
+    // Orthogonalise both sets of modes U = Q_s R_s and V = Q_t R_t such that
+    // U V^T = Q_s (R_s R_t^T) Q_t^T and only the small core is decomposed
+    Eigen::HouseholderQR<col_matrix> const spatial_qr(spatial_modes);
+    Eigen::HouseholderQR<col_matrix> const temporal_qr(temporal_modes);
+
+    auto const spatial_rank = std::min(spatial_modes.rows(), spatial_modes.cols());
+    auto const temporal_rank = std::min(temporal_modes.rows(), temporal_modes.cols());
+
+    col_matrix const spatial_basis = spatial_qr.householderQ()
+                                     * col_matrix::Identity(spatial_modes.rows(), spatial_rank);
+    col_matrix const temporal_basis = temporal_qr.householderQ()
+                                      * col_matrix::Identity(temporal_modes.rows(), temporal_rank);
+
+    col_matrix const spatial_factor = spatial_qr.matrixQR()
+                                          .topRows(spatial_rank)
+                                          .template triangularView<Eigen::Upper>();
+    col_matrix const temporal_factor = temporal_qr.matrixQR()
+                                           .topRows(temporal_rank)
+                                           .template triangularView<Eigen::Upper>();
+
+    bdc_svd core;
+    core.compute(spatial_factor * temporal_factor.transpose(), maximum_modes);
+
+    spatial_modes = spatial_basis * core.left() * core.values().asDiagonal();
+    temporal_modes = temporal_basis * core.right();
 }
 
 template <class MeshType>
-void latin_matrix<MeshType>::print_convergence_progress() const
+vector latin_matrix<MeshType>::displacement(std::size_t const step) const
 {
-    std::cout << std::string(6, ' ') << termcolor::bold;
-    if (displacement_norm <= displacement_tolerance)
-    {
-        std::cout << termcolor::green;
-    }
-    else
-    {
-        std::cout << termcolor::yellow;
-    }
-    std::cout << "Incremental displacement norm " << displacement_norm << "\n"
-              << termcolor::reset << std::string(6, ' ');
+    vector u = prescribed_displacement(times[step]);
 
-    if (force_norm <= residual_tolerance)
+    if (spatial_modes.cols() > 0)
     {
-        std::cout << termcolor::green;
+        u.noalias() += spatial_modes * temporal_modes.row(step).transpose();
     }
-    else
-    {
-        std::cout << termcolor::yellow;
-    }
-    std::cout << termcolor::bold << "Residual force norm " << force_norm << termcolor::reset << "\n";
+    return u;
 }
 
 template <class MeshType>
-void latin_matrix<MeshType>::update_relative_norms()
+vector latin_matrix<MeshType>::prescribed_displacement(double const time) const
 {
-    if (use_relative_norm)
-    {
-        displacement_norm = delta_d.norm() / displacement.norm();
-        force_norm = is_approx(std::max(f_ext.norm(), f_int.norm()), 0.0)
-                         ? 1.0
-                         : minus_residual.norm()
-                               / std::max(norm_initial_residual,
-                                          std::max(f_ext.norm(), f_int.norm()));
-    }
-    else
+    vector u = vector::Zero(fem_mesh.active_dofs());
+
+    for (auto const& [name, boundaries] : fem_mesh.dirichlet_boundaries())
     {
-        displacement_norm = delta_d.norm();
-        force_norm = minus_residual.norm();
+        for (auto const& boundary : boundaries)
+        {
+            auto const value = boundary.value_view(time);
+
+            for (auto const& dof : boundary.dof_view()) u(dof) = value;
+        }
     }
+    return u;
 }
 
 template <class MeshType>
-void latin_matrix<MeshType>::perform_equilibrium_iterations()
+void latin_matrix<MeshType>::compute_internal_force()
 {
-    displacement = displacement_old;
+    f_int.setZero();
 
-    // Full Newton-Raphson iteration to solve nonlinear equations
-    auto current_iteration{0};
-    while (current_iteration < maximum_iterations)
+    for (auto const& submesh : fem_mesh.meshes())
     {
-        auto const start = std::chrono::steady_clock::now();
-
-        std::cout << std::string(4, ' ') << termcolor::blue << termcolor::bold
-                  << "Newton-Raphson iteration " << current_iteration << termcolor::reset << "\n";
+        for (std::int64_t element{0}; element < submesh.elements(); ++element)
+        {
+            auto const& [dofs, fe_int] = submesh.internal_force(element);
 
-        assemble_stiffness();
+            f_int(dofs) += fe_int;
+        }
+    }
+}
 
-        compute_internal_force();
+template <class MeshType>
+void latin_matrix<MeshType>::compute_external_force(double const time)
+{
+    f_ext.setZero();
 
-        minus_residual = f_ext - f_int;
+    for (auto const& [name, boundaries] : fem_mesh.nonfollower_boundaries())
+    {
+        boundaries.add_external_force(f_ext, time);
 
-        if (current_iteration == 0)
+        for (auto const& boundary : boundaries.nodal_interface())
         {
-            apply_displacement_boundaries();
-            norm_initial_residual = minus_residual.norm();
+            for (auto dof_index : boundary.dof_view())
+            {
+                f_ext(dof_index) += boundary.value_view(time);
+            }
         }
+    }
+}
 
-        enforce_dirichlet_conditions(Kt, minus_residual);
-
-        solver->solve(Kt, delta_d, minus_residual);
-
-        displacement += delta_d;
-
-        fem_mesh.update_internal_variables(displacement,
-                                           current_iteration == 0 ? adaptive_load.increment() : 0.0);
-
-        update_relative_norms();
-
-        print_convergence_progress();
-
-        auto const end = std::chrono::steady_clock::now();
-        std::chrono::duration<double> const elapsed_seconds = end - start;
-        std::cout << std::string(6, ' ') << "Equilibrium iteration required "
-                  << elapsed_seconds.count() << "s\n";
-
-        if (is_iteration_converged()) break;
+template <class MeshType>
+bool latin_matrix<MeshType>::is_iteration_converged() const
+{
+    return displacement_norm <= displacement_tolerance && force_norm <= residual_tolerance;
+}
 
-        current_iteration++;
+template <class MeshType>
+void latin_matrix<MeshType>::print_convergence_progress() const
+{
+    std::cout << std::string(6, ' ') << termcolor::bold;
+    if (displacement_norm <= displacement_tolerance)
+    {
+        std::cout << termcolor::green;
     }
-    if (current_iteration == maximum_iterations)
+    else
     {
-        throw computational_error("Reached Newton-Raphson iteration limit");
+        std::cout << termcolor::yellow;
     }
+    std::cout << "Space-time displacement correction norm " << displacement_norm << "\n"
+              << termcolor::reset << std::string(6, ' ');
 
-    if (current_iteration != maximum_iterations)
+    if (force_norm <= residual_tolerance)
     {
-        displacement_old = displacement;
-
-        adaptive_load.update_convergence_state(current_iteration != maximum_iterations);
-        fem_mesh.save_internal_variables(current_iteration != maximum_iterations);
-
-        fem_mesh.update_internal_forces(f_int);
-
-        fem_mesh.write(adaptive_load.step(), adaptive_load.time());
+        std::cout << termcolor::green;
+    }
+    else
+    {
+        std::cout << termcolor::yellow;
     }
+    std::cout << termcolor::bold << "Space-time residual force norm " << force_norm
+              << termcolor::reset << "\n";
 }
 }
@@ -6,8 +6,8 @@
 #include "assembler/sparsity_pattern.hpp"
 #include "assembler/homogeneous_dirichlet.hpp"
 #include "solver/eigen/arpack.hpp"
+#include "telemetry.hpp"
 
-#include <chrono>
 #include <iostream>
 
 namespace neon::mechanics
@@ -60,7 +60,7 @@ void linear_buckling_matrix<MeshType>::assemble_stiffness()
 {
     fem::compute_sparsity_pattern(K, mesh);
 
-    auto const start = std::chrono::steady_clock::now();
+    telemetry::scoped_timer timer("Stiffness assembly");
 
     K.coeffs() = 0.0;
 
@@ -79,12 +79,5 @@ void linear_buckling_matrix<MeshType>::assemble_stiffness()
             }
         }
     }
-
-    auto const end = std::chrono::steady_clock::now();
-
-    std::chrono::duration<double> const elapsed_seconds = end - start;
-
-    std::cout << std::string(6, ' ') << "Stiffness assembly took " << elapsed_seconds.count()
-              << "s\n";
 }
 }
@@ -0,0 +1,314 @@
+
+#pragma once
+
+#include "assembler/sparsity_pattern.hpp"
+#include "numeric/dense_matrix.hpp"
+#include "numeric/sparse_matrix.hpp"
+#include "solver/linear/linear_solver_factory.hpp"
+#include "io/json.hpp"
+#include "telemetry.hpp"
+
+#include <algorithm>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <termcolor/termcolor.hpp>
+#include <tbb/parallel_for.h>
+
+namespace neon::mechanics
+{
+/// load_case_matrix solves independent load cases on a mesh with a constant
+/// tangent stiffness matrix, such as linear elasticity.  The stiffness matrix
+/// is assembled and factorised once and the right hand sides of all load
+/// cases are passed to \sa linear_solver::block_solve, which reuses the
+/// factorisation for every right hand side.  Each load
+/// case applies its own boundary conditions in addition to the common
+/// boundary conditions of the mesh and all load cases must constrain the
+/// same degrees of freedom.  The results of each load case are written as
+/// a separate time step.
+template <class MeshType>
+class load_case_matrix
+{
+public:
+    using mesh_type = MeshType;
+
+    using load_case_type = typename mesh_type::load_case_type;
+
+public:
+    explicit load_case_matrix(mesh_type& mesh, json const& simulation);
+
+    /// Solve and write each load case
+    void solve();
+
+protected:
+    /// Assembles the stiffness matrix for the undeformed configuration
+    void assemble_stiffness();
+
+    /// Gathers the external forces and the prescribed displacements of each
+    /// load case into the columns of \p f_ext and \p prescribed_displacements
+    void compute_load_cases();
+
+    /// Gathers the internal force vector for the reaction forces
+    void compute_internal_force(vector& f_int) const;
+
+    /// Zero the rows and the columns of the constrained degrees of freedom
+    /// and keep the diagonal entries to preserve the conditioning
+    void enforce_dirichlet_conditions();
+
+    /// \return the sorted degrees of freedom constrained in \p boundaries
+    [[nodiscard]] std::vector<std::int32_t> dirichlet_dofs(load_case_type const& boundaries) const;
+
+protected:
+    mesh_type& mesh;
+
+    /// Time where the boundary conditions of the load cases are evaluated
+    double time;
+
+    /// Stiffness matrix
+    sparse_matrix K;
+    /// External forces of each load case
+    col_matrix f_ext;
+    /// Prescribed displacements of each load case
+    col_matrix prescribed_displacements;
+    /// Displacements of each load case
+    col_matrix displacements;
+
+    /// Degrees of freedom constrained in every load case
+    std::vector<std::int32_t> constrained_dofs;
+
+    std::unique_ptr<linear_solver> solver;
+};
+
+template <class MeshType>
+load_case_matrix<MeshType>::load_case_matrix(mesh_type& mesh, json const& simulation)
+    : mesh(mesh),
+      time(simulation["time"]["period"]),
+      solver(make_linear_solver(simulation["linear_solver"], mesh.is_symmetric()))
+{
+    if (mesh.load_cases().empty())
+    {
+        throw std::domain_error("\"load_cases\" must be specified in the mesh for the "
+                                "\"load_cases\" solution");
+    }
+    if (!mesh.is_tangent_constant())
+    {
+        throw std::domain_error("The \"load_cases\" solution requires materials with a constant "
+                                "tangent such as linear elasticity");
+    }
+
+    std::cout << "\n"
+              << std::string(4, ' ') << "Linear equation system has " << mesh.active_dofs()
+              << " degrees of freedom and " << mesh.load_cases().size() << " load cases\n";
+}
+
+template <class MeshType>
+void load_case_matrix<MeshType>::solve()
+{
+    // The stiffness is evaluated in the undeformed configuration
+    mesh.update_internal_variables(vector::Zero(mesh.active_dofs()));
+
+    assemble_stiffness();
+
+    compute_load_cases();
+
+    // Move the prescribed displacements to the right hand side before the
+    // constrained rows and columns are removed from the stiffness matrix
+    col_matrix f = f_ext - K * prescribed_displacements;
+
+    for (auto const dof : constrained_dofs) f.row(dof).setZero();
+
+    enforce_dirichlet_conditions();
+
+    solver->block_solve(K, displacements, f);
+
+    displacements += prescribed_displacements;
+
+    vector f_int(mesh.active_dofs());
+
+    for (std::int64_t index{0}; index < displacements.cols(); ++index)
+    {
+        auto const& name = mesh.load_cases()[index].name;
+
+        std::cout << std::string(4, ' ') << termcolor::magenta << termcolor::bold
+                  << "Writing load case \"" << name << "\" as time step " << index + 1
+                  << termcolor::reset << std::endl;
+
+        mesh.update_internal_variables(displacements.col(index));
+        mesh.save_internal_variables(true);
+
+        compute_internal_force(f_int);
+
+        mesh.update_internal_forces(f_int);
+
+        mesh.write(index + 1, index + 1.0);
+
+        telemetry::complete_step(index + 1, index + 1.0);
+    }
+}
+
+template <class MeshType>
+void load_case_matrix<MeshType>::assemble_stiffness()
+{
+    fem::compute_sparsity_pattern(K, mesh);
+
+    telemetry::scoped_timer timer("Tangent stiffness assembly");
+
+    K.coeffs() = 0.0;
+
+    for (auto const& submesh : mesh.meshes())
+    {
+        tbb::parallel_for(std::int64_t{0}, submesh.elements(), [&](auto const element) {
+            auto const& [dofs, ke] = submesh.tangent_stiffness(element);
+
+            for (std::int64_t b{0}; b < dofs.size(); b++)
+            {
+                for (std::int64_t a{0}; a < dofs.size(); a++)
+                {
+                    K.coefficient_update(dofs(a), dofs(b), ke(a, b));
+                }
+            }
+        });
+    }
+}
+
+template <class MeshType>
+void load_case_matrix<MeshType>::compute_load_cases()
+{
+    telemetry::scoped_timer timer("External forces assembly");
+
+    auto const& load_cases = mesh.load_cases();
+
+    auto const cases = static_cast<std::int64_t>(load_cases.size());
+
+    f_ext = prescribed_displacements = col_matrix::Zero(mesh.active_dofs(), cases);
+
+    std::vector<std::vector<std::int32_t>> case_dofs(cases);
+
+    tbb::parallel_for(std::int64_t{0}, cases, [&](auto const index) {
+        auto const& boundaries = load_cases[index];
+
+        vector f = vector::Zero(mesh.active_dofs());
+
+        auto const add_external_force = [&](auto const& nonfollower_boundaries) {
+            for (auto const& [name, boundary] : nonfollower_boundaries)
+            {
+                boundary.add_external_force(f, time);
+
+                for (auto const& nodal_boundary : boundary.nodal_interface())
+                {
+                    for (auto const dof : nodal_boundary.dof_view())
+                    {
+                        f(dof) += nodal_boundary.value_view();
+                    }
+                }
+            }
+        };
+
+        auto const add_displacement = [&](auto const& dirichlet_boundaries) {
+            for (auto const& [name, dirichlet_boundary] : dirichlet_boundaries)
+            {
+                for (auto const& boundary : dirichlet_boundary)
+                {
+                    for (auto const dof : boundary.dof_view())
+                    {
+                        prescribed_displacements(dof, index) = boundary.value_view(time);
+                    }
+                }
+            }
+        };
+
+        // The common boundary conditions are applied in every load case
+        add_external_force(mesh.nonfollower_boundaries());
+        add_external_force(boundaries.nonfollower_boundaries);
+
+        f_ext.col(index) = f;
+
+        add_displacement(mesh.dirichlet_boundaries());
+        add_displacement(boundaries.dirichlet_boundaries);
+
+        case_dofs[index] = dirichlet_dofs(boundaries);
+    });
+
+    // A single factorisation requires the same constraints in every load case
+    if (std::any_of(begin(case_dofs), end(case_dofs), [&](auto const& dofs) {
+            return dofs != case_dofs.front();
+        }))
+    {
+        throw std::domain_error("Every load case must constrain the same degrees of freedom");
+    }
+    constrained_dofs = std::move(case_dofs.front());
+}
+
+template <class MeshType>
+void load_case_matrix<MeshType>::compute_internal_force(vector& f_int) const
+{
+    f_int.setZero();
+
+    for (auto const& submesh : mesh.meshes())
+    {
+        for (std::int64_t element{0}; element < submesh.elements(); ++element)
+        {
+            auto const& [dofs, fe_int] = submesh.internal_force(element);
+
+            f_int(dofs) += fe_int;
+        }
+    }
+}
+
+template <class MeshType>
+void load_case_matrix<MeshType>::enforce_dirichlet_conditions()
+{
+    std::vector<std::int32_t> non_zero_visitor;
+
+    for (auto const fixed_dof : constrained_dofs)
+    {
+        auto const diagonal_entry = K.coeff(fixed_dof, fixed_dof);
+
+        non_zero_visitor.clear();
+
+        // Zero the rows and columns
+        for (sparse_matrix::InnerIterator it(K, fixed_dof); it; ++it)
+        {
+            it.valueRef() = 0.0;
+            non_zero_visitor.push_back(K.IsRowMajor ? it.col() : it.row());
+        }
+
+        for (auto const& non_zero : non_zero_visitor)
+        {
+            auto const row = K.IsRowMajor ? non_zero : fixed_dof;
+            auto const col = K.IsRowMajor ? fixed_dof : non_zero;
+
+            K.coeffRef(row, col) = 0.0;
+        }
+        // Reset the diagonal to the same value to preserve conditioning
+        K.coeffRef(fixed_dof, fixed_dof) = diagonal_entry;
+    }
+}
+
+template <class MeshType>
+std::vector<std::int32_t> load_case_matrix<MeshType>::dirichlet_dofs(
+    load_case_type const& boundaries) const
+{
+    std::vector<std::int32_t> dofs;
+
+    auto const add_dofs = [&](auto const& dirichlet_boundaries) {
+        for (auto const& [name, dirichlet_boundary] : dirichlet_boundaries)
+        {
+            for (auto const& boundary : dirichlet_boundary)
+            {
+                dofs.insert(end(dofs), begin(boundary.dof_view()), end(boundary.dof_view()));
+            }
+        }
+    };
+
+    add_dofs(mesh.dirichlet_boundaries());
+    add_dofs(boundaries.dirichlet_boundaries);
+
+    std::sort(begin(dofs), end(dofs));
+    dofs.erase(std::unique(begin(dofs), end(dofs)), end(dofs));
+
+    return dofs;
+}
+}
@@ -6,8 +6,8 @@
 #include "assembler/sparsity_pattern.hpp"
 #include "assembler/homogeneous_dirichlet.hpp"
 #include "solver/eigen/arpack.hpp"
+#include "telemetry.hpp"
 
-#include <chrono>
 #include <iostream>
 
 namespace neon::mechanics
@@ -73,7 +73,7 @@ void natural_frequency_matrix<MeshType>::assemble_stiffness()
 {
     fem::compute_sparsity_pattern(K, mesh);
 
-    auto const start = std::chrono::steady_clock::now();
+    telemetry::scoped_timer timer("Stiffness matrix assembly");
 
     K.coeffs() = 0.0;
 
@@ -92,13 +92,6 @@ void natural_frequency_matrix<MeshType>::assemble_stiffness()
             }
         }
     }
-
-    auto const end = std::chrono::steady_clock::now();
-
-    std::chrono::duration<double> const elapsed_seconds = end - start;
-
-    std::cout << std::string(6, ' ') << "Stiffness matrix assembly took " << elapsed_seconds.count()
-              << "s\n";
 }
 
 template <typename MeshType>
@@ -106,7 +99,7 @@ void natural_frequency_matrix<MeshType>::assemble_mass()
 {
     fem::compute_sparsity_pattern(M, mesh);
 
-    auto const start = std::chrono::steady_clock::now();
+    telemetry::scoped_timer timer("Mass matrix assembly");
 
     M.coeffs() = 0.0;
 
@@ -125,13 +118,6 @@ void natural_frequency_matrix<MeshType>::assemble_mass()
             }
         }
     }
-
-    auto const end = std::chrono::steady_clock::now();
-
-    std::chrono::duration<double> const elapsed_seconds = end - start;
-
-    std::cout << std::string(6, ' ') << "Mass matrix assembly took " << elapsed_seconds.count()
-              << "s\n";
 }
 
 template <typename MeshType>
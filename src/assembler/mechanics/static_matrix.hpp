@@ -7,13 +7,18 @@
 #include "numeric/sparse_matrix.hpp"
 #include "solver/adaptive_time_step.hpp"
 #include "solver/linear/linear_solver_factory.hpp"
+#include "io/binary_archive.hpp"
 #include "io/json.hpp"
+#include "telemetry.hpp"
 
-#include <chrono>
+#include <algorithm>
+#include <deque>
+#include <fstream>
+#include <future>
 #include <memory>
 #include <string>
 #include <iostream>
-#include <variant>
+#include <utility>
 
 #include <termcolor/termcolor.hpp>
 #include <tbb/parallel_for.h>
@@ -30,9 +35,20 @@ class static_matrix
 public:
     using mesh_type = MeshType;
 
+    /// Copy of the converged internal variables of a submesh
+    using checkpoint_type = decltype(
+        std::declval<mesh_type&>().meshes().front().checkpoint_internal_variables());
+
 public:
     explicit static_matrix(mesh_type& mesh, json const& simulation);
 
+    /// Continue the solution of \p parent for the next simulation step on
+    /// the continued \p mesh.  The displacement, the tangent matrix with its
+    /// sparsity pattern and the linear solver with its symbolic analysis are
+    /// moved from \p parent.  The linear solver is only reused when the
+    /// \p "linear_solver" options of both steps are the same
+    explicit static_matrix(mesh_type& mesh, json const& simulation, static_matrix&& parent);
+
     /// Solve the nonlinear system of equations
     void solve();
 
@@ -54,6 +70,18 @@ protected:
     /// Move the nodes on the mesh for the Dirichlet boundary
     void apply_displacement_boundaries();
 
+    /// \return the sorted degrees of freedom of the active Dirichlet boundaries
+    [[nodiscard]] std::vector<std::int32_t> active_dirichlet_dofs() const;
+
+    /// Scale the converged increment of the last step by the ratio of the
+    /// load increments as the initial guess for an iterative linear solver
+    void predict_increment();
+
+    /// Solve with the constant tangent matrix.  The Dirichlet conditions are
+    /// only enforced on a copy of the matrix and the factorisation is reused
+    /// while the active Dirichlet boundaries do not change
+    void solve_constant_tangent();
+
     /// Equilibrium iteration convergence criteria
     bool is_iteration_converged() const;
 
@@ -63,8 +91,22 @@ protected:
     void update_relative_norms();
 
 private:
+    /// Read the nonlinear and the checkpoint options of the simulation step
+    void read_options(json const& simulation);
+
     void perform_equilibrium_iterations();
 
+    /// Record the internal variables at the end of a load cycle and
+    /// extrapolate them over a number of cycles when possible
+    void perform_cycle_jump();
+
+    /// Serialise the converged state and write it to the checkpoint file in
+    /// the background.  The previous checkpoint is completed first
+    void write_checkpoint();
+
+    /// Restore the converged state from the checkpoint file
+    void read_checkpoint();
+
 protected:
     mesh_type& mesh;
 
@@ -72,6 +114,10 @@ protected:
 
     /// Cache the sparsity pattern
     bool is_sparsity_computed{false};
+    /// Flag if the tangent stiffness matrix is constant and assembled once
+    bool is_tangent_constant{false};
+    /// Flag if the constant tangent matrix has been assembled
+    bool is_tangent_assembled{false};
     /// Flag for norm computation
     bool use_relative_norm{true};
 
@@ -88,6 +134,10 @@ protected:
 
     /// Tangent sparse stiffness matrix
     sparse_matrix Kt;
+    /// Constant tangent matrix with the Dirichlet conditions enforced
+    sparse_matrix Kt_constrained;
+    /// Degrees of freedom enforced in the constant tangent matrix
+    std::vector<std::int32_t> constrained_dofs;
     /// Internal force vector
     vector f_int;
     /// External force vector
@@ -98,9 +148,28 @@ protected:
     vector displacement_old;
     /// Incremental displacement vector
     vector delta_d;
+    /// Displacement increment of the last converged step
+    vector last_increment;
+    /// Load increment of the last converged step
+    double last_load_increment{0.0};
     /// Minus residual vector
     vector minus_residual;
 
+    /// Converged internal variables at the end of the last resolved cycles
+    std::deque<std::vector<checkpoint_type>> cycle_states;
+
+    /// File name for the checkpoint of the converged state
+    std::string checkpoint_file_name;
+    /// Number of converged time steps between checkpoints (zero is none)
+    std::int32_t checkpoint_every{0};
+    /// Flag if the solution continues from a checkpoint
+    bool is_restarted{false};
+    /// Background checkpoint file output
+    std::future<void> checkpoint_output;
+
+    /// Options of the linear solver
+    json linear_solver_data;
+
     std::unique_ptr<linear_solver> solver;
 };
 
@@ -108,7 +177,54 @@ template <class MeshType>
 static_matrix<MeshType>::static_matrix(mesh_type& mesh, json const& simulation)
     : mesh(mesh),
       adaptive_load(simulation["time"], mesh.time_history()),
-      solver(make_linear_solver(simulation["linear_solver"], mesh.is_symmetric()))
+      linear_solver_data(simulation["linear_solver"]),
+      solver(make_linear_solver(linear_solver_data, mesh.is_symmetric()))
+{
+    f_int = f_ext = displacement = displacement_old = delta_d = vector::Zero(mesh.active_dofs());
+
+    is_tangent_constant = mesh.is_tangent_constant();
+
+    read_options(simulation);
+}
+
+template <class MeshType>
+static_matrix<MeshType>::static_matrix(mesh_type& mesh,
+                                       json const& simulation,
+                                       static_matrix&& parent)
+    : mesh(mesh),
+      adaptive_load(simulation["time"], mesh.time_history()),
+      // The sparsity pattern only depends on the mesh
+      is_sparsity_computed(parent.is_sparsity_computed),
+      is_tangent_constant(mesh.is_tangent_constant()),
+      Kt(std::move(parent.Kt)),
+      f_int(std::move(parent.f_int)),
+      f_ext(vector::Zero(mesh.active_dofs())),
+      displacement(std::move(parent.displacement)),
+      displacement_old(displacement),
+      delta_d(vector::Zero(mesh.active_dofs())),
+      linear_solver_data(simulation["linear_solver"]),
+      solver(linear_solver_data == parent.linear_solver_data
+                 ? std::move(parent.solver)
+                 : make_linear_solver(linear_solver_data, mesh.is_symmetric()))
+{
+    if (is_tangent_constant)
+    {
+        is_tangent_assembled = parent.is_tangent_assembled;
+
+        // A new solver applies the constraints and factorises again
+        if (linear_solver_data == parent.linear_solver_data)
+        {
+            Kt_constrained = std::move(parent.Kt_constrained);
+            constrained_dofs = std::move(parent.constrained_dofs);
+        }
+    }
+
+    // The restarted state takes precedence over the parent state
+    read_options(simulation);
+}
+
+template <class MeshType>
+void static_matrix<MeshType>::read_options(json const& simulation)
 {
     auto const& nonlinear_options = simulation["nonlinear_options"];
 
@@ -132,7 +248,28 @@ static_matrix<MeshType>::static_matrix(mesh_type& mesh, json const& simulation)
     residual_tolerance = nonlinear_options["residual_tolerance"];
     displacement_tolerance = nonlinear_options["displacement_tolerance"];
 
-    f_int = f_ext = displacement = displacement_old = delta_d = vector::Zero(mesh.active_dofs());
+    if (simulation.find("checkpoint") != simulation.end())
+    {
+        auto const& checkpoint_data = simulation["checkpoint"];
+
+        checkpoint_file_name = simulation["name"].get<std::string>() + ".checkpoint";
+
+        if (checkpoint_data.find("write_every") != checkpoint_data.end())
+        {
+            checkpoint_every = checkpoint_data["write_every"];
+
+            if (checkpoint_every < 0)
+            {
+                throw std::domain_error("\"write_every\" in \"checkpoint\" must be positive");
+            }
+        }
+        if (checkpoint_data.find("restart") != checkpoint_data.end()
+            && checkpoint_data["restart"].get<bool>()
+            && std::ifstream(checkpoint_file_name).good())
+        {
+            read_checkpoint();
+        }
+    }
 
     // Perform Newton-Raphson iterations
     std::cout << "\n"
@@ -145,11 +282,12 @@ void static_matrix<MeshType>::solve()
 {
     try
     {
-        // Initialise the mesh with zero displacements
+        // Initialise the mesh with zero (or restarted) displacements
         mesh.update_internal_variables(displacement);
         mesh.update_internal_forces(f_int);
 
-        mesh.write(adaptive_load.step(), adaptive_load.time());
+        // The restarted time step has already been written
+        if (!is_restarted) mesh.write(adaptive_load.step(), adaptive_load.time());
 
         while (!adaptive_load.is_fully_applied())
         {
@@ -162,6 +300,8 @@ void static_matrix<MeshType>::solve()
 
             perform_equilibrium_iterations();
         }
+        // Report any errors from the last checkpoint
+        if (checkpoint_output.valid()) checkpoint_output.get();
     }
     catch (computational_error& comp_error)
     {
@@ -171,6 +311,8 @@ void static_matrix<MeshType>::solve()
                   << std::string(6, ' ') << termcolor::bold << termcolor::yellow
                   << comp_error.what() << termcolor::reset << std::endl;
 
+        telemetry::count("Cutbacks");
+
         adaptive_load.update_convergence_state(false);
         mesh.save_internal_variables(false);
 
@@ -203,7 +345,7 @@ void static_matrix<MeshType>::compute_internal_force()
 template <class MeshType>
 void static_matrix<MeshType>::compute_external_force()
 {
-    auto const start = std::chrono::steady_clock::now();
+    telemetry::scoped_timer timer("External forces assembly");
 
     auto const step_time = adaptive_load.step_time();
 
@@ -211,19 +353,8 @@ void static_matrix<MeshType>::compute_external_force()
 
     for (auto const& [name, boundaries] : mesh.nonfollower_boundaries())
     {
-        for (auto const& boundary : boundaries.natural_interface())
-        {
-            std::visit(
-                [&](auto const& boundary_mesh) {
-                    for (std::int64_t element{0}; element < boundary_mesh.elements(); ++element)
-                    {
-                        auto const [dofs, fe_ext] = boundary_mesh.external_force(element, step_time);
-
-                        f_ext(dofs) += fe_ext;
-                    }
-                },
-                boundary);
-        }
+        boundaries.add_external_force(f_ext, step_time);
+
         for (auto const& boundary : boundaries.nodal_interface())
         {
             for (auto dof_index : boundary.dof_view())
@@ -232,10 +363,6 @@ void static_matrix<MeshType>::compute_external_force()
             }
         }
     }
-    auto const end = std::chrono::steady_clock::now();
-    std::chrono::duration<double> elapsed_seconds = end - start;
-    std::cout << std::string(6, ' ') << "External forces assembly took " << elapsed_seconds.count()
-              << "s\n";
 }
 
 template <class MeshType>
@@ -247,7 +374,7 @@ void static_matrix<MeshType>::assemble_stiffness()
         is_sparsity_computed = true;
     }
 
-    auto const start = std::chrono::steady_clock::now();
+    telemetry::scoped_timer timer("Tangent stiffness assembly");
 
     Kt.coeffs() = 0.0;
 
@@ -265,12 +392,6 @@ void static_matrix<MeshType>::assemble_stiffness()
             }
         });
     }
-
-    auto const end = std::chrono::steady_clock::now();
-    std::chrono::duration<double> const elapsed_seconds = end - start;
-
-    std::cout << std::string(6, ' ') << "Tangent stiffness assembly took "
-              << elapsed_seconds.count() << "s\n";
 }
 
 template <class MeshType>
@@ -347,6 +468,67 @@ void static_matrix<MeshType>::apply_displacement_boundaries()
     displacement += prescribed_increment;
 }
 
+template <class MeshType>
+std::vector<std::int32_t> static_matrix<MeshType>::active_dirichlet_dofs() const
+{
+    std::vector<std::int32_t> dofs;
+
+    for (auto const& [name, boundaries] : mesh.dirichlet_boundaries())
+    {
+        for (auto const& boundary : boundaries)
+        {
+            if (boundary.is_not_active(adaptive_load.step_time()))
+            {
+                continue;
+            }
+            dofs.insert(end(dofs), begin(boundary.dof_view()), end(boundary.dof_view()));
+        }
+    }
+    std::sort(begin(dofs), end(dofs));
+    dofs.erase(std::unique(begin(dofs), end(dofs)), end(dofs));
+
+    return dofs;
+}
+
+template <class MeshType>
+void static_matrix<MeshType>::predict_increment()
+{
+    if (last_increment.size() != delta_d.size() || last_load_increment <= 0.0)
+    {
+        delta_d.setZero();
+        return;
+    }
+
+    delta_d = last_increment * (adaptive_load.increment() / last_load_increment);
+
+    // The prescribed increments are already applied to the displacement
+    for (auto const dof : active_dirichlet_dofs()) delta_d(dof) = 0.0;
+}
+
+template <class MeshType>
+void static_matrix<MeshType>::solve_constant_tangent()
+{
+    auto dofs = active_dirichlet_dofs();
+
+    if (Kt_constrained.size() == 0 || dofs != constrained_dofs)
+    {
+        telemetry::count("Constant tangent factorisations");
+
+        Kt_constrained = Kt;
+
+        enforce_dirichlet_conditions(Kt_constrained, minus_residual);
+
+        constrained_dofs = std::move(dofs);
+    }
+    else
+    {
+        for (auto const dof : constrained_dofs) minus_residual(dof) = 0.0;
+
+        solver->reuse_factorisation();
+    }
+    solver->solve(Kt_constrained, delta_d, minus_residual);
+}
+
 template <class MeshType>
 bool static_matrix<MeshType>::is_iteration_converged() const
 {
@@ -409,12 +591,18 @@ void static_matrix<MeshType>::perform_equilibrium_iterations()
     auto current_iteration{0};
     while (current_iteration < maximum_iterations)
     {
-        auto const start = std::chrono::steady_clock::now();
+        telemetry::scoped_timer timer("Equilibrium iteration", telemetry::timer_output::required);
+
+        telemetry::count("Newton-Raphson iterations");
 
         std::cout << std::string(4, ' ') << termcolor::blue << termcolor::bold
                   << "Newton-Raphson iteration " << current_iteration << termcolor::reset << "\n";
 
-        assemble_stiffness();
+        if (!is_tangent_constant || !is_tangent_assembled)
+        {
+            assemble_stiffness();
+            is_tangent_assembled = true;
+        }
 
         compute_internal_force();
 
@@ -424,11 +612,25 @@ void static_matrix<MeshType>::perform_equilibrium_iterations()
         {
             apply_displacement_boundaries();
             norm_initial_residual = minus_residual.norm();
+
+            predict_increment();
+        }
+        else
+        {
+            // The corrections are not correlated between iterations
+            delta_d.setZero();
         }
 
-        enforce_dirichlet_conditions(Kt, minus_residual);
+        if (is_tangent_constant)
+        {
+            solve_constant_tangent();
+        }
+        else
+        {
+            enforce_dirichlet_conditions(Kt, minus_residual);
 
-        solver->solve(Kt, delta_d, minus_residual);
+            solver->solve(Kt, delta_d, minus_residual);
+        }
 
         displacement += delta_d;
 
@@ -438,11 +640,6 @@ void static_matrix<MeshType>::perform_equilibrium_iterations()
 
         print_convergence_progress();
 
-        auto const end = std::chrono::steady_clock::now();
-        std::chrono::duration<double> const elapsed_seconds = end - start;
-        std::cout << std::string(6, ' ') << "Equilibrium iteration required "
-                  << elapsed_seconds.count() << "s\n";
-
         if (is_iteration_converged()) break;
 
         current_iteration++;
@@ -454,6 +651,9 @@ void static_matrix<MeshType>::perform_equilibrium_iterations()
 
     if (current_iteration != maximum_iterations)
     {
+        last_increment = displacement - displacement_old;
+        last_load_increment = adaptive_load.increment();
+
         displacement_old = displacement;
 
         adaptive_load.update_convergence_state(current_iteration != maximum_iterations);
@@ -462,6 +662,144 @@ void static_matrix<MeshType>::perform_equilibrium_iterations()
         mesh.update_internal_forces(f_int);
 
         mesh.write(adaptive_load.step(), adaptive_load.time());
+
+        if (adaptive_load.is_cycle_completed()) perform_cycle_jump();
+
+        if (checkpoint_every > 0
+            && (adaptive_load.step() % checkpoint_every == 0 || adaptive_load.is_fully_applied()))
+        {
+            write_checkpoint();
+        }
+
+        telemetry::complete_step(adaptive_load.step(), adaptive_load.time());
+    }
+}
+
+template <class MeshType>
+void static_matrix<MeshType>::perform_cycle_jump()
+{
+    // Keep the converged state at the end of the last three cycles
+    auto& state = cycle_states.emplace_back();
+
+    for (auto const& submesh : mesh.meshes())
+    {
+        state.push_back(submesh.checkpoint_internal_variables());
+    }
+
+    if (cycle_states.size() > 3) cycle_states.pop_front();
+
+    if (cycle_states.size() < 3 || !adaptive_load.is_cycle_jump_possible()) return;
+
+    double rate{0.0}, error{0.0};
+
+    for (std::size_t index{0}; index < mesh.meshes().size(); ++index)
+    {
+        auto const [submesh_rate, submesh_error] = mesh.meshes()[index]
+                                                       .internal_variables()
+                                                       .cycle_variation(cycle_states[0][index],
+                                                                        cycle_states[1][index],
+                                                                        cycle_states[2][index]);
+        rate = std::max(rate, submesh_rate);
+        error = std::max(error, submesh_error);
+    }
+
+    auto const cycles = adaptive_load.cycle_jump(rate, error);
+
+    if (cycles < 1.0) return;
+
+    for (std::size_t index{0}; index < mesh.meshes().size(); ++index)
+    {
+        mesh.meshes()[index].extrapolate_internal_variables(cycle_states[1][index],
+                                                            cycle_states[2][index],
+                                                            cycles);
     }
+
+    adaptive_load.jump(cycles);
+
+    // The extrapolated state is not a converged cycle
+    cycle_states.clear();
+}
+
+template <class MeshType>
+void static_matrix<MeshType>::write_checkpoint()
+{
+    // Complete the previous checkpoint and report any errors
+    if (checkpoint_output.valid()) checkpoint_output.get();
+
+    io::binary_output_archive archive;
+
+    archive.write(static_cast<std::int64_t>(displacement_old.size()));
+    archive.write(static_cast<std::int64_t>(mesh.meshes().size()));
+
+    adaptive_load.save(archive);
+
+    archive.write(displacement_old);
+
+    for (auto const& submesh : mesh.meshes())
+    {
+        archive.write(submesh.checkpoint_internal_variables());
+    }
+
+    // Increment predictor and the states of the resolved cycles
+    archive.write(last_increment);
+    archive.write(last_load_increment);
+
+    archive.write(static_cast<std::int64_t>(cycle_states.size()));
+
+    for (auto const& state : cycle_states) archive.write(state);
+
+    std::cout << std::string(6, ' ') << "Writing checkpoint for step " << adaptive_load.step()
+              << "\n";
+
+    checkpoint_output = std::async(std::launch::async,
+                                   [archive = std::move(archive), this]() {
+                                       archive.save(checkpoint_file_name);
+                                   });
+}
+
+template <class MeshType>
+void static_matrix<MeshType>::read_checkpoint()
+{
+    io::binary_input_archive archive(checkpoint_file_name);
+
+    std::int64_t dofs, submeshes;
+    archive.read(dofs);
+    archive.read(submeshes);
+
+    if (dofs != displacement.size() || submeshes != static_cast<std::int64_t>(mesh.meshes().size()))
+    {
+        throw std::domain_error("The checkpoint " + checkpoint_file_name
+                                + " does not match the mesh");
+    }
+
+    adaptive_load.load(archive);
+
+    archive.read(displacement_old);
+
+    displacement = displacement_old;
+
+    for (auto& submesh : mesh.meshes())
+    {
+        checkpoint_type state;
+        archive.read(state);
+        submesh.restore_internal_variables(state);
+    }
+
+    archive.read(last_increment);
+    archive.read(last_load_increment);
+
+    std::int64_t resolved_cycles;
+    archive.read(resolved_cycles);
+
+    cycle_states.resize(resolved_cycles);
+
+    for (auto& state : cycle_states) archive.read(state);
+
+    is_restarted = true;
+
+    mesh.restart_output(adaptive_load.time());
+
+    std::cout << std::string(4, ' ') << "Restarting from " << checkpoint_file_name << " at time "
+              << adaptive_load.time() << "\n";
 }
 }
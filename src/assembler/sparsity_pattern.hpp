@@ -2,6 +2,8 @@
 #pragma once
 
 #include "numeric/doublet.hpp"
+#include "solver/linear/ordering_cache.hpp"
+#include "thread_policy.hpp"
 
 #include <cstdint>
 #include <vector>
@@ -14,7 +16,10 @@ namespace neon::fem
 /// the resulting data structure.  This function requires that the mesh_type
 /// provide a \p local_dof_view method for each of the submeshes associated
 /// with the \p mesh
-/// This results in the non-zero entries in A set to zero.
+/// This results in the non-zero entries in A set to zero.  The values are
+/// distributed over the memory nodes of the threads \sa thread_policy
+/// The pattern is restored from the active ordering_cache when the element
+/// degrees of freedom are unchanged \sa ordering_cache
 template <typename sparse_matrix_type, typename mesh_type>
 void compute_sparsity_pattern(sparse_matrix_type& A, mesh_type const& mesh)
 {
@@ -22,11 +27,44 @@ void compute_sparsity_pattern(sparse_matrix_type& A, mesh_type const& mesh)
 
     static_assert(std::is_integral<integer_type>::value, "Index type must be an integer");
 
+    A.resize(mesh.active_dofs(), mesh.active_dofs());
+
+    auto const cache = ordering_cache::get();
+
+    // Key the pattern on the degrees of freedom of each element
+    std::uint64_t key{0};
+
+    if (cache != nullptr)
+    {
+        std::int64_t const dofs = mesh.active_dofs();
+
+        key = ordering_cache::hash(&dofs, 1);
+
+        for (auto const& submesh : mesh.meshes())
+        {
+            for (std::int64_t element{0}; element < submesh.elements(); element++)
+            {
+                auto const local_dof_view = submesh.local_dof_view(element);
+
+                for (std::int64_t p{0}; p < local_dof_view.size(); p++)
+                {
+                    std::int64_t const dof = local_dof_view(p);
+
+                    key = ordering_cache::hash(&dof, 1, key);
+                }
+            }
+        }
+
+        if (cache->restore_pattern(key, A))
+        {
+            thread_policy::distribute(A.valuePtr(), A.nonZeros() * sizeof(*A.valuePtr()));
+            return;
+        }
+    }
+
     std::vector<doublet<integer_type>> ij;
     ij.reserve(mesh.active_dofs());
 
-    A.resize(mesh.active_dofs(), mesh.active_dofs());
-
     for (auto const& submesh : mesh.meshes())
     {
         // Loop over the elements and add in the non-zero components
@@ -45,5 +83,10 @@ void compute_sparsity_pattern(sparse_matrix_type& A, mesh_type const& mesh)
     }
     A.setFromTriplets(begin(ij), end(ij));
     A.finalize();
+
+    if (cache != nullptr) cache->store_pattern(key, A);
+
+    // Place the rows in the memory of the threads performing the products
+    thread_policy::distribute(A.valuePtr(), A.nonZeros() * sizeof(*A.valuePtr()));
 }
 }
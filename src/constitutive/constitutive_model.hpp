@@ -3,8 +3,13 @@
 
 #include "internal_variables_forward.hpp"
 
+#include "constitutive/variable_types.hpp"
+#include "numeric/dense_matrix.hpp"
+
+#include <cstddef>
 #include <memory>
 #include <set>
+#include <stdexcept>
 
 namespace neon
 {
@@ -20,6 +25,9 @@ class constitutive_model
 public:
     using internal_variable_t = internal_variables<rank2_dimension, rank4_dimension>;
 
+    /// Tangent operator in Voigt notation
+    using tangent_operator_t = Eigen::Matrix<double, rank4_dimension, rank4_dimension>;
+
 public:
     /// Provide an internal variable class to be populated by the constitutive model
     explicit constitutive_model(std::shared_ptr<internal_variable_t>& variables)
@@ -33,6 +41,11 @@ public:
     /// \param time_step_size Time step size (or load increment if quasi-static)
     virtual void update_internal_variables(double const time_step_size) = 0;
 
+    /// Recompute the variables which are functions of the stored state, such
+    /// as the von Mises stress, after the state was modified outside of an
+    /// update \sa internal_variables::extrapolate
+    virtual void update_derived_variables() {}
+
     /// \return A base class reference to the common material properties
     [[nodiscard]] virtual material_property const& intrinsic_material() const = 0;
 
@@ -40,6 +53,41 @@ public:
 
     [[nodiscard]] virtual bool is_symmetric() const { return true; };
 
+    /// \return true if the tangent operator is independent of the deformation
+    /// and the history, such that the stiffness matrix only needs to be
+    /// assembled and factorised once
+    [[nodiscard]] virtual bool is_tangent_constant() const { return false; }
+
+    /// \return true if the tangent operator only depends on the current state
+    /// of a quadrature point and not on the history \sa tangent_operator
+    [[nodiscard]] virtual bool has_pointwise_tangent() const { return false; }
+
+    /// Evaluate the tangent operator from the current internal variables
+    /// \param l Index of the quadrature point in the internal variables
+    [[nodiscard]] virtual tangent_operator_t tangent_operator(std::size_t const l) const
+    {
+        throw std::domain_error("The constitutive model does not provide a pointwise tangent "
+                                "operator");
+    }
+
+    /// Evaluate the tangent operator during the assembly instead of storing it
+    /// for each quadrature point in the internal variables \sa tangent_operator
+    void evaluate_tangent_in_assembly()
+    {
+        if (!has_pointwise_tangent())
+        {
+            throw std::domain_error("The tangent operator of the constitutive model depends on "
+                                    "the history and must be stored");
+        }
+        is_tangent_stored = false;
+
+        variables->remove(variable::fourth::tangent_operator);
+        variables->remove(variable::major_symmetric::tangent_operator);
+    }
+
+    /// \return true if the tangent operator is stored in the internal variables
+    [[nodiscard]] bool stores_tangent() const noexcept { return is_tangent_stored; }
+
     [[nodiscard]] std::set<std::string> const& variable_names() const noexcept { return names; }
 
 protected:
@@ -48,6 +96,9 @@ protected:
 
     /// Internal variable names allocated by the constitutive model
     std::set<std::string> names;
+
+    /// Flag if the tangent operator is stored for each quadrature point
+    bool is_tangent_stored{true};
 };
 }
 
@@ -109,12 +109,28 @@ std::unique_ptr<constitutive_model> make_constitutive_model(
             }
             else if (chain_type == "langevin")
             {
-                return std::make_unique<affine_microsphere>(variables, material_data, entry->second);
+                auto model = std::make_unique<affine_microsphere>(variables,
+                                                                  material_data,
+                                                                  entry->second);
+
+                if (constitutive_model.find("surrogate") != constitutive_model.end())
+                {
+                    model->tabulate(constitutive_model["surrogate"]);
+                }
+                return model;
             }
         }
         else if (model_type == "nonaffine")
         {
-            return std::make_unique<nonaffine_microsphere>(variables, material_data, entry->second);
+            auto model = std::make_unique<nonaffine_microsphere>(variables,
+                                                                 material_data,
+                                                                 entry->second);
+
+            if (constitutive_model.find("surrogate") != constitutive_model.end())
+            {
+                model->tabulate(constitutive_model["surrogate"]);
+            }
+            return model;
         }
         else
         {
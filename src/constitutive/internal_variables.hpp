@@ -6,8 +6,13 @@
 #include "numeric/dense_matrix.hpp"
 #include "constitutive/variable_types.hpp"
 
+#include <algorithm>
+#include <cmath>
 #include <functional>
+#include <tuple>
+#include <type_traits>
 #include <unordered_map>
+#include <utility>
 #include <vector>
 #include <cstdint>
 
@@ -33,6 +38,21 @@ public:
 
     static auto constexpr tensor_size = rank2_dimension * rank2_dimension;
 
+    /// Number of independent components of a symmetric second order tensor
+    static auto constexpr symmetric_size = rank2_dimension * (rank2_dimension + 1) / 2;
+
+    /// A symmetric second order tensor type is packed in Voigt notation without
+    /// a factor on the off diagonal components \sa voigt::kinetic
+    using symmetric_tensor_type = Eigen::Matrix<double, symmetric_size, 1>;
+
+    /// Number of independent components of a fourth order tensor with major
+    /// symmetry in Voigt notation
+    static auto constexpr major_symmetric_size = rank4_dimension * (rank4_dimension + 1) / 2;
+
+    /// A fourth order tensor with major symmetry is packed row by row from the
+    /// upper triangle of the Voigt notation \sa voigt::major_symmetric
+    using major_symmetric_tensor_type = Eigen::Matrix<double, major_symmetric_size, 1>;
+
 public:
     internal_variables(std::size_t const size) : size{size} {}
 
@@ -72,6 +92,15 @@ public:
         add(names...);
     }
 
+    /// Add a number of symmetric tensor type variables to the object store
+    template <typename... all_types>
+    void add(variable::symmetric const name, all_types... names)
+    {
+        symmetric_tensors[name].resize(size, symmetric_tensor_type::Zero());
+        symmetric_tensors_old[name].resize(size, symmetric_tensor_type::Zero());
+        add(names...);
+    }
+
     /// Allocate scalars (defaulted to zeros)
     void add(variable::scalar const name, double const value = 0.0)
     {
@@ -93,12 +122,32 @@ public:
         second_order_tensors_old[name].resize(size, second_tensor_type::Zero());
     }
 
+    /// Allocate symmetric tensors (defaulted to zeros)
+    void add(variable::symmetric const name)
+    {
+        symmetric_tensors[name].resize(size, symmetric_tensor_type::Zero());
+        symmetric_tensors_old[name].resize(size, symmetric_tensor_type::Zero());
+    }
+
     /// Allocate fourth order tensor (defaulted to zeros)
     void add(variable::fourth const name, fourth_tensor_type const m = fourth_tensor_type::Zero())
     {
         fourth_order_tensors[name].resize(size, m);
     }
 
+    /// Allocate fourth order tensor with major symmetry (defaulted to zeros)
+    void add(variable::major_symmetric const name,
+             major_symmetric_tensor_type const m = major_symmetric_tensor_type::Zero())
+    {
+        major_symmetric_tensors[name].resize(size, m);
+    }
+
+    /// Release the storage of a fourth order tensor
+    void remove(variable::fourth const name) { fourth_order_tensors.erase(name); }
+
+    /// Release the storage of a fourth order tensor with major symmetry
+    void remove(variable::major_symmetric const name) { major_symmetric_tensors.erase(name); }
+
     bool has(variable::scalar const name) const { return scalars.find(name) != scalars.end(); }
 
     bool has(variable::vector const name) const { return vectors.find(name) != vectors.end(); }
@@ -108,11 +157,21 @@ public:
         return second_order_tensors.find(name) != second_order_tensors.end();
     }
 
+    bool has(variable::symmetric const name) const
+    {
+        return symmetric_tensors.find(name) != symmetric_tensors.end();
+    }
+
     bool has(variable::fourth const name) const
     {
         return fourth_order_tensors.find(name) != fourth_order_tensors.end();
     }
 
+    bool has(variable::major_symmetric const name) const
+    {
+        return major_symmetric_tensors.find(name) != major_symmetric_tensors.end();
+    }
+
     /// Const access to the converged vector variables
     std::vector<std::vector<double>> const& get_old(variable::vector const name) const
     {
@@ -125,6 +184,12 @@ public:
         return second_order_tensors_old.find(name)->second;
     }
 
+    /// Const access to the converged symmetric tensor variables
+    std::vector<symmetric_tensor_type> const& get_old(variable::symmetric const name) const
+    {
+        return symmetric_tensors_old.find(name)->second;
+    }
+
     /// Const access to the converged scalar variables
     std::vector<double> const& get_old(variable::scalar const name) const
     {
@@ -164,6 +229,17 @@ public:
         return second_order_tensors.find(name)->second;
     }
 
+    /// Mutable access to the non-converged symmetric tensor variables
+    std::vector<symmetric_tensor_type>& get(variable::symmetric const name)
+    {
+        if (!has(name))
+        {
+            throw std::domain_error("Symmetric tensor " + std::to_string(static_cast<int>(name))
+                                    + " does not exist in the variable table");
+        }
+        return symmetric_tensors.find(name)->second;
+    }
+
     /// Mutable access to the non-converged fourth order tensor variables
     std::vector<fourth_tensor_type>& get(variable::fourth const name)
     {
@@ -175,6 +251,19 @@ public:
         return fourth_order_tensors.find(name)->second;
     }
 
+    /// Mutable access to the non-converged fourth order tensor variables with
+    /// major symmetry
+    std::vector<major_symmetric_tensor_type>& get(variable::major_symmetric const name)
+    {
+        if (!has(name))
+        {
+            throw std::domain_error("Major symmetric fourth order tensor "
+                                    + std::to_string(static_cast<int>(name))
+                                    + " does not exist in the variable table");
+        }
+        return major_symmetric_tensors.find(name)->second;
+    }
+
     /// Mutable access to the non-converged scalar variables
     template <typename... scalar_types>
     auto get(variable::scalar const var0, scalar_types const... vars)
@@ -199,6 +288,14 @@ public:
                                std::ref(second_order_tensors.find(vars)->second)...);
     }
 
+    /// Mutable access to the non-converged symmetric tensor variables
+    template <typename... symmetric_types>
+    auto get(variable::symmetric const var0, symmetric_types const... vars)
+    {
+        return std::make_tuple(std::ref(symmetric_tensors.find(var0)->second),
+                               std::ref(symmetric_tensors.find(vars)->second)...);
+    }
+
     template <typename... fourth_types>
     auto get(variable::fourth const var0, fourth_types const... vars)
     {
@@ -218,12 +315,24 @@ public:
         return second_order_tensors.find(name)->second;
     }
 
+    /// Non-mutable access to the non-converged symmetric tensor variables
+    std::vector<symmetric_tensor_type> const& get(variable::symmetric const name) const
+    {
+        return symmetric_tensors.find(name)->second;
+    }
+
     /// Non-mutable access to the non-converged matrix variables
     std::vector<fourth_tensor_type> const& get(variable::fourth const name) const
     {
         return fourth_order_tensors.find(name)->second;
     }
 
+    /// Non-mutable access to the non-converged matrix variables with major symmetry
+    std::vector<major_symmetric_tensor_type> const& get(variable::major_symmetric const name) const
+    {
+        return major_symmetric_tensors.find(name)->second;
+    }
+
     /// Const access to the non-converged scalar variables
     template <typename... scalar_types>
     auto get(variable::scalar const var0, scalar_types const... vars) const
@@ -250,22 +359,251 @@ public:
     /// Commit to history when iteration converges
     void commit()
     {
-        scalars_old = scalars;
-        vectors_old = vectors;
-        second_order_tensors_old = second_order_tensors;
+        assign(scalars_old, scalars);
+        assign(vectors_old, vectors);
+        assign(second_order_tensors_old, second_order_tensors);
+        assign(symmetric_tensors_old, symmetric_tensors);
     }
 
     /// Revert to the old state when iteration doesn't converge
     void revert()
     {
-        scalars = scalars_old;
-        vectors = vectors_old;
-        second_order_tensors = second_order_tensors_old;
+        assign(scalars, scalars_old);
+        assign(vectors, vectors_old);
+        assign(second_order_tensors, second_order_tensors_old);
+        assign(symmetric_tensors, symmetric_tensors_old);
+    }
+
+    /// Apply \p function to the contiguous storage of each scalar, vector and
+    /// tensor variable, including the history.  The storage is not reallocated when
+    /// the variables are committed or reverted.
+    template <typename function_type>
+    void for_each_storage(function_type&& function) const
+    {
+        auto const apply = [&function](auto const& map) {
+            for (auto const& [name, values] : map) function(values);
+        };
+        apply(scalars);
+        apply(scalars_old);
+        apply(vectors);
+        apply(vectors_old);
+        apply(second_order_tensors);
+        apply(second_order_tensors_old);
+        apply(symmetric_tensors);
+        apply(symmetric_tensors_old);
+        apply(fourth_order_tensors);
+        apply(major_symmetric_tensors);
+    }
+
+    /// \return a copy of the converged (committed) variables \sa restore
+    [[nodiscard]] auto checkpoint() const
+    {
+        return std::make_tuple(scalars_old,
+                               vectors_old,
+                               second_order_tensors_old,
+                               symmetric_tensors_old);
+    }
+
+    /// Restore the converged and non-converged variables from a checkpoint
+    template <typename checkpoint_type>
+    void restore(checkpoint_type const& state)
+    {
+        std::tie(scalars_old, vectors_old, second_order_tensors_old, symmetric_tensors_old) = state;
+        revert();
+    }
+
+    /// Linearly extrapolate the converged variables over a number of load
+    /// cycles.  The checkpoints must be taken at the same phase of two
+    /// consecutive cycles and the extrapolated state is committed.  The
+    /// irreversible scalars do not decrease and the damage is limited to one.
+    /// Variables derived from the extrapolated state, such as the von Mises
+    /// stress, are not consistent with it until they are recomputed by the
+    /// constitutive model \sa cycle_variation
+    template <typename checkpoint_type>
+    void extrapolate(checkpoint_type const& previous,
+                     checkpoint_type const& current,
+                     double const cycles)
+    {
+        restore(current);
+
+        auto const& [previous_scalars,
+                     previous_vectors,
+                     previous_tensors,
+                     previous_symmetric_tensors] = previous;
+
+        for (auto& [name, values] : scalars_old)
+        {
+            auto const& previous_values = previous_scalars.at(name);
+
+            bool const is_irreversible = name == variable::scalar::effective_plastic_strain
+                                         || name == variable::scalar::damage;
+
+            for (std::size_t l{0}; l < values.size(); ++l)
+            {
+                auto const value = values[l];
+
+                values[l] += cycles * (value - previous_values[l]);
+
+                if (is_irreversible) values[l] = std::max(values[l], value);
+            }
+            if (name == variable::scalar::damage)
+            {
+                for (auto& value : values) value = std::min(value, 1.0);
+            }
+        }
+        for (auto& [name, values] : vectors_old)
+        {
+            auto const& previous_values = previous_vectors.at(name);
+
+            for (std::size_t l{0}; l < values.size(); ++l)
+            {
+                for (std::size_t i{0}; i < values[l].size(); ++i)
+                {
+                    values[l][i] += cycles * (values[l][i] - previous_values[l][i]);
+                }
+            }
+        }
+        for (auto& [name, values] : second_order_tensors_old)
+        {
+            auto const& previous_values = previous_tensors.at(name);
+
+            for (std::size_t l{0}; l < values.size(); ++l)
+            {
+                values[l] += cycles * (values[l] - previous_values[l]);
+            }
+        }
+        for (auto& [name, values] : symmetric_tensors_old)
+        {
+            auto const& previous_values = previous_symmetric_tensors.at(name);
+
+            for (std::size_t l{0}; l < values.size(); ++l)
+            {
+                values[l] += cycles * (values[l] - previous_values[l]);
+            }
+        }
+        revert();
+    }
+
+    /// Compute the variation of the variables between checkpoints taken at
+    /// the same phase of three consecutive load cycles.  The first difference
+    /// is the change per cycle and the second difference estimates the error
+    /// of a linear extrapolation.  Both are relative to the largest magnitude
+    /// of each variable over the quadrature points.
+    /// \return the largest relative first and second differences
+    template <typename checkpoint_type>
+    [[nodiscard]] static std::pair<double, double> cycle_variation(checkpoint_type const& first,
+                                                                   checkpoint_type const& second,
+                                                                   checkpoint_type const& third)
+    {
+        std::pair<double, double> variation{0.0, 0.0};
+
+        accumulate_variation(std::get<0>(first),
+                             std::get<0>(second),
+                             std::get<0>(third),
+                             [](double const x) { return std::abs(x); },
+                             variation);
+
+        accumulate_variation(std::get<1>(first),
+                             std::get<1>(second),
+                             std::get<1>(third),
+                             [](std::vector<double> const& x) {
+                                 double maximum{0.0};
+                                 for (auto const value : x)
+                                 {
+                                     maximum = std::max(maximum, std::abs(value));
+                                 }
+                                 return maximum;
+                             },
+                             variation);
+
+        accumulate_variation(std::get<2>(first),
+                             std::get<2>(second),
+                             std::get<2>(third),
+                             [](second_tensor_type const& x) { return x.cwiseAbs().maxCoeff(); },
+                             variation);
+
+        accumulate_variation(std::get<3>(first),
+                             std::get<3>(second),
+                             std::get<3>(third),
+                             [](symmetric_tensor_type const& x) { return x.cwiseAbs().maxCoeff(); },
+                             variation);
+
+        return variation;
     }
 
     /// \return Number of internal variables
     auto entries() const noexcept { return size; }
 
+protected:
+    /// Copy the variables in a hash map into the existing storage of \p
+    /// destination to retain the memory placement of the storage
+    template <typename map_type>
+    static void assign(map_type& destination, map_type const& source)
+    {
+        for (auto const& [name, values] : source)
+        {
+            auto& destination_values = destination[name];
+
+            if (destination_values.size() != values.size())
+            {
+                destination_values = values;
+                continue;
+            }
+            std::copy(begin(values), end(values), begin(destination_values));
+        }
+    }
+
+    /// Accumulate the largest relative first and second differences of the
+    /// variables in a hash map using the maximum norm \p norm of an entry
+    template <typename map_type, typename norm_type>
+    static void accumulate_variation(map_type const& first,
+                                     map_type const& second,
+                                     map_type const& third,
+                                     norm_type&& norm,
+                                     std::pair<double, double>& variation)
+    {
+        for (auto const& [name, values] : third)
+        {
+            auto const& first_values = first.at(name);
+            auto const& second_values = second.at(name);
+
+            double magnitude{0.0}, first_difference{0.0}, second_difference{0.0};
+
+            for (std::size_t l{0}; l < values.size(); ++l)
+            {
+                magnitude = std::max(magnitude, norm(values[l]));
+                first_difference = std::max(first_difference,
+                                            norm(difference(values[l], second_values[l])));
+                second_difference = std::max(second_difference,
+                                             norm(difference(difference(values[l], second_values[l]),
+                                                             difference(second_values[l],
+                                                                        first_values[l]))));
+            }
+
+            if (magnitude > 0.0)
+            {
+                variation.first = std::max(variation.first, first_difference / magnitude);
+                variation.second = std::max(variation.second, second_difference / magnitude);
+            }
+        }
+    }
+
+    /// \return the entry-wise difference of two variables
+    template <typename value_type>
+    static value_type difference(value_type const& left, value_type const& right)
+    {
+        if constexpr (std::is_same_v<value_type, std::vector<double>>)
+        {
+            value_type result(left.size());
+            std::transform(begin(left), end(left), begin(right), begin(result), std::minus<>{});
+            return result;
+        }
+        else
+        {
+            return left - right;
+        }
+    }
+
 protected:
     /// Hash map of scalar history
     std::unordered_map<variable::scalar, std::vector<double>> scalars;
@@ -282,9 +620,18 @@ protected:
     /// Hash map of old second order tensors
     std::unordered_map<variable::second, std::vector<second_tensor_type>> second_order_tensors_old;
 
+    /// Hash map of symmetric second order tensors
+    std::unordered_map<variable::symmetric, std::vector<symmetric_tensor_type>> symmetric_tensors;
+    /// Hash map of old symmetric second order tensors
+    std::unordered_map<variable::symmetric, std::vector<symmetric_tensor_type>> symmetric_tensors_old;
+
     /// Fourth order tensors
     std::unordered_map<variable::fourth, std::vector<fourth_tensor_type>> fourth_order_tensors;
 
+    /// Fourth order tensors with major symmetry
+    std::unordered_map<variable::major_symmetric, std::vector<major_symmetric_tensor_type>>
+        major_symmetric_tensors;
+
     std::size_t size;
 };
 }
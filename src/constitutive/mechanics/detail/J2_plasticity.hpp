@@ -110,7 +110,7 @@ tangent_operator_type algorithmic_tangent(double const G,
     // clang-format off
     A << 2 * Be_trial(0, 0),                  0, 2 * Be_trial(0, 1),
                           0, 2 * Be_trial(1, 1),                  0,
-         2 * Be_trial(1, 0),                  0,     Be_trial(2, 2);
+         2 * Be_trial(1, 0),                  0,     Be_trial(1, 1);
     // clang-format on
     return A;
 }
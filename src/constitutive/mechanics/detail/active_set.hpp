@@ -0,0 +1,76 @@
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+namespace neon::mechanics
+{
+/**
+ * active_set partitions the quadrature points of an elastic-plastic
+ * constitutive model into an elastic and an active set.
+ *
+ * Points which are shown to remain inside the yield surface are marked as
+ * elastic and receive the elastic update directly.  For small strain models
+ * the elastic tangent operator is constant and only needs to be written when
+ * a point changes from the plastic to the elastic set.  The remaining points
+ * are compacted into a dense list so the trial state and the return mapping
+ * are only computed (and load balanced) over the active points.
+ *
+ * The marking functions are safe to call concurrently for distinct points.
+ */
+class active_set
+{
+public:
+    /// Resize the active set for the number of quadrature points
+    void resize(std::size_t const size)
+    {
+        if (active.size() != size)
+        {
+            elastic_tangent.assign(size, 0);
+            active.assign(size, 0);
+        }
+    }
+
+    /// Mark the quadrature point as elastic
+    /// \return true if the elastic tangent operator needs to be written
+    bool mark_elastic(std::size_t const l) noexcept
+    {
+        active[l] = 0;
+
+        if (elastic_tangent[l])
+        {
+            return false;
+        }
+        elastic_tangent[l] = 1;
+        return true;
+    }
+
+    /// Mark the quadrature point for the trial state and the return mapping
+    void mark_active(std::size_t const l) noexcept { active[l] = 1; }
+
+    /// Mark the tangent operator of the quadrature point as plastic
+    void mark_plastic(std::size_t const l) noexcept { elastic_tangent[l] = 0; }
+
+    /// Compact the active points into a contiguous list of indices
+    /// \return the quadrature point indices in the active set
+    [[nodiscard]] std::vector<std::size_t> const& active_points()
+    {
+        active_indices.clear();
+
+        for (std::size_t l{0}; l < active.size(); ++l)
+        {
+            if (active[l]) active_indices.emplace_back(l);
+        }
+        return active_indices;
+    }
+
+private:
+    /// Flag if the stored tangent operator is the elastic tangent operator
+    std::vector<std::uint8_t> elastic_tangent;
+    /// Flag if the quadrature point is in the active set
+    std::vector<std::uint8_t> active;
+    /// Indices of the points in the active set
+    std::vector<std::size_t> active_indices;
+};
+}
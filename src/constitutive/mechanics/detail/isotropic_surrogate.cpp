@@ -0,0 +1,182 @@
+
+#include "isotropic_surrogate.hpp"
+
+#include <Eigen/Eigenvalues>
+
+#include <tbb/parallel_for.h>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+#include <string>
+
+namespace neon::mechanics
+{
+namespace
+{
+/// Tensor indices of each Voigt index
+std::array<std::pair<int, int>, 6> constexpr voigt_indices{
+    {{0, 0}, {1, 1}, {2, 2}, {1, 2}, {0, 2}, {0, 1}}};
+
+/// Maximum number of grid intervals in each direction
+std::int64_t constexpr maximum_divisions{256};
+}
+
+isotropic_surrogate::isotropic_surrogate(response_function const& response,
+                                         double const maximum_stretch,
+                                         double const tolerance)
+    : log_stretch_limit{std::log(maximum_stretch)}
+{
+    if (maximum_stretch <= 1.0)
+    {
+        throw std::domain_error("\"maximum_stretch\" for the surrogate must be greater than one");
+    }
+    if (tolerance <= 0.0)
+    {
+        throw std::domain_error("\"tolerance\" for the surrogate must be positive");
+    }
+
+    for (;;)
+    {
+        tabulate(response);
+
+        interpolation_error = estimate_error(response);
+
+        if (interpolation_error <= tolerance) break;
+
+        if (divisions == maximum_divisions)
+        {
+            throw std::domain_error("The surrogate tolerance could not be met with "
+                                    + std::to_string(maximum_divisions)
+                                    + " intervals, reduce the \"maximum_stretch\" or increase the "
+                                      "\"tolerance\"");
+        }
+        divisions *= 2;
+    }
+}
+
+std::optional<std::pair<matrix3, matrix6>> isotropic_surrogate::evaluate(
+    matrix3 const& F_unimodular) const
+{
+    // Principal stretches in ascending order with the principal directions
+    Eigen::SelfAdjointEigenSolver<matrix3> eigen_solver;
+    eigen_solver.computeDirect(F_unimodular * F_unimodular.transpose());
+
+    vector3 const log_stretches = 0.5 * eigen_solver.eigenvalues().array().log();
+
+    auto const smallest = std::min(log_stretches(0), 0.0);
+    auto const largest = std::max(log_stretches(2), 0.0);
+
+    if (smallest < -log_stretch_limit || largest > log_stretch_limit) return std::nullopt;
+
+    principal_values const values = interpolate(smallest, largest);
+
+    matrix3 const& Q = eigen_solver.eigenvectors();
+
+    matrix6 moduli = matrix6::Zero();
+    moduli(0, 0) = values(3);
+    moduli(1, 1) = values(4);
+    moduli(2, 2) = values(5);
+    moduli(0, 1) = moduli(1, 0) = values(6);
+    moduli(0, 2) = moduli(2, 0) = values(7);
+    moduli(1, 2) = moduli(2, 1) = values(8);
+    moduli(3, 3) = values(9);
+    moduli(4, 4) = values(10);
+    moduli(5, 5) = values(11);
+
+    // Rotation of the symmetric fourth order tensor from the principal frame
+    matrix6 T;
+    for (auto I = 0; I < 6; ++I)
+    {
+        auto const [i, j] = voigt_indices[I];
+
+        for (auto A = 0; A < 6; ++A)
+        {
+            auto const [a, b] = voigt_indices[A];
+
+            T(I, A) = Q(i, a) * Q(j, b) + (a != b ? Q(i, b) * Q(j, a) : 0.0);
+        }
+    }
+
+    return std::make_pair(matrix3(Q * values.head<3>().asDiagonal() * Q.transpose()),
+                          matrix6(T * moduli * T.transpose()));
+}
+
+isotropic_surrogate::principal_values isotropic_surrogate::principal_response(
+    response_function const& response,
+    double const smallest,
+    double const largest) const
+{
+    matrix3 const F = vector3(std::exp(smallest), std::exp(-smallest - largest), std::exp(largest))
+                          .asDiagonal();
+
+    auto const [stress, moduli] = response(F);
+
+    principal_values values;
+    values << stress(0, 0), stress(1, 1), stress(2, 2), moduli(0, 0), moduli(1, 1), moduli(2, 2),
+        moduli(0, 1), moduli(0, 2), moduli(1, 2), moduli(3, 3), moduli(4, 4), moduli(5, 5);
+    return values;
+}
+
+isotropic_surrogate::principal_values isotropic_surrogate::interpolate(double const smallest,
+                                                                       double const largest) const
+{
+    auto const x = (smallest + log_stretch_limit) / spacing;
+    auto const y = largest / spacing;
+
+    auto const i = std::clamp(static_cast<std::int64_t>(x), std::int64_t{0}, divisions - 1);
+    auto const j = std::clamp(static_cast<std::int64_t>(y), std::int64_t{0}, divisions - 1);
+
+    auto const xi = x - i;
+    auto const eta = y - j;
+
+    auto const node = j * (divisions + 1) + i;
+
+    return (1.0 - xi) * (1.0 - eta) * table[node] + xi * (1.0 - eta) * table[node + 1]
+           + (1.0 - xi) * eta * table[node + divisions + 1] + xi * eta * table[node + divisions + 2];
+}
+
+void isotropic_surrogate::tabulate(response_function const& response)
+{
+    spacing = log_stretch_limit / divisions;
+
+    table.resize((divisions + 1) * (divisions + 1));
+
+    tbb::parallel_for(std::int64_t{0}, static_cast<std::int64_t>(table.size()), [&](auto const node) {
+        auto const i = node % (divisions + 1);
+        auto const j = node / (divisions + 1);
+
+        table[node] = principal_response(response, -log_stretch_limit + i * spacing, j * spacing);
+    });
+}
+
+double isotropic_surrogate::estimate_error(response_function const& response) const
+{
+    // Scale the stresses and the moduli separately for a relative error
+    auto stress_scale{0.0}, moduli_scale{0.0};
+
+    for (auto const& values : table)
+    {
+        stress_scale = std::max(stress_scale, values.head<3>().cwiseAbs().maxCoeff());
+        moduli_scale = std::max(moduli_scale, values.tail<9>().cwiseAbs().maxCoeff());
+    }
+    stress_scale = std::max(stress_scale, std::numeric_limits<double>::epsilon());
+    moduli_scale = std::max(moduli_scale, std::numeric_limits<double>::epsilon());
+
+    std::vector<double> errors(divisions * divisions);
+
+    tbb::parallel_for(std::int64_t{0}, divisions * divisions, [&](auto const cell) {
+        auto const smallest = -log_stretch_limit + (cell % divisions + 0.5) * spacing;
+        auto const largest = (cell / divisions + 0.5) * spacing;
+
+        principal_values const difference = interpolate(smallest, largest)
+                                            - principal_response(response, smallest, largest);
+
+        errors[cell] = std::max(difference.head<3>().cwiseAbs().maxCoeff() / stress_scale,
+                                difference.tail<9>().cwiseAbs().maxCoeff() / moduli_scale);
+    });
+    return *std::max_element(begin(errors), end(errors));
+}
+}
@@ -0,0 +1,86 @@
+
+#pragma once
+
+#include "numeric/dense_matrix.hpp"
+
+#include <cstdint>
+#include <functional>
+#include <optional>
+#include <utility>
+#include <vector>
+
+namespace neon::mechanics
+{
+/**
+ * isotropic_surrogate tabulates the stress and moduli response of an isotropic
+ * hyperelastic model as a function of the principal stretches of the
+ * unimodular deformation.  The response in the principal frame is stored on
+ * a grid of the smallest and largest logarithmic principal stretch and the
+ * grid is refined until the bilinear interpolation error is below the
+ * requested relative tolerance.  At runtime the principal stretches and
+ * directions are computed from \f$ \bar{\mathbf{b}} \f$, the tabulated values
+ * are interpolated and rotated back to the spatial frame.  Deformations
+ * outside of the tabulated range are not handled and the caller must fall
+ * back to the exact response.
+ *
+ * The response is assumed to be isotropic, which for the microsphere models
+ * neglects the (small) anisotropy of the unit sphere quadrature rule.
+ */
+class isotropic_surrogate
+{
+public:
+    /// Stress and moduli (Voigt notation) response for a unimodular deformation
+    using response_function = std::function<std::pair<matrix3, matrix6>(matrix3 const&)>;
+
+public:
+    /// Tabulate the response for principal stretches in the range
+    /// [1 / maximum_stretch, maximum_stretch]
+    /// \param response Exact response to tabulate
+    /// \param maximum_stretch Largest principal stretch in the table
+    /// \param tolerance Relative interpolation error tolerance
+    explicit isotropic_surrogate(response_function const& response,
+                                 double const maximum_stretch,
+                                 double const tolerance);
+
+    /// Interpolate the stress and moduli response for \p F_unimodular
+    /// \return the response or an empty value if outside the tabulated range
+    [[nodiscard]] std::optional<std::pair<matrix3, matrix6>> evaluate(
+        matrix3 const& F_unimodular) const;
+
+    /// \return number of grid intervals in each direction
+    [[nodiscard]] auto intervals() const noexcept { return divisions; }
+
+    /// \return estimated relative interpolation error of the table
+    [[nodiscard]] auto error() const noexcept { return interpolation_error; }
+
+protected:
+    /// Principal stresses and the nine independent principal moduli
+    using principal_values = Eigen::Matrix<double, 12, 1>;
+
+    /// Compute the principal response for the logarithmic stretches
+    [[nodiscard]] principal_values principal_response(response_function const& response,
+                                                      double const smallest,
+                                                      double const largest) const;
+
+    /// Bilinear interpolation of the table
+    [[nodiscard]] principal_values interpolate(double const smallest, double const largest) const;
+
+    /// Fill the table for the current number of divisions
+    void tabulate(response_function const& response);
+
+    /// \return the maximum relative error at the centre of each grid cell
+    [[nodiscard]] double estimate_error(response_function const& response) const;
+
+protected:
+    /// Largest logarithmic principal stretch
+    double log_stretch_limit;
+    /// Grid spacing in logarithmic stretch
+    double spacing;
+    /// Number of grid intervals in each direction
+    std::int64_t divisions{4};
+    /// Estimated relative interpolation error
+    double interpolation_error;
+    /// Principal response at each grid node (row major over the largest stretch)
+    std::vector<principal_values> table;
+};
+}
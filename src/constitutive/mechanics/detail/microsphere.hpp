@@ -67,4 +67,22 @@ namespace neon::mechanics
     return (std::pow(micro_stretch, 4) + 3.0 * std::pow(N, 2))
            / std::pow(N - std::pow(micro_stretch, 2), 2);
 }
+
+/// Compute the Padé approximation for a batch of microstretches
+/// \sa pade_first
+template <typename ArrayType>
+[[nodiscard]] auto pade_first(Eigen::ArrayBase<ArrayType> const& micro_stretch, double const N)
+{
+    return ((3.0 * N - micro_stretch.square()) / (N - micro_stretch.square())).eval();
+}
+
+/// Compute the Padé approximation for a batch of microstretches
+/// \sa pade_second
+template <typename ArrayType>
+[[nodiscard]] auto pade_second(Eigen::ArrayBase<ArrayType> const& micro_stretch, double const N)
+{
+    return ((micro_stretch.square().square() + 3.0 * std::pow(N, 2))
+            / (N - micro_stretch.square()).square())
+        .eval();
+}
 }
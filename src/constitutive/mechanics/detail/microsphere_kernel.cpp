@@ -0,0 +1,91 @@
+
+#include "microsphere_kernel.hpp"
+
+namespace neon::mechanics
+{
+microsphere_kernel::microsphere_kernel(unit_sphere_quadrature const& unit_sphere)
+    : directions(unit_sphere.points(), 3), weights(unit_sphere.points())
+{
+    for (auto const& [l, x, y, z] : unit_sphere.coordinates())
+    {
+        directions.row(l) << x, y, z;
+        weights(l) = unit_sphere.weights()[l];
+    }
+
+    // The moments are the integrals for an undeformed configuration
+    batch_voigt V;
+    batch_array w;
+
+    vector6 m2 = vector6::Zero();
+    M4 = matrix6::Zero();
+
+    for (Eigen::Index offset{0}; offset < points(); offset += batch_size)
+    {
+        auto const size = std::min(Eigen::Index{batch_size}, points() - offset);
+
+        voigt_products(directions.middleRows(offset, size), V);
+
+        w = weights.segment(offset, size).array();
+
+        accumulate(m2, V, w);
+        accumulate(M4, V, w);
+    }
+    M2 = from_voigt(m2);
+    M4 = symmetrise(M4);
+}
+
+microsphere_kernel::nonaffine_integrals microsphere_kernel::nonaffine(matrix3 const& F_unimodular,
+                                                                     double const p,
+                                                                     double const q) const
+{
+    matrix3 const F_inverse = F_unimodular.inverse();
+
+    batch_vectors t, n;
+    batch_voigt V_t, V_n;
+    batch_array stretch, area_stretch, c_h, c_k;
+
+    auto stretch_sum{0.0};
+
+    vector6 h = vector6::Zero(), k = vector6::Zero();
+    matrix6 H = matrix6::Zero(), K = matrix6::Zero();
+
+    for (Eigen::Index offset{0}; offset < points(); offset += batch_size)
+    {
+        auto const size = std::min(Eigen::Index{batch_size}, points() - offset);
+
+        auto const r = directions.middleRows(offset, size);
+        auto const w = weights.segment(offset, size).array();
+
+        // Deformed tangents t = F * r and normals n = F^-T * r for the batch
+        t.noalias() = r * F_unimodular.transpose();
+        n.noalias() = r * F_inverse;
+
+        stretch = t.rowwise().norm().array();
+        area_stretch = n.rowwise().norm().array();
+
+        voigt_products(t, V_t);
+        voigt_products(n, V_n);
+
+        // Weighted powers of the stretches with lower powers by division
+        batch_array const stretch_p = w * (p * stretch.log()).exp();
+
+        stretch_sum += stretch_p.sum();
+
+        c_h = stretch_p / stretch.square();
+        c_k = w * ((q - 2.0) * area_stretch.log()).exp();
+
+        accumulate(h, V_t, c_h);
+        accumulate(H, V_t, c_h / stretch.square());
+
+        accumulate(k, V_n, c_k);
+        accumulate(K, V_n, c_k / area_stretch.square());
+    }
+
+    return {std::pow(stretch_sum, 1.0 / p),
+            from_voigt(h),
+            (p - 2.0) * symmetrise(H),
+            q * from_voigt(k),
+            q * (q - 2.0) * symmetrise(K),
+            2.0 * q * o_dot_product(k)};
+}
+}
@@ -0,0 +1,249 @@
+
+#pragma once
+
+#include "numeric/dense_matrix.hpp"
+#include "quadrature/unit_sphere_quadrature.hpp"
+
+#include <algorithm>
+#include <utility>
+
+namespace neon::mechanics
+{
+/**
+ * microsphere_kernel evaluates the homogenised stress and moduli for the
+ * microsphere family of constitutive models.  The unit sphere directions are
+ * stored once per quadrature rule in a structure of arrays layout and the
+ * deformed tangents are computed for a batch of sphere directions at a time.
+ * The integrands are therefore evaluated on contiguous arrays which the compiler
+ * can vectorise, instead of a 3x3 and 6x6 matrix product per direction.
+ *
+ * The fourth order tensor \f$ \mathbf{t} \otimes \mathbf{t} \otimes \mathbf{t}
+ * \otimes \mathbf{t} \f$ has only 21 independent components in Voigt notation
+ * and only these are accumulated before the symmetric part is mirrored.
+ */
+class microsphere_kernel
+{
+public:
+    /// Number of sphere directions processed together
+    static auto constexpr batch_size = 16;
+
+    /// Scalar values over a batch of sphere directions
+    using batch_array = Eigen::Array<double, Eigen::Dynamic, 1, Eigen::ColMajor, batch_size, 1>;
+
+    /// Vectors over a batch of sphere directions (each column is contiguous)
+    using batch_vectors = Eigen::Matrix<double, Eigen::Dynamic, 3, Eigen::ColMajor, batch_size, 3>;
+
+    /// Second order tensors t x t in kinetic Voigt notation over a batch
+    using batch_voigt = Eigen::Matrix<double, Eigen::Dynamic, 6, Eigen::ColMajor, batch_size, 6>;
+
+    /// Unit sphere integrals of the non-affine microsphere model \cite Miehe2004
+    struct nonaffine_integrals
+    {
+        /// Non-affine stretch \f$ \lambda = \left[ \sum_i w_i \bar{\lambda}_i^p \right]^{1/p} \f$
+        double stretch;
+        /// \f$ \mathbf{h} = \sum_i w_i \bar{\lambda}_i^{p-2} \mathbf{t}_i \otimes \mathbf{t}_i \f$
+        matrix3 h;
+        /// \f$ \mathbf{H} = (p-2) \sum_i w_i \bar{\lambda}_i^{p-4} \mathbf{t}_i \otimes
+        /// \mathbf{t}_i \otimes \mathbf{t}_i \otimes \mathbf{t}_i \f$
+        matrix6 H;
+        /// \f$ \mathbf{k} = q \sum_i w_i \bar{\nu}_i^{q-2} \mathbf{n}_i \otimes \mathbf{n}_i \f$
+        matrix3 k;
+        /// \f$ \mathbf{K} = q(q-2) \sum_i w_i \bar{\nu}_i^{q-4} \mathbf{n}_i \otimes
+        /// \mathbf{n}_i \otimes \mathbf{n}_i \otimes \mathbf{n}_i \f$
+        matrix6 K;
+        /// \f$ \mathbf{G} = 2q \sum_i w_i \bar{\nu}_i^{q-2} sym[\mathbf{g}^{-1} \odot
+        /// \mathbf{n}_i \otimes \mathbf{n}_i + \mathbf{n}_i \otimes \mathbf{n}_i \odot
+        /// \mathbf{g}^{-1}] \f$
+        matrix6 G;
+    };
+
+public:
+    /// Precompute the direction and moment data for the unit sphere rule
+    explicit microsphere_kernel(unit_sphere_quadrature const& unit_sphere);
+
+    /// \return number of sphere directions
+    [[nodiscard]] auto points() const noexcept { return directions.rows(); }
+
+    /// \return the second moment \f$ \sum_i w_i \mathbf{r}_i \otimes \mathbf{r}_i \f$
+    [[nodiscard]] matrix3 const& second_moment() const noexcept { return M2; }
+
+    /// \return the fourth moment \f$ \sum_i w_i \mathbf{r}_i \otimes \mathbf{r}_i
+    /// \otimes \mathbf{r}_i \otimes \mathbf{r}_i \f$ in Voigt notation
+    [[nodiscard]] matrix6 const& fourth_moment() const noexcept { return M4; }
+
+    /**
+     * Evaluate \f$ \sum_i w_i f(\lambda_i) \mathbf{t}_i \otimes \mathbf{t}_i \f$
+     * where \f$ \mathbf{t}_i = \bar{\mathbf{F}} \mathbf{r}_i \f$.
+     * \param F_unimodular Unimodular deformation gradient
+     * \param f Callable accepting the batch of microstretches and the index
+     *          of the first direction in the batch returning a batch_array
+     */
+    template <typename StressFunction>
+    [[nodiscard]] matrix3 stress(matrix3 const& F_unimodular, StressFunction&& f) const
+    {
+        vector6 s = vector6::Zero();
+
+        for_each_batch(F_unimodular,
+                       [&](auto const& V, auto const& w, auto const& stretch, auto const offset) {
+                           accumulate(s, V, w * f(stretch, offset));
+                       });
+        return from_voigt(s);
+    }
+
+    /**
+     * Evaluate \f$ \sum_i w_i f(\lambda_i) \mathbf{t}_i \otimes \mathbf{t}_i \otimes
+     * \mathbf{t}_i \otimes \mathbf{t}_i \f$ in Voigt notation
+     * \sa stress
+     */
+    template <typename ModuliFunction>
+    [[nodiscard]] matrix6 moduli(matrix3 const& F_unimodular, ModuliFunction&& f) const
+    {
+        matrix6 C = matrix6::Zero();
+
+        for_each_batch(F_unimodular,
+                       [&](auto const& V, auto const& w, auto const& stretch, auto const offset) {
+                           accumulate(C, V, w * f(stretch, offset));
+                       });
+        return symmetrise(C);
+    }
+
+    /// Evaluate the stress and the moduli in a single pass over the sphere
+    /// directions, sharing the deformed tangents and the microstretches
+    /// \sa stress
+    /// \sa moduli
+    template <typename StressFunction, typename ModuliFunction>
+    [[nodiscard]] std::pair<matrix3, matrix6> stress_and_moduli(matrix3 const& F_unimodular,
+                                                                StressFunction&& f,
+                                                                ModuliFunction&& g) const
+    {
+        vector6 s = vector6::Zero();
+        matrix6 C = matrix6::Zero();
+
+        for_each_batch(F_unimodular,
+                       [&](auto const& V, auto const& w, auto const& stretch, auto const offset) {
+                           accumulate(s, V, w * f(stretch, offset));
+                           accumulate(C, V, w * g(stretch, offset));
+                       });
+        return {from_voigt(s), symmetrise(C)};
+    }
+
+    /**
+     * Evaluate the six unit sphere integrals of the non-affine microsphere
+     * model in a single pass over the sphere directions.  The deformed tangents
+     * \f$ \mathbf{t}_i = \bar{\mathbf{F}} \mathbf{r}_i \f$ and the deformed
+     * normals \f$ \mathbf{n}_i = \bar{\mathbf{F}}^{-T} \mathbf{r}_i \f$ are
+     * computed once per direction and only one power is evaluated for each of
+     * the microstretch and the area stretch.  The \f$ \mathbf{G} \f$ tensor is
+     * linear in \f$ \mathbf{n} \otimes \mathbf{n} \f$ and is formed from the
+     * accumulated \f$ \mathbf{k} \f$ integrand.
+     * \param F_unimodular Unimodular deformation gradient
+     * \param p Non-affine stretch parameter
+     * \param q Non-affine tube parameter
+     */
+    [[nodiscard]] nonaffine_integrals nonaffine(matrix3 const& F_unimodular,
+                                                double const p,
+                                                double const q) const;
+
+    /**
+     * Apply \p function to each batch of sphere directions with the deformed
+     * tangent outer products \f$ \mathbf{t} \otimes \mathbf{t} \f$ in Voigt
+     * notation, the quadrature weights, the microstretches and the index of
+     * the first direction in the batch.
+     */
+    template <typename Callable>
+    void for_each_batch(matrix3 const& F_unimodular, Callable&& function) const
+    {
+        batch_vectors t;
+        batch_voigt V;
+        batch_array stretch;
+
+        for (Eigen::Index offset{0}; offset < points(); offset += batch_size)
+        {
+            auto const size = std::min(Eigen::Index{batch_size}, points() - offset);
+
+            // Deformed tangents t = F * r for the batch as t^T = r^T F^T
+            t.noalias() = directions.middleRows(offset, size) * F_unimodular.transpose();
+
+            stretch = t.rowwise().norm().array();
+
+            voigt_products(t, V);
+
+            function(V, weights.segment(offset, size).array(), stretch, offset);
+        }
+    }
+
+    /// Fill the kinetic Voigt representation of t x t for a batch of vectors
+    static void voigt_products(batch_vectors const& t, batch_voigt& V)
+    {
+        V.resize(t.rows(), 6);
+        V.col(0) = t.col(0).cwiseProduct(t.col(0));
+        V.col(1) = t.col(1).cwiseProduct(t.col(1));
+        V.col(2) = t.col(2).cwiseProduct(t.col(2));
+        V.col(3) = t.col(1).cwiseProduct(t.col(2));
+        V.col(4) = t.col(0).cwiseProduct(t.col(2));
+        V.col(5) = t.col(0).cwiseProduct(t.col(1));
+    }
+
+    /// Accumulate the weighted batch into a second order tensor in Voigt notation
+    static void accumulate(vector6& s, batch_voigt const& V, batch_array const& c)
+    {
+        s.noalias() += V.transpose() * c.matrix();
+    }
+
+    /// Accumulate the lower triangle (21 components) of the weighted batch of
+    /// fourth order tensors in Voigt notation
+    static void accumulate(matrix6& C, batch_voigt const& V, batch_array const& c)
+    {
+        for (auto j = 0; j < 6; ++j)
+        {
+            batch_array const cV = c * V.col(j).array();
+
+            for (auto i = j; i < 6; ++i)
+            {
+                C(i, j) += (cV * V.col(i).array()).sum();
+            }
+        }
+    }
+
+    /// \return the full matrix from the accumulated lower triangle
+    [[nodiscard]] static matrix6 symmetrise(matrix6 const& C)
+    {
+        return C.selfadjointView<Eigen::Lower>();
+    }
+
+    /// \return the o dot product \f$ sym[\mathbf{g}^{-1} \odot \mathbf{n} \otimes
+    /// \mathbf{n} + \mathbf{n} \otimes \mathbf{n} \odot \mathbf{g}^{-1}] \f$ from
+    /// \f$ \mathbf{n} \otimes \mathbf{n} \f$ in kinetic Voigt notation
+    [[nodiscard]] static matrix6 o_dot_product(vector6 const& s)
+    {
+        // clang-format off
+        return (matrix6() << 2.0 * s(0),        0.0,        0.0,               0.0,               s(4),              s(5),
+                                    0.0, 2.0 * s(1),        0.0,              s(3),                0.0,              s(5),
+                                    0.0,        0.0, 2.0 * s(2),              s(3),               s(4),               0.0,
+                                    0.0,       s(3),       s(3), 0.5 * (s(1) + s(2)),       0.5 * s(5),        0.5 * s(4),
+                                   s(4),        0.0,       s(4),        0.5 * s(5), 0.5 * (s(0) + s(2)),       0.5 * s(3),
+                                   s(5),       s(5),        0.0,        0.5 * s(4),        0.5 * s(3), 0.5 * (s(0) + s(1))).finished();
+        // clang-format on
+    }
+
+    /// \return the symmetric second order tensor from kinetic Voigt notation
+    [[nodiscard]] static matrix3 from_voigt(vector6 const& s)
+    {
+        // clang-format off
+        return (matrix3() << s(0), s(5), s(4),
+                             s(5), s(1), s(3),
+                             s(4), s(3), s(2)).finished();
+        // clang-format on
+    }
+
+private:
+    /// Unit sphere directions with the x, y and z components stored contiguously
+    matrixxd<3> directions;
+    /// Quadrature weights for each direction
+    vector weights;
+    /// Second moment of the directions
+    matrix3 M2;
+    /// Fourth moment of the directions in Voigt notation
+    matrix6 M4;
+};
+}
@@ -8,8 +8,7 @@
 #include "numeric/log_tensor_derivative.hpp"
 #include "numeric/mechanics"
 
-#include <range/v3/view/transform.hpp>
-#include <range/v3/view/zip.hpp>
+#include <tbb/parallel_for.h>
 
 #include <unsupported/Eigen/MatrixFunctions>
 
@@ -23,33 +22,32 @@ finite_strain_J2_plasticity::finite_strain_J2_plasticity(std::shared_ptr<interna
 {
     variables->add(variable::scalar::von_mises_stress,
                    variable::scalar::effective_plastic_strain,
-                   variable::second::hencky_strain_elastic);
+                   variable::symmetric::hencky_strain_elastic);
 
     names.emplace("hencky_strain_elastic");
 
-    // Add material tangent with the linear elasticity moduli
+    // The finite strain tangent does not have major symmetry and replaces the
+    // packed tangent of the small strain model with the linear elasticity moduli
+    variables->remove(variable::major_symmetric::tangent_operator);
     variables->add(variable::fourth::tangent_operator,
-                   consistent_tangent(1.0, matrix2::Zero(), matrix2::Zero(), C_e));
+                   consistent_tangent(1.0, matrix2::Identity(), matrix2::Zero(), C_e));
 }
 
 finite_strain_J2_plasticity::~finite_strain_J2_plasticity() = default;
 
 void finite_strain_J2_plasticity::update_internal_variables(double const time_step_size)
 {
-    using namespace ranges;
-
     auto const shear_modulus = material.shear_modulus();
 
     // Extract the internal variables
-    auto [deformation_gradients,
-          log_strain_e_list,
-          cauchy_stresses] = variables->get(variable::second::deformation_gradient,
-                                            variable::second::hencky_strain_elastic,
-                                            variable::second::cauchy_stress);
+    auto& deformation_gradients = variables->get(variable::second::deformation_gradient);
+    auto& cauchy_stresses = variables->get(variable::symmetric::cauchy_stress);
+
+    auto& log_strain_e_list = variables->get(variable::symmetric::hencky_strain_elastic);
 
-    auto const old_deformation_gradients = variables->get_old(variable::second::deformation_gradient);
+    auto const& old_deformation_gradients = variables->get_old(variable::second::deformation_gradient);
 
-    auto const J_list = variables->get(variable::scalar::DetF);
+    auto const& J_list = variables->get(variable::scalar::DetF);
 
     // Retrieve the accumulated internal variables
     auto [accumulated_plastic_strains,
@@ -58,64 +56,72 @@ void finite_strain_J2_plasticity::update_internal_variables(double const time_st
 
     auto& tangent_operators = variables->get(variable::fourth::tangent_operator);
 
-    auto const incremental_deformation_gradients = view::zip(deformation_gradients,
-                                                             old_deformation_gradients)
-                                                   | view::transform([](auto const& tpl) {
-                                                         auto const& [F, F_old] = tpl;
-                                                         return F * F_old.inverse();
-                                                     });
-
-    // Perform the update algorithm for each quadrature point
-    for (std::size_t l{0}; l < deformation_gradients.size(); l++)
-    {
-        auto const& F_inc = incremental_deformation_gradients[l];
+    points.resize(deformation_gradients.size());
+
+    // Perform the elastic predictor for each quadrature point.  The elastic
+    // logarithmic strain is required for the update of every point and is
+    // the trial state, so the points are classified from the trial state
+    tbb::parallel_for(std::size_t{0}, deformation_gradients.size(), [&](auto const l) {
+        // Incremental deformation gradient from the last converged state
+        matrix2 const F_inc = deformation_gradients[l] * old_deformation_gradients[l].inverse();
+
         auto const J = J_list[l];
 
-        auto& cauchy_stress = cauchy_stresses[l];
-        auto& accumulated_plastic_strain = accumulated_plastic_strains[l];
         auto& von_mises = von_mises_stresses[l];
-        auto& log_strain_e = log_strain_e_list[l];
-
-        // std::cout << "log strain elastic\n" << log_strain_e << std::endl;
 
         // Elastic trial deformation gradient
-        matrix2 const B_e = (2.0 * log_strain_e).exp();
-
-        // std::cout << "B elastic\n" << B_e << std::endl;
-
-        // std::cout << "Finc\n" << F_inc << std::endl;
+        matrix2 const B_e = (2.0 * voigt::kinetic::view(log_strain_e_list[l])).exp();
 
         // Elastic trial left Cauchy-Green deformation tensor
         matrix2 const B_e_trial = F_inc * B_e * F_inc.transpose();
 
-        // std::cout << "B elastic trial\n" << B_e_trial << std::endl;
-
         // Trial Logarithmic elastic strain
-        log_strain_e = 0.5 * B_e_trial.log();
+        matrix2 const log_strain_e = 0.5 * B_e_trial.log();
 
-        // std::cout << "log strain elastic\n" << log_strain_e << std::endl;
+        log_strain_e_list[l] = voigt::kinetic::to(log_strain_e);
 
         // Elastic stress predictor
-        cauchy_stress = compute_cauchy_stress(material.shear_modulus(), material.lambda(), log_strain_e)
-                        / J;
+        matrix2 const cauchy_stress = compute_cauchy_stress(material.shear_modulus(),
+                                                            material.lambda(),
+                                                            log_strain_e)
+                                      / J;
+
+        cauchy_stresses[l] = voigt::kinetic::to(cauchy_stress);
 
         // Trial von Mises stress
         von_mises = von_mises_stress(cauchy_stress);
 
-        // std::cout << "von Mises " << von_mises << std::endl;
-
         // Compute the initial estimate of the yield function for the material
         // and decide if the stress return needs to be computed
-        if (auto const f = evaluate_J2_yield_function(material, von_mises, accumulated_plastic_strain);
-            f <= 0.0)
+        if (evaluate_J2_yield_function(material, von_mises, accumulated_plastic_strains[l]) <= 0.0)
         {
-            tangent_operators[l] = consistent_tangent(J, log_strain_e, cauchy_stress, C_e);
-            continue;
+            points.mark_elastic(l);
+            tangent_operators[l] = consistent_tangent(J, B_e_trial, cauchy_stress, C_e);
+            return;
         }
+        points.mark_active(l);
+    });
 
-        auto const von_mises_trial = von_mises;
+    auto const& plastic_points = points.active_points();
 
-        std::cout << "\nQuadrature point plastic\n";
+    // Perform the return mapping over the compacted plastic points
+    tbb::parallel_for(std::size_t{0}, plastic_points.size(), [&](auto const i) {
+        auto const l = plastic_points[i];
+        auto const J = J_list[l];
+
+        points.mark_plastic(l);
+
+        matrix2 cauchy_stress = voigt::kinetic::view(cauchy_stresses[l]);
+
+        auto& accumulated_plastic_strain = accumulated_plastic_strains[l];
+        auto& von_mises = von_mises_stresses[l];
+
+        matrix2 log_strain_e = voigt::kinetic::view(log_strain_e_list[l]);
+
+        // Elastic trial left Cauchy-Green deformation tensor from the trial strain
+        matrix2 const B_e_trial = (2.0 * log_strain_e).exp();
+
+        auto const von_mises_trial = von_mises;
 
         // Compute the normal direction to the yield surface which remains
         // constant throughout the radial return method
@@ -125,14 +131,14 @@ void finite_strain_J2_plasticity::update_internal_variables(double const time_st
         auto const plastic_increment = perform_radial_return(von_mises, accumulated_plastic_strain);
 
         // Plastic strain update
-        // F_p = (plastic_increment * std::sqrt(3.0 / 2.0) * normal);
-
-        // std::cout << ">>>Elastic strain before dec\n" << log_strain_e << std::endl;
         log_strain_e -= plastic_increment * std::sqrt(3.0 / 2.0) * normal;
-        // std::cout << ">>>Elastic strain after dec\n" << log_strain_e << std::endl;
+
+        log_strain_e_list[l] = voigt::kinetic::to(log_strain_e);
 
         cauchy_stress -= 2.0 * shear_modulus * plastic_increment * std::sqrt(3.0 / 2.0) * normal / J;
 
+        cauchy_stresses[l] = voigt::kinetic::to(cauchy_stress);
+
         von_mises = von_mises_stress(cauchy_stress);
 
         accumulated_plastic_strain += plastic_increment;
@@ -147,8 +153,8 @@ void finite_strain_J2_plasticity::update_internal_variables(double const time_st
                                                  C_e);
 
         // Compute the elastic-plastic tangent modulus for large strain
-        tangent_operators[l] = consistent_tangent(J, log_strain_e, cauchy_stress, D_ep);
-    }
+        tangent_operators[l] = consistent_tangent(J, B_e_trial, cauchy_stress, D_ep);
+    });
 }
 
 matrix3 finite_strain_J2_plasticity::consistent_tangent(double const J,
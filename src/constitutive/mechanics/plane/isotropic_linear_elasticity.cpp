@@ -7,7 +7,6 @@
 #include "numeric/mechanics"
 
 #include <range/v3/view/transform.hpp>
-#include <range/v3/view/zip.hpp>
 
 #include <iostream>
 
@@ -18,13 +17,14 @@ isotropic_linear_elasticity::isotropic_linear_elasticity(std::shared_ptr<interna
                                                          plane const state)
     : constitutive_model(variables), material(material_data), state(state)
 {
-    variables->add(variable::second::linearised_strain, variable::scalar::von_mises_stress);
+    variables->add(variable::symmetric::linearised_strain, variable::scalar::von_mises_stress);
 
     names.emplace("linearised_strain");
     names.emplace("von_mises_stress");
 
     // Add material tangent with the linear elasticity spatial moduli
-    variables->add(variable::fourth::tangent_operator, elastic_moduli());
+    variables->add(variable::major_symmetric::tangent_operator,
+                   voigt::major_symmetric::to(elastic_moduli()));
 }
 
 isotropic_linear_elasticity::~isotropic_linear_elasticity() = default;
@@ -36,18 +36,18 @@ void isotropic_linear_elasticity::update_internal_variables(double const time_st
     // std::cout << "Performing the internal variable updates" << std::endl;
 
     // Extract the internal variables
-    auto [elastic_strains, cauchy_stresses] = variables->get(variable::second::linearised_strain,
-                                                             variable::second::cauchy_stress);
+    auto [elastic_strains, cauchy_stresses] = variables->get(variable::symmetric::linearised_strain,
+                                                             variable::symmetric::cauchy_stress);
 
     auto& von_mises_stresses = variables->get(variable::scalar::von_mises_stress);
 
-    auto const& tangents = variables->get(variable::fourth::tangent_operator);
-
     // std::cout << "Computing elastic strains" << std::endl;
 
     // Compute the linear strain gradient from the displacement gradient
     elastic_strains = variables->get(variable::second::displacement_gradient)
-                      | view::transform([](auto const& H) { return 0.5 * (H + H.transpose()); });
+                      | view::transform([](auto const& H) {
+                            return voigt::kinetic::to(0.5 * (H + H.transpose()));
+                        });
 
     for (auto const& elastic_strain : elastic_strains)
     {
@@ -55,9 +55,10 @@ void isotropic_linear_elasticity::update_internal_variables(double const time_st
     }
 
     // Compute Cauchy stress from the linear elastic strains
-    cauchy_stresses = view::zip(tangents, elastic_strains) | view::transform([](auto const& tpl) {
-                          auto const& [C, elastic_strain] = tpl;
-                          return voigt::kinetic::from(C * voigt::kinematic::to(elastic_strain));
+    cauchy_stresses = elastic_strains | view::transform([this](auto const& elastic_strain) {
+                          return (C_e
+                                  * voigt::kinematic::to(voigt::kinetic::view(elastic_strain)))
+                              .eval();
                       });
 
     for (auto const& cauchy_stress : cauchy_stresses)
@@ -71,6 +72,18 @@ void isotropic_linear_elasticity::update_internal_variables(double const time_st
                          });
 }
 
+void isotropic_linear_elasticity::update_derived_variables()
+{
+    using namespace ranges;
+
+    auto& von_mises_stresses = variables->get(variable::scalar::von_mises_stress);
+
+    von_mises_stresses = variables->get(variable::symmetric::cauchy_stress)
+                         | view::transform([](auto const& cauchy_stress) {
+                               return von_mises_stress(cauchy_stress);
+                           });
+}
+
 matrix3 isotropic_linear_elasticity::elastic_moduli() const
 {
     auto [lambda, shear_modulus] = material.Lame_parameters();
@@ -25,6 +25,9 @@ public:
     /// @param time_step_size Time step size (or load increment if quasi-static)
     virtual void update_internal_variables(double const time_step_size);
 
+    /// Recompute the von Mises stress from the stored Cauchy stress
+    virtual void update_derived_variables() override;
+
     /** @return A base class reference to the common material properties */
     [[nodiscard]] virtual material_property const& intrinsic_material() const { return material; }
 
@@ -32,6 +35,15 @@ public:
 
     [[nodiscard]] virtual bool is_symmetric() const { return true; };
 
+    [[nodiscard]] virtual bool is_tangent_constant() const override { return true; }
+
+    [[nodiscard]] virtual bool has_pointwise_tangent() const override { return true; }
+
+    [[nodiscard]] virtual tangent_operator_t tangent_operator(std::size_t const) const override
+    {
+        return C_e;
+    }
+
 protected:
     [[nodiscard]] matrix3 elastic_moduli() const;
 
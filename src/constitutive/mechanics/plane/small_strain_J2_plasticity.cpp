@@ -7,8 +7,6 @@
 #include "constitutive/mechanics/detail/J2_plasticity.hpp"
 #include "numeric/mechanics"
 
-#include <range/v3/view/transform.hpp>
-
 #include <tbb/parallel_for.h>
 
 #include <iostream>
@@ -20,7 +18,7 @@ small_strain_J2_plasticity::small_strain_J2_plasticity(std::shared_ptr<internal_
     : isotropic_linear_elasticity(variables, material_data, isotropic_linear_elasticity::plane::strain),
       material(material_data)
 {
-    variables->add(variable::second::linearised_plastic_strain);
+    variables->add(variable::symmetric::linearised_plastic_strain);
     variables->add(variable::scalar::effective_plastic_strain);
 
     names.emplace("linearised_plastic_strain");
@@ -36,67 +34,115 @@ void small_strain_J2_plasticity::update_internal_variables(double const time_ste
     auto const shear_modulus = material.shear_modulus();
 
     // Extract the internal variables
-    auto& plastic_strains = variables->get(variable::second::linearised_plastic_strain);
-    auto& strains = variables->get(variable::second::linearised_strain);
+    auto& plastic_strains = variables->get(variable::symmetric::linearised_plastic_strain);
+    auto& strains = variables->get(variable::symmetric::linearised_strain);
     auto& accumulated_plastic_strains = variables->get(variable::scalar::effective_plastic_strain);
 
-    auto& cauchy_stresses = variables->get(variable::second::cauchy_stress);
+    auto& cauchy_stresses = variables->get(variable::symmetric::cauchy_stress);
     auto& von_mises_stresses = variables->get(variable::scalar::von_mises_stress);
 
-    auto& tangent_operators = variables->get(variable::fourth::tangent_operator);
+    auto& tangent_operators = variables->get(variable::major_symmetric::tangent_operator);
+
+    auto const packed_C_e = voigt::major_symmetric::to(C_e);
+
+    auto const& displacement_gradients = variables->get(variable::second::displacement_gradient);
 
-    // Compute the linear strain gradient from the displacement gradient
-    strains = variables->get(variable::second::displacement_gradient)
-              | ranges::view::transform([](auto const& H) { return 0.5 * (H + H.transpose()); });
+    points.resize(strains.size());
 
-    // Perform the update algorithm for each quadrature point
+    // Screen the quadrature points with an upper bound of the trial von Mises
+    // stress.  The stored stress is the elastic stress of the stored strain,
+    // so the trial stress only differs by the elastic stress increment
     tbb::parallel_for(std::size_t{0}, strains.size(), [&](auto const l) {
-        auto const& strain = strains[l];
+        auto const& H = displacement_gradients[l];
+
+        auto& strain = strains[l];
+        auto& cauchy_stress = cauchy_stresses[l];
+        auto& von_mises = von_mises_stresses[l];
+
+        // Increment of the linear strain since the last update
+        vector3 const strain_increment = voigt::kinetic::to(0.5 * (H + H.transpose())) - strain;
+
+        strain += strain_increment;
+
+        vector3 const stress_increment = compute_cauchy_stress(material.shear_modulus(),
+                                                               material.lambda(),
+                                                               strain_increment);
+
+        // The von Mises stress is a seminorm of the stress
+        if (evaluate_J2_yield_function(material,
+                                       von_mises + von_mises_stress(stress_increment),
+                                       accumulated_plastic_strains[l])
+            > 0.0)
+        {
+            points.mark_active(l);
+            return;
+        }
+
+        // Elastic update for points which remain inside the yield surface
+        if (!strain_increment.isZero(0.0))
+        {
+            cauchy_stress += stress_increment;
+            von_mises = von_mises_stress(cauchy_stress);
+        }
+        if (points.mark_elastic(l)) tangent_operators[l] = packed_C_e;
+    });
+
+    auto const& active_points = points.active_points();
+
+    // Compute the trial state and the return mapping over the compacted active points
+    tbb::parallel_for(std::size_t{0}, active_points.size(), [&](auto const i) {
+        auto const l = active_points[i];
+
         auto& plastic_strain = plastic_strains[l];
         auto& cauchy_stress = cauchy_stresses[l];
         auto& accumulated_plastic_strain = accumulated_plastic_strains[l];
         auto& von_mises = von_mises_stresses[l];
 
+        vector3 const elastic_strain = strains[l] - plastic_strain;
+
         // Elastic stress predictor
         cauchy_stress = compute_cauchy_stress(material.shear_modulus(),
                                               material.lambda(),
-                                              strain - plastic_strain);
+                                              elastic_strain);
 
         // Trial von Mises stress
         von_mises = von_mises_stress(cauchy_stress);
 
-        // If this quadrature point is elastic, then set the tangent to the
-        // elastic modulus and continue to the next quadrature point
+        // The bound was not sharp and the point is elastic
         if (evaluate_J2_yield_function(material, von_mises, accumulated_plastic_strain) <= 0.0)
         {
-            tangent_operators[l] = C_e;
+            if (points.mark_elastic(l)) tangent_operators[l] = packed_C_e;
             return;
         }
+        points.mark_plastic(l);
 
         auto const von_mises_trial = von_mises;
 
         // Compute the normal direction to the yield surface which remains
         // constant throughout the radial return method
-        matrix2 const normal = deviatoric(cauchy_stress) / deviatoric(cauchy_stress).norm();
+        matrix2 const deviatoric_stress = deviatoric(voigt::kinetic::view(cauchy_stress));
+
+        matrix2 const normal = deviatoric_stress / deviatoric_stress.norm();
 
         auto const plastic_increment = perform_radial_return(von_mises, accumulated_plastic_strain);
 
-        plastic_strain += plastic_increment * std::sqrt(3.0 / 2.0) * normal;
+        plastic_strain += voigt::kinetic::to(plastic_increment * std::sqrt(3.0 / 2.0) * normal);
 
-        cauchy_stress -= 2.0 * shear_modulus * plastic_increment * std::sqrt(3.0 / 2.0) * normal;
+        cauchy_stress -= voigt::kinetic::to(2.0 * shear_modulus * plastic_increment
+                                            * std::sqrt(3.0 / 2.0) * normal);
 
         von_mises = von_mises_stress(cauchy_stress);
 
         accumulated_plastic_strain += plastic_increment;
 
-        tangent_operators[l] = algorithmic_tangent(material.shear_modulus(),
-                                                   material.hardening_modulus(
-                                                       accumulated_plastic_strain),
-                                                   plastic_increment,
-                                                   von_mises_trial,
-                                                   normal,
-                                                   I_dev,
-                                                   C_e);
+        tangent_operators[l] = voigt::major_symmetric::to(
+            algorithmic_tangent(material.shear_modulus(),
+                                material.hardening_modulus(accumulated_plastic_strain),
+                                plastic_increment,
+                                von_mises_trial,
+                                normal,
+                                I_dev,
+                                C_e));
     });
 }
 
@@ -4,9 +4,13 @@
 #include "constitutive/internal_variables.hpp"
 #include "constitutive/mechanics/volumetric_free_energy.hpp"
 #include "constitutive/mechanics/detail/microsphere.hpp"
+#include "io/json.hpp"
 
 #include <tbb/parallel_for.h>
 
+#include <iostream>
+#include <stdexcept>
+
 namespace neon::mechanics::solid
 {
 affine_microsphere::affine_microsphere(std::shared_ptr<internal_variables_t>& variables,
@@ -14,7 +18,7 @@ affine_microsphere::affine_microsphere(std::shared_ptr<internal_variables_t>& va
                                        unit_sphere_quadrature::point const p)
     : constitutive_model(variables), unit_sphere(p), material(material_data)
 {
-    variables->add(variable::fourth::tangent_operator);
+    variables->add(variable::major_symmetric::tangent_operator);
 
     // Commit these to history in case of failure on first time step
     variables->commit();
@@ -22,15 +26,13 @@ affine_microsphere::affine_microsphere(std::shared_ptr<internal_variables_t>& va
 
 void affine_microsphere::update_internal_variables(double const time_step_size)
 {
-    auto& tangent_operators = variables->get(variable::fourth::tangent_operator);
-    auto& cauchy_stresses = variables->get(variable::second::cauchy_stress);
+    auto& tangent_operators = variables->get(variable::major_symmetric::tangent_operator);
+    auto& cauchy_stresses = variables->get(variable::symmetric::cauchy_stress);
 
     auto const& deformation_gradients = variables->get(variable::second::deformation_gradient);
     auto const& det_deformation_gradients = variables->get(variable::scalar::DetF);
 
     auto const K{material.bulk_modulus()};
-    auto const G{material.shear_modulus()};
-    auto const N{material.segments_per_chain()};
 
     tbb::parallel_for(std::size_t{0}, deformation_gradients.size(), [&](auto const l) {
         auto const J = det_deformation_gradients[l];
@@ -39,17 +41,58 @@ void affine_microsphere::update_internal_variables(double const time_step_size)
 
         auto const pressure = J * volumetric_free_energy_dJ(J, K);
 
-        matrix3 const macro_stress = compute_macro_stress(F_bar, G, N);
+        auto const [macro_stress, macro_moduli] = evaluate_macro_response(F_bar);
 
-        cauchy_stresses[l] = compute_kirchhoff_stress(pressure, macro_stress) / J;
+        cauchy_stresses[l] = voigt::kinetic::to(compute_kirchhoff_stress(pressure, macro_stress)
+                                                / J);
 
-        tangent_operators[l] = compute_material_tangent(J,
-                                                        K,
-                                                        compute_macro_moduli(F_bar, G, N),
-                                                        macro_stress);
+        tangent_operators[l] = voigt::major_symmetric::to(
+            compute_material_tangent(J, K, macro_moduli, macro_stress));
     });
 }
 
+void affine_microsphere::tabulate(json const& surrogate_data)
+{
+    if (surrogate_data.find("maximum_stretch") == surrogate_data.end())
+    {
+        throw std::domain_error("\"maximum_stretch\" not specified in \"surrogate\"");
+    }
+    if (surrogate_data.find("tolerance") == surrogate_data.end())
+    {
+        throw std::domain_error("\"tolerance\" not specified in \"surrogate\"");
+    }
+
+    surrogate = std::make_unique<isotropic_surrogate>(
+        [this](matrix3 const& F_unimodular) { return compute_macro_response(F_unimodular); },
+        surrogate_data["maximum_stretch"].get<double>(),
+        surrogate_data["tolerance"].get<double>());
+
+    std::cout << std::string(4, ' ') << "Microsphere response tabulated with "
+              << surrogate->intervals() << " intervals and an estimated relative error of "
+              << surrogate->error() << "\n";
+}
+
+std::pair<matrix3, matrix6> affine_microsphere::compute_macro_response(
+    matrix3 const& F_unimodular) const
+{
+    return compute_macro_stress_moduli(F_unimodular,
+                                       material.shear_modulus(),
+                                       material.segments_per_chain());
+}
+
+std::pair<matrix3, matrix6> affine_microsphere::evaluate_macro_response(
+    matrix3 const& F_unimodular) const
+{
+    if (surrogate)
+    {
+        if (auto const response = surrogate->evaluate(F_unimodular); response)
+        {
+            return *response;
+        }
+    }
+    return compute_macro_response(F_unimodular);
+}
+
 matrix3 affine_microsphere::compute_kirchhoff_stress(double const pressure,
                                                      matrix3 const& macro_stress) const
 {
@@ -74,40 +117,23 @@ matrix6 affine_microsphere::compute_material_tangent(double const J,
     return (kappa + pressure) * IoI - 2.0 * pressure * I + P * D * P;
 }
 
-matrix3 affine_microsphere::compute_macro_stress(matrix3 const& F_unimodular,
-                                                 double const shear_modulus,
-                                                 double const N) const
+std::pair<matrix3, matrix6> affine_microsphere::compute_macro_stress_moduli(
+    matrix3 const& F_unimodular,
+    double const shear_modulus,
+    double const N) const
 {
-    return shear_modulus
-           * unit_sphere.integrate(matrix3::Zero().eval(),
-                                   [&](auto const& coordinates, auto const) -> matrix3 {
-                                       auto const& [r, _] = coordinates;
-
-                                       vector3 const t = deformed_tangent(F_unimodular, r);
-
-                                       return pade_first(compute_microstretch(t), N)
-                                              * outer_product(t, t);
-                                   });
-}
-
-matrix6 affine_microsphere::compute_macro_moduli(matrix3 const& F_unimodular,
-                                                 double const shear_modulus,
-                                                 double const N) const
-{
-    return shear_modulus
-           * unit_sphere.integrate(matrix6::Zero().eval(),
-                                   [&](auto const& coordinates, auto const) -> matrix6 {
-                                       auto const& [r, _] = coordinates;
-
-                                       vector3 const t = deformed_tangent(F_unimodular, r);
-
-                                       auto const micro_stretch = compute_microstretch(t);
-
-                                       auto const a = std::pow(micro_stretch, -2)
-                                                      * (pade_second(micro_stretch, N)
-                                                         - pade_first(micro_stretch, N));
-
-                                       return a * outer_product(t, t, t, t);
-                                   });
+    using batch_array = microsphere_kernel::batch_array;
+
+    auto const [macro_stress, macro_moduli] = kernel.stress_and_moduli(
+        F_unimodular,
+        [&](batch_array const& micro_stretch, auto) -> batch_array {
+            return pade_first(micro_stretch, N);
+        },
+        [&](batch_array const& micro_stretch, auto) -> batch_array {
+            return (pade_second(micro_stretch, N) - pade_first(micro_stretch, N))
+                   / micro_stretch.square();
+        });
+
+    return {shear_modulus * macro_stress, shear_modulus * macro_moduli};
 }
 }
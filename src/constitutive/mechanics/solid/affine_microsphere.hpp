@@ -3,11 +3,16 @@
 
 #include "constitutive/constitutive_model.hpp"
 
+#include "constitutive/mechanics/detail/isotropic_surrogate.hpp"
+#include "constitutive/mechanics/detail/microsphere_kernel.hpp"
 #include "material/micromechanical_elastomer.hpp"
 #include "numeric/tensor_operations.hpp"
 #include "quadrature/unit_sphere_quadrature.hpp"
 #include "io/json_forward.hpp"
 
+#include <memory>
+#include <utility>
+
 namespace neon::mechanics::solid
 {
 /**
@@ -37,6 +42,12 @@ public:
 
     void update_internal_variables(double const time_step_size) override;
 
+    /// Replace the unit sphere integration by an interpolation of the
+    /// tabulated response over the principal stretches.  Deformations outside
+    /// of the table use the unit sphere integration.
+    /// \param surrogate_data json object with "maximum_stretch" and "tolerance"
+    void tabulate(json const& surrogate_data);
+
     [[nodiscard]] material_property const& intrinsic_material() const noexcept override final
     {
         return material;
@@ -74,35 +85,42 @@ protected:
                                                    matrix6 const& macro_C,
                                                    matrix3 const& macro_stress) const;
 
-    /// Compute the macro stress using the unit sphere homogenisation
-    /// technique for a given F and N and perform the deviatoric projection
+    /// Compute the macro stress and the macro moduli using the unit sphere
+    /// homogenisation technique for a given F and N in a single pass over the
+    /// unit sphere directions
     /// \param F_unimodular Unimodular decomposition of the deformation gradient
     /// \param shear_modulus The material shear modulus
     /// \param N number of segments per chain
-    /// \return Kirchhoff stress tensor
-    [[nodiscard]] matrix3 compute_macro_stress(matrix3 const& F_unimodular,
-                                               double const shear_modulus,
-                                               double const N) const;
+    /// \return Kirchhoff stress tensor and the macromoduli from unit sphere homogenisation
+    [[nodiscard]] std::pair<matrix3, matrix6> compute_macro_stress_moduli(
+        matrix3 const& F_unimodular,
+        double const shear_modulus,
+        double const N) const;
 
-    /// Compute the material tangent matrix using the unit sphere homogenisation
-    /// technique for a given F and N
+    /// Compute the macro stress and the macro moduli from the unit sphere
+    /// homogenisation before the deviatoric projection
     /// \param F_unimodular Unimodular decomposition of the deformation gradient
-    /// \param shear_modulus The material shear modulus
-    /// \param N number of segments per chain
-    /// \return Macromoduli from unit sphere homogenisation
-    [[nodiscard]] matrix6 compute_macro_moduli(matrix3 const& F_unimodular,
-                                               double const shear_modulus,
-                                               double const N) const;
+    [[nodiscard]] virtual std::pair<matrix3, matrix6> compute_macro_response(
+        matrix3 const& F_unimodular) const;
+
+    /// \return the macro stress and moduli from the surrogate if enabled and
+    /// inside the tabulated range and otherwise from compute_macro_response
+    [[nodiscard]] std::pair<matrix3, matrix6> evaluate_macro_response(
+        matrix3 const& F_unimodular) const;
 
 protected:
     /// Unit sphere quadrature rule
     unit_sphere_quadrature unit_sphere;
+    /// Batched evaluation of the unit sphere integrals
+    microsphere_kernel kernel{unit_sphere};
     /// Outer product
     matrix6 const IoI = voigt::I_outer_I();
     /// Fourth order identity
     matrix6 const I = voigt::kinematic::fourth_order_identity();
     /// Deviatoric fourth order tensor
     matrix6 const P = voigt::kinetic::deviatoric();
+    /// Optional tabulated response
+    std::unique_ptr<isotropic_surrogate> surrogate;
 
 private:
     /// Material with micromechanical parameters
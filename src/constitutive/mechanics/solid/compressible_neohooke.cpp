@@ -2,6 +2,7 @@
 #include "compressible_neohooke.hpp"
 
 #include "constitutive/internal_variables.hpp"
+#include "numeric/tensor_operations.hpp"
 
 namespace neon::mechanics::solid
 {
@@ -11,16 +12,14 @@ compressible_neohooke::compressible_neohooke(std::shared_ptr<internal_variables_
 {
     // The Neo-Hookean model requires the deformation gradient and the Cauchy
     // stress, which are both allocated by default in the mesh object
-    variables->add(variable::fourth::tangent_operator);
+    variables->add(variable::major_symmetric::tangent_operator);
 }
 
 void compressible_neohooke::update_internal_variables(double const time_step_size)
 {
-    auto [deformation_gradients,
-          cauchy_stresses] = variables->get(variable::second::deformation_gradient,
-                                            variable::second::cauchy_stress);
+    auto const& deformation_gradients = variables->get(variable::second::deformation_gradient);
+    auto& cauchy_stresses = variables->get(variable::symmetric::cauchy_stress);
 
-    auto& tangent_operators = variables->get(variable::fourth::tangent_operator);
     auto const& determinants = variables->get(variable::scalar::DetF);
 
     // compute stresses
@@ -28,7 +27,7 @@ void compressible_neohooke::update_internal_variables(double const time_step_siz
                    end(deformation_gradients),
                    begin(determinants),
                    begin(cauchy_stresses),
-                   [&](matrix3 const& F, double const J) -> matrix3 {
+                   [&](matrix3 const& F, double const J) -> vector6 {
                        auto const [lambda, shear_modulus] = material.Lame_parameters();
 
                        auto const I = matrix3::Identity();
@@ -37,55 +36,38 @@ void compressible_neohooke::update_internal_variables(double const time_step_siz
                        matrix3 const B = F * F.transpose();
 
                        // Compute Kirchhoff stress and transform to Cauchy
-                       return (lambda * std::log(J) * I + shear_modulus * (B - I)) / J;
+                       return voigt::kinetic::to((lambda * std::log(J) * I
+                                                  + shear_modulus * (B - I))
+                                                 / J);
                    });
 
+    if (!is_tangent_stored) return;
+
     // compute material tangent operators
     std::transform(begin(determinants),
                    end(determinants),
-                   begin(tangent_operators),
-                   [&](double const J) -> matrix6 {
-                       auto const [lambda, shear_modulus_0] = material.Lame_parameters();
+                   begin(variables->get(variable::major_symmetric::tangent_operator)),
+                   [this](double const J) { return voigt::major_symmetric::to(moduli(J)); });
+}
+
+auto compressible_neohooke::tangent_operator(std::size_t const l) const -> tangent_operator_t
+{
+    return moduli(variables->get(variable::scalar::DetF)[l]);
+}
+
+matrix6 compressible_neohooke::moduli(double const J) const
+{
+    auto const [lambda, shear_modulus_0] = material.Lame_parameters();
 
-                       auto const shear_modulus = shear_modulus_0 - lambda * std::log(J);
+    auto const shear_modulus = shear_modulus_0 - lambda * std::log(J);
 
-                       return (matrix6() << lambda + 2.0 * shear_modulus,
-                               lambda,
-                               lambda,
-                               0.0,
-                               0.0,
-                               0.0, //
-                               lambda,
-                               lambda + 2.0 * shear_modulus,
-                               lambda,
-                               0.0,
-                               0.0,
-                               0.0, //
-                               lambda,
-                               lambda,
-                               lambda + 2.0 * shear_modulus,
-                               0.0,
-                               0.0,
-                               0.0, //
-                               0.0,
-                               0.0,
-                               0.0,
-                               shear_modulus,
-                               0.0,
-                               0.0, //
-                               0.0,
-                               0.0,
-                               0.0,
-                               0.0,
-                               shear_modulus,
-                               0.0, //
-                               0.0,
-                               0.0,
-                               0.0,
-                               0.0,
-                               0.0,
-                               shear_modulus)
-                           .finished();
-                   });
+    // clang-format off
+    return (matrix6() << lambda + 2.0 * shear_modulus, lambda, lambda, 0.0, 0.0, 0.0,
+                         lambda, lambda + 2.0 * shear_modulus, lambda, 0.0, 0.0, 0.0,
+                         lambda, lambda, lambda + 2.0 * shear_modulus, 0.0, 0.0, 0.0,
+                         0.0, 0.0, 0.0, shear_modulus, 0.0, 0.0,
+                         0.0, 0.0, 0.0, 0.0, shear_modulus, 0.0,
+                         0.0, 0.0, 0.0, 0.0, 0.0, shear_modulus).finished();
+    // clang-format on
 }
 }
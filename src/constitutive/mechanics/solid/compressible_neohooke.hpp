@@ -38,6 +38,14 @@ public:
 
     bool is_finite_deformation() const override final { return true; };
 
+    bool has_pointwise_tangent() const override final { return true; }
+
+    tangent_operator_t tangent_operator(std::size_t const l) const override final;
+
+private:
+    /// \return the spatial moduli for the volume ratio \p J
+    [[nodiscard]] matrix6 moduli(double const J) const;
+
 private:
     /// Elastic model where C1 = mu/2 and C2 = bulk-modulus / 2
     isotropic_elastic_property material;
@@ -6,46 +6,42 @@
 #include "numeric/float_compare.hpp"
 #include "numeric/mechanics"
 
-#include <range/v3/view/transform.hpp>
-#include <range/v3/view/zip.hpp>
+#include <tbb/parallel_for.h>
 
 #include <unsupported/Eigen/MatrixFunctions>
 
-#include <iostream>
-
 namespace neon::mechanics::solid
 {
 finite_strain_J2_plasticity::finite_strain_J2_plasticity(std::shared_ptr<internal_variables_t>& variables,
                                                          json const& material_data)
     : small_strain_J2_plasticity(variables, material_data)
 {
-    variables->add(variable::second::hencky_strain_elastic);
+    variables->add(variable::symmetric::hencky_strain_elastic);
 
     names.emplace("hencky_strain_elastic");
 
-    // Add material tangent with the linear elasticity moduli
+    // The finite strain tangent does not have major symmetry and replaces the
+    // packed tangent of the small strain model with the linear elasticity moduli
+    variables->remove(variable::major_symmetric::tangent_operator);
     variables->add(variable::fourth::tangent_operator,
-                   consistent_tangent(1.0, matrix3::Zero(), matrix3::Zero(), C_e));
+                   consistent_tangent(1.0, matrix3::Identity(), matrix3::Zero(), C_e));
 }
 
 finite_strain_J2_plasticity::~finite_strain_J2_plasticity() = default;
 
 void finite_strain_J2_plasticity::update_internal_variables(double const time_step_size)
 {
-    using namespace ranges;
-
     auto const shear_modulus = material.shear_modulus();
 
     // Extract the internal variables
-    auto [deformation_gradients,
-          log_strain_e_list,
-          cauchy_stresses] = variables->get(variable::second::deformation_gradient,
-                                            variable::second::hencky_strain_elastic,
-                                            variable::second::cauchy_stress);
+    auto& deformation_gradients = variables->get(variable::second::deformation_gradient);
+    auto& cauchy_stresses = variables->get(variable::symmetric::cauchy_stress);
 
-    auto const old_deformation_gradients = variables->get_old(variable::second::deformation_gradient);
+    auto& log_strain_e_list = variables->get(variable::symmetric::hencky_strain_elastic);
 
-    auto const J_list = variables->get(variable::scalar::DetF);
+    auto const& old_deformation_gradients = variables->get_old(variable::second::deformation_gradient);
+
+    auto const& J_list = variables->get(variable::scalar::DetF);
 
     // Retrieve the accumulated internal variables
     auto [accumulated_plastic_strains,
@@ -54,63 +50,72 @@ void finite_strain_J2_plasticity::update_internal_variables(double const time_st
 
     auto& tangent_operators = variables->get(variable::fourth::tangent_operator);
 
-    auto const incremental_deformation_gradients = view::zip(deformation_gradients,
-                                                             old_deformation_gradients)
-                                                   | view::transform([](auto const& tpl) {
-                                                         auto const& [F, F_old] = tpl;
-                                                         return F * F_old.inverse();
-                                                     });
+    points.resize(deformation_gradients.size());
+
+    // Perform the elastic predictor for each quadrature point.  The elastic
+    // logarithmic strain is required for the update of every point and is
+    // the trial state, so the points are classified from the trial state
+    tbb::parallel_for(std::size_t{0}, deformation_gradients.size(), [&](auto const l) {
+        // Incremental deformation gradient from the last converged state
+        matrix3 const F_inc = deformation_gradients[l] * old_deformation_gradients[l].inverse();
 
-    // Perform the update algorithm for each quadrature point
-    for (std::size_t l{0}; l < deformation_gradients.size(); l++)
-    {
-        auto const& F_inc = incremental_deformation_gradients[l];
         auto const J = J_list[l];
 
-        auto& cauchy_stress = cauchy_stresses[l];
-        auto& accumulated_plastic_strain = accumulated_plastic_strains[l];
         auto& von_mises = von_mises_stresses[l];
-        auto& log_strain_e = log_strain_e_list[l];
-
-        // std::cout << "log strain elastic\n" << log_strain_e << std::endl;
 
         // Elastic trial deformation gradient
-        matrix3 const B_e = (2.0 * log_strain_e).exp();
-
-        // std::cout << "B elastic\n" << B_e << std::endl;
-
-        // std::cout << "Finc\n" << F_inc << std::endl;
+        matrix3 const B_e = (2.0 * voigt::kinetic::view(log_strain_e_list[l])).exp();
 
         // Elastic trial left Cauchy-Green deformation tensor
         matrix3 const B_e_trial = F_inc * B_e * F_inc.transpose();
 
-        // std::cout << "B elastic trial\n" << B_e_trial << std::endl;
-
         // Trial Logarithmic elastic strain
-        log_strain_e = 0.5 * B_e_trial.log();
+        matrix3 const log_strain_e = 0.5 * B_e_trial.log();
 
-        // std::cout << "log strain elastic\n" << log_strain_e << std::endl;
+        log_strain_e_list[l] = voigt::kinetic::to(log_strain_e);
 
         // Elastic stress predictor
-        cauchy_stress = compute_cauchy_stress(material.shear_modulus(), material.lambda(), log_strain_e)
-                        / J;
+        matrix3 const cauchy_stress = compute_cauchy_stress(material.shear_modulus(),
+                                                            material.lambda(),
+                                                            log_strain_e)
+                                      / J;
+
+        cauchy_stresses[l] = voigt::kinetic::to(cauchy_stress);
 
         // Trial von Mises stress
         von_mises = von_mises_stress(cauchy_stress);
 
-        // std::cout << "von Mises " << von_mises << std::endl;
-
         // Compute the initial estimate of the yield function for the material
         // and decide if the stress return needs to be computed
-        if (auto const f = evaluate_yield_function(von_mises, accumulated_plastic_strain); f <= 0.0)
+        if (evaluate_yield_function(von_mises, accumulated_plastic_strains[l]) <= 0.0)
         {
-            tangent_operators[l] = consistent_tangent(J, log_strain_e, cauchy_stress, C_e);
-            continue;
+            points.mark_elastic(l);
+            tangent_operators[l] = consistent_tangent(J, B_e_trial, cauchy_stress, C_e);
+            return;
         }
+        points.mark_active(l);
+    });
 
-        auto const von_mises_trial = von_mises;
+    auto const& plastic_points = points.active_points();
+
+    // Perform the return mapping over the compacted plastic points
+    tbb::parallel_for(std::size_t{0}, plastic_points.size(), [&](auto const i) {
+        auto const l = plastic_points[i];
+        auto const J = J_list[l];
 
-        // std::cout << "\nQUADRATURE POINT PLASTIC\n";
+        points.mark_plastic(l);
+
+        matrix3 cauchy_stress = voigt::kinetic::view(cauchy_stresses[l]);
+
+        auto& accumulated_plastic_strain = accumulated_plastic_strains[l];
+        auto& von_mises = von_mises_stresses[l];
+
+        matrix3 log_strain_e = voigt::kinetic::view(log_strain_e_list[l]);
+
+        // Elastic trial left Cauchy-Green deformation tensor from the trial strain
+        matrix3 const B_e_trial = (2.0 * log_strain_e).exp();
+
+        auto const von_mises_trial = von_mises;
 
         // Compute the normal direction to the yield surface which remains
         // constant throughout the radial return method
@@ -120,14 +125,14 @@ void finite_strain_J2_plasticity::update_internal_variables(double const time_st
         auto const plastic_increment = perform_radial_return(von_mises, accumulated_plastic_strain);
 
         // Plastic strain update
-        // F_p = (plastic_increment * std::sqrt(3.0 / 2.0) * normal);
-
-        // std::cout << ">>>Elastic strain before dec\n" << log_strain_e << std::endl;
         log_strain_e -= plastic_increment * std::sqrt(3.0 / 2.0) * normal;
-        // std::cout << ">>>Elastic strain after dec\n" << log_strain_e << std::endl;
+
+        log_strain_e_list[l] = voigt::kinetic::to(log_strain_e);
 
         cauchy_stress -= 2.0 * shear_modulus * plastic_increment * std::sqrt(3.0 / 2.0) * normal / J;
 
+        cauchy_stresses[l] = voigt::kinetic::to(cauchy_stress);
+
         von_mises = von_mises_stress(cauchy_stress);
 
         accumulated_plastic_strain += plastic_increment;
@@ -139,8 +144,8 @@ void finite_strain_J2_plasticity::update_internal_variables(double const time_st
                                                  normal);
 
         // Compute the elastic-plastic tangent modulus for large strain
-        tangent_operators[l] = consistent_tangent(J, log_strain_e, cauchy_stress, D_ep);
-    }
+        tangent_operators[l] = consistent_tangent(J, B_e_trial, cauchy_stress, D_ep);
+    });
 }
 
 matrix6 finite_strain_J2_plasticity::consistent_tangent(double const J,
@@ -183,7 +188,6 @@ std::tuple<vector3, std::array<matrix3, 3>, bool, std::array<int, 3>> finite_str
     // if (x.norm() < 1.0e-2 || (is_approx(x(0), x(1)) && is_approx(x(1), x(2))))
     if (is_approx(x(0), x(1)) && is_approx(x(1), x(2)))
     {
-        std::cout << "We have repeated eigenvalues!\n" << x << std::endl;
         E[0] = matrix3::Identity();
         is_repeated = true;
         abc_ordering = {{-1, -1, -1}};
@@ -238,12 +242,8 @@ matrix6 finite_strain_J2_plasticity::compute_L(matrix3 const& Be_trial) const
         // Derivative when there is one repeated eigenvalue
         auto const& [a, b, c] = abc_ordering;
 
-        std::cout << "Eigenvalues\n" << x << std::endl;
-
         vector3 const y = x.array().log();
 
-        std::cout << "log Eigenvalues\n" << y << std::endl;
-
         auto const s1 = (y(a) - y(c)) / std::pow(x(a) - x(c), 2) - 1.0 / (x(c) * (x(a) - x(c)));
         auto const s2 = 2.0 * x(c) * (y(a) - y(c)) / std::pow(x(a) - x(c), 2)
                         - (x(a) + x(c)) / (x(a) - x(c)) / x(c);
@@ -259,7 +259,6 @@ matrix6 finite_strain_J2_plasticity::compute_L(matrix3 const& Be_trial) const
                + s6 * outer_product(matrix3::Identity());
     }
     // Derivative with all repeated eigenvalues
-    std::cout << "Returning the symmetrix identity tensor and the first eigenvalue " << x(0) << "\n";
     return x.norm() < 1.0e-5 ? Isym : Isym / x(0);
 }
 
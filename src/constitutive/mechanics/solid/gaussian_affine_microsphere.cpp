@@ -2,7 +2,6 @@
 #include "gaussian_affine_microsphere.hpp"
 
 #include "constitutive/internal_variables.hpp"
-#include "constitutive/mechanics/detail/microsphere.hpp"
 #include "constitutive/mechanics/volumetric_free_energy.hpp"
 
 #include <tbb/parallel_for.h>
@@ -14,7 +13,7 @@ gaussian_affine_microsphere::gaussian_affine_microsphere(std::shared_ptr<interna
                                                          unit_sphere_quadrature::point const p)
     : constitutive_model(variables), unit_sphere(p), material(material_data)
 {
-    variables->add(variable::fourth::tangent_operator);
+    variables->add(variable::major_symmetric::tangent_operator);
 
     // Commit these to history in case of failure on first time step
     variables->commit();
@@ -22,10 +21,10 @@ gaussian_affine_microsphere::gaussian_affine_microsphere(std::shared_ptr<interna
 
 void gaussian_affine_microsphere::update_internal_variables(double const time_step_size)
 {
-    auto& tangent_operators = variables->get(variable::fourth::tangent_operator);
+    auto& tangent_operators = variables->get(variable::major_symmetric::tangent_operator);
 
     auto const& deformation_gradients = variables->get(variable::second::deformation_gradient);
-    auto& cauchy_stresses = variables->get(variable::second::cauchy_stress);
+    auto& cauchy_stresses = variables->get(variable::symmetric::cauchy_stress);
 
     auto const& det_deformation_gradients = variables->get(variable::scalar::DetF);
 
@@ -43,9 +42,11 @@ void gaussian_affine_microsphere::update_internal_variables(double const time_st
         // Project the stresses to obtain the Kirchhoff macro-stress
         matrix3 const macro_stress = compute_macro_stress(F_bar, G);
 
-        cauchy_stresses[l] = compute_kirchhoff_stress(pressure, macro_stress) / J;
+        cauchy_stresses[l] = voigt::kinetic::to(compute_kirchhoff_stress(pressure, macro_stress)
+                                                / J);
 
-        tangent_operators[l] = compute_material_tangent(J, K, matrix6::Zero(), macro_stress);
+        tangent_operators[l] = voigt::major_symmetric::to(
+            compute_material_tangent(J, K, matrix6::Zero(), macro_stress));
     });
 }
 
@@ -77,14 +78,8 @@ matrix6 gaussian_affine_microsphere::compute_material_tangent(double const J,
 matrix3 gaussian_affine_microsphere::compute_macro_stress(matrix3 const& F_unimodular,
                                                           double const shear_modulus) const
 {
-    return 3.0 * shear_modulus
-           * unit_sphere.integrate(matrix3::Zero().eval(),
-                                   [&](auto const& coordinates, auto) -> matrix3 {
-                                       auto const& [r, _] = coordinates;
-
-                                       vector3 const t = deformed_tangent(F_unimodular, r);
-
-                                       return outer_product(t, t);
-                                   });
+    // The integrand is independent of the microstretch and the sum over the
+    // deformed tangents reduces to the precomputed second moment of the rule
+    return 3.0 * shear_modulus * F_unimodular * kernel.second_moment() * F_unimodular.transpose();
 }
 }
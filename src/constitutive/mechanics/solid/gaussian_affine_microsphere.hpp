@@ -3,6 +3,7 @@
 
 #include "constitutive/constitutive_model.hpp"
 
+#include "constitutive/mechanics/detail/microsphere_kernel.hpp"
 #include "material/micromechanical_elastomer.hpp"
 #include "numeric/tensor_operations.hpp"
 #include "quadrature/unit_sphere_quadrature.hpp"
@@ -85,6 +86,8 @@ protected:
 protected:
     /// Unit sphere quadrature rule
     unit_sphere_quadrature unit_sphere;
+    /// Batched evaluation of the unit sphere integrals
+    microsphere_kernel kernel{unit_sphere};
     /// Outer product
     matrix6 const IoI = voigt::I_outer_I();
     /// Fourth order identity
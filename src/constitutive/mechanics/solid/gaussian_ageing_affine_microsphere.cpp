@@ -2,9 +2,7 @@
 #include "constitutive/mechanics/solid/gaussian_ageing_affine_microsphere.hpp"
 
 #include "constitutive/internal_variables.hpp"
-#include "constitutive/mechanics/detail/microsphere.hpp"
 #include "constitutive/mechanics/volumetric_free_energy.hpp"
-#include "quadrature/trapezoidal.hpp"
 #include "solver/time/runge_kutta_integration.hpp"
 #include "numeric/float_compare.hpp"
 
@@ -77,11 +75,38 @@ void gaussian_ageing_affine_microsphere::update_internal_variables(double const
     auto const& deformation_gradients = variables->get(variable::second::deformation_gradient);
     auto const& det_F = variables->get(variable::scalar::DetF);
 
-    auto& cauchy_stresses = variables->get(variable::second::cauchy_stress);
-    auto& tangent_operators = variables->get(variable::fourth::tangent_operator);
+    auto& cauchy_stresses = variables->get(variable::symmetric::cauchy_stress);
+    auto& tangent_operators = variables->get(variable::major_symmetric::tangent_operator);
 
     auto const K{material.bulk_modulus()};
 
+    // Pack the network parameters at a quadrature point
+    auto const network_state = [&](auto const l) -> vector5 {
+        return (vector5() << active_shear_modulus[l],
+                inactive_shear_modulus[l],
+                reduction_factor[l],
+                active_segments[l],
+                inactive_segments[l])
+            .finished();
+    };
+
+    bool const update_network = !is_approx(time_step_size, 0.0)
+                                && !deformation_gradients.empty();
+
+    // The network evolution equations are independent of the deformation and
+    // every quadrature point starting from the same network state evolves in
+    // the same way.  Integrate the differential equations once through the
+    // micromechanical material and reuse the result for all matching points
+    vector5 reference_state, reference_update;
+
+    if (update_network)
+    {
+        reference_state = network_state(0);
+        reference_update = material.integrate(reference_state, time_step_size);
+
+        last_time_step_size = time_step_size;
+    }
+
     tbb::parallel_for(std::size_t{0}, deformation_gradients.size(), [&, this](auto const l) {
         // unimodular deformation gradient
         matrix3 const F_bar = unimodular(deformation_gradients[l]);
@@ -92,18 +117,14 @@ void gaussian_ageing_affine_microsphere::update_internal_variables(double const
         auto const& modulus_old = moduli_old[l];
         auto const& last_h_old = last_evaluation_old[l];
 
-        if (!is_approx(time_step_size, 0.0))
+        if (update_network)
         {
-            // Integrate the network evolution differential equations through
-            // the micromechanical material by passing our network parameters
-            vector5 parameters;
-            parameters(0) = active_shear_modulus[l];
-            parameters(1) = inactive_shear_modulus[l];
-            parameters(2) = reduction_factor[l];
-            parameters(3) = active_segments[l];
-            parameters(4) = inactive_segments[l];
+            vector5 const state = network_state(l);
 
-            parameters = material.integrate(parameters, time_step_size);
+            // Only integrate the network evolution for diverging network states
+            vector5 const parameters = state == reference_state
+                                           ? reference_update
+                                           : material.integrate(state, time_step_size);
 
             // Update the history variables for plotting
             active_shear_modulus[l] = parameters(0);
@@ -111,8 +132,6 @@ void gaussian_ageing_affine_microsphere::update_internal_variables(double const
             reduction_factor[l] = parameters(2);
             active_segments[l] = parameters(3);
             inactive_segments[l] = parameters(4);
-
-            last_time_step_size = time_step_size;
         }
 
         auto const creation_rate = material.creation_rate(active_shear_modulus[l],
@@ -120,79 +139,65 @@ void gaussian_ageing_affine_microsphere::update_internal_variables(double const
                                                           active_segments[l],
                                                           inactive_segments[l]);
 
-        // Partially integrate secondary modulus
-        unit_sphere.for_each([&](auto const& coordinates, auto const index) {
-            auto const& [r, _] = coordinates;
-
-            auto const stretch = compute_microstretch(deformed_tangent(F_bar, r));
-
-            last_h[index] = evaluate_integrand(creation_rate, reduction_factor[l], stretch);
-
-            modulus[index] = integrate_history(modulus_old[index],
-                                               last_h_old[index],
-                                               last_h[index],
-                                               last_time_step_size);
-        });
-
-        matrix3 const macro_stress = compute_macro_stress(F_bar, modulus, reduction_factor[l]);
-
-        matrix6 const macro_moduli = compute_macro_moduli(F_bar, creation_rate, last_time_step_size);
+        auto const [macro_stress, macro_moduli] = compute_macro_stress_moduli(F_bar,
+                                                                              modulus,
+                                                                              last_h,
+                                                                              modulus_old,
+                                                                              last_h_old,
+                                                                              creation_rate,
+                                                                              reduction_factor[l],
+                                                                              last_time_step_size);
 
         auto const J = det_F[l];
 
         auto const pressure = J * volumetric_free_energy_dJ(J, K);
 
-        cauchy_stresses[l] = compute_kirchhoff_stress(pressure, macro_stress) / J;
+        cauchy_stresses[l] = voigt::kinetic::to(compute_kirchhoff_stress(pressure, macro_stress)
+                                                / J);
 
-        tangent_operators[l] = compute_material_tangent(J, K, macro_moduli, macro_stress);
+        tangent_operators[l] = voigt::major_symmetric::to(
+            compute_material_tangent(J, K, macro_moduli, macro_stress));
     });
 }
 
-matrix3 gaussian_ageing_affine_microsphere::compute_macro_stress(matrix3 const& F_bar,
-                                                                 std::vector<double> const& modulus,
-                                                                 double const reduction_factor) const
+std::pair<matrix3, matrix6> gaussian_ageing_affine_microsphere::compute_macro_stress_moduli(
+    matrix3 const& F_bar,
+    std::vector<double>& modulus,
+    std::vector<double>& last_h,
+    std::vector<double> const& modulus_old,
+    std::vector<double> const& last_h_old,
+    double const creation_rate,
+    double const reduction_factor,
+    double const time_step_size) const
 {
-    return 3.0 * reduction_factor
-           * unit_sphere.integrate(matrix3::Zero().eval(),
-                                   [&](auto const& coordinates, auto const index) -> matrix3 {
-                                       auto const& [r, _] = coordinates;
+    using batch_array = microsphere_kernel::batch_array;
+    using batch_map = Eigen::Map<batch_array>;
+    using const_batch_map = Eigen::Map<batch_array const>;
 
-                                       vector3 const t = deformed_tangent(F_bar, r);
+    vector6 stress = vector6::Zero();
+    matrix6 moduli = matrix6::Zero();
 
-                                       return (material.shear_modulus() + modulus[index])
-                                              * outer_product(t, t);
-                                   });
-}
+    auto const G_0 = material.shear_modulus();
 
-matrix6 gaussian_ageing_affine_microsphere::compute_macro_moduli(matrix3 const& F_bar,
-                                                                 double const creation_rate,
-                                                                 double const time_step_size) const
-{
-    return -3.0 / 2.0 * creation_rate * time_step_size
-           * unit_sphere.integrate(matrix6::Zero().eval(),
-                                   [&](auto const& coordinates, auto) -> matrix6 {
-                                       auto const& [r, _] = coordinates;
+    kernel.for_each_batch(F_bar,
+                          [&](auto const& V, auto const& w, auto const& stretch, auto const i) {
+                              auto const size = stretch.size();
 
-                                       vector3 const t = deformed_tangent(F_bar, r);
+                              batch_map h(last_h.data() + i, size);
+                              batch_map G(modulus.data() + i, size);
 
-                                       auto const stretch = compute_microstretch(t);
+                              const_batch_map h_old(last_h_old.data() + i, size);
+                              const_batch_map G_old(modulus_old.data() + i, size);
 
-                                       return std::pow(stretch, -3) * outer_product(t, t, t, t);
-                                   });
-}
+                              // Partially integrate secondary modulus (trapezoidal)
+                              h = creation_rate / (stretch * reduction_factor);
+                              G = G_old + (h_old + h) * 0.5 * time_step_size;
 
-double gaussian_ageing_affine_microsphere::evaluate_integrand(double const creation_rate,
-                                                              double const reduction_factor,
-                                                              double const micro_stretch) const
-{
-    return creation_rate / (micro_stretch * reduction_factor);
-}
+                              microsphere_kernel::accumulate(stress, V, w * (G_0 + G));
+                              microsphere_kernel::accumulate(moduli, V, w / stretch.cube());
+                          });
 
-double gaussian_ageing_affine_microsphere::integrate_history(double const modulus,
-                                                             double const sphere_old,
-                                                             double const sphere,
-                                                             double const time_step_size) const
-{
-    return modulus + partial_trapezoidal(sphere_old, sphere, time_step_size);
+    return {3.0 * reduction_factor * microsphere_kernel::from_voigt(stress),
+            -3.0 / 2.0 * creation_rate * time_step_size * microsphere_kernel::symmetrise(moduli)};
 }
 }
@@ -5,6 +5,7 @@
 
 #include "numeric/dense_matrix.hpp"
 
+#include <utility>
 #include <vector>
 
 namespace neon::mechanics::solid
@@ -36,25 +37,19 @@ public:
     virtual void update_internal_variables(double const time_step_size) override;
 
 private:
-    [[nodiscard]] matrix3 compute_macro_stress(matrix3 const& F_bar,
-                                               std::vector<double> const& modulus,
-                                               double const reduction_factor) const;
-
-    [[nodiscard]] matrix6 compute_macro_moduli(matrix3 const& F_bar,
-                                               double const creation_rate,
-                                               double const time_step_size) const;
-
-    /// Compute the force contribution to the secondary modulus
-    /// \return evaluated integrand
-    [[nodiscard]] double evaluate_integrand(double const creation_rate,
-                                            double const reduction_factor,
-                                            double const micro_stretch) const;
-
-    /// Integrate the time history and return the integrated value
-    [[nodiscard]] double integrate_history(double const modulus,
-                                           double const sphere_old,
-                                           double const sphere,
-                                           double const time_step_size) const;
+    /// Update the accumulated secondary modulus for each sphere direction and
+    /// compute the macro stress and the macro moduli in a single pass over the
+    /// unit sphere directions
+    /// \return Macro stress and macro moduli from unit sphere homogenisation
+    [[nodiscard]] std::pair<matrix3, matrix6> compute_macro_stress_moduli(
+        matrix3 const& F_bar,
+        std::vector<double>& modulus,
+        std::vector<double>& last_h,
+        std::vector<double> const& modulus_old,
+        std::vector<double> const& last_h_old,
+        double const creation_rate,
+        double const reduction_factor,
+        double const time_step_size) const;
 
 private:
     /// Material with micromechanical parameters
@@ -14,13 +14,14 @@ isotropic_linear_elasticity::isotropic_linear_elasticity(std::shared_ptr<interna
                                                          json const& material_data)
     : constitutive_model(variables), material(material_data)
 {
-    variables->add(variable::second::linearised_strain, variable::scalar::von_mises_stress);
+    variables->add(variable::symmetric::linearised_strain, variable::scalar::von_mises_stress);
 
     names.emplace("linearised_strain");
     names.emplace("von_mises_stress");
 
     // Add material tangent with the linear elasticity spatial moduli
-    variables->add(variable::fourth::tangent_operator, elastic_moduli());
+    variables->add(variable::major_symmetric::tangent_operator,
+                   voigt::major_symmetric::to(elastic_moduli()));
 }
 
 isotropic_linear_elasticity::~isotropic_linear_elasticity() = default;
@@ -30,14 +31,16 @@ void isotropic_linear_elasticity::update_internal_variables(double const time_st
     using namespace ranges;
 
     // Extract the internal variables
-    auto [elastic_strains, cauchy_stresses] = variables->get(variable::second::linearised_strain,
-                                                             variable::second::cauchy_stress);
+    auto [elastic_strains, cauchy_stresses] = variables->get(variable::symmetric::linearised_strain,
+                                                             variable::symmetric::cauchy_stress);
 
     auto& von_mises_stresses = variables->get(variable::scalar::von_mises_stress);
 
     // Compute the linear strain gradient from the displacement gradient
     elastic_strains = variables->get(variable::second::displacement_gradient)
-                      | view::transform([](auto const& H) { return 0.5 * (H + H.transpose()); });
+                      | view::transform([](auto const& H) {
+                            return voigt::kinetic::to(0.5 * (H + H.transpose()));
+                        });
 
     // Compute Cauchy stress from the linear elastic strains
     cauchy_stresses = elastic_strains | view::transform([this](auto const& elastic_strain) {
@@ -52,6 +55,18 @@ void isotropic_linear_elasticity::update_internal_variables(double const time_st
                          });
 }
 
+void isotropic_linear_elasticity::update_derived_variables()
+{
+    using namespace ranges;
+
+    auto& von_mises_stresses = variables->get(variable::scalar::von_mises_stress);
+
+    von_mises_stresses = variables->get(variable::symmetric::cauchy_stress)
+                         | view::transform([](auto const& cauchy_stress) {
+                               return von_mises_stress(cauchy_stress);
+                           });
+}
+
 matrix6 isotropic_linear_elasticity::elastic_moduli() const
 {
     auto const [lambda, shear_modulus] = material.Lame_parameters();
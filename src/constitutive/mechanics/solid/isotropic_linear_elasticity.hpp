@@ -24,6 +24,9 @@ public:
 
     virtual void update_internal_variables(double const time_step_size) override;
 
+    /// Recompute the von Mises stress from the stored Cauchy stress
+    virtual void update_derived_variables() override;
+
     [[nodiscard]] virtual material_property const& intrinsic_material() const override
     {
         return material;
@@ -31,6 +34,15 @@ public:
 
     [[nodiscard]] virtual bool is_finite_deformation() const override { return false; }
 
+    [[nodiscard]] virtual bool is_tangent_constant() const override { return true; }
+
+    [[nodiscard]] virtual bool has_pointwise_tangent() const override { return true; }
+
+    [[nodiscard]] virtual tangent_operator_t tangent_operator(std::size_t const) const override
+    {
+        return C_e;
+    }
+
 protected:
     [[nodiscard]] matrix6 elastic_moduli() const;
 
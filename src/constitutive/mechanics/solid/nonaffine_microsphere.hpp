@@ -25,83 +25,11 @@ public:
                                    json const& material_data,
                                    unit_sphere_quadrature::point const rule);
 
-    virtual void update_internal_variables(double const time_step_size) override;
-
 protected:
-    /**
-     * Compute the non-affine stretch by numerical quadrature over the unit sphere
-     * \f{align*}{
-        \lambda &= \left[ \sum_{i=1}^m (\bar{\lambda}_i)^p w_i \right]^{1/p}
-      \f}
-     */
-    double compute_nonaffine_stretch(matrix3 const& F_deviatoric) const;
-
-    /**
-     * Evaluate the h tensor by numerical quadrature over the unit sphere
-     * \f{align*}{
-        \mathbf{h} &= \sum_{i=1}^m (\bar{\lambda}_i)^{p - 2}
-                      \mathbf{t}_i\otimes\mathbf{t}_i w_i
-      \f}
-     */
-    matrix3 compute_h_tensor(matrix3 const& F_deviatoric) const;
-
-    /**
-     * Evaluate the H tensor by numerical quadrature over the unit sphere
-     * \f{align*}{
-        \mathbf{H} &= (p - 2) \sum_{i=1}^m (\bar{\lambda}_i)^{p-4}
-                      \mathbf{t}_i\otimes\mathbf{t}_i\otimes\mathbf{t}_i\otimes\mathbf{t}_i w_i
-      \f}
-     */
-    matrix6 compute_H_tensor(matrix3 const& F_deviatoric) const;
-
-    /**
-     * Evaluate the k tensor by numerical quadrature over the unit sphere
-     * \f{align*}{
-        \mathbf{k} &= q \sum_{i=1}^m (\bar{\nu}_i)^{q-2}
-                      \mathbf{n}_i\otimes\mathbf{n}_i w_i
-      \f}
-     * where \f$ q \f$ is the non-affine tube parameter and \f$ \mathbf{n} \f$
-     * is the deformed normal.
-     * \sa non_affine_tube_parameter
-     * @param F_deviatoric Deviatoric part deformation gradient
-     */
-    matrix3 compute_k_tensor(matrix3 const& F_deviatoric) const;
-
-    /**
-     * Evaluate the K tensor by numerical quadrature over the unit sphere
-     * \f{align*}{
-        \mathbf{K} &= q(q-2)\sum_{i=1}^m (\bar{\nu}_i)^{q-4}
-                      \mathbf{n}_i\otimes\mathbf{n}_i\otimes\mathbf{n}_i\otimes\mathbf{n}_iw_i
-      \f}
-     * where \f$ q \f$ is the non-affine tube parameter.
-     * \sa non_affine_tube_parameter
-     */
-    matrix6 compute_K_tensor(matrix3 const& F_deviatoric) const;
-
-    /**
-     * Evaluate the G tensor by numerical quadrature over the unit sphere
-     * \f{align*}{
-        \mathbf{G} &= 2q \sum_{i=1}^m (\bar{\nu}_i)^{q - 2}
-        sym[\mathbf{g}^{-1} \odot \mathbf{n} \otimes \mathbf{n} + \mathbf{n} \otimes
-    \mathbf{n} \odot \mathbf{g}^{-1}] w_i
-      \f}
-     * where \f$ q \f$ is the non-affine tube parameter.
-     * \sa non_affine_tube_parameter
-     * \sa compute_o_dot_product
-     */
-    matrix6 compute_G_tensor(matrix3 const& F_deviatoric) const;
-
-    /**
-     * Compute the o dot product for the material tangent matrix for the
-     * non-affine model using the formula
-     * \f{align*}{
-         sym[\mathbf{g}^{-1} \odot \mathbf{n} \otimes \mathbf{n} + \mathbf{n} \otimes
-     \mathbf{n} \odot \mathbf{g}^{-1}] & \f}
-     * where \f$\mathbf{g}\f$ is the metric tensor (identity) and \f$\mathbf{n}\f$
-     * is the deformed normal vector
-     * \sa compute_G_tensor
-     */
-    matrix6 compute_o_dot_product(vector3 const& n) const;
+    /// Compute the superimposed chain and tube contributions to the macro
+    /// stress and the macro moduli \sa microsphere_kernel::nonaffine
+    [[nodiscard]] std::pair<matrix3, matrix6> compute_macro_response(
+        matrix3 const& F_unimodular) const override;
 
 private:
     /// Material with micromechanical parameters
@@ -116,16 +44,4 @@ private:
 };
 
 /** \} */
-
-inline matrix6 nonaffine_microsphere::compute_o_dot_product(vector3 const& n) const
-{
-    // clang-format off
-    return (matrix6() << 2.0 * n(0) * n(0),               0.0,               0.0,                               0.0,                       n(0) * n(2), n(0) * n(1),       //
-                                       0.0, 2.0 * n(1) * n(1),               0.0,                       n(1) * n(2),                               0.0, n(0) * n(1),       //
-                                       0.0,               0.0, 2.0 * n(2) * n(2),                       n(1) * n(2),                       n(0) * n(2), 0.0,               //
-                                       0.0,       n(1) * n(2),       n(1) * n(2), 0.5 * (n(1) * n(1) + n(2) * n(2)),                 0.5 * n(0) * n(1), 0.5 * n(0) * n(2), //
-                               n(0) * n(2),               0.0,       n(0) * n(2),                 0.5 * n(0) * n(1), 0.5 * (n(0) * n(0) + n(2) * n(2)), 0.5 * n(2) * n(1), //
-                               n(0) * n(1),       n(0) * n(1),               0.0,                 0.5 * n(0) * n(2),                 0.5 * n(2) * n(1), 0.5 * (n(0) * n(0) + n(1) * n(1))).finished();
-    // clang-format on
-}
 }
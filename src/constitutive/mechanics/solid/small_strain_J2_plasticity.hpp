@@ -3,6 +3,7 @@
 
 #include "isotropic_linear_elasticity.hpp"
 
+#include "constitutive/mechanics/detail/active_set.hpp"
 #include "numeric/tensor_operations.hpp"
 
 #include "material/isotropic_elastic_plastic.hpp"
@@ -29,6 +30,11 @@ public:
 
     virtual bool is_finite_deformation() const override { return false; }
 
+    /// The algorithmic tangent depends on the plastic flow and its history
+    virtual bool is_tangent_constant() const override { return false; }
+
+    virtual bool has_pointwise_tangent() const override { return false; }
+
 protected:
     [[nodiscard]] matrix6 algorithmic_tangent(double const plastic_increment,
                                               double const accumulated_plastic_strain,
@@ -55,5 +61,8 @@ protected:
     isotropic_elastic_plastic material;
 
     matrix6 const I_dev = voigt::kinematic::deviatoric();
+
+    /// Partition of the quadrature points into elastic and active sets
+    active_set points;
 };
 }
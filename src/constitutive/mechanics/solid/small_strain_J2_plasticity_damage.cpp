@@ -6,7 +6,6 @@
 #include "io/json.hpp"
 #include "exceptions.hpp"
 
-#include <range/v3/view/transform.hpp>
 #include <tbb/parallel_for.h>
 
 #include <iostream>
@@ -18,8 +17,8 @@ small_strain_J2_plasticity_damage::small_strain_J2_plasticity_damage(
     json const& material_data)
     : small_strain_J2_plasticity(variables, material_data), material(material_data)
 {
-    variables->add(variable::second::back_stress,
-                   variable::second::kinematic_hardening,
+    variables->add(variable::symmetric::back_stress,
+                   variable::symmetric::kinematic_hardening,
                    variable::scalar::damage,
                    variable::scalar::energy_release_rate);
 
@@ -27,6 +26,11 @@ small_strain_J2_plasticity_damage::small_strain_J2_plasticity_damage(
     names.emplace("kinematic_hardening");
     names.emplace("damage");
     names.emplace("energy_release_rate");
+
+    // The damaged tangent does not have major symmetry and replaces the packed
+    // tangent of the undamaged model with the linear elasticity moduli
+    variables->remove(variable::major_symmetric::tangent_operator);
+    variables->add(variable::fourth::tangent_operator, C_e);
 }
 
 small_strain_J2_plasticity_damage::~small_strain_J2_plasticity_damage() = default;
@@ -34,13 +38,13 @@ small_strain_J2_plasticity_damage::~small_strain_J2_plasticity_damage() = defaul
 void small_strain_J2_plasticity_damage::update_internal_variables(double const time_step_size)
 {
     // Retrieve the internal variables
-    auto& plastic_strains = variables->get(variable::second::linearised_plastic_strain);
-    auto& strains = variables->get(variable::second::linearised_strain);
+    auto& plastic_strains = variables->get(variable::symmetric::linearised_plastic_strain);
+    auto& strains = variables->get(variable::symmetric::linearised_strain);
     auto& accumulated_plastic_strains = variables->get(variable::scalar::effective_plastic_strain);
-    auto& accumulated_kinematic_stresses = variables->get(variable::second::kinematic_hardening);
+    auto& accumulated_kinematic_stresses = variables->get(variable::symmetric::kinematic_hardening);
 
-    auto& cauchy_stresses = variables->get(variable::second::cauchy_stress);
-    auto& back_stresses = variables->get(variable::second::back_stress);
+    auto& cauchy_stresses = variables->get(variable::symmetric::cauchy_stress);
+    auto& back_stresses = variables->get(variable::symmetric::back_stress);
     auto& von_mises_stresses = variables->get(variable::scalar::von_mises_stress);
 
     auto& energy_release_rates = variables->get(variable::scalar::energy_release_rate);
@@ -48,24 +52,30 @@ void small_strain_J2_plasticity_damage::update_internal_variables(double const t
 
     auto& tangent_operators = variables->get(variable::fourth::tangent_operator);
 
-    // Compute the linear strain gradient from the displacement gradient
-    strains = variables->get(variable::second::displacement_gradient)
-              | ranges::view::transform([](auto const& H) { return 0.5 * (H + H.transpose()); });
+    auto const& displacement_gradients = variables->get(variable::second::displacement_gradient);
 
     // Perform the update algorithm for each quadrature point
     tbb::parallel_for(std::size_t{0}, strains.size(), [&](auto const l) {
-        auto const& strain = strains[l];
-        auto& plastic_strain = plastic_strains[l];
-        auto& cauchy_stress = cauchy_stresses[l];
+        auto const& H = displacement_gradients[l];
+
         auto& von_mises = von_mises_stresses[l];
-        auto& back_stress = back_stresses[l];
         auto& scalar_damage = scalar_damages[l];
         auto& energy_var = energy_release_rates[l];
 
+        // Expand the symmetric history variables for the update
+        matrix3 plastic_strain = voigt::kinetic::view(plastic_strains[l]);
+        matrix3 back_stress = voigt::kinetic::view(back_stresses[l]);
+        matrix3 kinematic_hardening = voigt::kinetic::view(accumulated_kinematic_stresses[l]);
+
+        // Compute the linear strain gradient from the displacement gradient
+        matrix3 const strain = 0.5 * (H + H.transpose());
+
         // Elastic stress predictor
-        cauchy_stress = compute_cauchy_stress(material.shear_modulus(),
-                                              material.lambda(),
-                                              strain - plastic_strain);
+        matrix3 cauchy_stress = compute_cauchy_stress(material.shear_modulus(),
+                                                      material.lambda(),
+                                                      strain - plastic_strain);
+
+        strains[l] = voigt::kinetic::to(strain);
 
         matrix3 tau = deviatoric(cauchy_stress) / (1.0 - scalar_damage) - deviatoric(back_stress);
 
@@ -82,6 +92,7 @@ void small_strain_J2_plasticity_damage::update_internal_variables(double const t
         if (evaluate_yield_function(von_mises, back_stress) <= 0.0
             && evaluate_damage_yield_function(energy_var) <= 0.0)
         {
+            cauchy_stresses[l] = voigt::kinetic::to(cauchy_stress);
             tangent_operators[l] = C_e;
             return;
         }
@@ -89,7 +100,7 @@ void small_strain_J2_plasticity_damage::update_internal_variables(double const t
         auto const plastic_increment = perform_radial_return(cauchy_stress,
                                                              back_stress,
                                                              scalar_damage,
-                                                             accumulated_kinematic_stresses[l],
+                                                             kinematic_hardening,
                                                              energy_var,
                                                              tangent_operators[l],
                                                              time_step_size,
@@ -102,6 +113,43 @@ void small_strain_J2_plasticity_damage::update_internal_variables(double const t
         plastic_strain += plastic_increment * 3.0 / 2.0 * tau / (von_mises * (1 - scalar_damage));
 
         accumulated_plastic_strains[l] += plastic_increment / (1 - scalar_damage);
+
+        cauchy_stresses[l] = voigt::kinetic::to(cauchy_stress);
+        plastic_strains[l] = voigt::kinetic::to(plastic_strain);
+        back_stresses[l] = voigt::kinetic::to(back_stress);
+        accumulated_kinematic_stresses[l] = voigt::kinetic::to(kinematic_hardening);
+    });
+}
+
+void small_strain_J2_plasticity_damage::update_derived_variables()
+{
+    auto const& plastic_strains = variables->get(variable::symmetric::linearised_plastic_strain);
+    auto const& back_stresses = variables->get(variable::symmetric::back_stress);
+
+    auto const& strains = variables->get(variable::symmetric::linearised_strain);
+    auto const& cauchy_stresses = variables->get(variable::symmetric::cauchy_stress);
+    auto const& scalar_damages = variables->get(variable::scalar::damage);
+
+    auto& von_mises_stresses = variables->get(variable::scalar::von_mises_stress);
+    auto& energy_release_rates = variables->get(variable::scalar::energy_release_rate);
+
+    tbb::parallel_for(std::size_t{0}, strains.size(), [&](auto const l) {
+        auto const scalar_damage = scalar_damages[l];
+
+        vector6 const packed_elastic_strain = strains[l] - plastic_strains[l];
+
+        matrix3 const elastic_strain = voigt::kinetic::view(packed_elastic_strain);
+
+        matrix3 const tau = deviatoric(voigt::kinetic::view(cauchy_stresses[l])) / (1.0 - scalar_damage)
+                            - deviatoric(voigt::kinetic::view(back_stresses[l]));
+
+        von_mises_stresses[l] = von_mises_stress(tau);
+
+        energy_release_rates[l] = 0.5
+                                  * double_dot(elastic_strain,
+                                               compute_stress_like_matrix((1.0 - scalar_damage)
+                                                                              * C_e,
+                                                                          elastic_strain));
     });
 }
 
@@ -128,6 +176,10 @@ double small_strain_J2_plasticity_damage::perform_radial_return(matrix3& cauchy_
 
     matrix16 M = matrix16::Zero();
 
+    // Factorisation of the local Jacobian shared by the Newton correction and
+    // the extraction of the algorithmic tangent operator
+    Eigen::PartialPivLU<matrix16> lu;
+
     M(0, 0) = M(1, 1) = M(14, 14) = M(15, 15) = 1.0;
 
     // TODO: double check kinetic kinematic
@@ -197,13 +249,9 @@ double small_strain_J2_plasticity_damage::perform_radial_return(matrix3& cauchy_
                                  compute_stress_like_matrix(C_e, eps_e_t - delta_t * d_lam_plastic * normal_tild / (1.0 - d)));
         // clang-format on
 
-        // Eigen::JacobiSVD<Eigen::MatrixXd> svd(M);
-        // double cond = svd.singularValues()(0) /
-        // svd.singularValues()(svd.singularValues().size()
-        // - 1); std::cout << cond << "\n\n";
-        // vector a = -M.inverse() * f;
+        lu.compute(M);
 
-        y -= M.fullPivLu().solve(f);
+        y -= lu.solve(f);
 
         iterations++;
     }
@@ -233,8 +281,13 @@ double small_strain_J2_plasticity_damage::perform_radial_return(matrix3& cauchy_
 
     kin_hard = back_stress / C;
 
-    tangent_operator = (1.0 - scalar_damage) * mandel_notation(C_e)
-                       * mandel_notation(M.inverse().block<6, 6>(2, 2));
+    // Only the stress block of the inverse Jacobian is required for the tangent
+    Eigen::Matrix<double, 16, 6> unit_columns = Eigen::Matrix<double, 16, 6>::Zero();
+    unit_columns.block<6, 6>(2, 0) = matrix6::Identity();
+
+    matrix6 const dsigma_deps = lu.solve(unit_columns).block<6, 6>(2, 0);
+
+    tangent_operator = (1.0 - scalar_damage) * mandel_notation(C_e) * mandel_notation(dsigma_deps);
 
     return y(0) * delta_t; // plastic_increment
 }
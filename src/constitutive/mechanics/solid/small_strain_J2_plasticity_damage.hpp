@@ -35,6 +35,10 @@ public:
     */
     void update_internal_variables(double const time_step_size) override;
 
+    /// Recompute the von Mises stress of the effective stress and the energy
+    /// release rate from the stored state
+    void update_derived_variables() override;
+
     material_property const& intrinsic_material() const override { return material; }
 
     virtual bool is_finite_deformation() const override { return false; }
@@ -60,20 +60,12 @@ enum class vector : short {
 
 /// Second order tensor internal variables types
 enum class second : short {
-    /// Cauchy stress
-    cauchy_stress,
     /// Kirchhoff stress
     kirchhoff_stress,
     /// First Piola-Kirchhoff stress (PK1)
     piola_kirchhoff1,
     /// Second Piola-Kirchhoff stress (PK2)
     piola_kirchhoff2,
-    /// Linearised (infinitesimal) total strain
-    linearised_strain,
-    /// Linearised (infinitesimal) plastic strain
-    linearised_plastic_strain,
-    /// Hencky elastic strain
-    hencky_strain_elastic,
     /// Deformation gradient (F)
     deformation_gradient,
     /// Plastic deformation gradient (Fp)
@@ -82,10 +74,6 @@ enum class second : short {
     displacement_gradient,
     /// Green-Lagrange strain (E)
     green_lagrange,
-    /// Back stress (for hardening)
-    back_stress,
-    /// Kinematic hardening
-    kinematic_hardening,
     /// Conductivity tensor
     conductivity,
     /// Beam bending stiffness
@@ -94,11 +82,35 @@ enum class second : short {
     shear_stiffness
 };
 
+/// Symmetric second order tensor internal variables types stored in Voigt
+/// notation with the independent components only
+enum class symmetric : short {
+    /// Cauchy stress
+    cauchy_stress,
+    /// Linearised (infinitesimal) total strain
+    linearised_strain,
+    /// Linearised (infinitesimal) plastic strain
+    linearised_plastic_strain,
+    /// Hencky elastic strain
+    hencky_strain_elastic,
+    /// Back stress (for hardening)
+    back_stress,
+    /// Kinematic hardening
+    kinematic_hardening
+};
+
 /// Fourth order tensor types
 enum class fourth : short {
     /// Material tangent operator
     tangent_operator
 };
 
-using types = std::variant<scalar, vector, second, fourth, nodal>;
+/// Fourth order tensor types with major symmetry stored in Voigt notation
+/// with the upper triangle only
+enum class major_symmetric : short {
+    /// Material tangent operator of a model with a symmetric tangent
+    tangent_operator
+};
+
+using types = std::variant<scalar, vector, second, symmetric, fourth, major_symmetric, nodal>;
 }
@@ -0,0 +1,64 @@
+
+#include "io/binary_archive.hpp"
+
+#include "telemetry.hpp"
+
+#include <cstdio>
+#include <fstream>
+#include <stdexcept>
+
+namespace neon::io
+{
+void binary_output_archive::save(std::string const& file_name) const
+{
+    auto const temporary_file_name = file_name + ".tmp";
+
+    {
+        std::ofstream file(temporary_file_name, std::ios::binary | std::ios::trunc);
+
+        file.write(buffer.data(), buffer.size());
+
+        if (!file)
+        {
+            throw std::domain_error("Unable to write " + temporary_file_name + " to disk");
+        }
+    }
+
+    if (std::rename(temporary_file_name.c_str(), file_name.c_str()) != 0)
+    {
+        throw std::domain_error("Unable to rename " + temporary_file_name + " to " + file_name);
+    }
+    telemetry::count("Bytes written", buffer.size());
+}
+
+binary_input_archive::binary_input_archive(std::string const& file_name)
+{
+    std::ifstream file(file_name, std::ios::binary | std::ios::ate);
+
+    if (!file.is_open())
+    {
+        throw std::domain_error("Unable to open " + file_name);
+    }
+
+    buffer.resize(file.tellg());
+
+    file.seekg(0);
+    file.read(buffer.data(), buffer.size());
+
+    if (!file)
+    {
+        throw std::domain_error("Unable to read " + file_name);
+    }
+}
+
+void binary_input_archive::extract(void* const data, std::size_t const bytes)
+{
+    if (position + bytes > buffer.size())
+    {
+        throw std::domain_error("Unexpected end of the binary archive");
+    }
+    std::memcpy(data, buffer.data() + position, bytes);
+
+    position += bytes;
+}
+}
@@ -0,0 +1,173 @@
+
+#pragma once
+
+#include <Eigen/Core>
+
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <tuple>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+/// \file binary_archive.hpp
+
+namespace neon::io
+{
+/// binary_output_archive serialises values, Eigen matrices and standard
+/// containers into a contiguous memory buffer in the native byte order.  The
+/// buffer is written to disk in a single operation so the serialisation can
+/// be decoupled from the file output.
+class binary_output_archive
+{
+public:
+    /// Append an arithmetic or enumeration value
+    template <typename T>
+    std::enable_if_t<std::is_arithmetic_v<T> || std::is_enum_v<T>> write(T const value)
+    {
+        append(&value, sizeof(T));
+    }
+
+    /// Append a dense matrix with the dimensions for dynamic sizes
+    template <typename T, int rows, int cols, int options, int max_rows, int max_cols>
+    void write(Eigen::Matrix<T, rows, cols, options, max_rows, max_cols> const& matrix)
+    {
+        if constexpr (rows == Eigen::Dynamic || cols == Eigen::Dynamic)
+        {
+            write(static_cast<std::int64_t>(matrix.rows()));
+            write(static_cast<std::int64_t>(matrix.cols()));
+        }
+        append(matrix.data(), matrix.size() * sizeof(T));
+    }
+
+    template <typename T>
+    void write(std::vector<T> const& values)
+    {
+        write(static_cast<std::int64_t>(values.size()));
+
+        if constexpr (std::is_arithmetic_v<T>)
+        {
+            append(values.data(), values.size() * sizeof(T));
+        }
+        else
+        {
+            for (auto const& value : values) write(value);
+        }
+    }
+
+    template <typename Key, typename T>
+    void write(std::unordered_map<Key, T> const& map)
+    {
+        write(static_cast<std::int64_t>(map.size()));
+
+        for (auto const& [key, value] : map)
+        {
+            write(key);
+            write(value);
+        }
+    }
+
+    template <typename... Ts>
+    void write(std::tuple<Ts...> const& values)
+    {
+        std::apply([this](auto const&... value) { (write(value), ...); }, values);
+    }
+
+    /// Write the buffer to the file \p file_name.  The file is first written
+    /// to a temporary file and then renamed, such that an interruption while
+    /// writing does not corrupt an existing file.
+    void save(std::string const& file_name) const;
+
+    /// \return the size of the serialised data in bytes
+    [[nodiscard]] auto size() const noexcept { return buffer.size(); }
+
+protected:
+    void append(void const* const data, std::size_t const bytes)
+    {
+        auto const offset = buffer.size();
+        buffer.resize(offset + bytes);
+        std::memcpy(buffer.data() + offset, data, bytes);
+    }
+
+protected:
+    std::vector<char> buffer;
+};
+
+/// binary_input_archive reads the data serialised by binary_output_archive
+/// in the same order that it was written
+class binary_input_archive
+{
+public:
+    /// Read the entire file \p file_name into memory
+    explicit binary_input_archive(std::string const& file_name);
+
+    template <typename T>
+    std::enable_if_t<std::is_arithmetic_v<T> || std::is_enum_v<T>> read(T& value)
+    {
+        extract(&value, sizeof(T));
+    }
+
+    template <typename T, int rows, int cols, int options, int max_rows, int max_cols>
+    void read(Eigen::Matrix<T, rows, cols, options, max_rows, max_cols>& matrix)
+    {
+        if constexpr (rows == Eigen::Dynamic || cols == Eigen::Dynamic)
+        {
+            std::int64_t matrix_rows, matrix_cols;
+            read(matrix_rows);
+            read(matrix_cols);
+            matrix.resize(matrix_rows, matrix_cols);
+        }
+        extract(matrix.data(), matrix.size() * sizeof(T));
+    }
+
+    template <typename T>
+    void read(std::vector<T>& values)
+    {
+        std::int64_t size;
+        read(size);
+
+        values.resize(size);
+
+        if constexpr (std::is_arithmetic_v<T>)
+        {
+            extract(values.data(), values.size() * sizeof(T));
+        }
+        else
+        {
+            for (auto& value : values) read(value);
+        }
+    }
+
+    template <typename Key, typename T>
+    void read(std::unordered_map<Key, T>& map)
+    {
+        std::int64_t size;
+        read(size);
+
+        map.clear();
+
+        for (std::int64_t i{0}; i < size; ++i)
+        {
+            Key key;
+            read(key);
+            read(map[key]);
+        }
+    }
+
+    template <typename... Ts>
+    void read(std::tuple<Ts...>& values)
+    {
+        std::apply([this](auto&... value) { (read(value), ...); }, values);
+    }
+
+protected:
+    /// Copy \p bytes from the buffer and throw if the buffer is exhausted
+    void extract(void* const data, std::size_t const bytes);
+
+protected:
+    std::vector<char> buffer;
+    std::size_t position{0};
+};
+}
@@ -1,8 +1,10 @@
 
 #include "file_output.hpp"
 
+#include "mesh/basic_mesh.hpp"
 #include "mesh/node_ordering_adapter.hpp"
 #include "io/json.hpp"
+#include "telemetry.hpp"
 
 // TODO Remove once the override is fixed upstream
 #ifdef __clang__
@@ -12,7 +14,7 @@
 
 #include "io/vtk_coordinates.hpp"
 
-#include <vtkIdList.h>
+#include <vtkCellData.h>
 #include <vtkDoubleArray.h>
 #include <vtkIdTypeArray.h>
 #include <vtkPointData.h>
@@ -23,6 +25,8 @@
 #endif
 
 #include <boost/filesystem.hpp>
+
+#include <algorithm>
 #include <stdexcept>
 
 namespace neon::io
@@ -42,6 +46,20 @@ file_output::file_output(std::string const& file_name, json const& visualisation
     if (visualisation_data.find("write_every") != visualisation_data.end())
     {
         write_every = visualisation_data["write_every"];
+
+        if (write_every < 1)
+        {
+            throw std::domain_error("\"write_every\" must be greater than zero");
+        }
+    }
+    if (visualisation_data.find("write_interval") != visualisation_data.end())
+    {
+        write_interval = visualisation_data["write_interval"];
+
+        if (write_interval < 0.0)
+        {
+            throw std::domain_error("\"write_interval\" must be positive");
+        }
     }
     if (visualisation_data.find("fields") != visualisation_data.end())
     {
@@ -50,13 +68,147 @@ file_output::file_output(std::string const& file_name, json const& visualisation
             output_variables.insert(field.get<std::string>());
         }
     }
-    else
+    if (visualisation_data.find("quadrature_fields") != visualisation_data.end())
+    {
+        for (auto const& field : visualisation_data["quadrature_fields"])
+        {
+            quadrature_variables.insert(field.get<std::string>());
+        }
+    }
+    if (output_variables.empty() && quadrature_variables.empty())
     {
         std::cout << std::string(4, ' ') << "No outputs were requested.  I find this strange.\n";
     }
+    if (visualisation_data.find("element_sets") != visualisation_data.end())
+    {
+        for (auto const& element_set : visualisation_data["element_sets"])
+        {
+            element_sets.emplace_back(element_set.get<std::string>());
+        }
+        // The quadrature values are only defined for the elements of the mesh
+        if (!quadrature_variables.empty() && !element_sets.empty())
+        {
+            throw std::domain_error("\"quadrature_fields\" cannot be combined with "
+                                    "\"element_sets\"");
+        }
+    }
     boost::filesystem::create_directory(boost::filesystem::path(directory_name));
 }
 
+void file_output::coordinates(matrix const& configuration)
+{
+    if (element_sets.empty())
+    {
+        add_coordinates(configuration);
+        return;
+    }
+    // The output nodes are only known once the element sets are added
+    if (output_nodes.empty())
+    {
+        mesh_configuration = configuration;
+        return;
+    }
+    add_coordinates(configuration(Eigen::all, output_nodes));
+}
+
+void file_output::add_mesh(basic_mesh const& mesh_store, std::vector<std::string> const& names)
+{
+    if (element_sets.empty())
+    {
+        for (auto const& name : names)
+        {
+            for (auto const& submesh : mesh_store.meshes(name))
+            {
+                mesh(submesh.all_node_indices(), submesh.topology());
+            }
+        }
+        return;
+    }
+
+    for (auto const& element_set : element_sets)
+    {
+        if (!mesh_store.has(element_set))
+        {
+            throw std::domain_error("The element set \"" + element_set
+                                    + "\" in \"element_sets\" does not exist in the mesh");
+        }
+    }
+
+    // Collect the nodes of the element sets in ascending order
+    output_nodes.clear();
+
+    for (auto const& element_set : element_sets)
+    {
+        for (auto const& submesh : mesh_store.meshes(element_set))
+        {
+            auto const& nodes = submesh.all_node_indices();
+
+            output_nodes.insert(end(output_nodes), nodes.data(), nodes.data() + nodes.size());
+        }
+    }
+    std::sort(begin(output_nodes), end(output_nodes));
+    output_nodes.erase(std::unique(begin(output_nodes), end(output_nodes)), end(output_nodes));
+
+    // Renumber the connectivity to the position in the output nodes
+    std::vector<std::int64_t> output_index(output_nodes.back() + 1, -1);
+
+    for (std::size_t index{0}; index < output_nodes.size(); ++index)
+    {
+        output_index[output_nodes[index]] = index;
+    }
+
+    for (auto const& element_set : element_sets)
+    {
+        for (auto const& submesh : mesh_store.meshes(element_set))
+        {
+            indices const output_node_indices = submesh.all_node_indices().unaryExpr(
+                [&](auto const node) { return static_cast<std::int32_t>(output_index[node]); });
+
+            mesh(output_node_indices, submesh.topology());
+        }
+    }
+
+    if (mesh_configuration.size() > 0)
+    {
+        add_coordinates(mesh_configuration(Eigen::all, output_nodes));
+        mesh_configuration.resize(0, 0);
+    }
+}
+
+void file_output::field(std::string const& name, vector const& data, std::int64_t const components)
+{
+    if (output_nodes.empty())
+    {
+        add_field(name, data, components);
+        return;
+    }
+
+    vector output_data(output_nodes.size() * components);
+
+    for (std::size_t index{0}; index < output_nodes.size(); ++index)
+    {
+        output_data.segment(index * components, components)
+            = data.segment(output_nodes[index] * components, components);
+    }
+    add_field(name, output_data, components);
+}
+
+bool file_output::is_write_required(std::int32_t const time_step, double const current_time)
+{
+    if (time_step % write_every != 0)
+    {
+        return false;
+    }
+    // Allow for round-off in the accumulated time
+    if (current_time < last_write_time + write_interval * (1.0 - 1.0e-8))
+    {
+        return false;
+    }
+    last_write_time = current_time;
+
+    return true;
+}
+
 bool file_output::is_output_requested(std::string const& name) const
 {
     return output_variables.find(name) != end(output_variables);
@@ -64,8 +216,33 @@ bool file_output::is_output_requested(std::string const& name) const
 
 vtk_file_output::vtk_file_output(std::string const& file_name, json const& visualisation_data)
     : file_output(file_name, visualisation_data),
-      unstructured_mesh(vtkSmartPointer<vtkUnstructuredGrid>::New())
+      unstructured_mesh(vtkSmartPointer<vtkUnstructuredGrid>::New()),
+      points(vtkSmartPointer<vtkPoints>::New()),
+      cells(vtkSmartPointer<vtkCellArray>::New())
 {
+    if (visualisation_data.find("write_queue_size") != visualisation_data.end())
+    {
+        maximum_queue_size = visualisation_data["write_queue_size"];
+
+        if (maximum_queue_size == 0)
+        {
+            throw std::domain_error("\"write_queue_size\" must be greater than zero");
+        }
+    }
+
+    // Keep the entries of an existing time history for a restart
+    {
+        std::ifstream previous_pvd_file(file_name + ".pvd");
+
+        for (std::string line; std::getline(previous_pvd_file, line);)
+        {
+            if (auto const start = line.find("timestep = \""); start != std::string::npos)
+            {
+                previous_entries.emplace_back(std::stod(line.substr(start + 12)), line);
+            }
+        }
+    }
+
     pvd_file.open(file_name + ".pvd");
 
     if (!pvd_file.is_open())
@@ -78,14 +255,21 @@ vtk_file_output::vtk_file_output(std::string const& file_name, json const& visua
     pvd_file << std::string(2, ' ') << "<Collection>\n";
 
     unstructured_mesh->Allocate();
+
+    writer = std::thread(&vtk_file_output::process_queue, this);
 }
 
 vtk_file_output::~vtk_file_output()
 {
-    if (future.valid())
     {
-        future.wait();
+        std::lock_guard<std::mutex> lock(queue_mutex);
+        is_finished = true;
     }
+    queue_condition.notify_all();
+
+    // Flush the remaining snapshots to disk
+    if (writer.joinable()) writer.join();
+
     // close off the last of the file for the time stepping
     pvd_file << std::string(2, ' ') << "</Collection>\n"
              << "</VTKFile>\n";
@@ -94,51 +278,132 @@ vtk_file_output::~vtk_file_output()
 
 void vtk_file_output::write(int const time_step, double const current_time)
 {
-    // wait on previous future
-    if (future.valid())
+    if (is_cell_array_outdated) build_cells();
+
+    auto const vtk_filename = file_name + "_" + std::to_string(time_step) + ".vtu";
+
+    {
+        // Wait for space in the queue to bound the memory of the snapshots
+        std::unique_lock<std::mutex> lock(queue_mutex);
+
+        queue_condition.wait(lock, [this]() {
+            return write_queue.size() < maximum_queue_size || has_failed;
+        });
+
+        if (has_failed) throw std::domain_error("Error in VTK file IO occurred");
+
+        write_queue.push_back({directory_name + "/" + vtk_filename, unstructured_mesh});
+    }
+    queue_condition.notify_all();
+
+    std::cout << "\n"
+              << std::string(4, ' ') << "Writing solution to file for step " << time_step << "\n";
+
+    // Update the pvd file for timestep mapping
+    pvd_file << std::string(4, ' ') << "<DataSet timestep = \"" << std::to_string(current_time)
+             << "\" file = \"" << directory_name << "/" << vtk_filename << "\" />\n";
+
+    // Stage the fields of the next time step in a new snapshot
+    unstructured_mesh = stage_snapshot();
+}
+
+void vtk_file_output::restart(double const time)
+{
+    // Compare with the time as written in the time history
+    auto const restart_time = std::stod(std::to_string(time));
+
+    for (auto const& [entry_time, entry] : previous_entries)
+    {
+        if (entry_time > restart_time) continue;
+
+        pvd_file << entry << "\n";
+
+        last_write_time = std::max(last_write_time, entry_time);
+    }
+    previous_entries.clear();
+}
+
+void vtk_file_output::process_queue()
+{
+    while (true)
     {
-        if (future.wait(); future.get() == 0)
+        snapshot next;
         {
-            throw std::domain_error("Error in VTK file IO occurred");
+            std::unique_lock<std::mutex> lock(queue_mutex);
+
+            queue_condition.wait(lock, [this]() { return !write_queue.empty() || is_finished; });
+
+            if (write_queue.empty()) return;
+
+            next = write_queue.front();
         }
-    }
 
-    future = std::async(std::launch::async, [this, time_step, current_time]() {
         auto unstructured_mesh_writer = vtkSmartPointer<vtkXMLUnstructuredGridWriter>::New();
 
-        auto const vtk_filename = directory_name + "/" + file_name + "_" + std::to_string(time_step)
-                                  + "." + unstructured_mesh_writer->GetDefaultFileExtension();
+        unstructured_mesh_writer->SetFileName(next.file_name.c_str());
+        unstructured_mesh_writer->SetInputData(next.grid);
 
-        std::cout << "\n"
-                  << std::string(4, ' ') << "Writing solution to file for step " << time_step
-                  << "\n";
+        if (!use_binary_format) unstructured_mesh_writer->SetDataModeToAscii();
 
-        unstructured_mesh_writer->SetFileName(vtk_filename.c_str());
-        unstructured_mesh_writer->SetInputData(unstructured_mesh);
+        auto const is_written = unstructured_mesh_writer->Write() != 0;
 
-        if (!use_binary_format) unstructured_mesh_writer->SetDataModeToAscii();
+        if (is_written)
+        {
+            telemetry::count("Bytes written", boost::filesystem::file_size(next.file_name));
+        }
 
-        // Update the pvd file for timestep mapping
-        pvd_file << std::string(4, ' ') << "<DataSet timestep = \"" << std::to_string(current_time)
-                 << "\" file = \"" << directory_name << "/" << file_name << "_"
-                 << std::to_string(time_step) << "."
-                 << unstructured_mesh_writer->GetDefaultFileExtension() << "\" />\n";
+        {
+            std::lock_guard<std::mutex> lock(queue_mutex);
+
+            // Release the snapshot only after writing to bound the memory
+            write_queue.pop_front();
+
+            if (!is_written) has_failed = true;
+        }
+        queue_condition.notify_all();
+    }
+}
+
+void vtk_file_output::build_cells()
+{
+    auto cell_indices = vtkSmartPointer<vtkIdTypeArray>::New();
+
+    cell_indices->SetNumberOfValues(connectivity.size());
+
+    std::copy(begin(connectivity), end(connectivity), cell_indices->GetPointer(0));
+
+    cells = vtkSmartPointer<vtkCellArray>::New();
+    cells->SetCells(cell_types.size(), cell_indices);
+
+    unstructured_mesh->SetCells(cell_types.data(), cells);
+
+    is_cell_array_outdated = false;
+}
+
+vtkSmartPointer<vtkUnstructuredGrid> vtk_file_output::stage_snapshot()
+{
+    auto grid = vtkSmartPointer<vtkUnstructuredGrid>::New();
+
+    grid->SetPoints(points);
 
-        return unstructured_mesh_writer->Write();
-    });
+    // The cell types are copied by VTK and the cell array is shared
+    grid->SetCells(cell_types.data(), cells);
+
+    return grid;
 }
 
-void vtk_file_output::coordinates(matrix const& configuration)
+void vtk_file_output::add_coordinates(matrix const& configuration)
 {
-    auto points = vtkSmartPointer<vtkPoints>::New();
+    points = vtkSmartPointer<vtkPoints>::New();
 
-    points->Allocate(configuration.size() / configuration.rows());
+    points->SetNumberOfPoints(configuration.cols());
 
     for (std::int64_t i{0}; i < configuration.cols(); ++i)
     {
-        points->InsertNextPoint(configuration(0, i),
-                                (configuration.rows() > 1 ? configuration(1, i) : 0.0),
-                                (configuration.rows() > 2 ? configuration(2, i) : 0.0));
+        points->SetPoint(i,
+                         configuration(0, i),
+                         (configuration.rows() > 1 ? configuration(1, i) : 0.0),
+                         (configuration.rows() > 2 ? configuration(2, i) : 0.0));
     }
     unstructured_mesh->SetPoints(points);
 }
@@ -147,37 +412,260 @@ void vtk_file_output::mesh(indices const& all_node_indices, element_topology con
 {
     indices const vtk_node_indices = convert_to_vtk(all_node_indices, topology);
 
+    connectivity.reserve(connectivity.size()
+                         + vtk_node_indices.cols() * (vtk_node_indices.rows() + 1));
+
     for (std::int64_t element{0}; element < vtk_node_indices.cols(); ++element)
     {
-        auto node_indices = vtkSmartPointer<vtkIdList>::New();
+        connectivity.emplace_back(vtk_node_indices.rows());
 
         for (std::int64_t node{0}; node < vtk_node_indices.rows(); ++node)
         {
-            node_indices->InsertNextId(static_cast<std::int64_t>(vtk_node_indices(node, element)));
+            connectivity.emplace_back(vtk_node_indices(node, element));
         }
-        unstructured_mesh->InsertNextCell(to_vtk(topology), node_indices);
     }
+    cell_types.insert(end(cell_types), vtk_node_indices.cols(), to_vtk(topology));
+
+    is_cell_array_outdated = true;
 }
 
-void vtk_file_output::field(std::string const& name,
-                            vector const& field_vector,
-                            std::int64_t const components)
+void vtk_file_output::add_field(std::string const& name,
+                                vector const& field_vector,
+                                std::int64_t const components)
 {
-    if (future.valid())
-    {
-        future.wait();
-    }
+    // The staged snapshot is not shared with the writer thread
+    auto vtk_field = vtkSmartPointer<vtkDoubleArray>::New();
+
+    vtk_field->SetName(name.c_str());
+    vtk_field->SetNumberOfComponents(components);
+    vtk_field->SetNumberOfTuples(field_vector.size() / components);
+
+    std::copy_n(field_vector.data(), field_vector.size(), vtk_field->GetPointer(0));
+
+    unstructured_mesh->GetPointData()->AddArray(vtk_field);
+}
 
+void vtk_file_output::cell_field(std::string const& name,
+                                 vector const& field_vector,
+                                 std::int64_t const components)
+{
     auto vtk_field = vtkSmartPointer<vtkDoubleArray>::New();
 
     vtk_field->SetName(name.c_str());
     vtk_field->SetNumberOfComponents(components);
-    vtk_field->Allocate(field_vector.size() / components);
+    vtk_field->SetNumberOfTuples(field_vector.size() / components);
+
+    std::copy_n(field_vector.data(), field_vector.size(), vtk_field->GetPointer(0));
+
+    unstructured_mesh->GetCellData()->AddArray(vtk_field);
+}
 
-    for (std::int64_t index{0}; index < field_vector.size(); index += components)
+xdmf_file_output::xdmf_file_output(std::string const& file_name, json const& visualisation_data)
+    : file_output(file_name, visualisation_data),
+      binary_file_name(directory_name + "/" + file_name + ".bin")
+{
+    if (visualisation_data.find("precision") != visualisation_data.end())
     {
-        vtk_field->InsertNextTuple(field_vector.data() + index);
+        if (visualisation_data["precision"] != "single"
+            && visualisation_data["precision"] != "double")
+        {
+            throw std::domain_error("\"precision\" must be \"single\" or \"double\"");
+        }
+        use_single_precision = visualisation_data["precision"] == "single";
     }
-    unstructured_mesh->GetPointData()->AddArray(vtk_field);
+
+    xdmf_file.open(file_name + ".xdmf");
+    binary_file.open(binary_file_name, std::ios::binary);
+
+    if (!xdmf_file.is_open() || !binary_file.is_open())
+    {
+        throw std::domain_error("Not able to write to disk for visualisation\n");
+    }
+
+    xdmf_file << "<?xml version=\"1.0\"?>\n";
+    xdmf_file << "<Xdmf Version=\"3.0\">\n";
+    xdmf_file << std::string(2, ' ') << "<Domain>\n";
+    xdmf_file << std::string(4, ' ')
+              << "<Grid Name=\"" << file_name
+              << "\" GridType=\"Collection\" CollectionType=\"Temporal\">\n";
+}
+
+xdmf_file_output::~xdmf_file_output()
+{
+    // close off the last of the file for the time stepping
+    xdmf_file << std::string(4, ' ') << "</Grid>\n"
+              << std::string(2, ' ') << "</Domain>\n"
+              << "</Xdmf>\n";
+    xdmf_file.close();
+    binary_file.close();
+}
+
+void xdmf_file_output::write(int const time_step, double const current_time)
+{
+    // The topology is written once after all meshes have been added
+    if (topology_offset < 0)
+    {
+        topology_offset = append(connectivity.data(), connectivity.size());
+    }
+
+    std::cout << "\n"
+              << std::string(4, ' ') << "Writing solution to file for step " << time_step << "\n";
+
+    xdmf_file << std::string(6, ' ') << "<Grid Name=\"step_" << time_step
+              << "\" GridType=\"Uniform\">\n";
+
+    xdmf_file << std::string(8, ' ') << "<Time Value=\"" << std::to_string(current_time) << "\"/>\n";
+
+    xdmf_file << std::string(8, ' ') << "<Topology TopologyType=\"Mixed\" NumberOfElements=\""
+              << number_of_elements << "\">\n"
+              << data_item(std::to_string(connectivity.size()), "Int", 8, topology_offset)
+              << std::string(8, ' ') << "</Topology>\n";
+
+    xdmf_file << std::string(8, ' ') << "<Geometry GeometryType=\"XYZ\">\n"
+              << data_item(std::to_string(number_of_nodes) + " 3", "Float", 8, geometry_offset)
+              << std::string(8, ' ') << "</Geometry>\n";
+
+    xdmf_file << staged_attributes;
+
+    xdmf_file << std::string(6, ' ') << "</Grid>\n";
+
+    // Keep the binary data consistent with the index on disk
+    binary_file.flush();
+    xdmf_file.flush();
+
+    staged_attributes.clear();
+}
+
+void xdmf_file_output::restart(double const) {}
+
+void xdmf_file_output::add_coordinates(matrix const& configuration)
+{
+    number_of_nodes = configuration.cols();
+
+    matrix3x points = matrix3x::Zero(3, number_of_nodes);
+
+    points.topRows(std::min(configuration.rows(), std::int64_t{3}))
+        = configuration.topRows(std::min(configuration.rows(), std::int64_t{3}));
+
+    geometry_offset = append(points.data(), points.size());
+}
+
+void xdmf_file_output::mesh(indices const& all_node_indices, element_topology const topology)
+{
+    if (topology_offset >= 0)
+    {
+        throw std::domain_error("The mesh topology cannot be changed after the first write");
+    }
+
+    indices const xdmf_node_indices = convert_to_vtk(all_node_indices, topology);
+
+    auto const cell_type = to_xdmf(topology);
+
+    // Polylines require the number of nodes after the cell type
+    auto const cell_size = xdmf_node_indices.rows() + (cell_type == 2 ? 2 : 1);
+
+    connectivity.reserve(connectivity.size() + xdmf_node_indices.cols() * cell_size);
+
+    for (std::int64_t element{0}; element < xdmf_node_indices.cols(); ++element)
+    {
+        connectivity.emplace_back(cell_type);
+
+        if (cell_type == 2) connectivity.emplace_back(xdmf_node_indices.rows());
+
+        for (std::int64_t node{0}; node < xdmf_node_indices.rows(); ++node)
+        {
+            connectivity.emplace_back(xdmf_node_indices(node, element));
+        }
+    }
+    number_of_elements += xdmf_node_indices.cols();
+}
+
+void xdmf_file_output::add_field(std::string const& name,
+                                 vector const& field_vector,
+                                 std::int64_t const components)
+{
+    staged_attributes += attribute(name, "Node", field_vector, components);
+}
+
+void xdmf_file_output::cell_field(std::string const& name,
+                                  vector const& field_vector,
+                                  std::int64_t const components)
+{
+    staged_attributes += attribute(name, "Cell", field_vector, components);
+}
+
+std::string xdmf_file_output::attribute(std::string const& name,
+                                        std::string const& center,
+                                        vector const& field_vector,
+                                        std::int64_t const components)
+{
+    auto const tuples = field_vector.size() / components;
+
+    std::int64_t offset{0};
+
+    if (use_single_precision)
+    {
+        Eigen::VectorXf const single_precision_field = field_vector.cast<float>();
+
+        offset = append(single_precision_field.data(), single_precision_field.size());
+    }
+    else
+    {
+        offset = append(field_vector.data(), field_vector.size());
+    }
+
+    auto const attribute_type = [components]() -> std::string {
+        switch (components)
+        {
+            case 1:
+                return "Scalar";
+            case 3:
+                return "Vector";
+            case 6:
+                return "Tensor6";
+            case 9:
+                return "Tensor";
+        }
+        return "Matrix";
+    }();
+
+    return std::string(8, ' ') + "<Attribute Name=\"" + name + "\" AttributeType=\""
+           + attribute_type + "\" Center=\"" + center + "\">\n"
+           + data_item(std::to_string(tuples) + " " + std::to_string(components),
+                       "Float",
+                       use_single_precision ? 4 : 8,
+                       offset)
+           + std::string(8, ' ') + "</Attribute>\n";
+}
+
+template <typename T>
+std::int64_t xdmf_file_output::append(T const* const data, std::int64_t const size)
+{
+    auto const offset = binary_offset;
+
+    binary_file.write(reinterpret_cast<char const*>(data), size * sizeof(T));
+
+    if (!binary_file)
+    {
+        throw std::domain_error("Error in XDMF file IO occurred");
+    }
+
+    binary_offset += size * sizeof(T);
+
+    telemetry::count("Bytes written", size * sizeof(T));
+
+    return offset;
+}
+
+std::string xdmf_file_output::data_item(std::string const& dimensions,
+                                        std::string const& number_type,
+                                        std::int64_t const precision,
+                                        std::int64_t const offset) const
+{
+    // The binary file is relative to the location of the index file
+    return std::string(10, ' ') + "<DataItem Dimensions=\"" + dimensions + "\" NumberType=\""
+           + number_type + "\" Precision=\"" + std::to_string(precision)
+           + "\" Format=\"Binary\" Endian=\"Native\" Seek=\"" + std::to_string(offset) + "\">"
+           + binary_file_name + "</DataItem>\n";
 }
 }
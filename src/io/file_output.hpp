@@ -7,12 +7,26 @@
 
 #include "io/json_forward.hpp"
 
+#include <vtkCellArray.h>
+#include <vtkPoints.h>
 #include <vtkSmartPointer.h>
 #include <vtkUnstructuredGrid.h>
 
-#include <future>
+#include <condition_variable>
+#include <deque>
+#include <fstream>
+#include <limits>
+#include <mutex>
 #include <set>
 #include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace neon
+{
+class basic_mesh;
+}
 
 namespace neon::io
 {
@@ -24,25 +38,63 @@ public:
     /// Virtual destructor to finish writing out the time step mapping
     virtual ~file_output() = default;
 
-    /// Add coordinates to the file output set
-    virtual void coordinates(matrix const& configuration) = 0;
+    /// Add coordinates to the file output set.  Only the nodes of the element
+    /// sets are written if element sets are requested
+    void coordinates(matrix const& configuration);
 
     /// Add mesh information to the file output set
     virtual void mesh(indices const& all_node_indices, element_topology const topology) = 0;
 
+    /// Add the element groups with the \p names to the file output set, or
+    /// the element groups of the requested element sets instead.  The nodes
+    /// of the element sets are renumbered consecutively
+    void add_mesh(basic_mesh const& mesh_store, std::vector<std::string> const& names);
+
     /// Write out to file in the format specified
     virtual void write(int const time_step, double const total_time) = 0;
 
+    /// Keep the time steps written up to \p time by an earlier run when the
+    /// solution is restarted from a checkpoint at \p time
+    virtual void restart(double const time) = 0;
+
     /// Add the field to the output field with
     /// \param name Field name
-    /// \param data Flat vector of encoded data
+    /// \param data Flat vector of encoded data for every node of the mesh
     /// \param components Number of components encoded in the field
-    virtual void field(std::string const& name, vector const& data, std::int64_t const components) = 0;
+    void field(std::string const& name, vector const& data, std::int64_t const components);
+
+    /// Add the field to the output cells with
+    /// \param name Field name
+    /// \param data Flat vector of encoded data for each cell
+    /// \param components Number of components encoded for each cell
+    virtual void cell_field(std::string const& name,
+                            vector const& data,
+                            std::int64_t const components) = 0;
+
+    /// Check the output frequency in time steps and in time.  The time of the
+    /// output is recorded if the time step is to be written
+    /// \return true if the time step should be written
+    [[nodiscard]] bool is_write_required(std::int32_t const time_step, double const current_time);
 
     [[nodiscard]] bool is_output_requested(std::string const& name) const;
 
     [[nodiscard]] std::set<std::string> outputs() const noexcept { return output_variables; }
 
+    /// \return the variables requested at the quadrature points
+    [[nodiscard]] std::set<std::string> quadrature_outputs() const noexcept
+    {
+        return quadrature_variables;
+    }
+
+protected:
+    /// Add the coordinates of the output nodes in the format specified
+    virtual void add_coordinates(matrix const& configuration) = 0;
+
+    /// Add the nodal field of the output nodes in the format specified
+    virtual void add_field(std::string const& name,
+                           vector const& data,
+                           std::int64_t const components) = 0;
+
 protected:
     /// Directory to store visualisation output
     std::string const directory_name{"visualisation"};
@@ -50,13 +102,28 @@ protected:
     std::string file_name;
     /// Requested variables from the input file
     std::set<std::string> output_variables;
+    /// Requested variables at the quadrature points from the input file
+    std::set<std::string> quadrature_variables;
+    /// Element sets to write out instead of the entire mesh
+    std::vector<std::string> element_sets;
+    /// Mesh nodes used by the element sets in the output order
+    std::vector<std::int64_t> output_nodes;
+    /// Coordinates of every mesh node until the element sets are added
+    matrix mesh_configuration;
     /// Time steps to write out (e.g. two is every second time step)
     int write_every{1};
+    /// Minimum time between the outputs
+    double write_interval{0.0};
+    /// Time of the last output
+    double last_write_time{-std::numeric_limits<double>::max()};
 };
 
-// vtk_file_output output should be asynchronous as these operations are
-// typically expensive.  For the asynchronous aspect - the file_output class
-// should take the vtk object to write out while the computation continues.
+/// vtk_file_output writes the unstructured mesh and fields in the VTK XML
+/// format.  The fields for a time step are staged in a snapshot of the mesh
+/// and write() hands the snapshot to a background writer thread through a
+/// bounded queue.  A new snapshot sharing the points and cells is staged for
+/// the next time step, such that file output overlaps with the computation
+/// and only blocks when the queue is full.
 class vtk_file_output : public io::file_output
 {
 public:
@@ -67,24 +134,151 @@ public:
     /// Write out to file
     virtual void write(int const time_step, double const total_time) override final;
 
-    virtual void coordinates(matrix const& configuration) override final;
+    /// Add the time step mapping entries of the earlier run up to \p time
+    virtual void restart(double const time) override final;
 
     /// Add mesh information to the file output set
     virtual void mesh(indices const& all_node_indices, element_topology const topology) override final;
 
-    virtual void field(std::string const& name,
-                       vector const& data,
-                       std::int64_t const components) override final;
+    virtual void cell_field(std::string const& name,
+                            vector const& data,
+                            std::int64_t const components) override final;
+
+protected:
+    virtual void add_coordinates(matrix const& configuration) override final;
+
+    virtual void add_field(std::string const& name,
+                           vector const& data,
+                           std::int64_t const components) override final;
+
+private:
+    /// Mesh snapshot with the file name to write
+    struct snapshot
+    {
+        std::string file_name;
+        vtkSmartPointer<vtkUnstructuredGrid> grid;
+    };
+
+    /// Write the queued snapshots until finished
+    void process_queue();
+
+    /// Build the cell array from the staged connectivity
+    void build_cells();
+
+    /// \return a new mesh snapshot sharing the points and the cells
+    vtkSmartPointer<vtkUnstructuredGrid> stage_snapshot();
 
 private:
-    /// Holds one if successful and zero otherwise.  Use this to perform the
-    /// io without blocking computation
-    std::future<int> future;
-    /// VTK representation of mesh
+    /// VTK representation of mesh staged for the next write
     vtkSmartPointer<vtkUnstructuredGrid> unstructured_mesh;
+    /// Coordinates shared between snapshots
+    vtkSmartPointer<vtkPoints> points;
+    /// Cells shared between snapshots
+    vtkSmartPointer<vtkCellArray> cells;
+    /// Cell connectivity in the VTK layout (nodes followed by the node indices)
+    std::vector<vtkIdType> connectivity;
+    /// VTK cell type for each cell
+    std::vector<int> cell_types;
+    /// Flag if the cells need to be rebuilt
+    bool is_cell_array_outdated{false};
+
     /// Default to using binary VTK output for efficiency
     bool use_binary_format{true};
     /// Stream for writing time history
     std::ofstream pvd_file;
+    /// Time and entry of each time step in an existing time history
+    std::vector<std::pair<double, std::string>> previous_entries;
+
+    /// Snapshots waiting to be written
+    std::deque<snapshot> write_queue;
+    /// Maximum number of snapshots waiting to be written
+    std::size_t maximum_queue_size{2};
+    /// Flag to finish the writer thread
+    bool is_finished{false};
+    /// Flag if the writer thread encountered an error
+    bool has_failed{false};
+
+    std::mutex queue_mutex;
+    std::condition_variable queue_condition;
+
+    /// Background thread for the file output
+    std::thread writer;
+};
+
+/// xdmf_file_output writes the results as an XDMF index with the heavy data
+/// appended to a single binary file.  The mesh topology and the coordinates
+/// are written once and each time step only appends the requested fields,
+/// optionally in single precision, avoiding the duplication of the mesh in
+/// every time step.
+class xdmf_file_output : public io::file_output
+{
+public:
+    explicit xdmf_file_output(std::string const& file_name, json const& visualisation_data);
+
+    virtual ~xdmf_file_output();
+
+    /// Write out to file
+    virtual void write(int const time_step, double const total_time) override final;
+
+    /// The binary data of the earlier run is not kept and the index restarts
+    virtual void restart(double const time) override final;
+
+    /// Add mesh information to the file output set
+    virtual void mesh(indices const& all_node_indices, element_topology const topology) override final;
+
+    virtual void cell_field(std::string const& name,
+                            vector const& data,
+                            std::int64_t const components) override final;
+
+protected:
+    virtual void add_coordinates(matrix const& configuration) override final;
+
+    virtual void add_field(std::string const& name,
+                           vector const& data,
+                           std::int64_t const components) override final;
+
+private:
+    /// \return the XML attribute for the data
+    std::string attribute(std::string const& name,
+                          std::string const& center,
+                          vector const& data,
+                          std::int64_t const components);
+
+    /// Append the data to the binary file
+    /// \return the offset in bytes of the data in the binary file
+    template <typename T>
+    std::int64_t append(T const* const data, std::int64_t const size);
+
+    /// \return the XML data item for binary data at the \p offset
+    std::string data_item(std::string const& dimensions,
+                          std::string const& number_type,
+                          std::int64_t const precision,
+                          std::int64_t const offset) const;
+
+private:
+    /// Stream for the XDMF index
+    std::ofstream xdmf_file;
+    /// Stream for the binary data
+    std::ofstream binary_file;
+    /// Name of the binary file relative to the index
+    std::string binary_file_name;
+    /// Current size of the binary file
+    std::int64_t binary_offset{0};
+
+    /// Write the fields in single precision
+    bool use_single_precision{false};
+
+    /// Cell types followed by the node indices (mixed topology)
+    std::vector<std::int64_t> connectivity;
+    std::int64_t number_of_elements{0};
+    /// Binary file offset of the topology or -1 if not written
+    std::int64_t topology_offset{-1};
+
+    std::int64_t number_of_nodes{0};
+    /// Binary file offset of the coordinates
+    std::int64_t geometry_offset{0};
+
+    /// Attributes for the current time step
+    std::string staged_attributes;
 };
 }
@@ -0,0 +1,25 @@
+
+#include "io/file_output_factory.hpp"
+#include "io/json.hpp"
+
+namespace neon::io
+{
+std::unique_ptr<file_output> make_file_output(std::string const& file_name,
+                                              json const& visualisation_data)
+{
+    if (visualisation_data.find("format") == visualisation_data.end()
+        || visualisation_data["format"] == "vtk")
+    {
+        return std::make_unique<vtk_file_output>(file_name, visualisation_data);
+    }
+    else if (visualisation_data["format"] == "xdmf")
+    {
+        return std::make_unique<xdmf_file_output>(file_name, visualisation_data);
+    }
+
+    throw std::domain_error("A valid visualisation format was not specified.  Valid formats are "
+                            "\"vtk\" and \"xdmf\"");
+
+    return nullptr;
+}
+}
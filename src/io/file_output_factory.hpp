@@ -0,0 +1,15 @@
+
+#pragma once
+
+#include "io/file_output.hpp"
+#include "io/json_forward.hpp"
+
+#include <memory>
+
+namespace neon::io
+{
+/// Create the file output for the \p "format" in the visualisation data
+/// where the default is the VTK format
+std::unique_ptr<file_output> make_file_output(std::string const& file_name,
+                                              json const& visualisation_data);
+}
@@ -2,11 +2,74 @@
 #pragma once
 
 #include "numeric/dense_matrix.hpp"
+#include "numeric/index_types.hpp"
+
+#include <tbb/parallel_for.h>
+
+#include <string>
+#include <utility>
 
 /// \file node_averaged_variable.hpp
 
 namespace neon
 {
+/// Extrapolate the quadrature point values of each element to its nodes and
+/// accumulate the nodal values.  The local extrapolation is performed in
+/// parallel over the elements and the accumulation into the nodal vector is
+/// performed afterwards to avoid write conflicts.
+/// \tparam components Number of components for each quadrature point value
+/// \param extrapolation Local extrapolation matrix (nodes by quadrature points)
+/// \param node_indices Nodal connectivity (nodes by elements)
+/// \param nodes Total number of nodes in the mesh
+/// \param quadrature_value Function returning the row vector of components
+///        for an element and quadrature point
+/// \return the accumulated nodal values and the insertion count
+template <int components, typename function_type>
+std::pair<vector, vector> extrapolate_to_nodes(matrix const& extrapolation,
+                                               indices const& node_indices,
+                                               std::int64_t const nodes,
+                                               function_type&& quadrature_value)
+{
+    using component_matrix = Eigen::Matrix<double,
+                                           Eigen::Dynamic,
+                                           components,
+                                           components == 1 ? Eigen::ColMajor : Eigen::RowMajor>;
+
+    auto const elements = node_indices.cols();
+    auto const element_nodes = extrapolation.rows();
+
+    // Element nodal values with the components of each node stored contiguously
+    col_matrix element_values(element_nodes * components, elements);
+
+    tbb::parallel_for(std::int64_t{0}, elements, [&](auto const element) {
+        component_matrix values(extrapolation.cols(), components);
+
+        for (std::int64_t l{0}; l < extrapolation.cols(); ++l)
+        {
+            values.row(l) = quadrature_value(element, l);
+        }
+        Eigen::Map<component_matrix>(element_values.col(element).data(), element_nodes, components)
+            = extrapolation * values;
+    });
+
+    vector value = vector::Zero(nodes * components);
+    vector count = vector::Zero(nodes * components);
+
+    for (std::int64_t element{0}; element < elements; ++element)
+    {
+        for (std::int64_t n{0}; n < element_nodes; ++n)
+        {
+            auto const node = node_indices(n, element);
+
+            value.template segment<components>(node * components)
+                += element_values.col(element).template segment<components>(n * components);
+
+            count.template segment<components>(node * components).array() += 1.0;
+        }
+    }
+    return {value, count};
+}
+
 /// Interpolate the internal variables to the mesh nodes and perform an
 /// unweighted average.
 template <typename mesh_type, typename enum_type>
@@ -0,0 +1,119 @@
+
+#pragma once
+
+#include "constitutive/variable_types.hpp"
+#include "numeric/dense_matrix.hpp"
+#include "numeric/tensor_operations.hpp"
+
+#include <tbb/parallel_for.h>
+
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+
+/// \file quadrature_variables.hpp
+
+namespace neon
+{
+/// Gather the internal variables at the quadrature points of each element
+/// without extrapolation or averaging.  The values of an element are stored
+/// contiguously with the tensor components in row major order.  Symmetric
+/// tensors stored in Voigt notation are expanded to all tensor components.
+/// \return the element values and the number of values for each element
+template <typename mesh_type, typename enum_type>
+std::pair<vector, std::int64_t> quadrature_internal_variable(mesh_type const& submeshes,
+                                                             std::string const& variable_name,
+                                                             enum_type const variable_enum)
+{
+    using value_type = std::decay_t<
+        decltype(submeshes.front().internal_variables().get(variable_enum).front())>;
+
+    bool constexpr is_packed = std::is_same_v<enum_type, variable::symmetric>;
+
+    // Tensor dimension of a symmetric tensor in Voigt notation
+    int constexpr packed_dimension = [] {
+        if constexpr (is_packed)
+        {
+            return value_type::RowsAtCompileTime == 6 ? 3 : 2;
+        }
+        return 0;
+    }();
+
+    std::int64_t constexpr components = [] {
+        if constexpr (std::is_arithmetic_v<value_type>)
+        {
+            return 1;
+        }
+        else if constexpr (is_packed)
+        {
+            return packed_dimension * packed_dimension;
+        }
+        else
+        {
+            return value_type::RowsAtCompileTime * value_type::ColsAtCompileTime;
+        }
+    }();
+
+    std::int64_t elements{0}, quadrature_points{0};
+
+    for (auto const& submesh : submeshes)
+    {
+        if (!submesh.internal_variables().has(variable_enum))
+        {
+            throw std::domain_error("Internal variable " + variable_name
+                                    + " does not exist in mesh");
+        }
+
+        auto const points = submesh.internal_variables().get(variable_enum).size()
+                            / submesh.elements();
+
+        if (quadrature_points != 0 && points != quadrature_points)
+        {
+            throw std::domain_error("Quadrature output of " + variable_name
+                                    + " requires the same number of quadrature points in each "
+                                      "element group");
+        }
+        quadrature_points = points;
+        elements += submesh.elements();
+    }
+
+    vector values(elements * quadrature_points * components);
+
+    std::int64_t offset{0};
+
+    for (auto const& submesh : submeshes)
+    {
+        auto const& variable_list = submesh.internal_variables().get(variable_enum);
+
+        tbb::parallel_for(std::size_t{0}, variable_list.size(), [&](auto const i) {
+            if constexpr (std::is_arithmetic_v<value_type>)
+            {
+                values(offset + i) = variable_list[i];
+            }
+            else if constexpr (is_packed)
+            {
+                using row_major_type = Eigen::Matrix<double,
+                                                     packed_dimension,
+                                                     packed_dimension,
+                                                     Eigen::RowMajor>;
+
+                Eigen::Map<row_major_type>(values.data() + offset + i * components)
+                    = voigt::kinetic::view(variable_list[i]);
+            }
+            else
+            {
+                using row_major_type = Eigen::Matrix<double,
+                                                     value_type::RowsAtCompileTime,
+                                                     value_type::ColsAtCompileTime,
+                                                     Eigen::RowMajor>;
+
+                Eigen::Map<row_major_type>(values.data() + offset + i * components)
+                    = variable_list[i];
+            }
+        });
+        offset += variable_list.size() * components;
+    }
+    return {values, quadrature_points * components};
+}
+}
@@ -81,7 +81,7 @@ types convert(std::string const& name)
     }
     else if (name == "cauchy_stress")
     {
-        return second::cauchy_stress;
+        return symmetric::cauchy_stress;
     }
     else if (name == "kirchhoff_stress")
     {
@@ -89,15 +89,15 @@ types convert(std::string const& name)
     }
     else if (name == "linearised_strain")
     {
-        return second::linearised_strain;
+        return symmetric::linearised_strain;
     }
     else if (name == "linearised_plastic_strain")
     {
-        return second::linearised_plastic_strain;
+        return symmetric::linearised_plastic_strain;
     }
     else if (name == "hencky_strain_elastic")
     {
-        return second::hencky_strain_elastic;
+        return symmetric::hencky_strain_elastic;
     }
     else if (name == "deformation_gradient")
     {
@@ -117,11 +117,11 @@ types convert(std::string const& name)
     }
     else if (name == "back_stress")
     {
-        return second::back_stress;
+        return symmetric::back_stress;
     }
     else if (name == "kinematic_hardening")
     {
-        return second::kinematic_hardening;
+        return symmetric::kinematic_hardening;
     }
     else if (name == "conductivity")
     {
@@ -149,7 +149,7 @@ types convert(std::string const& name)
     }
     throw std::domain_error("Name " + name + " is not a valid output variable name\n");
     // dummy return
-    return second::cauchy_stress;
+    return symmetric::cauchy_stress;
 }
 
 char const* convert(variable::scalar value)
@@ -218,9 +218,6 @@ char const* convert(variable::second value)
 {
     switch (value)
     {
-        case variable::second::cauchy_stress:
-            return "cauchy_stress";
-            break;
         case variable::second::kirchhoff_stress:
             return "kirchhoff_stress";
             break;
@@ -230,15 +227,6 @@ char const* convert(variable::second value)
         case variable::second::piola_kirchhoff2:
             return "piola_kirchhoff2";
             break;
-        case variable::second::linearised_strain:
-            return "linearised_strain";
-            break;
-        case variable::second::linearised_plastic_strain:
-            return "linearised_plastic_strain";
-            break;
-        case variable::second::hencky_strain_elastic:
-            return "hencky_strain_elastic";
-            break;
         case variable::second::deformation_gradient:
             return "deformation_gradient";
             break;
@@ -251,12 +239,6 @@ char const* convert(variable::second value)
         case variable::second::green_lagrange:
             return "green_lagrange";
             break;
-        case variable::second::back_stress:
-            return "back_stress";
-            break;
-        case variable::second::kinematic_hardening:
-            return "kinematic_hardening";
-            break;
         case variable::second::conductivity:
             return "conductivity";
             break;
@@ -269,4 +251,30 @@ char const* convert(variable::second value)
     }
     return "\0";
 }
+
+char const* convert(variable::symmetric value)
+{
+    switch (value)
+    {
+        case variable::symmetric::cauchy_stress:
+            return "cauchy_stress";
+            break;
+        case variable::symmetric::linearised_strain:
+            return "linearised_strain";
+            break;
+        case variable::symmetric::linearised_plastic_strain:
+            return "linearised_plastic_strain";
+            break;
+        case variable::symmetric::hencky_strain_elastic:
+            return "hencky_strain_elastic";
+            break;
+        case variable::symmetric::back_stress:
+            return "back_stress";
+            break;
+        case variable::symmetric::kinematic_hardening:
+            return "kinematic_hardening";
+            break;
+    }
+    return "\0";
+}
 }
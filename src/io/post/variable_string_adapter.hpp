@@ -15,4 +15,6 @@ types convert(std::string const& name);
 char const* convert(variable::scalar);
 /// \return convert a second order tensor enum to a string
 char const* convert(variable::second);
+/// \return convert a symmetric second order tensor enum to a string
+char const* convert(variable::symmetric);
 }
@@ -28,4 +28,9 @@ std::vector<basic_submesh> const& basic_mesh::meshes(std::string const& name) co
     }
     return found->second;
 }
+
+bool basic_mesh::has(std::string const& name) const
+{
+    return meshes_map.find(name) != meshes_map.end();
+}
 }
@@ -20,6 +20,9 @@ public:
     /// \return mesh matching a specific name
     [[nodiscard]] std::vector<basic_submesh> const& meshes(std::string const& name) const;
 
+    /// \return true if a mesh with the \p name exists
+    [[nodiscard]] bool has(std::string const& name) const;
+
 protected:
     std::map<std::string, std::vector<basic_submesh>> meshes_map;
 };
@@ -0,0 +1,28 @@
+
+#pragma once
+
+#include "mesh/boundary/dirichlet.hpp"
+
+#include <map>
+#include <string>
+#include <vector>
+
+namespace neon
+{
+/// load_case holds the boundary conditions of one of the independent load
+/// cases applied to the same mesh.  These are applied in addition to the
+/// boundary conditions common to every load case
+/// \sa mechanics::load_case_matrix
+template <typename nonfollower_load_type>
+struct load_case
+{
+    /// Name of the load case for the output
+    std::string name;
+
+    /// Displacement boundary conditions
+    std::map<std::string, std::vector<dirichlet>> dirichlet_boundaries;
+
+    /// Nonfollower (force) boundary conditions
+    std::map<std::string, nonfollower_load_type> nonfollower_boundaries;
+};
+}
@@ -1,6 +1,7 @@
 
 #include "neumann.hpp"
 
+#include <algorithm>
 #include <utility>
 
 namespace neon
@@ -29,4 +30,28 @@ neumann::neumann(indices node_indices,
       coordinates{coordinates}
 {
 }
+
+std::pair<std::vector<std::int32_t>, vector> neumann::assemble_reference_load() const
+{
+    std::vector<std::int32_t> unique_dofs(dof_indices.data(),
+                                          dof_indices.data() + dof_indices.size());
+
+    std::sort(begin(unique_dofs), end(unique_dofs));
+    unique_dofs.erase(std::unique(begin(unique_dofs), end(unique_dofs)), end(unique_dofs));
+
+    vector reference_load = vector::Zero(unique_dofs.size());
+
+    for (std::int64_t element{0}; element < elements(); ++element)
+    {
+        auto const [dofs, f_ext] = reference_external_force(element);
+
+        for (std::int64_t a{0}; a < dofs.size(); ++a)
+        {
+            auto const position = std::lower_bound(begin(unique_dofs), end(unique_dofs), dofs(a));
+
+            reference_load(std::distance(begin(unique_dofs), position)) += f_ext(a);
+        }
+    }
+    return {std::move(unique_dofs), std::move(reference_load)};
+}
 }
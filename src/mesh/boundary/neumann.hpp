@@ -7,6 +7,8 @@
 #include "mesh/material_coordinates.hpp"
 
 #include <memory>
+#include <utility>
+#include <vector>
 
 namespace neon
 {
@@ -52,6 +54,12 @@ public:
         return node_indices(Eigen::all, element);
     }
 
+    /// Assemble the element external force vectors for a unit load over the
+    /// boundary.  Loads computed in the initial configuration do not change
+    /// shape with the load history and this vector only requires scaling.
+    /// \return unique degrees of freedom and the reference load vector
+    [[nodiscard]] std::pair<std::vector<std::int32_t>, vector> assemble_reference_load() const;
+
 protected:
     /// Indices for the nodal coordinates
     indices node_indices;
@@ -99,13 +107,11 @@ public:
     surface_load(surface_load&& other) = default;
     surface_load& operator=(surface_load const&) = default;
 
-    /// Compute the external force due to a neumann type boundary condition.
-    /// This computes the following integral on a boundary element
+    /// Compute the external force due to a neumann type boundary condition
+    /// for a unit load.  This computes the following integral on a boundary element
     /// \param element Surface element to compute external force on
-    /// \param load_factor Load factor to interpolate load with
     /// \return Dof list and a vector for assembly
-    virtual std::pair<index_view, vector> external_force(std::int64_t const element,
-                                                         double const load_factor) const override
+    std::pair<index_view, vector> reference_external_force(std::int64_t const element) const override
     {
         auto const node_view = node_indices(Eigen::all, element);
 
@@ -119,7 +125,7 @@ public:
                                                           return N * jacobian_determinant(X * dN);
                                                       });
 
-        return {dof_indices(Eigen::all, element), interpolate_prescribed_load(load_factor) * f_ext};
+        return {dof_indices(Eigen::all, element), f_ext};
     }
 
 protected:
@@ -166,8 +172,7 @@ public:
 
     volume_load& operator=(volume_load const&) = default;
 
-    virtual std::pair<index_view, vector> external_force(std::int64_t const element,
-                                                         double const load_factor) const override
+    std::pair<index_view, vector> reference_external_force(std::int64_t const element) const override
     {
         auto const node_view = node_indices(Eigen::all, element);
 
@@ -181,7 +186,7 @@ public:
                                                           return N * jacobian_determinant(X * dN);
                                                       });
 
-        return {dof_indices(Eigen::all, element), interpolate_prescribed_load(load_factor) * f_ext};
+        return {dof_indices(Eigen::all, element), f_ext};
     }
 
 protected:
@@ -16,9 +16,17 @@ class vector_contribution : public boundary
 public:
     using boundary::boundary;
 
+    /// \return element external force vector for a unit load
+    [[nodiscard]] virtual std::pair<index_view, vector> reference_external_force(
+        std::int64_t const element) const = 0;
+
     /// \return element external force vector
-    [[nodiscard]] virtual std::pair<index_view, vector> external_force(
-        std::int64_t const element,
-        double const load_factor) const = 0;
+    [[nodiscard]] std::pair<index_view, vector> external_force(std::int64_t const element,
+                                                              double const load_factor) const
+    {
+        auto const [dofs, f_ext] = reference_external_force(element);
+
+        return {dofs, interpolate_prescribed_load(load_factor) * f_ext};
+    }
 };
 }
@@ -3,13 +3,15 @@
 
 #include "mesh/basic_mesh.hpp"
 #include "mesh/dof_allocator.hpp"
+#include "io/file_output_factory.hpp"
 #include "io/json.hpp"
 #include "io/post/variable_string_adapter.hpp"
 #include "io/post/node_averaged_variables.hpp"
+#include "io/post/quadrature_variables.hpp"
+#include "telemetry.hpp"
 
 #include <termcolor/termcolor.hpp>
 
-#include <chrono>
 #include <exception>
 #include <numeric>
 
@@ -19,7 +21,7 @@ namespace neon::diffusion
 {
 mesh::mesh(basic_mesh const& basic_mesh, json const& material_data, json const& mesh_data)
     : coordinates(std::make_shared<material_coordinates>(basic_mesh.coordinates())),
-      writer(std::make_unique<io::vtk_file_output>(mesh_data["name"], mesh_data["visualisation"]))
+      writer(io::make_file_output(mesh_data["name"], mesh_data["visualisation"]))
 {
     check_boundary_conditions(mesh_data["boundaries"]);
 
@@ -30,9 +32,9 @@ mesh::mesh(basic_mesh const& basic_mesh, json const& material_data, json const&
     for (auto const& submesh : basic_mesh.meshes(simulation_name))
     {
         submeshes.emplace_back(material_data, mesh_data, coordinates, submesh);
-
-        writer->mesh(submesh.all_node_indices(), submesh.topology());
     }
+    writer->add_mesh(basic_mesh, {simulation_name});
+
     allocate_boundary_conditions(mesh_data, basic_mesh);
 
     allocate_variable_names();
@@ -40,7 +42,7 @@ mesh::mesh(basic_mesh const& basic_mesh, json const& material_data, json const&
 
 void mesh::update_internal_variables(vector const& u, double const time_step_size)
 {
-    auto const start = std::chrono::steady_clock::now();
+    telemetry::scoped_timer timer("Internal variable update");
 
     temperature = u;
 
@@ -48,12 +50,6 @@ void mesh::update_internal_variables(vector const& u, double const time_step_siz
     {
         submesh.update_internal_variables(time_step_size);
     }
-
-    auto const end = std::chrono::steady_clock::now();
-    std::chrono::duration<double> elapsed_seconds = end - start;
-
-    std::cout << std::string(6, ' ') << "Internal variable update took " << elapsed_seconds.count()
-              << "s\n";
 }
 
 void mesh::save_internal_variables(bool const have_converged)
@@ -138,6 +134,8 @@ void mesh::check_boundary_conditions(json const& boundary_data) const
 
 void mesh::write(std::int32_t const time_step, double const current_time)
 {
+    if (!writer->is_write_required(time_step, current_time)) return;
+
     // nodal variables
     if (writer->is_output_requested("temperature"))
     {
@@ -170,6 +168,23 @@ void mesh::write(std::int32_t const time_step, double const current_time)
             },
             output_variable);
     }
+    // internal variables at the quadrature points
+    for (auto const& output_variable : quadrature_output_variables)
+    {
+        std::visit(
+            [this](auto&& output) {
+                using T = std::decay_t<decltype(output)>;
+                if constexpr (std::is_same_v<T, variable::scalar>
+                              || std::is_same_v<T, variable::second>)
+                {
+                    auto const [values, components] = quadrature_internal_variable(submeshes,
+                                                                                   convert(output),
+                                                                                   output);
+                    writer->cell_field(convert(output), values, components);
+                }
+            },
+            output_variable);
+    }
     writer->write(time_step, current_time);
 }
 
@@ -182,8 +197,19 @@ void mesh::allocate_variable_names()
         output_variables.emplace_back(variable::convert(name));
     }
 
+    for (auto const& name : writer->quadrature_outputs())
+    {
+        quadrature_output_variables.emplace_back(variable::convert(name));
+    }
+
+    auto requested_variables = output_variables;
+
+    requested_variables.insert(end(requested_variables),
+                               begin(quadrature_output_variables),
+                               end(quadrature_output_variables));
+
     // check if output variables exist in all the submeshes
-    for (auto const& output_variable : output_variables)
+    for (auto const& output_variable : requested_variables)
     {
         std::visit(
             [this](auto&& output) {
@@ -70,6 +70,9 @@ protected:
     /// Output variables
     std::vector<variable::types> output_variables;
 
+    /// Output variables at the quadrature points
+    std::vector<variable::types> quadrature_output_variables;
+
     vector temperature;
 };
 }
@@ -7,7 +7,9 @@
 #include "interpolations/interpolation_factory.hpp"
 #include "material/material_property.hpp"
 #include "mesh/material_coordinates.hpp"
+#include "io/post/node_averaged_variables.hpp"
 #include "numeric/gradient_operator.hpp"
+#include "thread_policy.hpp"
 
 #include <cfenv>
 #include <omp.h>
@@ -27,6 +29,7 @@ submesh::submesh(json const& material_data,
       variables(std::make_shared<internal_variables_t>(elements() * sf->quadrature().points())),
       cm(make_constitutive_model(variables, material_data, mesh_data))
 {
+    variables->for_each_storage([](auto const& values) { thread_policy::distribute(values); });
 }
 
 void submesh::save_internal_variables(bool const have_converged)
@@ -112,76 +115,28 @@ void submesh::update_internal_variables(double const time_step_size)
 
 std::pair<vector, vector> submesh::nodal_averaged_variable(variable::second const tensor_name) const
 {
-    vector count = vector::Zero(coordinates->size() * 9);
-    vector value = count;
-
     auto const& tensor_list = variables->get(tensor_name);
 
-    auto const& E = sf->local_quadrature_extrapolation();
-
-    // vector format of values
-    vector component = vector::Zero(sf->quadrature().points());
-
-    for (std::int64_t e{0}; e < elements(); ++e)
-    {
-        // Assemble these into the global value vector
-        auto const& node_list = local_node_view(e);
-
-        for (auto ci = 0; ci < 3; ++ci)
-        {
-            for (auto cj = 0; cj < 3; ++cj)
-            {
-                for (std::size_t l{0}; l < sf->quadrature().points(); ++l)
-                {
-                    auto const& tensor = tensor_list[view(e, l)];
-                    component(l) = tensor(ci, cj);
-                }
-
-                // Local extrapolation to the nodes
-                vector const nodal_component = E * component;
-
-                for (auto n = 0; n < nodal_component.rows(); n++)
-                {
-                    value(node_list[n] * 9 + ci * 3 + cj) += nodal_component(n);
-                    count(node_list[n] * 9 + ci * 3 + cj) += 1.0;
-                }
-            }
-        }
-    }
-    return {value, count};
+    // The tensor components are stored in row major order for each node
+    return extrapolate_to_nodes<9>(sf->local_quadrature_extrapolation(),
+                                    all_node_indices(),
+                                    coordinates->size(),
+                                    [&](auto const element, auto const l) {
+                                        matrix3 const tensor = tensor_list[view(element, l)].transpose();
+                                        return Eigen::Map<Eigen::Matrix<double, 1, 9> const>(tensor.data())
+                                            .eval();
+                                    });
 }
 
 std::pair<vector, vector> submesh::nodal_averaged_variable(variable::scalar const name) const
 {
-    vector count = vector::Zero(coordinates->size());
-    vector value = count;
-
     auto const& scalar_list = variables->get(name);
 
-    auto const& E = sf->local_quadrature_extrapolation();
-
-    // vector format of values
-    vector component = vector::Zero(sf->quadrature().points());
-
-    for (std::int64_t element{0}; element < elements(); ++element)
-    {
-        // Assemble these into the global value vector
-        auto const& node_list = local_node_view(element);
-
-        for (std::size_t l{0}; l < sf->quadrature().points(); ++l)
-        {
-            component(l) = scalar_list[view(element, l)];
-        }
-
-        // Local extrapolation to the nodes
-        vector const nodal_component = E * component;
-
-        for (auto n = 0l; n < nodal_component.rows(); n++)
-        {
-            value(node_list[n]) += nodal_component(n);
-            count(node_list[n]) += 1.0;
-        }
-    }
-    return {value, count};
+    return extrapolate_to_nodes<1>(sf->local_quadrature_extrapolation(),
+                                   all_node_indices(),
+                                   coordinates->size(),
+                                   [&](auto const element, auto const l) {
+                                       return Eigen::Matrix<double, 1, 1>(scalar_list[view(element, l)]);
+                                   });
 }
 }
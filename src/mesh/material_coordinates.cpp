@@ -1,11 +1,15 @@
 
 #include "material_coordinates.hpp"
 
+#include "thread_policy.hpp"
+
 namespace neon
 {
 material_coordinates::material_coordinates(matrix3x const& initial_coordinates)
     : nodal_coordinates(initial_coordinates), x(initial_coordinates)
 {
+    thread_policy::distribute(X);
+    thread_policy::distribute(x);
 }
 
 vector material_coordinates::displacement() const
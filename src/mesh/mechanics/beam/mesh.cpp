@@ -5,9 +5,10 @@
 #include "mesh/basic_mesh.hpp"
 #include "mesh/dof_allocator.hpp"
 #include "io/post/variable_string_adapter.hpp"
+#include "io/file_output_factory.hpp"
 #include "io/json.hpp"
+#include "telemetry.hpp"
 
-#include <chrono>
 #include <exception>
 #include <memory>
 #include <numeric>
@@ -30,8 +31,7 @@ mesh::mesh(basic_mesh const& basic_mesh,
       displacement(active_dofs() / 2),
       rotation(active_dofs() / 2),
       generate_time_step{generate_time_step},
-      writer(std::make_unique<io::vtk_file_output>(simulation_data["name"],
-                                                   simulation_data["Visualisation"]))
+      writer(io::make_file_output(simulation_data["name"], simulation_data["Visualisation"]))
 {
     check_boundary_conditions(simulation_data["boundaries"]);
 
@@ -39,6 +39,8 @@ mesh::mesh(basic_mesh const& basic_mesh,
 
     std::cout << "simulation name is: " << simulation_data["name"] << std::endl;
 
+    std::vector<std::string> section_names;
+
     for (auto const& section : simulation_data["sections"])
     {
         if (section.find("name") == section.end())
@@ -46,13 +48,14 @@ mesh::mesh(basic_mesh const& basic_mesh,
             throw std::domain_error("A section is missing a \"name\" field");
         }
 
-        for (auto const& submesh : basic_mesh.meshes(section["name"].get<std::string>()))
+        section_names.emplace_back(section["name"].get<std::string>());
+
+        for (auto const& submesh : basic_mesh.meshes(section_names.back()))
         {
             submeshes.emplace_back(material_data, simulation_data, section, coordinates, submesh);
-
-            writer->mesh(submesh.all_node_indices(), submesh.topology());
         }
     }
+    writer->add_mesh(basic_mesh, section_names);
 
     allocate_boundary_conditions(simulation_data, basic_mesh);
     allocate_variable_names();
@@ -62,7 +65,7 @@ bool mesh::is_symmetric() const { return true; }
 
 void mesh::update_internal_variables(vector const& displacement_rotation, double const time_step_size)
 {
-    auto const start = std::chrono::steady_clock::now();
+    telemetry::scoped_timer timer("Internal variable update");
 
     displacement = displacement_rotation(block_sequence<3, 6>{0, displacement.size()});
     rotation = displacement_rotation(block_sequence<3, 6>{3, rotation.size()});
@@ -73,12 +76,6 @@ void mesh::update_internal_variables(vector const& displacement_rotation, double
     {
         submesh.update_internal_variables(time_step_size);
     }
-
-    auto const end = std::chrono::steady_clock::now();
-    std::chrono::duration<double> const elapsed_seconds = end - start;
-
-    std::cout << std::string(6, ' ') << "Internal variable update took " << elapsed_seconds.count()
-              << "s\n";
 }
 
 bool mesh::is_nonfollower_load(std::string const& boundary_type) const
@@ -174,6 +171,8 @@ std::vector<double> mesh::time_history() const
 
 void mesh::write(std::int32_t const time_step, double const current_time)
 {
+    if (!writer->is_write_required(time_step, current_time)) return;
+
     // nodal variables
     if (writer->is_output_requested("displacement"))
     {
@@ -215,5 +214,9 @@ void mesh::allocate_variable_names()
 
         output_variables.emplace_back(variable::convert(name));
     }
+    if (!writer->quadrature_outputs().empty())
+    {
+        throw std::domain_error("Quadrature point output is not available for beam meshes");
+    }
 }
 }
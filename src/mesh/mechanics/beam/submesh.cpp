@@ -30,7 +30,7 @@ submesh::submesh(json const& material_data,
 
     dof_allocator(node_indices, dof_indices, traits::dof_order);
 
-    variables->add(variable::second::cauchy_stress,
+    variables->add(variable::symmetric::cauchy_stress,
                    variable::scalar::shear_area_1,
                    variable::scalar::shear_area_2,
                    variable::scalar::cross_sectional_area,
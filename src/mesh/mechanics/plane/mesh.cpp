@@ -3,15 +3,18 @@
 
 #include "mesh/basic_mesh.hpp"
 #include "mesh/dof_allocator.hpp"
+#include "io/file_output_factory.hpp"
 #include "io/json.hpp"
 #include "io/post/variable_string_adapter.hpp"
 #include "io/post/node_averaged_variables.hpp"
+#include "io/post/quadrature_variables.hpp"
+#include "telemetry.hpp"
 
-#include <chrono>
 #include <exception>
 #include <numeric>
 
 #include <termcolor/termcolor.hpp>
+#include <tbb/parallel_for.h>
 
 static bool is_nodal_variable(std::string const& name)
 {
@@ -27,8 +30,7 @@ mesh::mesh(basic_mesh const& basic_mesh,
     : coordinates(std::make_shared<material_coordinates>(basic_mesh.coordinates())),
       reaction_forces{coordinates->size() * traits::dofs_per_node},
       generate_time_step{generate_time_step},
-      writer(std::make_unique<io::vtk_file_output>(simulation_data["name"],
-                                                   simulation_data["visualisation"]))
+      writer(io::make_file_output(simulation_data["name"], simulation_data["visualisation"]))
 {
     check_boundary_conditions(simulation_data["boundaries"]);
 
@@ -37,9 +39,9 @@ mesh::mesh(basic_mesh const& basic_mesh,
     for (auto const& submesh : basic_mesh.meshes(simulation_data["name"]))
     {
         submeshes.emplace_back(material_data, simulation_data, coordinates, submesh);
-
-        writer->mesh(submesh.all_node_indices(), submesh.topology());
     }
+    writer->add_mesh(basic_mesh, {simulation_data["name"].get<std::string>()});
+
     allocate_boundary_conditions(simulation_data, basic_mesh);
 
     allocate_variable_names();
@@ -52,9 +54,16 @@ bool mesh::is_symmetric() const
     });
 }
 
+bool mesh::is_tangent_constant() const
+{
+    return std::all_of(begin(submeshes), end(submeshes), [](auto const& submesh) {
+        return submesh.constitutive().is_tangent_constant();
+    });
+}
+
 void mesh::update_internal_variables(vector const& u, double const time_step_size)
 {
-    auto const start = std::chrono::steady_clock::now();
+    telemetry::scoped_timer timer("Internal variable update");
 
     coordinates->update_current_xy_configuration(u);
 
@@ -62,12 +71,6 @@ void mesh::update_internal_variables(vector const& u, double const time_step_siz
     {
         submesh.update_internal_variables(time_step_size);
     }
-
-    auto const end = std::chrono::steady_clock::now();
-    std::chrono::duration<double> elapsed_seconds = end - start;
-
-    std::cout << std::string(6, ' ') << "Internal variable update took " << elapsed_seconds.count()
-              << "s\n";
 }
 
 void mesh::save_internal_variables(bool const have_converged)
@@ -85,26 +88,41 @@ bool mesh::is_nonfollower_load(std::string const& boundary_type) const
 }
 
 void mesh::allocate_boundary_conditions(json const& simulation_data, basic_mesh const& basic_mesh)
+{
+    allocate_boundaries(simulation_data["boundaries"],
+                        simulation_data,
+                        basic_mesh,
+                        displacement_bcs,
+                        nonfollower_loads);
+
+    allocate_load_cases(simulation_data, basic_mesh);
+}
+
+void mesh::allocate_boundaries(json const& boundary_data,
+                               json const& simulation_data,
+                               basic_mesh const& basic_mesh,
+                               std::map<std::string, std::vector<dirichlet>>& displacements,
+                               std::map<std::string, nonfollower_load_boundary>& loads)
 {
     // Populate the boundary conditions and their corresponding mesh
-    for (auto const& boundary : simulation_data["boundaries"])
+    for (auto const& boundary : boundary_data)
     {
         std::string const& boundary_name = boundary["name"];
         std::string const& boundary_type = boundary["type"];
 
-        if (boundary_type == "Displacement")
+        if (boundary_type == "displacement")
         {
-            this->allocate_displacement_boundary(boundary, basic_mesh);
+            this->allocate_displacement_boundary(boundary, basic_mesh, displacements);
         }
         else if (is_nonfollower_load(boundary_type))
         {
-            nonfollower_loads.emplace(boundary_name,
-                                      nonfollower_load_boundary(coordinates,
-                                                                basic_mesh.meshes(boundary_name),
-                                                                simulation_data,
-                                                                boundary,
-                                                                dof_table,
-                                                                generate_time_step));
+            loads.emplace(boundary_name,
+                          nonfollower_load_boundary(coordinates,
+                                                    basic_mesh.meshes(boundary_name),
+                                                    simulation_data,
+                                                    boundary,
+                                                    dof_table,
+                                                    generate_time_step));
         }
         else
         {
@@ -113,7 +131,9 @@ void mesh::allocate_boundary_conditions(json const& simulation_data, basic_mesh
     }
 }
 
-void mesh::allocate_displacement_boundary(json const& boundary, basic_mesh const& basic_mesh)
+void mesh::allocate_displacement_boundary(json const& boundary,
+                                          basic_mesh const& basic_mesh,
+                                          std::map<std::string, std::vector<dirichlet>>& boundaries)
 {
     std::string const& boundary_name = boundary["name"];
 
@@ -132,12 +152,46 @@ void mesh::allocate_displacement_boundary(json const& boundary, basic_mesh const
                                return dof + dof_offset;
                            });
 
-            displacement_bcs[boundary_name].emplace_back(boundary_dofs,
-                                                         boundary,
-                                                         dof_key,
-                                                         generate_time_step);
+            boundaries[boundary_name].emplace_back(boundary_dofs,
+                                                   boundary,
+                                                   dof_key,
+                                                   generate_time_step);
+        }
+    }
+}
+
+void mesh::allocate_load_cases(json const& simulation_data, basic_mesh const& basic_mesh)
+{
+    if (simulation_data.find("load_cases") == simulation_data.end()) return;
+
+    auto const& load_case_data = simulation_data["load_cases"];
+
+    for (auto const& data : load_case_data)
+    {
+        if (data.find("name") == data.end() || data.find("boundaries") == data.end())
+        {
+            throw std::domain_error("\"name\" and \"boundaries\" must be specified for each "
+                                    "load case");
         }
+        check_boundary_conditions(data["boundaries"]);
     }
+
+    load_case_boundaries.resize(load_case_data.size());
+
+    // The reference loads of each load case are integrated independently
+    tbb::parallel_for(std::size_t{0}, load_case_data.size(), [&](auto const index) {
+        auto const& data = load_case_data[index];
+
+        auto& boundaries = load_case_boundaries[index];
+
+        boundaries.name = data["name"];
+
+        allocate_boundaries(data["boundaries"],
+                            simulation_data,
+                            basic_mesh,
+                            boundaries.dirichlet_boundaries,
+                            boundaries.nonfollower_boundaries);
+    });
 }
 
 std::vector<double> mesh::time_history() const
@@ -182,16 +236,21 @@ void mesh::check_boundary_conditions(json const& boundary_data) const
                                         + "\" was not specified in \"boundary\".");
             }
         }
-        if ((!boundary.count("Time")) && (!boundary.count("Generatetype")))
+        if (boundary.find("time") == boundary.end()
+            && boundary.find("generate_type") == boundary.end())
         {
-            throw std::domain_error("Neither \"Time\" nor \"Generatetype\" was specified in "
+            throw std::domain_error("Neither \"time\" nor \"generate_type\" was specified in "
                                     "\"boundary\".");
         }
     }
 }
 
+void mesh::restart_output(double const current_time) { writer->restart(current_time); }
+
 void mesh::write(std::int32_t const time_step, double const current_time)
 {
+    if (!writer->is_write_required(time_step, current_time)) return;
+
     // nodal variables
     if (writer->is_output_requested("displacement"))
     {
@@ -217,7 +276,8 @@ void mesh::write(std::int32_t const time_step, double const current_time)
                                                             output),
                                   1);
                 }
-                else if constexpr (std::is_same_v<T, variable::second>)
+                else if constexpr (std::is_same_v<T, variable::second>
+                                   || std::is_same_v<T, variable::symmetric>)
                 {
                     writer->field(convert(output),
                                   average_internal_variable(submeshes,
@@ -229,6 +289,24 @@ void mesh::write(std::int32_t const time_step, double const current_time)
             },
             output_variable);
     }
+    // internal variables at the quadrature points
+    for (auto const& output_variable : quadrature_output_variables)
+    {
+        std::visit(
+            [this](auto&& output) {
+                using T = std::decay_t<decltype(output)>;
+                if constexpr (std::is_same_v<T, variable::scalar>
+                              || std::is_same_v<T, variable::second>
+                              || std::is_same_v<T, variable::symmetric>)
+                {
+                    auto const [values, components] = quadrature_internal_variable(submeshes,
+                                                                                   convert(output),
+                                                                                   output);
+                    writer->cell_field(convert(output), values, components);
+                }
+            },
+            output_variable);
+    }
     writer->write(time_step, current_time);
 }
 
@@ -241,8 +319,19 @@ void mesh::allocate_variable_names()
         output_variables.emplace_back(variable::convert(name));
     }
 
+    for (auto const& name : writer->quadrature_outputs())
+    {
+        quadrature_output_variables.emplace_back(variable::convert(name));
+    }
+
+    auto requested_variables = output_variables;
+
+    requested_variables.insert(end(requested_variables),
+                               begin(quadrature_output_variables),
+                               end(quadrature_output_variables));
+
     // check if output variables exist in all the submeshes
-    for (auto const& output_variable : output_variables)
+    for (auto const& output_variable : requested_variables)
     {
         std::visit(
             [this](auto&& output) {
@@ -258,7 +347,8 @@ void mesh::allocate_variable_names()
                                                 + std::to_string(static_cast<int>(output)) + ")");
                     }
                 }
-                else if constexpr (std::is_same_v<T, variable::second>)
+                else if constexpr (std::is_same_v<T, variable::second>
+                                   || std::is_same_v<T, variable::symmetric>)
                 {
                     if (std::none_of(begin(submeshes), end(submeshes), [&output](auto const& submesh) {
                             return submesh.internal_variables().has(output);
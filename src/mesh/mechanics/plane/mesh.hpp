@@ -2,6 +2,7 @@
 #pragma once
 
 #include "mesh/boundary/dirichlet.hpp"
+#include "mesh/boundary/load_case.hpp"
 #include "mesh/mechanics/plane/boundary/nonfollower_load.hpp"
 #include "mesh/mechanics/plane/submesh.hpp"
 #include "io/file_output.hpp"
@@ -23,6 +24,9 @@ public:
 
     using traits = submesh::traits;
 
+    /// Boundary conditions of an independent load case
+    using load_case_type = load_case<nonfollower_load_boundary>;
+
 public:
     mesh(basic_mesh const& basic_mesh,
          json const& material_data,
@@ -36,6 +40,10 @@ public:
     /// resulting matrix from this mesh is symmetric.  \sa LinearSolver
     [[nodiscard]] bool is_symmetric() const;
 
+    /// Checks the constitutive models to determine if the tangent stiffness
+    /// matrix is independent of the deformation and the history
+    [[nodiscard]] bool is_tangent_constant() const;
+
     void update_internal_forces(vector const& fint) { reaction_forces = -fint; }
 
     /// Deform the body by updating the displacement x = X + u
@@ -57,6 +65,10 @@ public:
 
     [[nodiscard]] auto const& nonfollower_boundaries() const { return nonfollower_loads; }
 
+    /// \return the boundary conditions of the \p "load_cases" in addition to
+    /// the common boundary conditions \sa load_case_matrix
+    [[nodiscard]] auto const& load_cases() const noexcept { return load_case_boundaries; }
+
     /// Gathers the time history for each boundary condition and
     /// returns a sorted vector which may contain duplicated entries.
     /// \sa adaptive_time_step
@@ -67,14 +79,30 @@ public:
     /// Write out results to file
     void write(std::int32_t const time_step, double const current_time);
 
+    /// Continue the file output of a solution restarted at \p current_time
+    void restart_output(double const current_time);
+
 protected:
     void check_boundary_conditions(json const& boundary_data) const;
 
     void allocate_variable_names();
 
-    void allocate_boundary_conditions(json const& boundary_data, basic_mesh const& basic_mesh);
+    void allocate_boundary_conditions(json const& simulation_data, basic_mesh const& basic_mesh);
 
-    void allocate_displacement_boundary(json const& boundary, basic_mesh const& basic_mesh);
+    /// Allocate the boundary conditions in \p boundary_data to the
+    /// \p displacements and the nonfollower \p loads
+    void allocate_boundaries(json const& boundary_data,
+                             json const& simulation_data,
+                             basic_mesh const& basic_mesh,
+                             std::map<std::string, std::vector<dirichlet>>& displacements,
+                             std::map<std::string, nonfollower_load_boundary>& loads);
+
+    void allocate_displacement_boundary(json const& boundary,
+                                        basic_mesh const& basic_mesh,
+                                        std::map<std::string, std::vector<dirichlet>>& boundaries);
+
+    /// Allocate the boundary conditions of each of the \p "load_cases"
+    void allocate_load_cases(json const& simulation_data, basic_mesh const& basic_mesh);
 
     [[nodiscard]] bool is_nonfollower_load(std::string const& boundary_type) const;
 
@@ -88,6 +116,9 @@ protected:
     /// Nonfollower boundaries
     std::map<std::string, nonfollower_load_boundary> nonfollower_loads;
 
+    /// Boundaries of the independent load cases
+    std::vector<load_case_type> load_case_boundaries;
+
     /// Internal nodal forces for reaction forces
     vector reaction_forces;
 
@@ -106,6 +137,9 @@ protected:
 
     /// Output variables
     std::vector<variable::types> output_variables;
+
+    /// Output variables at the quadrature points
+    std::vector<variable::types> quadrature_output_variables;
 };
 }
 }
@@ -8,9 +8,11 @@
 #include "interpolations/interpolation_factory.hpp"
 #include "material/material_property.hpp"
 #include "mesh/material_coordinates.hpp"
+#include "io/post/node_averaged_variables.hpp"
 #include "mesh/dof_allocator.hpp"
 #include "numeric/mechanics"
 #include "traits/mechanics.hpp"
+#include "thread_policy.hpp"
 
 #include <cfenv>
 #include <chrono>
@@ -33,7 +35,7 @@ submesh::submesh(json const& material_data,
     // Allocate storage for the displacement gradient
     variables->add(variable::second::displacement_gradient,
                    variable::second::deformation_gradient,
-                   variable::second::cauchy_stress,
+                   variable::symmetric::cauchy_stress,
                    variable::scalar::DetF);
 
     // Get the old data to the undeformed configuration
@@ -42,8 +44,18 @@ submesh::submesh(json const& material_data,
         F = matrix2::Identity();
     }
 
+    // Avoid storing a tangent operator for each quadrature point if it can be
+    // computed from the current state during the assembly
+    if (cm->has_pointwise_tangent())
+    {
+        cm->evaluate_tangent_in_assembly();
+    }
+
     variables->commit();
 
+    // Place the variables in the memory of the threads processing the elements
+    variables->for_each_storage([](auto const& values) { thread_policy::distribute(values); });
+
     dof_allocator(node_indices, dof_list, traits::dof_order);
 }
 
@@ -85,17 +97,19 @@ std::pair<index_view, vector> submesh::internal_force(std::int32_t const element
 
 matrix const& submesh::geometric_tangent_stiffness(matrix2x const& x, std::int32_t const element) const
 {
-    auto const& cauchy_stresses = variables->get(variable::second::cauchy_stress);
+    auto const& cauchy_stresses = variables->get(variable::symmetric::cauchy_stress);
 
     thread_local matrix k_geo(nodes_per_element(), nodes_per_element());
     thread_local matrix k_geo_full;
 
+    k_geo.setZero(nodes_per_element(), nodes_per_element());
+
     sf->quadrature().integrate_inplace(k_geo, [&](auto const& N_dN, auto const l) {
         auto const& [N, rhea] = N_dN;
 
         matrix2 const Jacobian = local_deformation_gradient(rhea, x);
 
-        auto const cauchy = cauchy_stresses[view(element, l)];
+        auto const cauchy = voigt::kinetic::view(cauchy_stresses[view(element, l)]);
 
         // Compute the symmetric gradient operator
         auto const L = local_gradient(rhea, Jacobian);
@@ -113,16 +127,31 @@ matrix const& submesh::material_tangent_stiffness(matrix2x const& x, std::int32_
 
     thread_local matrix k_mat(local_dofs, local_dofs);
 
-    k_mat.setZero();
+    // Resize for submeshes of a different topology processed by this thread
+    k_mat.setZero(local_dofs, local_dofs);
 
-    auto const& tangent_operators = variables->get(variable::fourth::tangent_operator);
+    // The stored tangent is either the full tangent or the upper triangle of a
+    // tangent with major symmetry and neither is stored when it is evaluated
+    auto const* tangent_operators = variables->has(variable::fourth::tangent_operator)
+                                        ? &variables->get(variable::fourth::tangent_operator)
+                                        : nullptr;
 
-    matrix B = matrix::Zero(4, local_dofs);
+    auto const* symmetric_tangent_operators =
+        variables->has(variable::major_symmetric::tangent_operator)
+            ? &variables->get(variable::major_symmetric::tangent_operator)
+            : nullptr;
+
+    matrix B = matrix::Zero(3, local_dofs);
 
     sf->quadrature().integrate_inplace(k_mat, [&](auto const& femval, auto const& l) {
         auto const& [N, rhea] = femval;
 
-        auto const& D = tangent_operators[view(element, l)];
+        // Use the stored tangent or evaluate it at the quadrature point
+        matrix3 const D = tangent_operators ? (*tangent_operators)[view(element, l)]
+                          : symmetric_tangent_operators
+                              ? matrix3(voigt::major_symmetric::view(
+                                  (*symmetric_tangent_operators)[view(element, l)]))
+                              : cm->tangent_operator(view(element, l));
 
         matrix2 const Jacobian{local_deformation_gradient(rhea, x)};
 
@@ -137,9 +166,9 @@ vector const& submesh::internal_nodal_force(matrix2x const& x, std::int32_t cons
 {
     thread_local vector f_int(nodes_per_element() * dofs_per_node());
 
-    f_int.setZero();
+    f_int.setZero(nodes_per_element() * dofs_per_node());
 
-    auto const& cauchy_stresses = variables->get(variable::second::cauchy_stress);
+    auto const& cauchy_stresses = variables->get(variable::symmetric::cauchy_stress);
 
     sf->quadrature()
         .integrate_inplace(Eigen::Map<row_matrix>(f_int.data(), nodes_per_element(), dofs_per_node()),
@@ -148,7 +177,8 @@ vector const& submesh::internal_nodal_force(matrix2x const& x, std::int32_t cons
 
                                matrix2 const Jacobian = local_deformation_gradient(dN, x);
 
-                               matrix2 const& cauchy_stress = cauchy_stresses[view(element, l)];
+                               auto const cauchy_stress = voigt::kinetic::view(
+                                   cauchy_stresses[view(element, l)]);
 
                                // symmetric gradient operator
                                auto const Bt = dN * Jacobian.inverse();
@@ -262,75 +292,43 @@ void submesh::update_Jacobian_determinants()
 
 std::pair<vector, vector> submesh::nodal_averaged_variable(variable::scalar const scalar_name) const
 {
-    vector count = vector::Zero(coordinates->size());
-    vector value = count;
-
     auto const& scalar_list = variables->get(scalar_name);
 
-    auto const& E = sf->local_quadrature_extrapolation();
-
-    // vector format of values
-    vector component = vector::Zero(sf->quadrature().points());
-
-    for (std::int64_t element{0}; element < elements(); ++element)
-    {
-        for (std::size_t l{0}; l < sf->quadrature().points(); ++l)
-        {
-            component(l) = scalar_list[view(element, l)];
-        }
-
-        // Local extrapolation to the nodes
-        vector const nodal_component = E * component;
-
-        // Assemble these into the global value vector
-        auto const& node_list = local_node_view(element);
-
-        for (auto n = 0; n < nodal_component.rows(); n++)
-        {
-            value(node_list[n]) += nodal_component(n);
-            count(node_list[n]) += 1.0;
-        }
-    }
-    return {value, count};
+    return extrapolate_to_nodes<1>(sf->local_quadrature_extrapolation(),
+                                   all_node_indices(),
+                                   coordinates->size(),
+                                   [&](auto const element, auto const l) {
+                                       return Eigen::Matrix<double, 1, 1>(scalar_list[view(element, l)]);
+                                   });
 }
 
 std::pair<vector, vector> submesh::nodal_averaged_variable(variable::second const tensor_name) const
 {
-    vector count = vector::Zero(coordinates->size() * 4);
-    vector value = count;
-
     auto const& tensor_list = variables->get(tensor_name);
 
-    matrix const E = sf->local_quadrature_extrapolation();
+    // The tensor components are stored in row major order for each node
+    return extrapolate_to_nodes<4>(sf->local_quadrature_extrapolation(),
+                                    all_node_indices(),
+                                    coordinates->size(),
+                                    [&](auto const element, auto const l) {
+                                        matrix2 const tensor = tensor_list[view(element, l)].transpose();
+                                        return Eigen::Map<Eigen::Matrix<double, 1, 4> const>(tensor.data())
+                                            .eval();
+                                    });
+}
 
-    // vector format of values
-    vector component(sf->quadrature().points());
+std::pair<vector, vector> submesh::nodal_averaged_variable(variable::symmetric const tensor_name) const
+{
+    auto const& tensor_list = variables->get(tensor_name);
 
-    for (std::int64_t element{0}; element < elements(); ++element)
-    {
-        // Assemble these into the global value vector
-        auto const& node_list = local_node_view(element);
-
-        for (auto ci = 0; ci < 2; ++ci)
-        {
-            for (auto cj = 0; cj < 2; ++cj)
-            {
-                for (std::size_t l{0}; l < sf->quadrature().points(); ++l)
-                {
-                    component(l) = tensor_list[view(element, l)](ci, cj);
-                }
-
-                // Local extrapolation to the nodes
-                vector const nodal_component = E * component;
-
-                for (auto n = 0; n < nodal_component.rows(); n++)
-                {
-                    value(node_list[n] * 4 + ci * 2 + cj) += nodal_component(n);
-                    count(node_list[n] * 4 + ci * 2 + cj) += 1.0;
-                }
-            }
-        }
-    }
-    return {value, count};
+    return extrapolate_to_nodes<4>(sf->local_quadrature_extrapolation(),
+                                    all_node_indices(),
+                                    coordinates->size(),
+                                    [&](auto const element, auto const l) {
+                                        matrix2 const tensor = voigt::kinetic::view(
+                                            tensor_list[view(element, l)]);
+                                        return Eigen::Map<Eigen::Matrix<double, 1, 4> const>(tensor.data())
+                                            .eval();
+                                    });
 }
 }
@@ -44,6 +44,31 @@ public:
 
     void save_internal_variables(bool const have_converged);
 
+    /// \return copy of the converged internal variables \sa restore_internal_variables
+    [[nodiscard]] auto checkpoint_internal_variables() const { return variables->checkpoint(); }
+
+    /// Reset the internal variables to a converged state \sa checkpoint_internal_variables
+    template <typename checkpoint_type>
+    void restore_internal_variables(checkpoint_type const& state)
+    {
+        variables->restore(state);
+    }
+
+    /// Extrapolate the internal variables over a number of load cycles and
+    /// commit the state with the derived variables recomputed
+    /// \sa checkpoint_internal_variables
+    template <typename checkpoint_type>
+    void extrapolate_internal_variables(checkpoint_type const& previous,
+                                        checkpoint_type const& current,
+                                        double const cycles)
+    {
+        variables->extrapolate(previous, current, cycles);
+
+        cm->update_derived_variables();
+
+        variables->commit();
+    }
+
     [[nodiscard]] auto dofs_per_node() const noexcept { return traits::dofs_per_node; }
 
     [[nodiscard]] auto const& shape_function() const { return *sf; }
@@ -71,6 +96,10 @@ public:
     [[nodiscard]] std::pair<vector, vector> nodal_averaged_variable(
         variable::second const tensor_name) const;
 
+    /// \return the nodal averaged symmetric tensor expanded to all components
+    [[nodiscard]] std::pair<vector, vector> nodal_averaged_variable(
+        variable::symmetric const tensor_name) const;
+
     [[nodiscard]] std::pair<vector, vector> nodal_averaged_variable(
         variable::scalar const scalar_name) const;
 
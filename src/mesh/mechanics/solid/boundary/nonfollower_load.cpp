@@ -118,5 +118,27 @@ nonfollower_load_boundary::nonfollower_load_boundary(
         throw std::domain_error("Need to specify a boundary type \"traction\", \"pressure\" or "
                                 "\"body_force\"");
     }
+
+    // The loads are computed in the initial configuration and only the load
+    // history changes between steps
+    for (auto const& boundary_mesh : boundary_meshes)
+    {
+        reference_loads.emplace_back(std::visit(
+            [](auto const& mesh) { return mesh.assemble_reference_load(); }, boundary_mesh));
+    }
+}
+
+void nonfollower_load_boundary::add_external_force(vector& f_ext, double const time) const
+{
+    for (std::size_t index{0}; index < boundary_meshes.size(); ++index)
+    {
+        auto const load = std::visit(
+            [&](auto const& mesh) { return mesh.interpolate_prescribed_load(time); },
+            boundary_meshes[index]);
+
+        auto const& [dofs, reference_load] = reference_loads[index];
+
+        f_ext(dofs) += load * reference_load;
+    }
 }
 }
@@ -39,9 +39,16 @@ public:
 
     auto const& nodal_interface() const noexcept { return nodal_values; }
 
+    /// Add the external force from the natural boundary conditions at \p time
+    /// to \p f_ext by scaling the cached reference load vectors
+    void add_external_force(vector& f_ext, double const time) const;
+
 protected:
     std::vector<value_types> boundary_meshes;
 
     std::vector<nodal_value> nodal_values;
+
+    /// Unique degrees of freedom and the unit load vector of each natural boundary
+    std::vector<std::pair<std::vector<std::int32_t>, vector>> reference_loads;
 };
 }
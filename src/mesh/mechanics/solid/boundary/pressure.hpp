@@ -18,9 +18,8 @@ class pressure : public traction
 public:
     using traction::traction;
 
-    /// Evaluated the external force contributions for a pressure boundary
+    /// Evaluated the external force contributions for a unit pressure boundary
     /// condition in the initial configuration.
-    std::pair<index_view, vector> external_force(std::int64_t const element,
-                                                 double const load_factor) const override;
+    std::pair<index_view, vector> reference_external_force(std::int64_t const element) const override;
 };
 }
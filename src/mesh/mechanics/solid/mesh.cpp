@@ -3,16 +3,19 @@
 
 #include "mesh/basic_mesh.hpp"
 #include "mesh/dof_allocator.hpp"
+#include "io/file_output_factory.hpp"
 #include "io/json.hpp"
 #include "io/post/variable_string_adapter.hpp"
 #include "io/post/node_averaged_variables.hpp"
+#include "io/post/quadrature_variables.hpp"
+#include "telemetry.hpp"
 
-#include <chrono>
 #include <exception>
 #include <memory>
 #include <numeric>
 
 #include <termcolor/termcolor.hpp>
+#include <tbb/parallel_for.h>
 
 namespace neon::mechanics::solid
 {
@@ -27,8 +30,7 @@ mesh::mesh(basic_mesh const& basic_mesh,
            double const generate_time_step)
     : coordinates(std::make_shared<material_coordinates>(basic_mesh.coordinates())),
       generate_time_step{generate_time_step},
-      writer(std::make_unique<io::vtk_file_output>(simulation_data["name"],
-                                                   simulation_data["visualisation"]))
+      writer(io::make_file_output(simulation_data["name"], simulation_data["visualisation"]))
 {
     check_boundary_conditions(simulation_data["boundaries"]);
 
@@ -37,9 +39,32 @@ mesh::mesh(basic_mesh const& basic_mesh,
     for (auto const& submesh : basic_mesh.meshes(simulation_data["name"]))
     {
         submeshes.emplace_back(material_data, simulation_data, coordinates, submesh);
-
-        writer->mesh(submesh.all_node_indices(), submesh.topology());
     }
+    writer->add_mesh(basic_mesh, {simulation_data["name"].get<std::string>()});
+
+    allocate_boundary_conditions(simulation_data, basic_mesh);
+    allocate_variable_names();
+}
+
+mesh::mesh(mesh&& parent,
+           basic_mesh const& basic_mesh,
+           json const& simulation_data,
+           double const generate_time_step)
+    : coordinates(std::move(parent.coordinates)),
+      submeshes(std::move(parent.submeshes)),
+      reaction_forces(std::move(parent.reaction_forces)),
+      generate_time_step{generate_time_step}
+{
+    check_boundary_conditions(simulation_data["boundaries"]);
+
+    // Complete the output of the parent before the files are reopened
+    parent.writer.reset();
+
+    writer = io::make_file_output(simulation_data["name"], simulation_data["visualisation"]);
+
+    writer->coordinates(coordinates->coordinates());
+    writer->add_mesh(basic_mesh, {simulation_data["name"].get<std::string>()});
+
     allocate_boundary_conditions(simulation_data, basic_mesh);
     allocate_variable_names();
 }
@@ -51,19 +76,20 @@ bool mesh::is_symmetric() const
     });
 }
 
+bool mesh::is_tangent_constant() const
+{
+    return std::all_of(begin(submeshes), end(submeshes), [](auto const& submesh) {
+        return submesh.constitutive().is_tangent_constant();
+    });
+}
+
 void mesh::update_internal_variables(vector const& u, double const time_step_size)
 {
-    auto const start = std::chrono::steady_clock::now();
+    telemetry::scoped_timer timer("Internal variable update");
 
     coordinates->update_current_configuration(u);
 
     for (auto& submesh : submeshes) submesh.update_internal_variables(time_step_size);
-
-    auto const end = std::chrono::steady_clock::now();
-    std::chrono::duration<double> const elapsed_seconds = end - start;
-
-    std::cout << std::string(6, ' ') << "Internal variable update took " << elapsed_seconds.count()
-              << "s\n";
 }
 
 void mesh::save_internal_variables(bool const have_converged)
@@ -78,26 +104,41 @@ bool mesh::is_nonfollower_load(std::string const& boundary_type) const
 }
 
 void mesh::allocate_boundary_conditions(json const& simulation_data, basic_mesh const& basic_mesh)
+{
+    allocate_boundaries(simulation_data["boundaries"],
+                        simulation_data,
+                        basic_mesh,
+                        displacement_bcs,
+                        nonfollower_loads);
+
+    allocate_load_cases(simulation_data, basic_mesh);
+}
+
+void mesh::allocate_boundaries(json const& boundary_data,
+                               json const& simulation_data,
+                               basic_mesh const& basic_mesh,
+                               std::map<std::string, std::vector<dirichlet>>& displacements,
+                               std::map<std::string, nonfollower_load_boundary>& loads)
 {
     // Populate the boundary conditions and their corresponding mesh
-    for (auto const& boundary : simulation_data["boundaries"])
+    for (auto const& boundary : boundary_data)
     {
         std::string const& boundary_name = boundary["name"];
         std::string const& boundary_type = boundary["type"];
 
         if (boundary_type == "displacement")
         {
-            this->allocate_displacement_boundary(boundary, basic_mesh);
+            this->allocate_displacement_boundary(boundary, basic_mesh, displacements);
         }
         else if (is_nonfollower_load(boundary_type))
         {
-            nonfollower_loads.emplace(boundary_name,
-                                      nonfollower_load_boundary(coordinates,
-                                                                basic_mesh.meshes(boundary_name),
-                                                                simulation_data,
-                                                                boundary,
-                                                                dof_table,
-                                                                generate_time_step));
+            loads.emplace(boundary_name,
+                          nonfollower_load_boundary(coordinates,
+                                                    basic_mesh.meshes(boundary_name),
+                                                    simulation_data,
+                                                    boundary,
+                                                    dof_table,
+                                                    generate_time_step));
         }
         else
         {
@@ -106,7 +147,9 @@ void mesh::allocate_boundary_conditions(json const& simulation_data, basic_mesh
     }
 }
 
-void mesh::allocate_displacement_boundary(json const& boundary, basic_mesh const& basic_mesh)
+void mesh::allocate_displacement_boundary(json const& boundary,
+                                          basic_mesh const& basic_mesh,
+                                          std::map<std::string, std::vector<dirichlet>>& boundaries)
 {
     std::string const& boundary_name = boundary["name"];
 
@@ -125,14 +168,48 @@ void mesh::allocate_displacement_boundary(json const& boundary, basic_mesh const
                                return dof + dof_offset;
                            });
 
-            displacement_bcs[boundary_name].emplace_back(boundary_dofs,
-                                                         boundary,
-                                                         dof_key,
-                                                         generate_time_step);
+            boundaries[boundary_name].emplace_back(boundary_dofs,
+                                                   boundary,
+                                                   dof_key,
+                                                   generate_time_step);
         }
     }
 }
 
+void mesh::allocate_load_cases(json const& simulation_data, basic_mesh const& basic_mesh)
+{
+    if (simulation_data.find("load_cases") == simulation_data.end()) return;
+
+    auto const& load_case_data = simulation_data["load_cases"];
+
+    for (auto const& data : load_case_data)
+    {
+        if (data.find("name") == data.end() || data.find("boundaries") == data.end())
+        {
+            throw std::domain_error("\"name\" and \"boundaries\" must be specified for each "
+                                    "load case");
+        }
+        check_boundary_conditions(data["boundaries"]);
+    }
+
+    load_case_boundaries.resize(load_case_data.size());
+
+    // The reference loads of each load case are integrated independently
+    tbb::parallel_for(std::size_t{0}, load_case_data.size(), [&](auto const index) {
+        auto const& data = load_case_data[index];
+
+        auto& boundaries = load_case_boundaries[index];
+
+        boundaries.name = data["name"];
+
+        allocate_boundaries(data["boundaries"],
+                            simulation_data,
+                            basic_mesh,
+                            boundaries.dirichlet_boundaries,
+                            boundaries.nonfollower_boundaries);
+    });
+}
+
 std::vector<double> mesh::time_history() const
 {
     std::set<double> history;
@@ -161,8 +238,12 @@ std::vector<double> mesh::time_history() const
     return {begin(history), end(history)};
 }
 
+void mesh::restart_output(double const current_time) { writer->restart(current_time); }
+
 void mesh::write(std::int32_t const time_step, double const current_time)
 {
+    if (!writer->is_write_required(time_step, current_time)) return;
+
     // nodal variables
     if (writer->is_output_requested("displacement"))
     {
@@ -187,7 +268,8 @@ void mesh::write(std::int32_t const time_step, double const current_time)
                                                             output),
                                   1);
                 }
-                else if constexpr (std::is_same_v<T, variable::second>)
+                else if constexpr (std::is_same_v<T, variable::second>
+                                   || std::is_same_v<T, variable::symmetric>)
                 {
                     writer->field(convert(output),
                                   average_internal_variable(submeshes,
@@ -199,6 +281,24 @@ void mesh::write(std::int32_t const time_step, double const current_time)
             },
             output_variable);
     }
+    // internal variables at the quadrature points
+    for (auto const& output_variable : quadrature_output_variables)
+    {
+        std::visit(
+            [this](auto&& output) {
+                using T = std::decay_t<decltype(output)>;
+                if constexpr (std::is_same_v<T, variable::scalar>
+                              || std::is_same_v<T, variable::second>
+                              || std::is_same_v<T, variable::symmetric>)
+                {
+                    auto const [values, components] = quadrature_internal_variable(submeshes,
+                                                                                   convert(output),
+                                                                                   output);
+                    writer->cell_field(convert(output), values, components);
+                }
+            },
+            output_variable);
+    }
     writer->write(time_step, current_time);
 }
 
@@ -243,8 +343,19 @@ void mesh::allocate_variable_names()
         output_variables.emplace_back(variable::convert(name));
     }
 
+    for (auto const& name : writer->quadrature_outputs())
+    {
+        quadrature_output_variables.emplace_back(variable::convert(name));
+    }
+
+    auto requested_variables = output_variables;
+
+    requested_variables.insert(end(requested_variables),
+                               begin(quadrature_output_variables),
+                               end(quadrature_output_variables));
+
     // check if output variables exist in all the submeshes
-    for (auto const& output_variable : output_variables)
+    for (auto const& output_variable : requested_variables)
     {
         std::visit(
             [this](auto&& output) {
@@ -260,7 +371,8 @@ void mesh::allocate_variable_names()
                                                 + std::to_string(static_cast<short>(output)) + ")");
                     }
                 }
-                else if constexpr (std::is_same_v<T, variable::second>)
+                else if constexpr (std::is_same_v<T, variable::second>
+                                   || std::is_same_v<T, variable::symmetric>)
                 {
                     if (std::none_of(begin(submeshes), end(submeshes), [&output](auto const& submesh) {
                             return submesh.internal_variables().has(output);
@@ -2,6 +2,7 @@
 #pragma once
 
 #include "mesh/boundary/dirichlet.hpp"
+#include "mesh/boundary/load_case.hpp"
 #include "mesh/mechanics/solid/boundary/nonfollower_load.hpp"
 #include "mesh/mechanics/solid/submesh.hpp"
 #include "io/file_output.hpp"
@@ -23,12 +24,24 @@ public:
     /// Alias traits to submesh
     using traits = submesh::traits;
 
+    /// Boundary conditions of an independent load case
+    using load_case_type = load_case<nonfollower_load_boundary>;
+
 public:
     mesh(basic_mesh const& basic_mesh,
          json const& material_data,
          json const& simulation_data,
          double const generate_time_step);
 
+    /// Continue from the converged state of \p parent with the boundary
+    /// conditions and the output of the next simulation step.  The nodal
+    /// coordinates and the submeshes with their internal variables are moved
+    /// from \p parent instead of rebuilt
+    mesh(mesh&& parent,
+         basic_mesh const& basic_mesh,
+         json const& simulation_data,
+         double const generate_time_step);
+
     /// The number of active degrees of freedom in this mesh
     [[nodiscard]] auto active_dofs() const { return traits::dofs_per_node * coordinates->size(); }
 
@@ -36,6 +49,10 @@ public:
     /// resulting matrix from this mesh is symmetric.  \sa LinearSolver
     [[nodiscard]] bool is_symmetric() const;
 
+    /// Checks the constitutive models to determine if the tangent stiffness
+    /// matrix is independent of the deformation and the history
+    [[nodiscard]] bool is_tangent_constant() const;
+
     /// Update the internal forces for printing out reaction forces
     void update_internal_forces(vector const& fint) { reaction_forces = -fint; }
 
@@ -61,6 +78,10 @@ public:
 
     [[nodiscard]] auto const& nonfollower_boundaries() const { return nonfollower_loads; }
 
+    /// \return the boundary conditions of the \p "load_cases" in addition to
+    /// the common boundary conditions \sa load_case_matrix
+    [[nodiscard]] auto const& load_cases() const noexcept { return load_case_boundaries; }
+
     /// Gathers the time history for each boundary condition and
     /// returns a sorted vector which may contain traces of duplicates.
     /// \sa adaptive_time_step
@@ -72,6 +93,9 @@ public:
     /// Write out results to file
     void write(std::int32_t const time_step, double const current_time);
 
+    /// Continue the file output of a solution restarted at \p current_time
+    void restart_output(double const current_time);
+
     /// Write out eigenvalues and eigenmodes to file
     void write(vector const& eigenvalues, matrix const& eigenvectors);
 
@@ -80,9 +104,22 @@ protected:
 
     void allocate_variable_names();
 
-    void allocate_boundary_conditions(json const& boundary_data, basic_mesh const& reference_mesh);
+    void allocate_boundary_conditions(json const& simulation_data, basic_mesh const& basic_mesh);
+
+    /// Allocate the boundary conditions in \p boundary_data to the
+    /// \p displacements and the nonfollower \p loads
+    void allocate_boundaries(json const& boundary_data,
+                             json const& simulation_data,
+                             basic_mesh const& basic_mesh,
+                             std::map<std::string, std::vector<dirichlet>>& displacements,
+                             std::map<std::string, nonfollower_load_boundary>& loads);
+
+    void allocate_displacement_boundary(json const& boundary,
+                                        basic_mesh const& basic_mesh,
+                                        std::map<std::string, std::vector<dirichlet>>& boundaries);
 
-    void allocate_displacement_boundary(json const& boundary, basic_mesh const& reference_mesh);
+    /// Allocate the boundary conditions of each of the \p "load_cases"
+    void allocate_load_cases(json const& simulation_data, basic_mesh const& basic_mesh);
 
     [[nodiscard]] bool is_nonfollower_load(std::string const& boundary_type) const;
 
@@ -98,6 +135,9 @@ protected:
     /// Nonfollower (force) boundary conditions
     std::map<std::string, nonfollower_load_boundary> nonfollower_loads;
 
+    /// Boundary conditions of the independent load cases
+    std::vector<load_case_type> load_case_boundaries;
+
     /// Nodal reaction forces
     vector reaction_forces;
 
@@ -116,5 +156,8 @@ protected:
 
     /// Output variables
     std::vector<variable::types> output_variables;
+
+    /// Output variables at the quadrature points
+    std::vector<variable::types> quadrature_output_variables;
 };
 }
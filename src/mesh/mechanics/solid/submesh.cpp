@@ -9,10 +9,12 @@
 #include "interpolations/interpolation_factory.hpp"
 #include "material/material_property.hpp"
 #include "mesh/material_coordinates.hpp"
+#include "io/post/node_averaged_variables.hpp"
 #include "numeric/gradient_operator.hpp"
 #include "numeric/mechanics"
 #include "mesh/dof_allocator.hpp"
 #include "traits/mechanics.hpp"
+#include "thread_policy.hpp"
 
 #include <termcolor/termcolor.hpp>
 
@@ -37,7 +39,7 @@ submesh::submesh(json const& material_data,
     // Allocate storage for the displacement gradient
     variables->add(variable::second::displacement_gradient,
                    variable::second::deformation_gradient,
-                   variable::second::cauchy_stress);
+                   variable::symmetric::cauchy_stress);
 
     variables->add(variable::scalar::DetF);
 
@@ -46,8 +48,18 @@ submesh::submesh(json const& material_data,
 
     std::fill(begin(deformation_gradients), end(deformation_gradients), matrix3::Identity());
 
+    // Avoid storing a tangent operator for each quadrature point if it can be
+    // computed from the current state during the assembly
+    if (cm->has_pointwise_tangent())
+    {
+        cm->evaluate_tangent_in_assembly();
+    }
+
     variables->commit();
 
+    // Place the variables in the memory of the threads processing the elements
+    variables->for_each_storage([](auto const& values) { thread_policy::distribute(values); });
+
     dof_allocator(node_indices, dof_indices, traits::dof_order);
 }
 
@@ -86,11 +98,11 @@ std::pair<index_view, vector const&> submesh::internal_force(std::int32_t const
 {
     auto const& x = coordinates->current_configuration(local_node_view(element));
 
-    auto const& cauchy_stresses = variables->get(variable::second::cauchy_stress);
+    auto const& cauchy_stresses = variables->get(variable::symmetric::cauchy_stress);
 
-    static vector f_int(nodes_per_element() * dofs_per_node());
+    thread_local vector f_int(nodes_per_element() * dofs_per_node());
 
-    f_int.setZero();
+    f_int.setZero(nodes_per_element() * dofs_per_node());
 
     sf->quadrature()
         .integrate_inplace(Eigen::Map<row_matrix>(f_int.data(), nodes_per_element(), dofs_per_node()),
@@ -99,7 +111,8 @@ std::pair<index_view, vector const&> submesh::internal_force(std::int32_t const
 
                                matrix3 const jacobian = local_deformation_gradient(dN, x);
 
-                               matrix3 const& cauchy_stress = cauchy_stresses[view(element, index)];
+                               auto const cauchy_stress = voigt::kinetic::view(
+                                   cauchy_stresses[view(element, index)]);
 
                                // symmetric gradient operator
                                matrix const Bt = dN * jacobian.inverse();
@@ -112,48 +125,65 @@ std::pair<index_view, vector const&> submesh::internal_force(std::int32_t const
 
 matrix const& submesh::geometric_tangent_stiffness(matrix3x const& x, std::int32_t const element) const
 {
-    auto const& cauchy_stresses = variables->get(variable::second::cauchy_stress);
+    auto const& cauchy_stresses = variables->get(variable::symmetric::cauchy_stress);
 
     thread_local matrix k_geo(nodes_per_element(), nodes_per_element());
 
     thread_local matrix k_geo_full(nodes_per_element() * dofs_per_node(),
                                    nodes_per_element() * dofs_per_node());
 
-    k_geo.setZero();
+    k_geo.setZero(nodes_per_element(), nodes_per_element());
 
     sf->quadrature().integrate_inplace(k_geo, [&](auto const& N_dN, auto const index) -> matrix {
         auto const& [N, dN] = N_dN;
 
         matrix3 const J = local_deformation_gradient(dN, x);
 
-        matrix3 const& cauchy_stress = cauchy_stresses[view(element, index)];
+        auto const cauchy_stress = voigt::kinetic::view(cauchy_stresses[view(element, index)]);
 
         matrix const L = local_gradient(dN, J);
 
         return L.transpose() * cauchy_stress * L * J.determinant();
     });
 
-    identity_expansion_inplace<3>(k_geo, k_geo_full.setZero());
+    identity_expansion_inplace<3>(k_geo,
+                                  k_geo_full.setZero(nodes_per_element() * dofs_per_node(),
+                                                     nodes_per_element() * dofs_per_node()));
 
     return k_geo_full;
 }
 
 matrix const& submesh::material_tangent_stiffness(matrix3x const& x, std::int32_t const element) const
 {
-    auto const& tangent_operators = variables->get(variable::fourth::tangent_operator);
+    // The stored tangent is either the full tangent or the upper triangle of a
+    // tangent with major symmetry and neither is stored when it is evaluated
+    auto const* tangent_operators = variables->has(variable::fourth::tangent_operator)
+                                        ? &variables->get(variable::fourth::tangent_operator)
+                                        : nullptr;
+
+    auto const* symmetric_tangent_operators =
+        variables->has(variable::major_symmetric::tangent_operator)
+            ? &variables->get(variable::major_symmetric::tangent_operator)
+            : nullptr;
 
     auto const local_dofs = nodes_per_element() * dofs_per_node();
 
     thread_local matrix k_mat(local_dofs, local_dofs);
     thread_local matrix B(6, local_dofs);
 
-    k_mat.setZero();
-    B.setZero();
+    // Resize for submeshes of a different topology processed by this thread
+    k_mat.setZero(local_dofs, local_dofs);
+    B.setZero(6, local_dofs);
 
     sf->quadrature().integrate_inplace(k_mat, [&](auto const& N_dN, auto const l) {
         auto const& [N, dN] = N_dN;
 
-        matrix6 const& D = tangent_operators[view(element, l)];
+        // Use the stored tangent or evaluate it at the quadrature point
+        matrix6 const D = tangent_operators ? (*tangent_operators)[view(element, l)]
+                          : symmetric_tangent_operators
+                              ? matrix6(voigt::major_symmetric::view(
+                                  (*symmetric_tangent_operators)[view(element, l)]))
+                              : cm->tangent_operator(view(element, l));
 
         matrix3 const jacobian = local_deformation_gradient(dN, x);
 
@@ -272,76 +302,43 @@ void submesh::update_Jacobian_determinants()
 
 std::pair<vector, vector> submesh::nodal_averaged_variable(variable::second const tensor_name) const
 {
-    vector count = vector::Zero(coordinates->size() * 9),
-           value = vector::Zero(coordinates->size() * 9);
-
     auto const& tensor_list = variables->get(tensor_name);
 
-    auto const& E = sf->local_quadrature_extrapolation();
+    // The tensor components are stored in row major order for each node
+    return extrapolate_to_nodes<9>(sf->local_quadrature_extrapolation(),
+                                    all_node_indices(),
+                                    coordinates->size(),
+                                    [&](auto const element, auto const l) {
+                                        matrix3 const tensor = tensor_list[view(element, l)].transpose();
+                                        return Eigen::Map<Eigen::Matrix<double, 1, 9> const>(tensor.data())
+                                            .eval();
+                                    });
+}
 
-    // vector format of values
-    vector component = vector::Zero(sf->quadrature().points());
+std::pair<vector, vector> submesh::nodal_averaged_variable(variable::symmetric const tensor_name) const
+{
+    auto const& tensor_list = variables->get(tensor_name);
 
-    for (std::int64_t e{0}; e < elements(); ++e)
-    {
-        // Assemble these into the global value vector
-        auto const& node_list = local_node_view(e);
-
-        for (auto ci = 0; ci < 3; ++ci)
-        {
-            for (auto cj = 0; cj < 3; ++cj)
-            {
-                for (std::size_t l{0}; l < sf->quadrature().points(); ++l)
-                {
-                    auto const& tensor = tensor_list[view(e, l)];
-                    component(l) = tensor(ci, cj);
-                }
-
-                // Local extrapolation to the nodes
-                vector const nodal_component = E * component;
-
-                for (auto n = 0; n < nodal_component.rows(); n++)
-                {
-                    value(node_list[n] * 9 + ci * 3 + cj) += nodal_component(n);
-                    count(node_list[n] * 9 + ci * 3 + cj) += 1.0;
-                }
-            }
-        }
-    }
-    return {value, count};
+    return extrapolate_to_nodes<9>(sf->local_quadrature_extrapolation(),
+                                    all_node_indices(),
+                                    coordinates->size(),
+                                    [&](auto const element, auto const l) {
+                                        matrix3 const tensor = voigt::kinetic::view(
+                                            tensor_list[view(element, l)]);
+                                        return Eigen::Map<Eigen::Matrix<double, 1, 9> const>(tensor.data())
+                                            .eval();
+                                    });
 }
 
 std::pair<vector, vector> submesh::nodal_averaged_variable(variable::scalar const scalar_name) const
 {
-    vector count = vector::Zero(coordinates->size());
-    vector value = count;
-
     auto const& scalar_list = variables->get(scalar_name);
 
-    auto const& E = sf->local_quadrature_extrapolation();
-
-    // vector format of values
-    vector component = vector::Zero(sf->quadrature().points());
-
-    for (std::int64_t e{0}; e < elements(); ++e)
-    {
-        // Assemble these into the global value vector
-        auto const& node_list = local_node_view(e);
-
-        for (std::size_t l{0}; l < sf->quadrature().points(); ++l)
-        {
-            component(l) = scalar_list[view(e, l)];
-        }
-
-        // Local extrapolation to the nodes
-        vector const nodal_component = E * component;
-
-        for (auto n = 0; n < nodal_component.rows(); n++)
-        {
-            value(node_list[n]) += nodal_component(n);
-            count(node_list[n]) += 1.0;
-        }
-    }
-    return {value, count};
+    return extrapolate_to_nodes<1>(sf->local_quadrature_extrapolation(),
+                                   all_node_indices(),
+                                   coordinates->size(),
+                                   [&](auto const element, auto const l) {
+                                       return Eigen::Matrix<double, 1, 1>(scalar_list[view(element, l)]);
+                                   });
 }
 }
@@ -43,6 +43,22 @@ std::unordered_map<element_topology, VTKCellType> const
                   {element_topology::hexahedron20, VTK_QUADRATIC_HEXAHEDRON},
                   {element_topology::hexahedron27, VTK_TRIQUADRATIC_HEXAHEDRON}};
 
+std::unordered_map<element_topology, std::int32_t> const
+    xdmf_converter{{element_topology::line2, 2},
+                   {element_topology::triangle3, 4},
+                   {element_topology::quadrilateral4, 5},
+                   {element_topology::quadrilateral8, 37},
+                   {element_topology::quadrilateral9, 35},
+                   {element_topology::tetrahedron4, 6},
+                   {element_topology::hexahedron8, 9},
+                   {element_topology::prism6, 8},
+                   {element_topology::pyramid5, 7},
+                   {element_topology::triangle6, 36},
+                   {element_topology::tetrahedron10, 38},
+                   {element_topology::prism15, 40},
+                   {element_topology::hexahedron20, 48},
+                   {element_topology::hexahedron27, 50}};
+
 void convert_from_gmsh(indices& node_indices, element_topology const topology)
 {
     // Reorder based on the differences between the local node numbering
@@ -352,4 +368,15 @@ VTKCellType to_vtk(element_topology const topology)
     }
     return found->second;
 }
+
+std::int32_t to_xdmf(element_topology const topology)
+{
+    auto const found = xdmf_converter.find(topology);
+    if (found == xdmf_converter.end())
+    {
+        throw std::domain_error("Element code " + std::to_string(static_cast<int>(topology))
+                                + " not implemented for xdmf element type");
+    }
+    return found->second;
+}
 } // namespace neon
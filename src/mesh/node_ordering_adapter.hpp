@@ -26,4 +26,8 @@ void convert_from_gmsh(indices& nodal_connectivity, element_topology const topol
 
 /// Convert the \p neon topology type to the \p VTKCellType
 [[nodiscard]] VTKCellType to_vtk(element_topology const topology);
+
+/// Convert the \p neon topology type to the XDMF mixed topology cell code.
+/// The XDMF node ordering is the same as the VTK node ordering
+[[nodiscard]] std::int32_t to_xdmf(element_topology const topology);
 }
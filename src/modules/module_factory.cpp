@@ -9,14 +9,15 @@
 
 #include "geometry/profile.hpp"
 
+#include "solver/linear/linear_solver_factory.hpp"
+
 #include "io/json.hpp"
 
 namespace neon
 {
-std::unique_ptr<abstract_module> make_module(
-    json const& simulation,
-    std::map<std::string, std::pair<basic_mesh, json>> const& mesh_store,
-    std::map<std::string, std::unique_ptr<geometry::profile>> const& profile_store)
+namespace
+{
+void check_mandatory_fields(json const& simulation)
 {
     if (simulation.find("name") == simulation.end())
     {
@@ -30,6 +31,15 @@ std::unique_ptr<abstract_module> make_module(
     {
         throw std::domain_error("\"solution\" field must be specified");
     }
+}
+}
+
+std::unique_ptr<abstract_module> make_module(
+    json const& simulation,
+    std::map<std::string, std::pair<basic_mesh, json>> const& mesh_store,
+    std::map<std::string, std::unique_ptr<geometry::profile>> const& profile_store)
+{
+    check_mandatory_fields(simulation);
 
     auto const& mesh_data = simulation["meshes"].front();
 
@@ -70,17 +80,33 @@ std::unique_ptr<abstract_module> make_module(
                                                                                          material,
                                                                                          simulation);
         }
+        else if (solution_type == "load_cases")
+        {
+            return std::make_unique<
+                solid_mechanics_module<mechanics::load_case_matrix<mechanics::solid::mesh>>>(
+                mesh, material, simulation);
+        }
 
-        throw std::domain_error("\"solution\" is not valid.  Please use \"equilibrium\"");
+        throw std::domain_error("\"solution\" is not valid.  Please use \"equilibrium\" or "
+                                "\"load_cases\"");
     }
     else if (module_type == "plane_strain")
     {
+        if (solution_type == "load_cases")
+        {
+            return std::make_unique<
+                plane_strain_module<mechanics::load_case_matrix<mechanics::plane::mesh>>>(
+                mesh, material, simulation);
+        }
         if (simulation.find("nonlinear_options") == simulation.end())
         {
             throw std::domain_error("\"nonlinear_options\" needs to be present for a "
                                     "plane_strain simulation");
         }
-        return std::make_unique<plane_strain_module>(mesh, material, simulation);
+        return std::make_unique<
+            plane_strain_module<mechanics::static_matrix<mechanics::plane::mesh>>>(mesh,
+                                                                                  material,
+                                                                                  simulation);
     }
     else if (module_type == "beam")
     {
@@ -108,4 +134,97 @@ std::unique_ptr<abstract_module> make_module(
                               "\"heat_diffusion\"\n");
     return nullptr;
 }
+
+std::unique_ptr<abstract_module> make_module(
+    json const& simulation,
+    json const& parent_simulation,
+    std::unique_ptr<abstract_module> parent,
+    std::map<std::string, std::pair<basic_mesh, json>> const& mesh_store,
+    std::map<std::string, std::unique_ptr<geometry::profile>> const& profile_store)
+{
+    using equilibrium_module = solid_mechanics_module<
+        mechanics::static_matrix<mechanics::solid::mesh>>;
+
+    auto const is_same_field = [&](auto const& field) {
+        return simulation.find(field) != simulation.end()
+               && parent_simulation.find(field) != parent_simulation.end()
+               && simulation[field] == parent_simulation[field];
+    };
+
+    if (is_same_field("module") && is_same_field("solution")
+        && simulation["meshes"].front()["name"] == parent_simulation["meshes"].front()["name"])
+    {
+        if (auto continued = dynamic_cast<equilibrium_module*>(parent.get()))
+        {
+            std::string const& name = simulation["name"];
+            std::string const& parent_name = parent_simulation["name"];
+
+            std::cout << std::string(4, ' ') << "Name     \"" << name << "\" continues \""
+                      << parent_name << "\"\n";
+
+            auto const& mesh_data = simulation["meshes"].front();
+
+            auto const& mesh = mesh_store.find(mesh_data["name"].get<std::string>())->second.first;
+
+            return std::make_unique<equilibrium_module>(std::move(*continued), mesh, simulation);
+        }
+    }
+    // Release the parent state before the next module is allocated
+    parent.reset();
+
+    return make_module(simulation, mesh_store, profile_store);
+}
+
+void check_module(json const& simulation,
+                  std::map<std::string, std::pair<basic_mesh, json>> const& mesh_store)
+{
+    check_mandatory_fields(simulation);
+
+    auto const& mesh_data = simulation["meshes"].front();
+
+    auto const& mesh = mesh_store.find(mesh_data["name"].get<std::string>())->second.first;
+
+    if (!mesh.has(mesh_data["name"].get<std::string>()))
+    {
+        throw std::domain_error("Mesh name " + mesh_data["name"].dump()
+                                + " does not exist in the mesh store");
+    }
+
+    if (mesh_data.find("boundaries") != mesh_data.end())
+    {
+        for (auto const& boundary : mesh_data["boundaries"])
+        {
+            for (auto const& mandatory_field : {"name", "type"})
+            {
+                if (!boundary.count(mandatory_field))
+                {
+                    throw std::domain_error("\"" + std::string(mandatory_field)
+                                            + "\" was not specified in \"boundary\".");
+                }
+            }
+            if (!mesh.has(boundary["name"].get<std::string>()))
+            {
+                throw std::domain_error("Boundary name " + boundary["name"].dump()
+                                        + " does not exist in the mesh store");
+            }
+        }
+    }
+
+    if (simulation.find("linear_solver") != simulation.end())
+    {
+        make_linear_solver(simulation["linear_solver"]);
+    }
+
+    std::string const& module_type = simulation["module"];
+
+    if ((module_type == "solid_mechanics" || module_type == "plane_strain")
+        && simulation["solution"] == "equilibrium")
+    {
+        if (simulation.find("nonlinear_options") == simulation.end())
+        {
+            throw std::domain_error("\"nonlinear_options\" needs to be present for a "
+                                    + module_type + " simulation");
+        }
+    }
+}
 }
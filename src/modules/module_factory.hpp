@@ -22,4 +22,21 @@ std::unique_ptr<abstract_module> make_module(
     json const& simulation,
     std::map<std::string, std::pair<basic_mesh, json>> const& mesh_store,
     std::map<std::string, std::unique_ptr<geometry::profile>> const& profile_store);
+
+/// Construct the module for a simulation step that inherits from the step
+/// \p parent_simulation.  The converged state of \p parent is moved into the
+/// new module when both steps use the same module, solution and mesh.
+/// Otherwise a new module is constructed and \p parent is released
+std::unique_ptr<abstract_module> make_module(
+    json const& simulation,
+    json const& parent_simulation,
+    std::unique_ptr<abstract_module> parent,
+    std::map<std::string, std::pair<basic_mesh, json>> const& mesh_store,
+    std::map<std::string, std::unique_ptr<geometry::profile>> const& profile_store);
+
+/// Check the mesh, the boundary and the linear solver data of a simulation
+/// step without constructing the module.  The module of an inheriting step is
+/// only constructed after the parent step has been solved
+void check_module(json const& simulation,
+                  std::map<std::string, std::pair<basic_mesh, json>> const& mesh_store);
 }
@@ -3,9 +3,10 @@
 
 namespace neon
 {
-plane_strain_module::plane_strain_module(basic_mesh const& mesh,
-                                         json const& material,
-                                         json const& simulation)
+template <typename matrix_type>
+plane_strain_module<matrix_type>::plane_strain_module(basic_mesh const& mesh,
+                                                      json const& material,
+                                                      json const& simulation)
     : fem_mesh(mesh,
                material,
                simulation["meshes"].front(),
@@ -13,4 +14,7 @@ plane_strain_module::plane_strain_module(basic_mesh const& mesh,
       fem_matrix(fem_mesh, simulation)
 {
 }
+
+template class plane_strain_module<mechanics::static_matrix<mechanics::plane::mesh>>;
+template class plane_strain_module<mechanics::load_case_matrix<mechanics::plane::mesh>>;
 }
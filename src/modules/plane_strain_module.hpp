@@ -4,6 +4,7 @@
 #include "abstract_module.hpp"
 
 #include "assembler/mechanics/static_matrix.hpp"
+#include "assembler/mechanics/load_case_matrix.hpp"
 #include "mesh/mechanics/plane/mesh.hpp"
 
 namespace neon
@@ -18,11 +19,13 @@ namespace plane_strain
 }
 }
 
+/// plane_strain_module is responsible for handling the setup and simulation
+/// of the class for plane strain problems
+template <typename matrix_type>
 class plane_strain_module : public abstract_module
 {
 public:
     using mesh_type = mechanics::plane::mesh;
-    using matrix_type = mechanics::static_matrix<mesh_type>;
 
 public:
     plane_strain_module(basic_mesh const& mesh, json const& material, json const& simulation);
@@ -41,4 +44,6 @@ protected:
     /// Nonlinear solver routines
     matrix_type fem_matrix;
 };
+extern template class plane_strain_module<mechanics::static_matrix<mechanics::plane::mesh>>;
+extern template class plane_strain_module<mechanics::load_case_matrix<mechanics::plane::mesh>>;
 }
@@ -17,8 +17,29 @@ solid_mechanics_module<matrix_type>::solid_mechanics_module(basic_mesh const& me
 {
 }
 
+template <typename matrix_type>
+template <typename parent_matrix_type>
+solid_mechanics_module<matrix_type>::solid_mechanics_module(
+    solid_mechanics_module<parent_matrix_type>&& parent,
+    basic_mesh const& mesh,
+    json const& simulation)
+    : fem_mesh(std::move(parent.fem_mesh),
+               mesh,
+               simulation["meshes"].front(),
+               simulation["time"]["increments"]["initial"]),
+      fem_matrix(fem_mesh, simulation, std::move(parent.fem_matrix))
+{
+}
+
 template class solid_mechanics_module<mechanics::static_matrix<mechanics::solid::mesh>>;
 template class solid_mechanics_module<mechanics::latin_matrix<mechanics::solid::mesh>>;
+template class solid_mechanics_module<mechanics::load_case_matrix<mechanics::solid::mesh>>;
+
+template solid_mechanics_module<mechanics::static_matrix<mechanics::solid::mesh>>::
+    solid_mechanics_module(
+        solid_mechanics_module<mechanics::static_matrix<mechanics::solid::mesh>>&&,
+        basic_mesh const&,
+        json const&);
 
 linear_buckling_module::linear_buckling_module(basic_mesh const& mesh,
                                                json const& material,
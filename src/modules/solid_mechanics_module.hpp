@@ -5,6 +5,7 @@
 
 #include "assembler/mechanics/static_matrix.hpp"
 #include "assembler/mechanics/latin_matrix.hpp"
+#include "assembler/mechanics/load_case_matrix.hpp"
 
 #include "assembler/mechanics/linear_buckling_matrix.hpp"
 #include "assembler/mechanics/natural_frequency_matrix.hpp"
@@ -37,6 +38,15 @@ public:
 public:
     solid_mechanics_module(basic_mesh const& mesh, json const& material, json const& simulation);
 
+    /// Continue the converged state of \p parent with the next simulation
+    /// step.  The mesh and the matrix system are moved from \p parent.  This
+    /// is only instantiated for the equilibrium solution since the LATIN
+    /// solution starts from the initial state
+    template <typename parent_matrix_type>
+    solid_mechanics_module(solid_mechanics_module<parent_matrix_type>&& parent,
+                           basic_mesh const& mesh,
+                           json const& simulation);
+
     virtual ~solid_mechanics_module() = default;
 
     solid_mechanics_module(solid_mechanics_module const&) = delete;
@@ -53,6 +63,7 @@ protected:
 };
 extern template class solid_mechanics_module<mechanics::static_matrix<mechanics::solid::mesh>>;
 extern template class solid_mechanics_module<mechanics::latin_matrix<mechanics::solid::mesh>>;
+extern template class solid_mechanics_module<mechanics::load_case_matrix<mechanics::solid::mesh>>;
 
 /// linear_buckling_module is responsible for handling the setup
 /// and simulation of the class for three dimensional linear (eigenvalue)
@@ -21,6 +21,28 @@ namespace detail
     return std::sqrt(3.0 / 2.0) * deviatoric(a).norm();
 }
 
+/// Compute the von Mises stress based on the reduced stress tensor in Voigt
+/// notation \sa voigt::kinetic
+[[nodiscard]] inline auto von_mises_stress(vector3 const& a)
+{
+    auto const mean = (a(0) + a(1)) / 3.0;
+
+    return std::sqrt(3.0 / 2.0
+                     * (std::pow(a(0) - mean, 2) + std::pow(a(1) - mean, 2)
+                        + 2.0 * std::pow(a(2), 2)));
+}
+
+/// Compute the von Mises stress based on the full stress tensor in Voigt
+/// notation \sa voigt::kinetic
+[[nodiscard]] inline auto von_mises_stress(vector6 const& a)
+{
+    auto const mean = a.head<3>().sum() / 3.0;
+
+    return std::sqrt(3.0 / 2.0
+                     * ((a.head<3>().array() - mean).square().sum()
+                        + 2.0 * a.tail<3>().squaredNorm()));
+}
+
 [[nodiscard]] inline matrix2 compute_cauchy_stress(double const G,
                                                    double const lambda_e,
                                                    matrix2 const& elastic_strain)
@@ -34,6 +56,28 @@ namespace detail
 {
     return lambda_e * elastic_strain.trace() * matrix3::Identity() + 2.0 * G * elastic_strain;
 }
+
+/// Compute the Cauchy stress from the reduced elastic strain in Voigt notation
+/// \sa voigt::kinetic
+[[nodiscard]] inline vector3 compute_cauchy_stress(double const G,
+                                                   double const lambda_e,
+                                                   vector3 const& elastic_strain)
+{
+    vector3 cauchy_stress = 2.0 * G * elastic_strain;
+    cauchy_stress.head<2>().array() += lambda_e * elastic_strain.head<2>().sum();
+    return cauchy_stress;
+}
+
+/// Compute the Cauchy stress from the elastic strain in Voigt notation
+/// \sa voigt::kinetic
+[[nodiscard]] inline vector6 compute_cauchy_stress(double const G,
+                                                   double const lambda_e,
+                                                   vector6 const& elastic_strain)
+{
+    vector6 cauchy_stress = 2.0 * G * elastic_strain;
+    cauchy_stress.head<3>().array() += lambda_e * elastic_strain.head<3>().sum();
+    return cauchy_stress;
+}
 }
 
 /// Compute the von Mises stress of the stress tensor
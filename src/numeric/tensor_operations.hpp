@@ -3,6 +3,8 @@
 
 #include "dense_matrix.hpp"
 
+#include <algorithm>
+
 /// \file tensor_operations.hpp
 /// \brief Collection of tensor operations
 
@@ -404,6 +406,46 @@ template <typename matrix_expression>
     return detail::to(a.eval());
 }
 
+namespace detail
+{
+/// Reads the component of a symmetric second order tensor in Voigt notation
+/// from the tensor indices.  The off diagonal index is the number of packed
+/// components less the sum of the tensor indices \sa view
+template <int size>
+class symmetric_component
+{
+public:
+    explicit symmetric_component(Eigen::Matrix<double, size, 1> const& a) : a(a) {}
+
+    [[nodiscard]] double operator()(Eigen::Index const i, Eigen::Index const j) const
+    {
+        return a(i == j ? i : size - i - j);
+    }
+
+private:
+    Eigen::Matrix<double, size, 1> const& a;
+};
+}
+
+/// \return a read-only expression of the symmetric second order tensor stored
+/// in Voigt notation in \p a.  The components are read from \p a on access,
+/// so the tensor is not expanded into a copy and the view must not outlive \p a
+template <int size>
+[[nodiscard]] inline auto view(Eigen::Matrix<double, size, 1> const& a)
+{
+    static_assert(size == 3 || size == 6, "Voigt notation of a two or three dimensional tensor");
+
+    auto constexpr dimension = size == 6 ? 3 : 2;
+
+    return Eigen::Matrix<double, dimension, dimension>::NullaryExpr(dimension,
+                                                                   dimension,
+                                                                   detail::symmetric_component<size>(a));
+}
+
+/// A view of a temporary would dangle
+template <int size>
+void view(Eigen::Matrix<double, size, 1>&& a) = delete;
+
 /// Compute the deviatoric tensor in Voigt notation according to
 /// \f$ \mathbb{P} = \frac{1}{2}(\delta_{ik} \delta_{jl} + \delta_{il} \delta_{jk}) -
 /// \frac{1}{3}\delta_{ij} \delta_{kl} \f$
@@ -423,6 +465,75 @@ template <typename matrix_expression>
 /// \f$ \mathbb{I} = \delta_{ijkl} \f$
 [[nodiscard]] inline matrix6 fourth_order_identity() { return matrix6::Identity(); }
 }
+
+//! Fourth order tensors with major symmetry in Voigt notation, where the
+//! upper triangle is packed row by row (tangent operator type)
+namespace major_symmetric
+{
+namespace detail
+{
+/// \return the dimension of the Voigt notation with \p size packed components
+[[nodiscard]] constexpr int dimension(int const size)
+{
+    int n{0};
+    while (n * (n + 1) / 2 < size) ++n;
+    return n;
+}
+
+/// Reads the component of a fourth order tensor with major symmetry in Voigt
+/// notation from the row and the column of the upper triangle \sa view
+template <int size>
+class upper_component
+{
+public:
+    explicit upper_component(Eigen::Matrix<double, size, 1> const& a) : a(a) {}
+
+    [[nodiscard]] double operator()(Eigen::Index const i, Eigen::Index const j) const
+    {
+        auto const row = std::min(i, j);
+        auto const column = std::max(i, j);
+
+        return a(row * n - row * (row - 1) / 2 + column - row);
+    }
+
+private:
+    static auto constexpr n = dimension(size);
+
+    Eigen::Matrix<double, size, 1> const& a;
+};
+}
+
+/// Pack the upper triangle of a fourth order tensor in Voigt notation.  The
+/// lower triangle is assumed to be the transpose and is not read
+template <int n>
+[[nodiscard]] inline Eigen::Matrix<double, n*(n + 1) / 2, 1> to(Eigen::Matrix<double, n, n> const& a)
+{
+    Eigen::Matrix<double, n*(n + 1) / 2, 1> b;
+
+    for (Eigen::Index i{0}, offset{0}; i < n; offset += n - i, ++i)
+    {
+        b.segment(offset, n - i) = a.row(i).tail(n - i).transpose();
+    }
+    return b;
+}
+
+/// \return a read-only expression of the fourth order tensor with major
+/// symmetry stored in \p a, which is not expanded into a copy and must not
+/// outlive \p a \sa voigt::kinetic::view
+template <int size>
+[[nodiscard]] inline auto view(Eigen::Matrix<double, size, 1> const& a)
+{
+    auto constexpr n = detail::dimension(size);
+
+    static_assert(n * (n + 1) / 2 == size, "Packed upper triangle of a square matrix");
+
+    return Eigen::Matrix<double, n, n>::NullaryExpr(n, n, detail::upper_component<size>(a));
+}
+
+/// A view of a temporary would dangle
+template <int size>
+void view(Eigen::Matrix<double, size, 1>&& a) = delete;
+}
 }
 /*! @} End of Doxygen Groups */
 
@@ -2,13 +2,18 @@
 #include "simulation_parser.hpp"
 
 #include "exceptions.hpp"
+#include "telemetry.hpp"
+#include "thread_policy.hpp"
 #include "geometry/profile_factory.hpp"
 #include "modules/abstract_module.hpp"
 #include "modules/module_factory.hpp"
+#include "solver/linear/ordering_cache.hpp"
 
 #include <iomanip>
 #include <fstream>
+#include <iterator>
 #include <thread>
+#include <vector>
 
 #include <boost/filesystem.hpp>
 #include <termcolor/termcolor.hpp>
@@ -58,9 +63,17 @@ void simulation_parser::parse()
 
     this->check_input_fields();
 
-    if (root.find("cores") != end(root))
+    // Size the threading runtimes before any parallel work is performed
+    policy = std::make_unique<thread_policy>(root);
+
+    threads = policy->threads();
+
+    telemetry::configure(root);
+
+    if (root.find("ordering_cache") != end(root) && root["ordering_cache"].get<bool>())
     {
-        threads = root["cores"];
+        cache = std::make_unique<ordering_cache>(root["name"].get<std::string>()
+                                                 + ".ordering_cache");
     }
 
     if (root.find("materials") == end(root))
@@ -146,19 +159,45 @@ void simulation_parser::parse()
 
 void simulation_parser::start()
 {
-    // Construct the modules and automatically check for correct input.
-    // Throws the appropriate exception when an error is detected.
+    // Check the input of every step before the first step is solved.  The
+    // first module of each chain is constructed here, while the inheriting
+    // modules are constructed from the state of the completed parent step
+    std::vector<std::unique_ptr<abstract_module>> modules;
+
     for (auto const& [name, simulations] : multistep_simulations)
     {
-        for (auto const& simulation : simulations)
+        modules.emplace_back(make_module(simulations.front(), mesh_store, profile_store));
+
+        for (auto simulation = std::next(begin(simulations)); simulation != end(simulations);
+             ++simulation)
         {
-            modules.emplace_back(make_module(simulation, mesh_store, profile_store));
+            check_module(*simulation, mesh_store);
         }
     }
-    for (auto const& module : modules)
+
+    auto first_module = begin(modules);
+
+    for (auto const& [name, simulations] : multistep_simulations)
     {
+        auto module = std::move(*first_module++);
+
         module->perform_simulation();
+
+        for (auto simulation = std::next(begin(simulations)); simulation != end(simulations);
+             ++simulation)
+        {
+            module = make_module(*simulation,
+                                 *std::prev(simulation),
+                                 std::move(module),
+                                 mesh_store,
+                                 profile_store);
+
+            module->perform_simulation();
+        }
     }
+    if (cache != nullptr) cache->save();
+
+    telemetry::write();
 }
 
 void simulation_parser::build_simulation_tree()
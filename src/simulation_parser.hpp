@@ -19,6 +19,8 @@ namespace geometry
 class profile;
 }
 class abstract_module;
+class ordering_cache;
+class thread_policy;
 
 class simulation_parser
 {
@@ -66,10 +68,13 @@ protected:
 
     std::map<std::string, std::list<json>> multistep_simulations;
 
-    /// Simulation modules to run
-    std::vector<std::unique_ptr<abstract_module>> modules;
-
     /// The file input
     json root;
+
+    /// Threading policy for the duration of the simulation
+    std::unique_ptr<thread_policy> policy;
+
+    /// Optional cache of the sparsity patterns and the orderings
+    std::unique_ptr<ordering_cache> cache;
 };
 }
@@ -2,13 +2,19 @@
 #include "adaptive_time_step.hpp"
 
 #include "numeric/float_compare.hpp"
+#include "io/binary_archive.hpp"
 #include "io/json.hpp"
 
+#include <algorithm>
+#include <cmath>
 #include <exception>
 #include <termcolor/termcolor.hpp>
 
 namespace neon
 {
+/// Relative tolerance of a time with respect to the cycle period
+static double constexpr phase_tolerance{1.0e-8};
+
 adaptive_time_step::adaptive_time_step(json const& increment_data,
                                        std::vector<double> mandatory_time_history)
 {
@@ -36,6 +42,12 @@ void adaptive_time_step::update_convergence_state(bool const is_converged)
         last_converged_time_step_size = current_time - last_converged_time;
         last_converged_time = current_time;
 
+        is_cycle_end = cycle_period > 0.0
+                       && std::abs(std::remainder(last_converged_time, cycle_period))
+                              < phase_tolerance * cycle_period;
+
+        if (is_cycle_end) completed_cycles++;
+
         is_applied = is_approx(current_time, final_time) || time_queue.empty();
 
         consecutive_unconverged = 0;
@@ -60,6 +72,8 @@ void adaptive_time_step::update_convergence_state(bool const is_converged)
     }
     else
     {
+        is_cycle_end = false;
+
         auto const dt = std::max(minimum_increment,
                                  (current_time - last_converged_time) * cutback_factor);
 
@@ -92,6 +106,54 @@ void adaptive_time_step::update_convergence_state(bool const is_converged)
     }
 }
 
+double adaptive_time_step::cycle_jump(double const rate, double const error) const
+{
+    if (!is_cycle_jump_possible()) return 0.0;
+
+    // Whole cycles remaining in the load case after resolving the next cycles
+    auto const remaining_cycles = std::floor((final_time - last_converged_time) / cycle_period
+                                             + phase_tolerance)
+                                  - resolved_cycles;
+
+    // Limit the change of the variables over the jump
+    auto const change_cycles = rate > 0.0 ? maximum_change / rate : maximum_cycles;
+
+    // The error of a linear extrapolation over n cycles is approximately
+    // n (n + 1) / 2 times the second difference per cycle
+    auto const error_cycles = error > 0.0 ? std::sqrt(2.0 * jump_tolerance / error) : maximum_cycles;
+
+    return std::max(0.0,
+                    std::floor(std::min({change_cycles, error_cycles, maximum_cycles, remaining_cycles})));
+}
+
+void adaptive_time_step::jump(double const cycles)
+{
+    auto constexpr terminal_indent{4};
+
+    auto const duration = cycles * cycle_period;
+
+    last_converged_time += duration;
+    current_time += duration;
+
+    // Mandatory times inside the jump are skipped over
+    while (!time_queue.empty() && time_queue.top() < last_converged_time + phase_tolerance * cycle_period)
+    {
+        time_queue.pop();
+    }
+
+    if (!time_queue.empty()) current_time = std::min(current_time, time_queue.top());
+
+    current_time = std::min(current_time, final_time);
+
+    completed_cycles = 0;
+    is_cycle_end = false;
+
+    std::cout << std::string(terminal_indent, ' ') << termcolor::cyan << termcolor::bold
+              << "Cycle jump over " << cycles << " cycles - step time set to " << current_time
+              << " for next attempt\n"
+              << termcolor::reset << std::flush;
+}
+
 void adaptive_time_step::reset(json const& new_increment_data)
 {
     // Update the history counters
@@ -103,6 +165,55 @@ void adaptive_time_step::reset(json const& new_increment_data)
 
     last_converged_time = last_converged_time_step_size = 0.0;
     consecutive_unconverged = consecutive_converged = 0;
+
+    completed_cycles = 0;
+    is_cycle_end = false;
+}
+
+void adaptive_time_step::save(io::binary_output_archive& archive) const
+{
+    archive.write(std::make_tuple(successful_increments,
+                                  consecutive_converged,
+                                  consecutive_unconverged,
+                                  current_time,
+                                  total_time,
+                                  last_converged_time,
+                                  last_converged_time_step_size,
+                                  is_applied,
+                                  completed_cycles,
+                                  is_cycle_end));
+
+    // Remaining mandatory time points
+    auto remaining_times = time_queue;
+
+    std::vector<double> times;
+    times.reserve(remaining_times.size());
+
+    for (; !remaining_times.empty(); remaining_times.pop())
+    {
+        times.emplace_back(remaining_times.top());
+    }
+    archive.write(times);
+}
+
+void adaptive_time_step::load(io::binary_input_archive& archive)
+{
+    auto state = std::tie(successful_increments,
+                          consecutive_converged,
+                          consecutive_unconverged,
+                          current_time,
+                          total_time,
+                          last_converged_time,
+                          last_converged_time_step_size,
+                          is_applied,
+                          completed_cycles,
+                          is_cycle_end);
+    archive.read(state);
+
+    std::vector<double> times;
+    archive.read(times);
+
+    time_queue = decltype(time_queue)(begin(times), end(times));
 }
 
 void adaptive_time_step::parse_input(json const& increment_data, double const maximum_mandatory_time)
@@ -121,6 +232,8 @@ void adaptive_time_step::parse_input(json const& increment_data, double const ma
 
     final_time = increment_data["period"];
 
+    parse_cycle_jump(increment_data);
+
     if (maximum_mandatory_time > final_time)
     {
         std::cout << std::string(2, ' ') << termcolor::yellow << termcolor::bold
@@ -159,6 +272,51 @@ void adaptive_time_step::check_increment_data(json const& increment_data)
     }
 }
 
+void adaptive_time_step::parse_cycle_jump(json const& increment_data)
+{
+    cycle_period = 0.0;
+
+    if (increment_data.find("cycle_jump") == increment_data.end()) return;
+
+    auto const& cycle_data = increment_data["cycle_jump"];
+
+    for (auto const& mandatory_field : {"period", "tolerance"})
+    {
+        if (cycle_data.find(mandatory_field) == cycle_data.end())
+        {
+            throw std::domain_error("\"cycle_jump\" requires a \"" + std::string(mandatory_field)
+                                    + "\" value\n");
+        }
+    }
+
+    cycle_period = cycle_data["period"];
+    jump_tolerance = cycle_data["tolerance"];
+
+    if (cycle_period <= 0.0 || jump_tolerance <= 0.0)
+    {
+        throw std::domain_error("\"cycle_jump\" period and tolerance must be positive\n");
+    }
+
+    if (cycle_data.find("resolved_cycles") != cycle_data.end())
+    {
+        resolved_cycles = cycle_data["resolved_cycles"];
+    }
+    if (cycle_data.find("maximum_change") != cycle_data.end())
+    {
+        maximum_change = cycle_data["maximum_change"];
+    }
+    if (cycle_data.find("maximum_cycles") != cycle_data.end())
+    {
+        maximum_cycles = cycle_data["maximum_cycles"];
+    }
+
+    // Three cycles are required to estimate the extrapolation error
+    if (resolved_cycles < 3)
+    {
+        throw std::domain_error("\"cycle_jump\" requires at least three \"resolved_cycles\"\n");
+    }
+}
+
 bool adaptive_time_step::is_highly_nonlinear() const
 {
     return consecutive_unconverged > 0 || consecutive_converged < 4;
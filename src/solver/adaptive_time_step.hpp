@@ -9,6 +9,12 @@
 
 namespace neon
 {
+namespace io
+{
+class binary_output_archive;
+class binary_input_archive;
+}
+
 /**
  * adaptive_time_step responsibility is to handle the time step for each
  * SimulationCase (see input file).
@@ -64,6 +70,14 @@ namespace neon
  * require the load factor from this algorithm.  If g is the applied value
  * for a Dirichlet condition, then g depends on α (load factor) such that g(α).
  *
+ * For long periodic loading histories an optional cycle jump can be specified
+ * with the time data.  After a number of resolved load cycles the slowly
+ * varying internal variables are extrapolated over a number of cycles which
+ * is determined from their change per cycle and an estimate of the
+ * extrapolation error.  The time is then advanced by the same number of
+ * periods and the next cycles are resolved.  This assumes the loading is
+ * periodic with the cycle period over the jump.
+ *
  * TODO This class can be extended by including a smart prediction algorithm
  * for the determination of the best next step.
  */
@@ -93,13 +107,40 @@ public:
     /// Update the convergence state to determine the next increment
     void update_convergence_state(bool const is_converged);
 
+    /// \return true if the last converged time completed a load cycle
+    [[nodiscard]] bool is_cycle_completed() const noexcept { return is_cycle_end; }
+
+    /// \return true if enough load cycles have been resolved to attempt a jump
+    [[nodiscard]] bool is_cycle_jump_possible() const noexcept
+    {
+        return is_cycle_end && completed_cycles >= resolved_cycles;
+    }
+
+    /// Compute the number of load cycles to jump over
+    /// \param rate Largest relative change of the variables per cycle
+    /// \param error Largest relative second difference of the variables
+    /// \return number of whole cycles or zero if a jump is not possible
+    [[nodiscard]] double cycle_jump(double const rate, double const error) const;
+
+    /// Advance the converged time by a number of load cycles
+    void jump(double const cycles);
+
     void reset(json const& new_increment_data);
 
+    /// Write the time stepping progress to the \p archive for a restart
+    void save(io::binary_output_archive& archive) const;
+
+    /// Read the time stepping progress from the \p archive.  The time step
+    /// parameters are taken from the input data
+    void load(io::binary_input_archive& archive);
+
 protected:
     void parse_input(json const& increment_data, double const maximum_mandatory_time);
 
     void check_increment_data(json const& increment_data);
 
+    void parse_cycle_jump(json const& increment_data);
+
     [[nodiscard]] bool is_highly_nonlinear() const;
 
 protected:
@@ -131,6 +172,21 @@ protected:
 
     bool is_applied{false};
 
+    /// Period of the load cycle or zero without cycle jumps
+    double cycle_period{0.0};
+    /// Minimum number of resolved cycles between jumps
+    std::int32_t resolved_cycles{3};
+    /// Number of cycles completed since the last jump
+    std::int32_t completed_cycles{0};
+    /// Relative error tolerance of the extrapolation
+    double jump_tolerance{1.0e-3};
+    /// Largest relative change of the variables in a jump
+    double maximum_change{0.1};
+    /// Largest number of cycles in a jump
+    double maximum_cycles{1.0e6};
+    /// Flag if the last converged time completed a load cycle
+    bool is_cycle_end{false};
+
     std::priority_queue<double, std::vector<double>, std::greater<double>> time_queue;
 };
 }
@@ -1,11 +1,13 @@
 
 #include "MUMPS.hpp"
 #include "exceptions.hpp"
+#include "ordering_cache.hpp"
+#include "telemetry.hpp"
 
 #include <Eigen/Sparse>
 
-#include <chrono>
 #include <iostream>
+#include <string>
 
 namespace neon
 {
@@ -47,11 +49,9 @@ MUMPS::~MUMPS()
     MUMPSAdapter::mumps_c(info);
 }
 
-void MUMPS::internal_solve(sparse_matrix const& A, vector& x, vector const& b)
+void MUMPS::internal_solve(sparse_matrix const& A, double* const X, std::int32_t const columns)
 {
-    auto start = std::chrono::high_resolution_clock::now();
-
-    x = b;
+    telemetry::scoped_timer timer("MUMPS solver");
 
     info.n = A.rows();
     info.nz = coefficients.size();
@@ -62,6 +62,29 @@ void MUMPS::internal_solve(sparse_matrix const& A, vector& x, vector const& b)
 
     if (build_sparsity_pattern)
     {
+        auto const cache = ordering_cache::get();
+
+        auto const key = cache != nullptr ? ordering_cache::pattern_hash(A) : 0;
+
+        // The pivot order depends on the symmetry of the factorisation
+        auto const method = "MUMPS " + std::to_string(info.sym);
+
+        auto const cached = cache != nullptr ? cache->find_ordering(method, key, A.rows())
+                                             : nullptr;
+
+        // Provide the cached pivot order instead of computing the ordering
+        if (cached != nullptr)
+        {
+            permutation.assign(begin(*cached), end(*cached));
+
+            info.perm_in = permutation.data();
+            info.icntl[6] = Ordering::User;
+        }
+        else
+        {
+            info.icntl[6] = Ordering::Automatic;
+        }
+
         // Analysis phase
         info.job = Job::Analysis;
         MUMPSAdapter::mumps_c(info);
@@ -70,20 +93,36 @@ void MUMPS::internal_solve(sparse_matrix const& A, vector& x, vector const& b)
         {
             throw computational_error("Error in analysis phase of MUMPS solver\n");
         }
+
+        if (cache != nullptr && info.icntl[6] != Ordering::User)
+        {
+            cache->store_ordering(method, key, {info.sym_perm, info.sym_perm + info.n});
+        }
         build_sparsity_pattern = false;
+        build_factorisation = true;
     }
 
-    // Factorization phase
-    info.job = Job::Factorisation;
-    MUMPSAdapter::mumps_c(info);
-
-    if (info.info[0] < 0)
+    if (build_factorisation)
     {
-        throw computational_error("Error in factorisation phase of MUMPS solver\n");
+        // Factorization phase
+        info.job = Job::Factorisation;
+        MUMPSAdapter::mumps_c(info);
+
+        if (info.info[0] < 0)
+        {
+            throw computational_error("Error in factorisation phase of MUMPS solver\n");
+        }
+
+        // Entries in the factors, negative values are in millions
+        auto const entries = info.infog[28];
+
+        telemetry::count("Factorisation entries",
+                         entries < 0 ? -std::int64_t{entries} * 1'000'000 : entries);
     }
+    build_factorisation = true;
 
-    info.rhs = x.data();
-    info.nrhs = 1;
+    info.rhs = X;
+    info.nrhs = columns;
     info.lrhs = info.n;
 
     info.job = Job::BackSubstitution;
@@ -93,11 +132,6 @@ void MUMPS::internal_solve(sparse_matrix const& A, vector& x, vector const& b)
     {
         throw computational_error("Error in back substitution phase of MUMPS solver\n");
     }
-
-    auto end = std::chrono::high_resolution_clock::now();
-    std::chrono::duration<double> elapsed_seconds = end - start;
-
-    std::cout << std::string(6, ' ') << "MUMPS solver took " << elapsed_seconds.count() << "s\n";
 }
 
 void MUMPSLLT::allocate_coordinate_format_storage(sparse_matrix const& A)
@@ -145,7 +179,17 @@ void MUMPSLLT::allocate_coordinate_format_storage(sparse_matrix const& A)
 void MUMPSLLT::solve(sparse_matrix const& A, vector& x, vector const& b)
 {
     this->allocate_coordinate_format_storage(A);
-    internal_solve(A, x, b);
+
+    x = b;
+    internal_solve(A, x.data(), 1);
+}
+
+void MUMPSLLT::block_solve(sparse_matrix const& A, col_matrix& X, col_matrix const& B)
+{
+    this->allocate_coordinate_format_storage(A);
+
+    X = B;
+    internal_solve(A, X.data(), X.cols());
 }
 
 void MUMPSLU::allocate_coordinate_format_storage(sparse_matrix const& A)
@@ -172,6 +216,16 @@ void MUMPSLU::allocate_coordinate_format_storage(sparse_matrix const& A)
 void MUMPSLU::solve(sparse_matrix const& A, vector& x, vector const& b)
 {
     this->allocate_coordinate_format_storage(A);
-    internal_solve(A, x, b);
+
+    x = b;
+    internal_solve(A, x.data(), 1);
+}
+
+void MUMPSLU::block_solve(sparse_matrix const& A, col_matrix& X, col_matrix const& B)
+{
+    this->allocate_coordinate_format_storage(A);
+
+    X = B;
+    internal_solve(A, X.data(), X.cols());
 }
 }
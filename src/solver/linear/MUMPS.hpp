@@ -35,7 +35,7 @@ struct MUMPSWrapper<double>
 class MUMPS : public direct_linear_solver
 {
 public:
-    enum Ordering { AMD, AMF = 2, Scotch, Pord, Metis, QAMD, Automatic };
+    enum Ordering { AMD, User, AMF, Scotch, Pord, Metis, QAMD, Automatic };
 
     // Jobs in MUMPS use the following:
     // 4   Job = 1 && Job = 2
@@ -68,13 +68,16 @@ protected:
      */
     virtual void allocate_coordinate_format_storage(sparse_matrix const& A) = 0;
 
-    void internal_solve(sparse_matrix const& A, vector& x, vector const& b);
+    /// Solve for the \p columns right hand sides stored in \p X which are
+    /// overwritten by the solution
+    void internal_solve(sparse_matrix const& A, double* const X, std::int32_t const columns);
 
 protected:
     MUMPSAdapter::MUMPS_STRUC_C info;
 
     std::vector<int> rows, cols;      //!< Row and column index storage (uncompressed)
     std::vector<double> coefficients; //!< Sparse matrix coefficients
+    std::vector<int> permutation;     //!< Cached pivot order of each variable
 };
 
 /**
@@ -89,6 +92,8 @@ public:
 
     void solve(sparse_matrix const& A, vector& x, vector const& b) override final;
 
+    void block_solve(sparse_matrix const& A, col_matrix& X, col_matrix const& B) override final;
+
 protected:
     virtual void allocate_coordinate_format_storage(sparse_matrix const& A) override final;
 };
@@ -105,6 +110,8 @@ public:
 
     void solve(sparse_matrix const& A, vector& x, vector const& b) override final;
 
+    void block_solve(sparse_matrix const& A, col_matrix& X, col_matrix const& B) override final;
+
 protected:
     virtual void allocate_coordinate_format_storage(sparse_matrix const& A) override final;
 };
@@ -1,13 +1,75 @@
 
 #include "PaStiX.hpp"
 
+#include "ordering_cache.hpp"
 #include "simulation_parser.hpp"
+#include "telemetry.hpp"
 
-#include <chrono>
 #include <termcolor/termcolor.hpp>
 
+#include <algorithm>
+#include <utility>
+
 namespace neon
 {
+namespace
+{
+/// Analyse the pattern of \p A with the ordering from the active cache if
+/// available, otherwise compute the ordering and store it in the cache.  The
+/// permutation and its inverse are stored as returned by PaStiX, which uses
+/// the one based numbering of the matrix passed by the Eigen interface
+template <typename solver_type>
+void analyse(solver_type& solver, sparse_matrix const& A, std::string const& method)
+{
+    auto const cache = ordering_cache::get();
+
+    if (cache == nullptr)
+    {
+        solver.analyzePattern(A);
+        return;
+    }
+
+    auto const key = ordering_cache::pattern_hash(A);
+
+    auto const cached = cache->find_ordering(method, key, 2 * A.rows());
+
+    if (cached != nullptr)
+    {
+        auto& permutation = solver.permutation();
+        auto& inverse_permutation = solver.inverse_permutation();
+
+        permutation.resize(A.rows());
+        inverse_permutation.resize(A.rows());
+
+        std::copy(cached->begin(), cached->begin() + A.rows(), permutation.data());
+        std::copy(cached->begin() + A.rows(), cached->end(), inverse_permutation.data());
+
+        solver.iparm(IPARM_ORDERING) = API_ORDER_PERSONAL;
+    }
+    else
+    {
+        solver.iparm(IPARM_ORDERING) = API_ORDER_SCOTCH;
+    }
+
+    solver.analyzePattern(A);
+
+    if (cached == nullptr)
+    {
+        auto const& permutation = solver.permutation();
+        auto const& inverse_permutation = solver.inverse_permutation();
+
+        std::vector<std::int32_t> ordering(permutation.data(),
+                                           permutation.data() + permutation.size());
+
+        ordering.insert(end(ordering),
+                        inverse_permutation.data(),
+                        inverse_permutation.data() + inverse_permutation.size());
+
+        cache->store_ordering(method, key, std::move(ordering));
+    }
+}
+}
+
 PaStiXLDLT::PaStiXLDLT()
 {
     // Verbosity
@@ -22,22 +84,34 @@ PaStiXLDLT::PaStiXLDLT()
 
 void PaStiXLDLT::solve(sparse_matrix const& A, vector& x, vector const& b)
 {
-    auto start = std::chrono::high_resolution_clock::now();
+    telemetry::scoped_timer timer("PaStiX LDLT direct solver");
+
+    factorise(A);
+
+    x = ldlt.solve(b);
+}
+
+void PaStiXLDLT::block_solve(sparse_matrix const& A, col_matrix& X, col_matrix const& B)
+{
+    telemetry::scoped_timer timer("PaStiX LDLT direct solver");
 
+    factorise(A);
+
+    X = ldlt.solve(B);
+}
+
+void PaStiXLDLT::factorise(sparse_matrix const& A)
+{
     if (build_sparsity_pattern)
     {
-        ldlt.analyzePattern(A);
+        analyse(ldlt, A, "PaStiX LDLT");
         build_sparsity_pattern = false;
+        build_factorisation = true;
     }
 
-    ldlt.factorize(A);
-
-    x = ldlt.solve(b);
+    if (build_factorisation) ldlt.factorize(A);
 
-    auto end = std::chrono::high_resolution_clock::now();
-    std::chrono::duration<double> elapsed_seconds = end - start;
-    std::cout << std::string(6, ' ') << "PaStiX LDLT direct solver took " << elapsed_seconds.count()
-              << "s\n";
+    build_factorisation = true;
 }
 
 PaStiXLU::PaStiXLU()
@@ -54,22 +128,34 @@ PaStiXLU::PaStiXLU()
 
 void PaStiXLU::solve(sparse_matrix const& A, vector& x, vector const& b)
 {
-    auto start = std::chrono::high_resolution_clock::now();
+    telemetry::scoped_timer timer("PaStiX LU direct solver");
 
+    factorise(A);
+
+    x = lu.solve(b);
+}
+
+void PaStiXLU::block_solve(sparse_matrix const& A, col_matrix& X, col_matrix const& B)
+{
+    telemetry::scoped_timer timer("PaStiX LU direct solver");
+
+    factorise(A);
+
+    X = lu.solve(B);
+}
+
+void PaStiXLU::factorise(sparse_matrix const& A)
+{
     if (build_sparsity_pattern)
     {
-        lu.analyzePattern(A);
+        analyse(lu, A, "PaStiX LU");
         build_sparsity_pattern = false;
+        build_factorisation = true;
     }
 
-    lu.factorize(A);
-
-    x = lu.solve(b);
+    if (build_factorisation) lu.factorize(A);
 
-    auto end = std::chrono::high_resolution_clock::now();
-    std::chrono::duration<double> elapsed_seconds = end - start;
-    std::cout << std::string(6, ' ') << "PaStiX LU direct solver took " << elapsed_seconds.count()
-              << "s\n";
+    build_factorisation = true;
 }
 }
 
@@ -7,6 +7,19 @@
 
 namespace neon
 {
+/// pastix_ordering exposes the ordering of the Eigen interface to PaStiX such
+/// that a cached ordering can be given to the analysis \sa ordering_cache
+template <typename pastix_type>
+class pastix_ordering : public pastix_type
+{
+public:
+    /// \return the new position of each variable
+    [[nodiscard]] auto& permutation() { return this->m_perm; }
+
+    /// \return the variable at each new position
+    [[nodiscard]] auto& inverse_permutation() { return this->m_invp; }
+};
+
 /// PaStiXLDLT is a supernodal direct solver with multithreading support.  This
 /// performs the LDLT Cholesky factorisation of a symmetric system
 class PaStiXLDLT : public direct_linear_solver
@@ -16,8 +29,16 @@ public:
 
     void solve(sparse_matrix const& A, vector& x, vector const& b) override final;
 
+    /// Solve all columns of \p B with one factorisation.  The Eigen interface
+    /// passes the columns to PaStiX in turn
+    void block_solve(sparse_matrix const& A, col_matrix& X, col_matrix const& B) override final;
+
 private:
-    Eigen::PastixLDLT<Eigen::SparseMatrix<double>, Eigen::Upper> ldlt;
+    /// Analyse and factorise \p A unless the factorisation is reused
+    void factorise(sparse_matrix const& A);
+
+private:
+    pastix_ordering<Eigen::PastixLDLT<Eigen::SparseMatrix<double>, Eigen::Upper>> ldlt;
 };
 
 /// PaStiXLU is a supernodal direct solver with multithreading support.  This
@@ -29,10 +50,18 @@ public:
 
     void solve(sparse_matrix const& A, vector& x, vector const& b) override final;
 
+    /// Solve all columns of \p B with one factorisation.  The Eigen interface
+    /// passes the columns to PaStiX in turn
+    void block_solve(sparse_matrix const& A, col_matrix& X, col_matrix const& B) override final;
+
+private:
+    /// Analyse and factorise \p A unless the factorisation is reused
+    void factorise(sparse_matrix const& A);
+
 private:
     // BUG Likely not going to work with unsymmetric matrix because of row and
     // column ordering change.  Should give the transpose of the matrix but
     // unsure why Eigen can't handle this
-    Eigen::PastixLU<Eigen::SparseMatrix<double>> lu;
+    pastix_ordering<Eigen::PastixLU<Eigen::SparseMatrix<double>>> lu;
 };
 }
@@ -6,6 +6,7 @@
 #include "exceptions.hpp"
 #include "dmatrix_vector_product.hpp"
 #include "numeric/float_compare.hpp"
+#include "telemetry.hpp"
 #include "solver/cuda_error.hpp"
 
 #include <cmath>
@@ -186,6 +187,8 @@ void biconjugate_gradient_stabilised_cuda::solve(sparse_matrix const& A, vector&
         }
     }
 
+    telemetry::count("Linear solver iterations", k);
+
     std::cout << std::string(6, ' ') << "BiCGStab iterations: " << k << " (max. " << max_iterations
               << "), estimated error: " << std::sqrt(residual) << " (min. " << residual_tolerance
               << ")\n";
@@ -6,6 +6,7 @@
 #include "exceptions.hpp"
 #include "dmatrix_vector_product.hpp"
 #include "numeric/float_compare.hpp"
+#include "telemetry.hpp"
 
 #define VIENNACL_HAVE_EIGEN
 #define VIENNACL_WITH_OPENCL
@@ -45,6 +46,8 @@ void biconjugate_gradient_stabilised_ocl::solve(sparse_matrix const& A, vector&
 
     viennacl::backend::finish();
 
+    telemetry::count("Linear solver iterations", solver_tag.iters());
+
     std::cout << std::string(6, ' ') << "BiCGStab iterations: " << solver_tag.iters() << " (max. "
               << max_iterations << "), estimated error: " << solver_tag.error() << " (min. "
               << residual_tolerance << ")\n";
@@ -6,6 +6,7 @@
 #include "exceptions.hpp"
 #include "dmatrix_vector_product.hpp"
 #include "numeric/float_compare.hpp"
+#include "telemetry.hpp"
 #include "solver/cuda_error.hpp"
 
 #include <cmath>
@@ -163,6 +164,8 @@ void conjugate_gradient_cuda::solve(sparse_matrix const& A, vector& x, vector co
         cublasDdot(cublasHandle, N, d_z, 1, d_r, 1, &residual);
     }
 
+    telemetry::count("Linear solver iterations", k);
+
     std::cout << std::string(6, ' ') << "Conjugate Gradient iterations: " << k << " (max. "
               << max_iterations << "), estimated error: " << std::sqrt(residual) << " (min. "
               << residual_tolerance << ")\n";
@@ -6,6 +6,7 @@
 #include "exceptions.hpp"
 #include "dmatrix_vector_product.hpp"
 #include "numeric/float_compare.hpp"
+#include "telemetry.hpp"
 
 #define VIENNACL_HAVE_EIGEN
 #define VIENNACL_WITH_OPENCL
@@ -71,6 +72,8 @@ void conjugate_gradient_ocl::solve(sparse_matrix const& A, vector& x, vector con
 
     viennacl::backend::finish();
 
+    telemetry::count("Linear solver iterations", solver_tag.iters());
+
     std::cout << std::string(6, ' ') << "Conjugate Gradient iterations: " << solver_tag.iters()
               << " (max. " << max_iterations << "), estimated error: " << solver_tag.error()
               << " (min. " << residual_tolerance << ")\n";
@@ -5,11 +5,10 @@
 #include "linear_solver.hpp"
 
 #include "exceptions.hpp"
-#include "simulation_parser.hpp"
+#include "telemetry.hpp"
 
-#ifdef ENABLE_OPENMP
-#include <omp.h>
-#endif
+#include <Eigen/Cholesky>
+#include <Eigen/Eigenvalues>
 
 #include <cfenv>
 #include <chrono>
@@ -17,6 +16,24 @@
 
 namespace neon
 {
+void linear_solver::block_solve(sparse_matrix const& A, col_matrix& X, col_matrix const& B)
+{
+    X.setZero(B.rows(), B.cols());
+
+    vector x;
+
+    for (std::int64_t column{0}; column < B.cols(); ++column)
+    {
+        if (column > 0) reuse_factorisation();
+
+        x = X.col(column);
+
+        solve(A, x, B.col(column));
+
+        X.col(column) = x;
+    }
+}
+
 iterative_linear_solver::iterative_linear_solver(double const residual_tolerance)
     : residual_tolerance{residual_tolerance}
 {
@@ -35,9 +52,7 @@ iterative_linear_solver::iterative_linear_solver(double const residual_tolerance
 
 void conjugate_gradient::solve(sparse_matrix const& A, vector& x, vector const& b)
 {
-#ifdef ENABLE_OPENMP
-    omp_set_num_threads(simulation_parser::threads);
-#endif
+    telemetry::scoped_timer timer("Conjugate gradient solver", telemetry::timer_output::silent);
 
     std::feclearexcept(FE_ALL_EXCEPT);
 
@@ -48,7 +63,12 @@ void conjugate_gradient::solve(sparse_matrix const& A, vector& x, vector const&
 
     pcg.compute(A);
 
-    x = pcg.solve(b);
+    // Start from the solution estimate of the caller
+    if (x.size() != b.size()) x = vector::Zero(b.size());
+
+    x = pcg.solveWithGuess(b, x);
+
+    telemetry::count("Linear solver iterations", pcg.iterations());
 
     std::cout << std::string(6, ' ') << "Conjugate Gradient iterations: " << pcg.iterations()
               << " (max. " << max_iterations << "), estimated error: " << pcg.error() << " (min. "
@@ -68,6 +88,8 @@ void conjugate_gradient::solve(sparse_matrix const& A, vector& x, vector const&
 
 void biconjugate_gradient_stabilised::solve(sparse_matrix const& A, vector& x, vector const& b)
 {
+    telemetry::scoped_timer timer("BiCGStab solver", telemetry::timer_output::silent);
+
     std::feclearexcept(FE_ALL_EXCEPT);
 
     Eigen::BiCGSTAB<sparse_matrix> bicgstab; //, Eigen::IncompleteLUT<double>
@@ -77,7 +99,12 @@ void biconjugate_gradient_stabilised::solve(sparse_matrix const& A, vector& x, v
 
     bicgstab.compute(A);
 
-    x = bicgstab.solve(b);
+    // Start from the solution estimate of the caller
+    if (x.size() != b.size()) x = vector::Zero(b.size());
+
+    x = bicgstab.solveWithGuess(b, x);
+
+    telemetry::count("Linear solver iterations", bicgstab.iterations());
 
     if (std::fetestexcept(FE_INVALID))
     {
@@ -95,25 +122,244 @@ void biconjugate_gradient_stabilised::solve(sparse_matrix const& A, vector& x, v
               << " (min. " << residual_tolerance << ")\n";
 }
 
+deflated_conjugate_gradient::deflated_conjugate_gradient(double const residual_tolerance,
+                                                         std::int32_t const max_iterations,
+                                                         std::int32_t const deflation_vectors)
+    : iterative_linear_solver(residual_tolerance, max_iterations),
+      deflation_vectors{deflation_vectors}
+{
+}
+
+void deflated_conjugate_gradient::solve(sparse_matrix const& A, vector& x, vector const& b)
+{
+    telemetry::scoped_timer timer("Deflated conjugate gradient solver",
+                                  telemetry::timer_output::silent);
+
+    std::feclearexcept(FE_ALL_EXCEPT);
+
+    if (build_sparsity_pattern || inverse_diagonal.size() != A.rows())
+    {
+        is_refresh_required = true;
+        build_sparsity_pattern = false;
+    }
+
+    if (is_refresh_required) refresh(A);
+
+    auto const b_norm = b.norm();
+
+    if (b_norm == 0.0)
+    {
+        x = vector::Zero(b.size());
+        return;
+    }
+
+    if (x.size() != b.size()) x = vector::Zero(b.size());
+
+    bool const is_deflated = W.cols() > 0;
+
+    // Coarse operator of the deflation subspace
+    col_matrix const AW = A * W;
+    Eigen::LDLT<col_matrix> const E(W.transpose() * AW);
+
+    vector r = b - A * x;
+
+    // Galerkin projection of the initial guess onto the deflation subspace
+    if (is_deflated)
+    {
+        x += W * E.solve(W.transpose() * r);
+        r = b - A * x;
+    }
+
+    vector z = inverse_diagonal.cwiseProduct(r);
+    vector p = z;
+
+    if (is_deflated) p -= W * E.solve(AW.transpose() * z);
+
+    vector q(b.size());
+
+    // The first search directions are recycled into the deflation subspace
+    std::int64_t const recycled_columns = std::min(std::int64_t{2} * deflation_vectors,
+                                                   static_cast<std::int64_t>(b.size()));
+
+    col_matrix P(b.size(), recycled_columns), AP(b.size(), recycled_columns);
+
+    double rz = r.dot(z);
+
+    std::int32_t iterations{0};
+
+    while (r.norm() > residual_tolerance * b_norm && iterations < max_iterations)
+    {
+        q.noalias() = A * p;
+
+        if (iterations < recycled_columns)
+        {
+            P.col(iterations) = p;
+            AP.col(iterations) = q;
+        }
+
+        double const alpha = rz / p.dot(q);
+
+        x += alpha * p;
+        r -= alpha * q;
+
+        z = inverse_diagonal.cwiseProduct(r);
+
+        double const rz_next = r.dot(z);
+
+        p = z + (rz_next / rz) * p;
+
+        // Keep the search direction conjugate to the deflation subspace
+        if (is_deflated) p -= W * E.solve(AW.transpose() * z);
+
+        rz = rz_next;
+
+        ++iterations;
+    }
+
+    telemetry::count("Linear solver iterations", iterations);
+
+    std::cout << std::string(6, ' ') << "Deflated Conjugate Gradient iterations: " << iterations
+              << " (max. " << max_iterations << "), subspace size: " << W.cols()
+              << ", estimated error: " << r.norm() / b_norm << " (min. " << residual_tolerance
+              << ")\n";
+
+    if (std::fetestexcept(FE_INVALID))
+    {
+        throw computational_error("Floating point error reported\n");
+    }
+
+    if (iterations >= max_iterations)
+    {
+        is_refresh_required = true;
+
+        throw computational_error("Deflated conjugate gradient solver maximum iterations "
+                                  "reached");
+    }
+
+    // Rebuild once the recycled information no longer reduces the iterations
+    if (reference_iterations == 0)
+    {
+        reference_iterations = iterations;
+    }
+    else if (iterations > reference_iterations)
+    {
+        is_refresh_required = true;
+    }
+
+    auto const directions = std::min(static_cast<std::int64_t>(iterations), recycled_columns);
+
+    update_subspace(AW, P.leftCols(directions), AP.leftCols(directions));
+}
+
+void deflated_conjugate_gradient::refresh(sparse_matrix const& A)
+{
+    inverse_diagonal = A.diagonal().unaryExpr(
+        [](double const value) { return value == 0.0 ? 1.0 : 1.0 / value; });
+
+    W.resize(A.rows(), 0);
+
+    reference_iterations = 0;
+    is_refresh_required = false;
+}
+
+void deflated_conjugate_gradient::update_subspace(col_matrix const& AW,
+                                                  col_matrix const& P,
+                                                  col_matrix const& AP)
+{
+    if (P.cols() == 0) return;
+
+    col_matrix Z(P.rows(), W.cols() + P.cols()), AZ(P.rows(), W.cols() + P.cols());
+    Z << W, P;
+    AZ << AW, AP;
+
+    // Rayleigh-Ritz for the Jacobi preconditioned matrix in the span of Z
+    col_matrix G = Z.transpose() * AZ;
+    G = (0.5 * (G + G.transpose())).eval();
+
+    col_matrix const F = Z.transpose() * inverse_diagonal.cwiseInverse().asDiagonal() * Z;
+
+    Eigen::GeneralizedSelfAdjointEigenSolver<col_matrix> eigen_solver(G, F);
+
+    if (eigen_solver.info() != Eigen::Success) return;
+
+    // The eigenvalues are sorted in increasing order
+    col_matrix ritz_vectors = Z
+                              * eigen_solver.eigenvectors().leftCols(
+                                  std::min(std::int64_t{deflation_vectors}, Z.cols()));
+
+    // Keep the current subspace if the search directions were dependent
+    if (ritz_vectors.allFinite()) W = std::move(ritz_vectors);
+}
+
 void SparseLU::solve(sparse_matrix const& A, vector& x, vector const& b)
+{
+    telemetry::scoped_timer timer("SparseLU direct solver", telemetry::timer_output::silent);
+
+    factorise(A);
+
+    x = lu.solve(b);
+}
+
+void SparseLU::block_solve(sparse_matrix const& A, col_matrix& X, col_matrix const& B)
+{
+    telemetry::scoped_timer timer("SparseLU direct solver", telemetry::timer_output::silent);
+
+    factorise(A);
+
+    X = lu.solve(B);
+}
+
+void SparseLU::factorise(sparse_matrix const& A)
 {
     if (build_sparsity_pattern)
     {
         lu.analyzePattern(A);
         build_sparsity_pattern = false;
+        build_factorisation = true;
     }
-    lu.factorize(A);
-    x = lu.solve(b);
+    if (build_factorisation)
+    {
+        lu.factorize(A);
+
+        telemetry::count("Factorisation entries", lu.nnzL() + lu.nnzU());
+    }
+
+    build_factorisation = true;
 }
 
 void SparseLLT::solve(sparse_matrix const& A, vector& x, vector const& b)
+{
+    telemetry::scoped_timer timer("SparseLLT direct solver", telemetry::timer_output::silent);
+
+    factorise(A);
+
+    x = llt.solve(b);
+}
+
+void SparseLLT::block_solve(sparse_matrix const& A, col_matrix& X, col_matrix const& B)
+{
+    telemetry::scoped_timer timer("SparseLLT direct solver", telemetry::timer_output::silent);
+
+    factorise(A);
+
+    X = llt.solve(B);
+}
+
+void SparseLLT::factorise(sparse_matrix const& A)
 {
     if (build_sparsity_pattern)
     {
         llt.analyzePattern(A);
         build_sparsity_pattern = false;
+        build_factorisation = true;
     }
-    llt.factorize(A);
-    x = llt.solve(b);
+    if (build_factorisation)
+    {
+        llt.factorize(A);
+
+        telemetry::count("Factorisation entries", llt.matrixL().nestedExpression().nonZeros());
+    }
+
+    build_factorisation = true;
 }
 }
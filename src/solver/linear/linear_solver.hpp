@@ -3,6 +3,7 @@
 
 #include "numeric/dense_matrix.hpp"
 #include "numeric/sparse_matrix.hpp"
+#include "solver/linear/ordering_cache.hpp"
 
 namespace neon
 {
@@ -15,11 +16,23 @@ public:
 
     virtual void solve(sparse_matrix const& A, vector& x, vector const& b) = 0;
 
+    /// Solve for each column of \p B with a single factorisation of \p A.
+    /// By default the columns are solved in turn and the direct solvers
+    /// reuse the factorisation of the first column
+    virtual void block_solve(sparse_matrix const& A, col_matrix& X, col_matrix const& B);
+
     /// Notifies the linear solvers of a change in sparsity structure of A
     void update_sparsity_pattern() { build_sparsity_pattern = true; }
 
+    /// Notifies the direct linear solvers that the coefficients of A are
+    /// unchanged since the last solve and the factorisation can be reused.
+    /// This only applies to the next call to solve
+    void reuse_factorisation() { build_factorisation = false; }
+
 protected:
     bool build_sparsity_pattern{true};
+    /// Factorise the matrix on the next solve
+    bool build_factorisation{true};
 };
 
 class iterative_linear_solver : public linear_solver
@@ -73,6 +86,47 @@ public:
     void solve(sparse_matrix const& A, vector& x, vector const& b) override final;
 };
 
+/// deflated_conjugate_gradient is a preconditioned conjugate gradient solver
+/// for a sequence of closely related systems, such as the Newton-Raphson
+/// iterations and consecutive load steps.  The first search directions of
+/// each solve are recycled into approximate eigenvectors for the smallest
+/// eigenvalues of the preconditioned matrix.  These span a deflation subspace
+/// which is removed from the Krylov space of the next solve and improves the
+/// convergence rate.  The Jacobi preconditioner and the subspace are kept
+/// between calls and only rebuilt when a solve requires more iterations than
+/// the first solve after the last rebuild.
+class deflated_conjugate_gradient : public iterative_linear_solver
+{
+public:
+    /// Construct with the residual tolerance, the maximum number of
+    /// iterations and the number of vectors in the deflation subspace
+    explicit deflated_conjugate_gradient(double const residual_tolerance,
+                                         std::int32_t const max_iterations,
+                                         std::int32_t const deflation_vectors);
+
+    void solve(sparse_matrix const& A, vector& x, vector const& b) override final;
+
+protected:
+    /// Recompute the preconditioner and discard the deflation subspace
+    void refresh(sparse_matrix const& A);
+
+    /// Replace the deflation subspace by the Ritz vectors of the smallest
+    /// eigenvalues in the span of the subspace and the search directions \p P
+    void update_subspace(col_matrix const& AW, col_matrix const& P, col_matrix const& AP);
+
+protected:
+    /// Number of vectors in the deflation subspace
+    std::int32_t deflation_vectors{8};
+    /// Basis of the deflation subspace
+    col_matrix W;
+    /// Inverse of the diagonal of the matrix at the last refresh
+    vector inverse_diagonal;
+    /// Iterations of the first solve after the last refresh
+    std::int32_t reference_iterations{0};
+    /// Flag to rebuild the preconditioner and the subspace on the next solve
+    bool is_refresh_required{true};
+};
+
 class direct_linear_solver : public linear_solver
 {
 };
@@ -85,8 +139,16 @@ class SparseLU : public direct_linear_solver
 public:
     void solve(sparse_matrix const& A, vector& x, vector const& b) override final;
 
+    /// Solve all columns of \p B with one factorisation.  The supernodal
+    /// triangular solves are applied to all columns together
+    void block_solve(sparse_matrix const& A, col_matrix& X, col_matrix const& B) override final;
+
 private:
-    Eigen::SparseLU<sparse_matrix, Eigen::AMDOrdering<std::int32_t>> lu;
+    /// Analyse and factorise \p A unless the factorisation is reused
+    void factorise(sparse_matrix const& A);
+
+private:
+    Eigen::SparseLU<sparse_matrix, cached_amd_ordering<std::int32_t>> lu;
 };
 
 /// SparseLLT is a single threaded sparse Cholesky factorization using AMD reordering.
@@ -97,7 +159,18 @@ class SparseLLT : public direct_linear_solver
 public:
     void solve(sparse_matrix const& A, vector& x, vector const& b) override final;
 
+    /// Solve all columns of \p B with one factorisation.  The triangular
+    /// solves are performed column by column
+    void block_solve(sparse_matrix const& A, col_matrix& X, col_matrix const& B) override final;
+
+private:
+    /// Analyse and factorise \p A unless the factorisation is reused
+    void factorise(sparse_matrix const& A);
+
 private:
-    Eigen::SimplicialLLT<Eigen::SparseMatrix<sparse_matrix::Scalar>> llt;
+    Eigen::SimplicialLLT<Eigen::SparseMatrix<sparse_matrix::Scalar>,
+                         Eigen::Lower,
+                         cached_amd_ordering<std::int32_t>>
+        llt;
 };
 }
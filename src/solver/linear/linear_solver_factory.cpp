@@ -13,6 +13,7 @@
 
 #include "MUMPS.hpp"
 #include "PaStiX.hpp"
+#include "mixed_precision.hpp"
 #include "io/json.hpp"
 
 #include <exception>
@@ -60,6 +61,29 @@ std::unique_ptr<linear_solver> make_iterative_solver(json const& solver_data, bo
     return std::make_unique<BiConjugateGradient>();
 }
 
+std::unique_ptr<linear_solver> make_mixed_precision_solver(json const& solver_data,
+                                                          bool const is_symmetric)
+{
+    if (solver_data.find("tolerance") != end(solver_data)
+        || solver_data.find("maximum_iterations") != end(solver_data))
+    {
+        double const tolerance = solver_data.value("tolerance", 1.0e-10);
+        std::int32_t const maximum_iterations = solver_data.value("maximum_iterations", 20);
+
+        if (is_symmetric)
+        {
+            return std::make_unique<MixedPrecisionLLT>(tolerance, maximum_iterations);
+        }
+        return std::make_unique<MixedPrecisionLU>(tolerance, maximum_iterations);
+    }
+
+    if (is_symmetric)
+    {
+        return std::make_unique<MixedPrecisionLLT>();
+    }
+    return std::make_unique<MixedPrecisionLU>();
+}
+
 std::unique_ptr<linear_solver> make_linear_solver(json const& solver_data, bool const is_symmetric)
 {
     if (solver_data.find("type") == end(solver_data))
@@ -98,6 +122,18 @@ std::unique_ptr<linear_solver> make_linear_solver(json const& solver_data, bool
     }
     else if (solver_name == "direct")
     {
+        if (solver_data.find("precision") != end(solver_data))
+        {
+            if (solver_data["precision"] != "double" && solver_data["precision"] != "mixed")
+            {
+                throw std::domain_error("\"precision\" must be \"double\" or \"mixed\"");
+            }
+            if (solver_data["precision"] == "mixed")
+            {
+                return make_mixed_precision_solver(solver_data, is_symmetric);
+            }
+        }
+
         if (is_symmetric)
         {
             return std::make_unique<SparseLLT>();
@@ -110,6 +146,21 @@ std::unique_ptr<linear_solver> make_linear_solver(json const& solver_data, bool
         // If a device isn't specified use a multithreaded CPU implementation
         if (solver_data.find("device") == end(solver_data) || solver_data["device"] == "cpu")
         {
+            // Recycle the Krylov subspace between the solutions of a sequence of
+            // symmetric systems.  The unsymmetric solver is warm started instead
+            if (solver_data.value("recycling", false) && is_symmetric)
+            {
+                std::int32_t const deflation_vectors = solver_data.value("deflation_vectors", 8);
+
+                if (deflation_vectors < 1)
+                {
+                    throw std::domain_error("\"deflation_vectors\" must be positive");
+                }
+                return std::make_unique<
+                    deflated_conjugate_gradient>(solver_data.value("tolerance", 1.0e-5),
+                                                 solver_data.value("maximum_iterations", 2000),
+                                                 deflation_vectors);
+            }
             return make_iterative_solver<conjugate_gradient,
                                          biconjugate_gradient_stabilised>(solver_data, is_symmetric);
         }
@@ -0,0 +1,176 @@
+
+#include "mixed_precision.hpp"
+
+#include "exceptions.hpp"
+#include "telemetry.hpp"
+
+#include <cfenv>
+#include <iostream>
+#include <limits>
+#include <string>
+
+namespace neon
+{
+mixed_precision_solver::mixed_precision_solver(double const residual_tolerance,
+                                               std::int32_t const max_iterations)
+    : residual_tolerance{residual_tolerance}, max_iterations{max_iterations}
+{
+}
+
+void mixed_precision_solver::solve(sparse_matrix const& A, vector& x, vector const& b)
+{
+    telemetry::scoped_timer timer("Mixed precision direct solver", telemetry::timer_output::silent);
+
+    std::feclearexcept(FE_ALL_EXCEPT);
+
+    if (build_sparsity_pattern || build_factorisation)
+    {
+        // The single precision copy is only required for the factorisation
+        single_sparse_matrix const A_single = A.cast<float>();
+
+        if (build_sparsity_pattern)
+        {
+            analyse(A_single);
+            build_sparsity_pattern = false;
+        }
+        factorise(A_single);
+    }
+
+    build_factorisation = true;
+
+    auto const b_norm = b.norm();
+
+    if (b_norm == 0.0)
+    {
+        x = vector::Zero(b.size());
+        return;
+    }
+
+    x = correction(b);
+
+    // Refine while each correction reduces the residual by at least a half
+    vector r = b - A * x;
+
+    double residual_norm = r.norm();
+    double previous_norm = std::numeric_limits<double>::max();
+
+    std::int32_t iterations{0};
+
+    while (residual_norm > residual_tolerance * b_norm && iterations < max_iterations
+           && residual_norm < 0.5 * previous_norm)
+    {
+        x += correction(r);
+
+        r = b - A * x;
+
+        previous_norm = residual_norm;
+        residual_norm = r.norm();
+
+        ++iterations;
+    }
+
+    telemetry::count("Linear solver iterations", iterations);
+
+    if (residual_norm > residual_tolerance * b_norm)
+    {
+        std::cout << std::string(6, ' ') << "Refinement stagnated after " << iterations
+                  << " iterations with relative residual " << residual_norm / b_norm
+                  << ", using the single precision factors as a preconditioner\n";
+
+        krylov_solve(A, x, b);
+    }
+
+    if (std::fetestexcept(FE_INVALID))
+    {
+        throw computational_error("Floating point error reported\n");
+    }
+}
+
+void MixedPrecisionLLT::analyse(single_sparse_matrix const& A_single)
+{
+    llt.analyzePattern(A_single);
+}
+
+void MixedPrecisionLLT::factorise(single_sparse_matrix const& A_single)
+{
+    llt.factorize(A_single);
+
+    if (llt.info() != Eigen::Success)
+    {
+        throw computational_error("Single precision Cholesky factorisation failed");
+    }
+
+    telemetry::count("Factorisation entries", llt.matrixL().nestedExpression().nonZeros());
+}
+
+vector MixedPrecisionLLT::correction(vector const& r) const
+{
+    return llt.solve(r.cast<float>()).cast<double>();
+}
+
+void MixedPrecisionLLT::krylov_solve(sparse_matrix const& A, vector& x, vector const& b) const
+{
+    Eigen::ConjugateGradient<sparse_matrix,
+                             Eigen::Lower | Eigen::Upper,
+                             single_precision_preconditioner>
+        pcg;
+
+    pcg.setTolerance(residual_tolerance);
+    pcg.setMaxIterations(max_iterations);
+
+    pcg.compute(A);
+    pcg.preconditioner().set_solver(this);
+
+    x = pcg.solveWithGuess(b, x);
+
+    telemetry::count("Linear solver iterations", pcg.iterations());
+
+    if (pcg.info() != Eigen::Success)
+    {
+        throw computational_error("Mixed precision conjugate gradient maximum iterations "
+                                  "reached");
+    }
+}
+
+void MixedPrecisionLU::analyse(single_sparse_matrix const& A_single)
+{
+    lu.analyzePattern(A_single);
+}
+
+void MixedPrecisionLU::factorise(single_sparse_matrix const& A_single)
+{
+    lu.factorize(A_single);
+
+    if (lu.info() != Eigen::Success)
+    {
+        throw computational_error("Single precision LU factorisation failed");
+    }
+
+    telemetry::count("Factorisation entries", lu.nnzL() + lu.nnzU());
+}
+
+vector MixedPrecisionLU::correction(vector const& r) const
+{
+    return lu.solve(r.cast<float>()).cast<double>();
+}
+
+void MixedPrecisionLU::krylov_solve(sparse_matrix const& A, vector& x, vector const& b) const
+{
+    Eigen::BiCGSTAB<sparse_matrix, single_precision_preconditioner> bicgstab;
+
+    bicgstab.setTolerance(residual_tolerance);
+    bicgstab.setMaxIterations(max_iterations);
+
+    bicgstab.compute(A);
+    bicgstab.preconditioner().set_solver(this);
+
+    x = bicgstab.solveWithGuess(b, x);
+
+    telemetry::count("Linear solver iterations", bicgstab.iterations());
+
+    if (bicgstab.info() != Eigen::Success)
+    {
+        throw computational_error("Mixed precision BiCGStab maximum iterations reached");
+    }
+}
+}
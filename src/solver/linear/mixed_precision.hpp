@@ -0,0 +1,132 @@
+
+#pragma once
+
+#include "linear_solver.hpp"
+
+/// \file mixed_precision.hpp
+
+namespace neon
+{
+/// mixed_precision_solver factorises a single precision copy of the matrix
+/// and recovers a double precision solution by iterative refinement.  The
+/// factors require half the memory and bandwidth of a double precision
+/// factorisation.  If the refinement stagnates because the matrix is too
+/// ill-conditioned for single precision, the factors are applied as the
+/// preconditioner of a double precision Krylov method instead.
+class mixed_precision_solver : public direct_linear_solver
+{
+public:
+    /// Single precision matrix for the factorisation
+    using single_sparse_matrix = Eigen::SparseMatrix<float>;
+
+    friend class single_precision_preconditioner;
+
+public:
+    /// Construct with the default residual tolerance and refinement iterations
+    explicit mixed_precision_solver() = default;
+
+    /// Override the default relative residual tolerance and the maximum
+    /// number of refinement iterations
+    explicit mixed_precision_solver(double const residual_tolerance,
+                                    std::int32_t const max_iterations);
+
+    void solve(sparse_matrix const& A, vector& x, vector const& b) override final;
+
+protected:
+    /// Compute the ordering and the symbolic factorisation
+    virtual void analyse(single_sparse_matrix const& A_single) = 0;
+
+    /// Compute the numerical factorisation
+    virtual void factorise(single_sparse_matrix const& A_single) = 0;
+
+    /// \return the solution of the single precision system for \p r
+    [[nodiscard]] virtual vector correction(vector const& r) const = 0;
+
+    /// Solve with a Krylov method preconditioned by the single precision
+    /// factors using \p x as the initial guess
+    virtual void krylov_solve(sparse_matrix const& A, vector& x, vector const& b) const = 0;
+
+protected:
+    /// Relative residual of the double precision solution
+    double residual_tolerance{1.0e-10};
+    /// Maximum number of refinement or Krylov iterations
+    std::int32_t max_iterations{20};
+};
+
+/// single_precision_preconditioner adapts the factors of a mixed precision
+/// solver to the preconditioner interface of the Eigen iterative solvers
+class single_precision_preconditioner
+{
+public:
+    single_precision_preconditioner() = default;
+
+    void set_solver(mixed_precision_solver const* new_solver) { solver = new_solver; }
+
+    /// The factorisation is computed by the solver
+    template <typename matrix_type>
+    single_precision_preconditioner& analyzePattern(matrix_type const&)
+    {
+        return *this;
+    }
+
+    template <typename matrix_type>
+    single_precision_preconditioner& factorize(matrix_type const&)
+    {
+        return *this;
+    }
+
+    template <typename matrix_type>
+    single_precision_preconditioner& compute(matrix_type const&)
+    {
+        return *this;
+    }
+
+    [[nodiscard]] vector solve(vector const& r) const { return solver->correction(r); }
+
+    [[nodiscard]] Eigen::ComputationInfo info() const { return Eigen::Success; }
+
+protected:
+    mixed_precision_solver const* solver{nullptr};
+};
+
+/// MixedPrecisionLLT is a single precision sparse Cholesky factorization
+/// using AMD reordering with double precision conjugate gradient recovery
+class MixedPrecisionLLT : public mixed_precision_solver
+{
+public:
+    using mixed_precision_solver::mixed_precision_solver;
+
+protected:
+    void analyse(single_sparse_matrix const& A_single) override final;
+
+    void factorise(single_sparse_matrix const& A_single) override final;
+
+    [[nodiscard]] vector correction(vector const& r) const override final;
+
+    void krylov_solve(sparse_matrix const& A, vector& x, vector const& b) const override final;
+
+private:
+    Eigen::SimplicialLLT<single_sparse_matrix, Eigen::Lower, cached_amd_ordering<std::int32_t>>
+        llt;
+};
+
+/// MixedPrecisionLU is a single precision sparse LU factorization using AMD
+/// reordering with double precision BiCGStab recovery
+class MixedPrecisionLU : public mixed_precision_solver
+{
+public:
+    using mixed_precision_solver::mixed_precision_solver;
+
+protected:
+    void analyse(single_sparse_matrix const& A_single) override final;
+
+    void factorise(single_sparse_matrix const& A_single) override final;
+
+    [[nodiscard]] vector correction(vector const& r) const override final;
+
+    void krylov_solve(sparse_matrix const& A, vector& x, vector const& b) const override final;
+
+private:
+    Eigen::SparseLU<single_sparse_matrix, cached_amd_ordering<std::int32_t>> lu;
+};
+}
@@ -0,0 +1,93 @@
+
+#include "ordering_cache.hpp"
+
+#include "io/binary_archive.hpp"
+
+#include <fstream>
+#include <iostream>
+#include <stdexcept>
+#include <utility>
+
+namespace neon
+{
+ordering_cache* ordering_cache::active = nullptr;
+
+namespace
+{
+/// Version of the file layout
+std::int64_t constexpr file_version = 1;
+}
+
+ordering_cache::ordering_cache(std::string file_name) : file_name(std::move(file_name))
+{
+    active = this;
+
+    if (!std::ifstream(this->file_name).good()) return;
+
+    try
+    {
+        io::binary_input_archive archive(this->file_name);
+
+        std::int64_t version;
+        archive.read(version);
+
+        if (version != file_version) return;
+
+        archive.read(patterns);
+        archive.read(orderings);
+
+        std::cout << std::string(4, ' ') << "Read " << patterns.size() << " sparsity patterns and "
+                  << orderings.size() << " orderings from " << this->file_name << "\n";
+    }
+    catch (std::domain_error const&)
+    {
+        // An incomplete file is rebuilt
+        patterns.clear();
+        orderings.clear();
+    }
+}
+
+ordering_cache::~ordering_cache()
+{
+    if (active == this)
+    {
+        active = nullptr;
+    }
+}
+
+std::vector<std::int32_t> const* ordering_cache::find_ordering(std::string const& method,
+                                                               std::uint64_t const key,
+                                                               std::size_t const size) const
+{
+    auto const location = orderings.find(hash(method.data(), method.size(), key));
+
+    if (location == orderings.end() || location->second.size() != size) return nullptr;
+
+    telemetry::count("Cached orderings");
+
+    return &location->second;
+}
+
+void ordering_cache::store_ordering(std::string const& method,
+                                    std::uint64_t const key,
+                                    std::vector<std::int32_t> permutation)
+{
+    orderings[hash(method.data(), method.size(), key)] = std::move(permutation);
+    is_modified = true;
+}
+
+void ordering_cache::save()
+{
+    if (!is_modified) return;
+
+    io::binary_output_archive archive;
+
+    archive.write(file_version);
+    archive.write(patterns);
+    archive.write(orderings);
+
+    archive.save(file_name);
+
+    is_modified = false;
+}
+}
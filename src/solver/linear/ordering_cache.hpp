@@ -0,0 +1,198 @@
+
+#pragma once
+
+#include "numeric/sparse_matrix.hpp"
+#include "telemetry.hpp"
+
+#include <Eigen/OrderingMethods>
+
+#include <algorithm>
+#include <cstdint>
+#include <string>
+#include <tuple>
+#include <unordered_map>
+#include <vector>
+
+/// \file ordering_cache.hpp
+
+namespace neon
+{
+/// ordering_cache keeps the compressed sparsity pattern of the system matrix
+/// and the fill-reducing orderings of the direct linear solvers between runs
+/// on the same mesh.  The patterns are keyed on a hash of the element degrees
+/// of freedom and the orderings on a hash of the matrix pattern.  Dirichlet
+/// conditions are enforced on the values and do not change either key.  The
+/// entries are read from the file when the cache is constructed and new
+/// entries are written with \sa save.  The cache is active for the lifetime
+/// of the object.  Entries read from the cache are recorded in the
+/// "Cached sparsity patterns" and "Cached orderings" telemetry counters.
+class ordering_cache
+{
+public:
+    /// Read the entries from \p file_name if the file exists
+    explicit ordering_cache(std::string file_name);
+
+    ordering_cache(ordering_cache const&) = delete;
+
+    ordering_cache& operator=(ordering_cache const&) = delete;
+
+    ~ordering_cache();
+
+    /// \return the active cache or nullptr if caching is not enabled
+    [[nodiscard]] static ordering_cache* get() noexcept { return active; }
+
+    /// Restore the pattern stored for \p key into \p A with zero values
+    /// \return true if the pattern was found
+    template <typename sparse_matrix_type>
+    bool restore_pattern(std::uint64_t const key, sparse_matrix_type& A) const;
+
+    /// Store the compressed pattern of \p A for \p key
+    template <typename sparse_matrix_type>
+    void store_pattern(std::uint64_t const key, sparse_matrix_type const& A);
+
+    /// \return the permutation with \p size entries stored for the pattern
+    /// \p key and the ordering \p method or nullptr if it is not in the cache
+    [[nodiscard]] std::vector<std::int32_t> const* find_ordering(std::string const& method,
+                                                                 std::uint64_t const key,
+                                                                 std::size_t const size) const;
+
+    /// Store the permutation for the pattern \p key and the ordering \p method
+    void store_ordering(std::string const& method,
+                        std::uint64_t const key,
+                        std::vector<std::int32_t> permutation);
+
+    /// Write the entries to the file if an entry was added
+    void save();
+
+    /// \return the number of stored patterns and orderings
+    [[nodiscard]] auto size() const noexcept { return patterns.size() + orderings.size(); }
+
+    /// Combine \p size values with the hash \p seed (64 bit FNV-1a)
+    template <typename T>
+    [[nodiscard]] static std::uint64_t hash(T const* data,
+                                            std::size_t const size,
+                                            std::uint64_t seed = 14695981039346656037ull);
+
+    /// \return the hash of the pattern of a compressed sparse matrix
+    template <typename sparse_matrix_type>
+    [[nodiscard]] static std::uint64_t pattern_hash(sparse_matrix_type const& A);
+
+protected:
+    /// Rows, outer and inner indices of a compressed pattern
+    using pattern_type = std::tuple<std::int64_t,
+                                    std::vector<std::int32_t>,
+                                    std::vector<std::int32_t>>;
+
+protected:
+    std::string file_name;
+
+    std::unordered_map<std::uint64_t, pattern_type> patterns;
+
+    /// Permutations keyed on the combined hash of the method and the pattern
+    std::unordered_map<std::uint64_t, std::vector<std::int32_t>> orderings;
+
+    /// Flag if entries were added since the file was read
+    bool is_modified{false};
+
+    /// Cache used by the sparsity pattern and the linear solvers
+    static ordering_cache* active;
+};
+
+/// cached_amd_ordering is the fill-reducing ordering for the Eigen sparse
+/// factorisations.  The permutation is taken from the active ordering_cache
+/// when available, otherwise the approximate minimum degree ordering is
+/// computed and stored in the cache
+template <typename index_type>
+class cached_amd_ordering
+{
+public:
+    using PermutationType = Eigen::PermutationMatrix<Eigen::Dynamic, Eigen::Dynamic, index_type>;
+
+    template <typename matrix_type>
+    void operator()(matrix_type const& A, PermutationType& permutation)
+    {
+        auto const cache = ordering_cache::get();
+
+        if (cache == nullptr || !A.isCompressed())
+        {
+            Eigen::AMDOrdering<index_type>()(A, permutation);
+            return;
+        }
+
+        auto const key = ordering_cache::pattern_hash(A);
+
+        if (auto const cached = cache->find_ordering("amd", key, A.cols()); cached != nullptr)
+        {
+            using map_type = Eigen::Map<Eigen::Matrix<std::int32_t, Eigen::Dynamic, 1> const>;
+
+            permutation.indices() = map_type(cached->data(), cached->size())
+                                        .template cast<index_type>();
+            return;
+        }
+
+        Eigen::AMDOrdering<index_type>()(A, permutation);
+
+        cache->store_ordering("amd",
+                              key,
+                              {permutation.indices().data(),
+                               permutation.indices().data() + permutation.size()});
+    }
+};
+
+template <typename T>
+std::uint64_t ordering_cache::hash(T const* data, std::size_t const size, std::uint64_t seed)
+{
+    auto const bytes = reinterpret_cast<unsigned char const*>(data);
+
+    for (std::size_t i{0}; i < size * sizeof(T); ++i)
+    {
+        seed = (seed ^ bytes[i]) * 1099511628211ull;
+    }
+    return seed;
+}
+
+template <typename sparse_matrix_type>
+std::uint64_t ordering_cache::pattern_hash(sparse_matrix_type const& A)
+{
+    std::int64_t const dimensions[] = {A.rows(), A.cols()};
+
+    auto seed = hash(dimensions, 2);
+    seed = hash(A.outerIndexPtr(), A.outerSize() + 1, seed);
+    return hash(A.innerIndexPtr(), A.nonZeros(), seed);
+}
+
+template <typename sparse_matrix_type>
+bool ordering_cache::restore_pattern(std::uint64_t const key, sparse_matrix_type& A) const
+{
+    auto const location = patterns.find(key);
+
+    if (location == patterns.end()) return false;
+
+    auto const& [rows, outer, inner] = location->second;
+
+    if (static_cast<std::int64_t>(outer.size()) != A.outerSize() + 1 || rows != A.rows())
+    {
+        return false;
+    }
+
+    A.resizeNonZeros(inner.size());
+
+    std::copy(begin(outer), end(outer), A.outerIndexPtr());
+    std::copy(begin(inner), end(inner), A.innerIndexPtr());
+
+    A.coeffs().setZero();
+
+    telemetry::count("Cached sparsity patterns");
+
+    return true;
+}
+
+template <typename sparse_matrix_type>
+void ordering_cache::store_pattern(std::uint64_t const key, sparse_matrix_type const& A)
+{
+    patterns[key] = pattern_type{A.rows(),
+                                 {A.outerIndexPtr(), A.outerIndexPtr() + A.outerSize() + 1},
+                                 {A.innerIndexPtr(), A.innerIndexPtr() + A.nonZeros()}};
+    is_modified = true;
+}
+}
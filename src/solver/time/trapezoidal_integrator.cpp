@@ -1,10 +1,16 @@
 
 #include "trapezoidal_integrator.hpp"
 
-#include <iostream>
-
+#include "numeric/float_compare.hpp"
 #include "io/json.hpp"
 
+#include <termcolor/termcolor.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <limits>
+
 namespace neon
 {
 trapezoidal_integrator::trapezoidal_integrator(json const& time_data)
@@ -49,17 +55,151 @@ trapezoidal_integrator::trapezoidal_integrator(json const& time_data)
     final_time = time_data["period"];
     time_step_size = time_data["increments"]["initial"];
 
+    auto const& increments = time_data["increments"];
+
+    if (increments.find("adaptive") != end(increments) && increments["adaptive"].get<bool>())
+    {
+        for (auto const f : {"minimum", "maximum", "tolerance"})
+        {
+            if (increments.find(f) == end(increments))
+            {
+                throw std::runtime_error("Adaptive \"increments\" require a \"" + std::string(f)
+                                         + "\" field");
+            }
+        }
+        use_adaptive_step = true;
+
+        minimum_time_step_size = increments["minimum"];
+        maximum_time_step_size = increments["maximum"];
+        tolerance = increments["tolerance"];
+
+        if (minimum_time_step_size > time_step_size || time_step_size > maximum_time_step_size)
+        {
+            throw std::runtime_error("The \"initial\" increment must be between the \"minimum\" "
+                                     "and \"maximum\" increments");
+        }
+    }
+
     std::cout << std::string(4, ' ') << "Start time     : " << start_time << std::endl;
     std::cout << std::string(4, ' ') << "Final time     : " << final_time << std::endl;
     std::cout << std::string(4, ' ') << "Time step size : " << time_step_size << std::endl;
+
+    if (use_adaptive_step)
+    {
+        std::cout << std::string(4, ' ') << "Error tolerance: " << tolerance << std::endl;
+    }
 }
 
 bool trapezoidal_integrator::loop()
 {
+    if (use_adaptive_step)
+    {
+        // Finish the integration exactly on the final time
+        if (final_time - time <= 1.0e-10 * final_time) return false;
+
+        time_step_size = std::min(time_step_size, final_time - time);
+    }
+
     current_time_step++;
 
     time += time_step_size;
 
-    return time < final_time;
+    return use_adaptive_step || time < final_time;
+}
+
+bool trapezoidal_integrator::update_time_step(vector const& x, vector const& x_next)
+{
+    if (!use_adaptive_step) return true;
+
+    auto constexpr safety_factor{0.9};
+    // Smallest reduction and largest growth of the time step size
+    auto constexpr minimum_factor{0.2}, maximum_factor{2.0};
+    // Growth required before changing (and refactorising) the time step size
+    auto constexpr growth_threshold{1.5};
+
+    // Crank-Nicolson is second order accurate and the other methods first order
+    auto const order = is_approx(method, 0.5) ? 2 : 1;
+
+    if (history.empty()) history.emplace_back(time - time_step_size, x);
+
+    // Without enough history for the predictor the initial step size is accepted
+    if (static_cast<int>(history.size()) <= order)
+    {
+        history.emplace_back(time, x_next);
+        return true;
+    }
+
+    auto const error = estimate_local_error(x_next).lpNorm<Eigen::Infinity>()
+                       / (tolerance
+                          * std::max(x_next.lpNorm<Eigen::Infinity>(),
+                                     std::numeric_limits<double>::epsilon()));
+
+    auto const factor = safety_factor * std::pow(std::max(error, 1.0e-10), -1.0 / (order + 1.0));
+
+    if (error > 1.0)
+    {
+        // The reduced step remains within the interval of the rejected step,
+        // which is shorter than the minimum for the final step
+        auto const reduced_step_size = std::min(std::max(minimum_time_step_size,
+                                                         time_step_size
+                                                             * std::max(factor, minimum_factor)),
+                                                final_time - (time - time_step_size));
+
+        if (reduced_step_size >= time_step_size || is_approx(time_step_size, minimum_time_step_size))
+        {
+            throw std::domain_error("minimum increment is not small enough to satisfy the local "
+                                    "error tolerance\n");
+        }
+
+        time += reduced_step_size - time_step_size;
+        time_step_size = reduced_step_size;
+
+        std::cout << std::string(6, ' ') << termcolor::yellow << termcolor::bold
+                  << "Local error estimate " << error << " exceeds tolerance - time step size "
+                  << "reduced to " << time_step_size << termcolor::reset << std::endl;
+
+        return false;
+    }
+
+    history.emplace_back(time, x_next);
+    history.pop_front();
+
+    if (factor > growth_threshold)
+    {
+        time_step_size = std::min(maximum_time_step_size,
+                                  time_step_size * std::min(factor, maximum_factor));
+    }
+    return true;
+}
+
+vector trapezoidal_integrator::estimate_local_error(vector const& x_next) const
+{
+    auto const order = static_cast<int>(history.size()) - 1;
+
+    // Extrapolate the previous solutions to the current time (Lagrange form)
+    vector x_predictor = vector::Zero(x_next.size());
+
+    for (int i{0}; i <= order; ++i)
+    {
+        double basis{1.0};
+        for (int j{0}; j <= order; ++j)
+        {
+            if (i == j) continue;
+
+            basis *= (time - history[j].first) / (history[i].first - history[j].first);
+        }
+        x_predictor += basis * history[i].second;
+    }
+
+    // The extrapolation error is the next derivative times the node polynomial
+    double predictor_constant = order == 1 ? -0.5 : -1.0 / 6.0;
+    for (auto const& [t, x] : history) predictor_constant *= time - t;
+
+    // Leading error (approximate - exact) of the theta method with the same
+    // derivative is (theta - 1/2) h^2 x'' + (theta / 2 - 1/6) h^3 x'''
+    auto const corrector_constant = order == 1 ? (method - 0.5) * std::pow(time_step_size, 2)
+                                               : std::pow(time_step_size, 3) / 12.0;
+
+    return corrector_constant / (corrector_constant - predictor_constant) * (x_next - x_predictor);
 }
 }
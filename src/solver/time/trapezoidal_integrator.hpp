@@ -1,10 +1,21 @@
 
 #pragma once
 
+#include "numeric/dense_matrix.hpp"
 #include "io/json_forward.hpp"
 
+#include <deque>
+#include <utility>
+
 namespace neon
 {
+/// trapezoidal_integrator performs the time discretisation of first order
+/// systems using the generalised trapezoidal (theta) method.  The time step
+/// size is either fixed or adaptively controlled from an estimate of the local
+/// truncation error.  The estimate compares the solution with a polynomial
+/// extrapolation of the previous solutions (Milne's device) and the time step
+/// size is only changed when a significant growth is possible so the
+/// factorisation of the system can be reused between steps.
 class trapezoidal_integrator
 {
 public:
@@ -19,6 +30,19 @@ public:
 
     [[nodiscard]] double current_time() const noexcept { return time; }
 
+    /// \return the implicit weighting of the method (theta)
+    [[nodiscard]] double implicit_factor() const noexcept { return method; }
+
+    /// Estimate the local truncation error for the step from \p x to \p x_next
+    /// and update the time step size.  If the step is rejected the time is
+    /// reset with a smaller time step size and the step must be repeated.
+    /// \return true if the step is accepted
+    [[nodiscard]] bool update_time_step(vector const& x, vector const& x_next);
+
+protected:
+    /// \return the local truncation error estimate for the solution \p x_next
+    [[nodiscard]] vector estimate_local_error(vector const& x_next) const;
+
 protected:
     /// 0.0 if forward Euler, 0.5 if Crank-Nicolson and 1.0 if backward Euler
     double method;
@@ -27,5 +51,15 @@ protected:
 
     double time{start_time};
     int current_time_step{0};
+
+    /// Flag for the adaptive time step size control
+    bool use_adaptive_step{false};
+    /// Time step size limits for adaptive stepping
+    double minimum_time_step_size{1.0}, maximum_time_step_size{1.0};
+    /// Relative local truncation error tolerance
+    double tolerance{1.0e-3};
+
+    /// Accepted times and solutions for the extrapolation predictor
+    std::deque<std::pair<double, vector>> history;
 };
 }
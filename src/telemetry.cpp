@@ -0,0 +1,425 @@
+
+#include "telemetry.hpp"
+
+#include "io/json.hpp"
+
+#include <atomic>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace neon::telemetry
+{
+namespace
+{
+struct statistic
+{
+    std::int64_t calls{0};
+    double seconds{0.0};
+};
+
+struct event
+{
+    char const* name;
+    /// Time since the origin of the trace in microseconds
+    std::int64_t begin;
+    std::int64_t duration;
+};
+
+using timer_map = std::map<std::string_view, statistic>;
+using counter_map = std::map<std::string_view, std::int64_t>;
+
+/// Events and aggregates of a single thread.  The lock is only contended
+/// when the buffers are collected.
+struct thread_buffer
+{
+    std::mutex mutex;
+    std::int64_t thread_index{0};
+    std::vector<event> events;
+    timer_map timers;
+    counter_map counters;
+};
+
+struct step_record
+{
+    std::int64_t step;
+    double time;
+    std::int64_t timestamp;
+    timer_map timers;
+    counter_map counters;
+};
+
+struct registry
+{
+    std::mutex mutex;
+
+    std::vector<std::shared_ptr<thread_buffer>> buffers;
+
+    std::chrono::steady_clock::time_point const origin{std::chrono::steady_clock::now()};
+
+    std::atomic<verbosity> level{verbosity::detailed};
+
+    std::atomic<bool> is_tracing{false};
+
+    std::string name;
+    std::string summary_format;
+
+    std::vector<step_record> steps;
+
+    timer_map total_timers;
+    counter_map total_counters;
+};
+
+registry& global()
+{
+    static registry instance;
+    return instance;
+}
+
+thread_buffer& local()
+{
+    thread_local std::shared_ptr<thread_buffer> const buffer = [] {
+        auto& state = global();
+
+        std::lock_guard<std::mutex> lock(state.mutex);
+
+        auto& new_buffer = state.buffers.emplace_back(std::make_shared<thread_buffer>());
+
+        new_buffer->thread_index = state.buffers.size() - 1;
+
+        return new_buffer;
+    }();
+    return *buffer;
+}
+
+std::int64_t microseconds(std::chrono::steady_clock::duration const duration)
+{
+    return std::chrono::duration_cast<std::chrono::microseconds>(duration).count();
+}
+
+/// Collect and reset the aggregates of each thread.  The registry must be
+/// locked by the caller.
+std::pair<timer_map, counter_map> collect(registry& state)
+{
+    timer_map timers;
+    counter_map counters;
+
+    for (auto const& buffer : state.buffers)
+    {
+        std::lock_guard<std::mutex> lock(buffer->mutex);
+
+        for (auto const& [name, value] : buffer->timers)
+        {
+            timers[name].calls += value.calls;
+            timers[name].seconds += value.seconds;
+        }
+        for (auto const& [name, value] : buffer->counters) counters[name] += value;
+
+        buffer->timers.clear();
+        buffer->counters.clear();
+    }
+
+    for (auto const& [name, value] : timers)
+    {
+        state.total_timers[name].calls += value.calls;
+        state.total_timers[name].seconds += value.seconds;
+    }
+    for (auto const& [name, value] : counters) state.total_counters[name] += value;
+
+    return {timers, counters};
+}
+
+json to_json(timer_map const& timers, counter_map const& counters)
+{
+    json values;
+
+    values["timers"] = json::object();
+    values["counters"] = json::object();
+
+    for (auto const& [name, value] : timers)
+    {
+        values["timers"][std::string(name)] = {{"calls", value.calls}, {"seconds", value.seconds}};
+    }
+    for (auto const& [name, value] : counters)
+    {
+        values["counters"][std::string(name)] = value;
+    }
+    return values;
+}
+
+void write_trace(registry& state, std::string const& file_name)
+{
+    std::ofstream file(file_name);
+
+    file << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+
+    bool is_first{true};
+
+    auto const separator = [&is_first]() {
+        auto const value = is_first ? "\n" : ",\n";
+        is_first = false;
+        return value;
+    };
+
+    for (auto const& buffer : state.buffers)
+    {
+        std::lock_guard<std::mutex> lock(buffer->mutex);
+
+        for (auto const& [name, begin, duration] : buffer->events)
+        {
+            file << separator() << json{{"name", name},
+                                        {"cat", "neon"},
+                                        {"ph", "X"},
+                                        {"ts", begin},
+                                        {"dur", duration},
+                                        {"pid", 1},
+                                        {"tid", buffer->thread_index}}
+                                       .dump();
+        }
+    }
+
+    // Counters are shown as a time series at the end of each step
+    for (auto const& record : state.steps)
+    {
+        for (auto const& [name, value] : record.counters)
+        {
+            file << separator() << json{{"name", std::string(name)},
+                                        {"ph", "C"},
+                                        {"ts", record.timestamp},
+                                        {"pid", 1},
+                                        {"args", {{"value", value}}}}
+                                       .dump();
+        }
+    }
+    file << "\n]}\n";
+
+    if (!file)
+    {
+        throw std::domain_error("Unable to write " + file_name + " to disk");
+    }
+}
+
+void write_csv(registry const& state, std::string const& file_name)
+{
+    std::ofstream file(file_name);
+
+    file << "step,time,name,calls,seconds,value\n";
+
+    for (auto const& record : state.steps)
+    {
+        for (auto const& [name, value] : record.timers)
+        {
+            file << record.step << "," << record.time << ",\"" << name << "\"," << value.calls
+                 << "," << value.seconds << ",\n";
+        }
+        for (auto const& [name, value] : record.counters)
+        {
+            file << record.step << "," << record.time << ",\"" << name << "\",,," << value
+                 << "\n";
+        }
+    }
+
+    if (!file)
+    {
+        throw std::domain_error("Unable to write " + file_name + " to disk");
+    }
+}
+}
+
+void configure(json const& root)
+{
+    auto& state = global();
+
+    std::lock_guard<std::mutex> lock(state.mutex);
+
+    state.level = verbosity::detailed;
+    state.is_tracing = false;
+    state.summary_format.clear();
+    state.steps.clear();
+    state.total_timers.clear();
+    state.total_counters.clear();
+
+    for (auto const& buffer : state.buffers)
+    {
+        std::lock_guard<std::mutex> buffer_lock(buffer->mutex);
+
+        buffer->events.clear();
+        buffer->timers.clear();
+        buffer->counters.clear();
+    }
+
+    state.name = root.find("name") != root.end() ? root["name"].get<std::string>() : "neon";
+
+    if (root.find("telemetry") == root.end()) return;
+
+    auto const& telemetry = root["telemetry"];
+
+    if (telemetry.find("verbosity") != telemetry.end())
+    {
+        auto const& level = telemetry["verbosity"];
+
+        if (level == "quiet")
+        {
+            state.level = verbosity::quiet;
+        }
+        else if (level == "summary")
+        {
+            state.level = verbosity::summary;
+        }
+        else if (level != "detailed")
+        {
+            throw std::domain_error("\"verbosity\" must be \"quiet\", \"summary\" or "
+                                    "\"detailed\"");
+        }
+    }
+
+    if (telemetry.find("trace") != telemetry.end())
+    {
+        state.is_tracing = telemetry["trace"].get<bool>();
+    }
+
+    if (telemetry.find("summary") != telemetry.end())
+    {
+        state.summary_format = telemetry["summary"].get<std::string>();
+
+        if (state.summary_format != "csv" && state.summary_format != "json")
+        {
+            throw std::domain_error("\"summary\" must be \"csv\" or \"json\"");
+        }
+    }
+}
+
+verbosity console() { return global().level; }
+
+void count(char const* const name, std::int64_t const value)
+{
+    auto& buffer = local();
+
+    std::lock_guard<std::mutex> lock(buffer.mutex);
+
+    buffer.counters[name] += value;
+}
+
+void complete_step(std::int64_t const step, double const time)
+{
+    auto& state = global();
+
+    std::lock_guard<std::mutex> lock(state.mutex);
+
+    auto [timers, counters] = collect(state);
+
+    if (state.level == verbosity::summary)
+    {
+        std::cout << std::string(6, ' ') << "Step " << step << ":";
+
+        for (auto const& [name, value] : timers)
+        {
+            std::cout << " " << name << " " << value.seconds << "s (" << value.calls << "),";
+        }
+        for (auto const& [name, value] : counters)
+        {
+            std::cout << " " << name << " " << value << ",";
+        }
+        std::cout << "\n";
+    }
+
+    state.steps.push_back({step,
+                           time,
+                           microseconds(std::chrono::steady_clock::now() - state.origin),
+                           std::move(timers),
+                           std::move(counters)});
+}
+
+json summary()
+{
+    auto& state = global();
+
+    std::lock_guard<std::mutex> lock(state.mutex);
+
+    // Include the scopes recorded after the last completed step in the totals
+    collect(state);
+
+    json values = to_json(state.total_timers, state.total_counters);
+
+    values["steps"] = json::array();
+
+    for (auto const& record : state.steps)
+    {
+        auto& step_values = values["steps"].emplace_back(to_json(record.timers, record.counters));
+
+        step_values["step"] = record.step;
+        step_values["time"] = record.time;
+    }
+    return values;
+}
+
+void write()
+{
+    auto& state = global();
+
+    if (state.summary_format == "json")
+    {
+        std::ofstream(state.name + "_telemetry.json") << summary().dump(4) << "\n";
+    }
+
+    std::lock_guard<std::mutex> lock(state.mutex);
+
+    if (state.is_tracing)
+    {
+        write_trace(state, state.name + ".trace.json");
+    }
+    if (state.summary_format == "csv")
+    {
+        write_csv(state, state.name + "_telemetry.csv");
+    }
+}
+
+scoped_timer::scoped_timer(char const* const name, timer_output const output)
+    : name(name), output(output), start(std::chrono::steady_clock::now())
+{
+}
+
+scoped_timer::~scoped_timer()
+{
+    auto const end = std::chrono::steady_clock::now();
+
+    auto const seconds = std::chrono::duration<double>(end - start).count();
+
+    auto& state = global();
+    auto& buffer = local();
+
+    {
+        std::lock_guard<std::mutex> lock(buffer.mutex);
+
+        auto& value = buffer.timers[name];
+        value.calls++;
+        value.seconds += seconds;
+
+        if (state.is_tracing)
+        {
+            buffer.events.push_back({name,
+                                     microseconds(start - state.origin),
+                                     microseconds(end - start)});
+        }
+    }
+
+    if (state.level == verbosity::detailed && output != timer_output::silent)
+    {
+        std::cout << std::string(6, ' ') << name
+                  << (output == timer_output::required ? " required " : " took ") << seconds
+                  << "s\n";
+    }
+}
+
+double scoped_timer::elapsed() const
+{
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+}
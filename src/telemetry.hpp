@@ -0,0 +1,81 @@
+
+#pragma once
+
+#include "io/json_forward.hpp"
+
+#include <chrono>
+#include <cstdint>
+
+/// \file telemetry.hpp
+
+/// telemetry records the time spent in instrumented scopes and the value of
+/// counters (iterations, cutbacks, bytes written) in a buffer for each thread.
+/// The buffers are aggregated for each converged step and exported as a
+/// Chrome trace (chrome://tracing or Perfetto) and as a per step summary.
+/// Names of the scopes and counters must be string literals.
+namespace neon::telemetry
+{
+/// Level of the console output for the instrumentation
+enum class verbosity {
+    /// No timing output
+    quiet,
+    /// One line for each completed step
+    summary,
+    /// The time of each instrumented scope
+    detailed
+};
+
+/// Configure the instrumentation from the optional \p "telemetry" field in
+/// the root of the input file and discard all recorded data
+void configure(json const& root);
+
+/// \return the console verbosity
+[[nodiscard]] verbosity console();
+
+/// Add \p value to the counter \p name
+void count(char const* const name, std::int64_t const value = 1);
+
+/// Aggregate the scopes and counters recorded since the last completed step
+void complete_step(std::int64_t const step, double const time);
+
+/// \return the totals and the per step aggregates as a json object
+[[nodiscard]] json summary();
+
+/// Write the trace and the summary files requested in the configuration
+void write();
+
+/// Console line of a scoped_timer at the detailed verbosity
+enum class timer_output {
+    /// Print "<name> took <seconds>s"
+    took,
+    /// Print "<name> required <seconds>s"
+    required,
+    /// Only record the time
+    silent
+};
+
+/// scoped_timer records the time from construction to destruction as an
+/// event of the calling thread.  The time is printed at the detailed console
+/// verbosity unless the timer is silent.
+class scoped_timer
+{
+public:
+    explicit scoped_timer(char const* const name, timer_output const output = timer_output::took);
+
+    scoped_timer(scoped_timer const&) = delete;
+
+    scoped_timer& operator=(scoped_timer const&) = delete;
+
+    ~scoped_timer();
+
+    /// \return the time since construction in seconds
+    [[nodiscard]] double elapsed() const;
+
+protected:
+    char const* name;
+
+    timer_output output;
+
+    std::chrono::steady_clock::time_point start;
+};
+}
@@ -0,0 +1,236 @@
+
+#include "thread_policy.hpp"
+
+#include "io/json.hpp"
+
+#include <hwloc.h>
+#include <omp.h>
+#include <unistd.h>
+
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+#include <tbb/partitioner.h>
+#include <tbb/task_arena.h>
+#include <tbb/task_scheduler_observer.h>
+
+#include <algorithm>
+#include <climits>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <thread>
+
+namespace neon
+{
+thread_policy const* thread_policy::active = nullptr;
+
+class thread_policy::pinning_observer : public tbb::task_scheduler_observer
+{
+public:
+    explicit pinning_observer(thread_policy const& policy) : policy(policy) { observe(true); }
+
+    ~pinning_observer() { observe(false); }
+
+    void on_scheduler_entry(bool) override
+    {
+        policy.bind(tbb::this_task_arena::current_thread_index());
+    }
+
+protected:
+    thread_policy const& policy;
+};
+
+thread_policy::thread_policy(json const& root)
+    : thread_count(std::max(1u, std::thread::hardware_concurrency()))
+{
+    if (root.find("cores") != end(root))
+    {
+        if (!root["cores"].is_number_integer() || root["cores"].get<int>() < 1)
+        {
+            throw std::domain_error("\"cores\" must be a positive integer");
+        }
+        thread_count = root["cores"];
+    }
+
+    control = std::make_unique<tbb::global_control>(tbb::global_control::max_allowed_parallelism,
+                                                    thread_count);
+
+    omp_set_num_threads(thread_count);
+
+    if (root.find("affinity") == end(root))
+    {
+        return;
+    }
+
+    auto const& affinity = root["affinity"];
+
+    // The handles release the topology and the bitmaps if the input is invalid
+    hwloc_topology_t loaded_topology;
+    hwloc_topology_init(&loaded_topology);
+    topology.reset(loaded_topology);
+
+    hwloc_topology_load(topology.get());
+
+    cpusets.resize(thread_count);
+
+    for (auto& cpuset : cpusets) cpuset.reset(hwloc_bitmap_alloc());
+
+    auto const processing_units = hwloc_get_nbobjs_by_type(topology.get(), HWLOC_OBJ_PU);
+
+    if (affinity.is_array())
+    {
+        if (affinity.size() < static_cast<std::size_t>(thread_count))
+        {
+            throw std::domain_error("\"affinity\" requires a processing unit for each of the "
+                                    + std::to_string(thread_count) + " cores");
+        }
+
+        for (int thread{0}; thread < thread_count; ++thread)
+        {
+            auto const unit = hwloc_get_pu_obj_by_os_index(topology.get(),
+                                                           affinity[thread].get<unsigned>());
+            if (unit == nullptr)
+            {
+                throw std::domain_error("\"affinity\" processing unit "
+                                        + affinity[thread].dump() + " does not exist");
+            }
+            hwloc_bitmap_copy(cpusets[thread].get(), unit->cpuset);
+        }
+    }
+    else if (affinity == "compact")
+    {
+        // Fill the processing units in the logical order of the topology
+        for (int thread{0}; thread < thread_count; ++thread)
+        {
+            auto const unit = hwloc_get_obj_by_type(topology.get(),
+                                                    HWLOC_OBJ_PU,
+                                                    thread % processing_units);
+
+            hwloc_bitmap_copy(cpusets[thread].get(), unit->cpuset);
+        }
+    }
+    else if (affinity == "spread")
+    {
+        // Distribute the threads evenly over the sockets and memory nodes
+        auto root_object = hwloc_get_root_obj(topology.get());
+
+        // hwloc_distrib allocates the sets which are then owned by the handles
+        std::vector<hwloc_bitmap_t> distributed_sets(thread_count, nullptr);
+
+        hwloc_distrib(topology.get(),
+                      &root_object,
+                      1,
+                      distributed_sets.data(),
+                      thread_count,
+                      INT_MAX,
+                      0);
+
+        for (int thread{0}; thread < thread_count; ++thread)
+        {
+            cpusets[thread].reset(distributed_sets[thread]);
+            hwloc_bitmap_singlify(cpusets[thread].get());
+        }
+    }
+    else
+    {
+        throw std::domain_error("\"affinity\" must be \"compact\", \"spread\" or a list of "
+                                "processing units");
+    }
+
+    // Pin the OpenMP threads and the main thread
+#pragma omp parallel num_threads(thread_count)
+    {
+        bind(omp_get_thread_num());
+    }
+    bind(0);
+
+    observer = std::make_unique<pinning_observer>(*this);
+
+    // Memory placement only matters with more than one memory node
+    auto const support = hwloc_topology_get_support(topology.get());
+
+    if (support->membind->set_area_membind && support->membind->migrate_membind
+        && hwloc_get_nbobjs_by_type(topology.get(), HWLOC_OBJ_NUMANODE) > 1)
+    {
+        nodesets.resize(thread_count);
+
+        for (int thread{0}; thread < thread_count; ++thread)
+        {
+            nodesets[thread].reset(hwloc_bitmap_alloc());
+            hwloc_cpuset_to_nodeset(topology.get(),
+                                    cpusets[thread].get(),
+                                    nodesets[thread].get());
+        }
+        active = this;
+    }
+}
+
+thread_policy::~thread_policy()
+{
+    if (active == this)
+    {
+        active = nullptr;
+    }
+
+    // Stop pinning the worker threads before the processing units are released
+    observer.reset();
+}
+
+void thread_policy::topology_deleter::operator()(hwloc_topology* topology) const
+{
+    hwloc_topology_destroy(topology);
+}
+
+void thread_policy::bitmap_deleter::operator()(hwloc_bitmap_s* bitmap) const
+{
+    hwloc_bitmap_free(bitmap);
+}
+
+void thread_policy::distribute(void const* data, std::size_t const bytes)
+{
+    if (active == nullptr || bytes == 0)
+    {
+        return;
+    }
+
+    std::uintptr_t const page_size = sysconf(_SC_PAGESIZE);
+
+    // Extend the range to whole pages
+    auto const first = reinterpret_cast<std::uintptr_t>(data) / page_size;
+    auto const last = (reinterpret_cast<std::uintptr_t>(data) + bytes + page_size - 1) / page_size;
+
+    tbb::parallel_for(tbb::blocked_range<std::uintptr_t>(first, last),
+                      [page_size](auto const& pages) {
+                          active->migrate(reinterpret_cast<char const*>(pages.begin() * page_size),
+                                          reinterpret_cast<char const*>(pages.end() * page_size),
+                                          tbb::this_task_arena::current_thread_index());
+                      },
+                      tbb::static_partitioner{});
+}
+
+void thread_policy::bind(int const thread_index) const
+{
+    if (thread_index < 0 || cpusets.empty())
+    {
+        return;
+    }
+    hwloc_set_cpubind(topology.get(),
+                      cpusets[thread_index % cpusets.size()].get(),
+                      HWLOC_CPUBIND_THREAD);
+}
+
+void thread_policy::migrate(char const* first, char const* last, int const thread_index) const
+{
+    if (thread_index < 0)
+    {
+        return;
+    }
+    // A failure leaves the pages in place and only affects the performance
+    hwloc_set_area_membind(topology.get(),
+                           first,
+                           last - first,
+                           nodesets[thread_index % nodesets.size()].get(),
+                           HWLOC_MEMBIND_BIND,
+                           HWLOC_MEMBIND_MIGRATE | HWLOC_MEMBIND_BYNODESET);
+}
+}
@@ -0,0 +1,103 @@
+
+#pragma once
+
+#include "io/json_forward.hpp"
+
+#include <tbb/global_control.h>
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+/// \file thread_policy.hpp
+
+// Forward declarations of the hwloc handles
+struct hwloc_topology;
+struct hwloc_bitmap_s;
+
+namespace neon
+{
+/// thread_policy sets the number of threads for every threading runtime in
+/// the program from the \p "cores" field of the input file.  The TBB arena,
+/// the OpenMP runtime and the threaded linear solvers use the same number of
+/// threads.  The optional \p "affinity" field pins each thread to a
+/// processing unit such that the memory placement can follow the threads.
+/// The policy is active for the lifetime of the object.
+class thread_policy
+{
+public:
+    /// Apply the policy given in the root of the input file
+    explicit thread_policy(json const& root);
+
+    thread_policy(thread_policy const&) = delete;
+
+    thread_policy& operator=(thread_policy const&) = delete;
+
+    ~thread_policy();
+
+    /// \return the number of threads
+    [[nodiscard]] auto threads() const noexcept { return thread_count; }
+
+    /// \return true if the threads are pinned to processing units
+    [[nodiscard]] auto is_pinned() const noexcept { return !cpusets.empty(); }
+
+    /// Move the pages of an allocation to the memory nodes of the threads that
+    /// process them.  The allocation is split into contiguous blocks in the
+    /// same way as a statically partitioned parallel loop over the data, which
+    /// is equivalent to a first touch in the processing threads.  This has no
+    /// effect if no pinning policy is active.
+    static void distribute(void const* data, std::size_t const bytes);
+
+    /// Distribute the allocation of a contiguous container \sa distribute
+    template <typename container_type>
+    static void distribute(container_type const& container)
+    {
+        distribute(container.data(), container.size() * sizeof(*container.data()));
+    }
+
+protected:
+    /// Bind the calling thread to the processing unit of a thread index
+    void bind(int const thread_index) const;
+
+    /// Move the pages in the range to the memory node of the calling thread
+    void migrate(char const* first, char const* last, int const thread_index) const;
+
+protected:
+    /// Number of threads for all threading runtimes
+    int thread_count;
+
+    /// Release the topology with hwloc_topology_destroy
+    struct topology_deleter
+    {
+        void operator()(hwloc_topology* topology) const;
+    };
+
+    /// Release the bitmap with hwloc_bitmap_free
+    struct bitmap_deleter
+    {
+        void operator()(hwloc_bitmap_s* bitmap) const;
+    };
+
+    using bitmap_handle = std::unique_ptr<hwloc_bitmap_s, bitmap_deleter>;
+
+    /// Topology of the machine
+    std::unique_ptr<hwloc_topology, topology_deleter> topology;
+
+    /// Processing units for each thread index
+    std::vector<bitmap_handle> cpusets;
+
+    /// Memory nodes for each thread index
+    std::vector<bitmap_handle> nodesets;
+
+    /// Limit on the size of the TBB arena
+    std::unique_ptr<tbb::global_control> control;
+
+    class pinning_observer;
+
+    /// Pin the TBB worker threads when they join the arena
+    std::unique_ptr<pinning_observer> observer;
+
+    /// Policy used for the memory placement
+    static thread_policy const* active;
+};
+}
@@ -0,0 +1,100 @@
+
+#include "benchmark.hpp"
+
+#include "assembler/homogeneous_dirichlet.hpp"
+#include "assembler/sparsity_pattern.hpp"
+
+#include "fixtures/cube_mesh.hpp"
+
+#include <tbb/parallel_for.h>
+
+namespace neon::benchmark
+{
+void assembly_benchmarks(report& results)
+{
+    auto const divisions = results.configuration().divisions;
+
+    for (auto const& topology : topologies)
+    {
+        basic_mesh reference_mesh(json::parse(json_cube_mesh(divisions, topology)));
+
+        auto const simulation_data = cube_simulation_data(json::parse("{\"name\" : "
+                                                                      "\"neohooke\"}"));
+
+        mechanics::solid::mesh mesh(reference_mesh,
+                                    json::parse("{\"name\" : \"rubber\", \"elastic_modulus\" : "
+                                                "10.0e6, \"poissons_ratio\" : 0.45}"),
+                                    simulation_data,
+                                    1.0);
+
+        mesh.update_internal_variables(vector::Zero(mesh.active_dofs()), 1.0);
+
+        json const parameters{{"topology", topology},
+                              {"divisions", divisions},
+                              {"dofs", mesh.active_dofs()}};
+
+        sparse_matrix K;
+
+        results.measure("compute_sparsity_pattern", parameters, [&]() {
+            fem::compute_sparsity_pattern(K, mesh);
+        });
+
+        results.measure("assembly_serial", parameters, [&]() { assemble_stiffness(mesh, K); });
+
+        results.measure("assembly_parallel", parameters, [&]() {
+            K.coeffs() = 0.0;
+
+            for (auto const& submesh : mesh.meshes())
+            {
+                tbb::parallel_for(std::int64_t{0}, submesh.elements(), [&](auto const element) {
+                    auto const& [dofs, ke] = submesh.tangent_stiffness(element);
+
+                    for (std::int64_t b{0}; b < dofs.size(); b++)
+                    {
+                        for (std::int64_t a{0}; a < dofs.size(); a++)
+                        {
+                            K.coefficient_update(dofs(a), dofs(b), ke(a, b));
+                        }
+                    }
+                });
+            }
+        });
+
+        results.measure("assembly_triplets", parameters, [&]() {
+            std::vector<Eigen::Triplet<double>> triplets;
+
+            for (auto const& submesh : mesh.meshes())
+            {
+                for (std::int64_t element{0}; element < submesh.elements(); ++element)
+                {
+                    auto const& [dofs, ke] = submesh.tangent_stiffness(element);
+
+                    for (std::int64_t b{0}; b < dofs.size(); b++)
+                    {
+                        for (std::int64_t a{0}; a < dofs.size(); a++)
+                        {
+                            triplets.emplace_back(dofs(a), dofs(b), ke(a, b));
+                        }
+                    }
+                }
+            }
+            K.setFromTriplets(begin(triplets), end(triplets));
+        });
+
+        assemble_stiffness(mesh, K);
+
+        sparse_matrix A;
+
+        // The copy is timed separately so it can be subtracted from the
+        // Dirichlet enforcement which must start from an unmodified matrix
+        results.measure("matrix_copy", parameters, [&]() { A = K; });
+
+        results.measure("dirichlet_enforcement", parameters, [&]() {
+            A = K;
+            vector x = vector::Zero(A.rows());
+            vector b = vector::Zero(A.rows());
+            apply_dirichlet_conditions(A, x, b, mesh);
+        });
+    }
+}
+}
@@ -0,0 +1,55 @@
+
+#include "benchmark.hpp"
+
+#include "mesh/material_coordinates.hpp"
+#include "mesh/mechanics/beam/submesh.hpp"
+
+#include "fixtures/cube_mesh.hpp"
+
+#include <memory>
+
+namespace neon::benchmark
+{
+void beam_benchmarks(report& results)
+{
+    // A beam mesh has the same number of elements as the cube mesh to keep
+    // the timings large enough to be measured
+    auto const divisions = results.configuration().divisions;
+    auto const elements = divisions * divisions * divisions;
+
+    basic_mesh reference_mesh(json::parse(json_line_mesh(elements)));
+
+    auto coordinates = std::make_shared<material_coordinates>(reference_mesh.coordinates());
+
+    json const material_data = json::parse("{\"name\" : \"steel\", \"elastic_modulus\" : "
+                                           "200.0e9, \"poissons_ratio\" : 0.3}");
+
+    json const simulation_data{{"element_options", {{"quadrature", "full"}}}};
+
+    json const section_data{{"name", "beam"},
+                            {"tangent", {1.0, 0.0, 0.0}},
+                            {"normal", {0.0, 1.0, 0.0}}};
+
+    for (auto const& basic_submesh : reference_mesh.meshes("beam"))
+    {
+        mechanics::beam::submesh submesh(material_data,
+                                         simulation_data,
+                                         section_data,
+                                         coordinates,
+                                         basic_submesh);
+
+        json const parameters{{"topology", "line2"}, {"elements", elements}};
+
+        results.measure("beam_update_internal_variables", parameters, [&]() {
+            submesh.update_internal_variables(1.0);
+        });
+
+        results.measure("beam_tangent_stiffness", parameters, [&]() {
+            for (std::int64_t element{0}; element < submesh.elements(); ++element)
+            {
+                static_cast<void>(submesh.tangent_stiffness(element));
+            }
+        });
+    }
+}
+}
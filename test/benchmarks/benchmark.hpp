@@ -0,0 +1,165 @@
+
+#pragma once
+
+#include "mesh/basic_mesh.hpp"
+#include "mesh/mechanics/solid/mesh.hpp"
+#include "numeric/sparse_matrix.hpp"
+#include "io/json.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <numeric>
+#include <string>
+#include <vector>
+
+/// \file benchmark.hpp
+/// Minimal timing harness for the neon_benchmarks target.  Each benchmark is
+/// measured a number of times after a warm up run and the timing statistics
+/// are collected into a JSON report for comparison across commits.
+
+namespace neon::benchmark
+{
+/// Command line options controlling the size and the selection of benchmarks
+struct options
+{
+    /// Elements along each edge of the cube meshes
+    std::int32_t divisions{8};
+    /// Timed runs for each benchmark
+    std::int32_t repetitions{5};
+    /// Only run benchmarks with names containing this string
+    std::string filter;
+};
+
+/// report collects the timing statistics of each benchmark
+class report
+{
+public:
+    explicit report(options const& settings) : settings(settings) {}
+
+    /// \return benchmark options
+    [[nodiscard]] auto const& configuration() const noexcept { return settings; }
+
+    /// \return true if the benchmark with \p name should be run
+    [[nodiscard]] bool is_selected(std::string const& name) const
+    {
+        return settings.filter.empty() || name.find(settings.filter) != std::string::npos;
+    }
+
+    /// Time \p function and add the statistics to the report
+    /// \param name Benchmark name
+    /// \param parameters Parameters identifying the benchmark case
+    /// \param function Callable to time
+    template <typename Callable>
+    void measure(std::string const& name, json const& parameters, Callable&& function)
+    {
+        if (!is_selected(name)) return;
+
+        // Warm up caches and any lazily computed data
+        function();
+
+        std::vector<double> timings;
+        timings.reserve(settings.repetitions);
+
+        for (std::int32_t repetition{0}; repetition < settings.repetitions; ++repetition)
+        {
+            auto const start = std::chrono::steady_clock::now();
+
+            function();
+
+            auto const end = std::chrono::steady_clock::now();
+
+            timings.push_back(std::chrono::duration<double>(end - start).count());
+        }
+
+        std::sort(begin(timings), end(timings));
+
+        auto const mean = std::accumulate(begin(timings), end(timings), 0.0) / timings.size();
+
+        entries.push_back({{"name", name},
+                           {"parameters", parameters},
+                           {"repetitions", settings.repetitions},
+                           {"minimum", timings.front()},
+                           {"median", timings[timings.size() / 2]},
+                           {"mean", mean},
+                           {"maximum", timings.back()}});
+    }
+
+    /// \return the benchmark results as a JSON array
+    [[nodiscard]] json const& results() const noexcept { return entries; }
+
+private:
+    options settings;
+
+    json entries = json::array();
+};
+
+/// Simulation input for a cube clamped on the bottom face and stretched on
+/// the top face using the constitutive model in \p constitutive
+inline json cube_simulation_data(json const& constitutive)
+{
+    return {{"boundaries",
+             {{{"name", "bottom"},
+               {"type", "displacement"},
+               {"time", {0.0, 1.0}},
+               {"x", {0.0, 0.0}},
+               {"y", {0.0, 0.0}},
+               {"z", {0.0, 0.0}}},
+              {{"name", "top"},
+               {"type", "displacement"},
+               {"time", {0.0, 1.0}},
+               {"z", {0.0, 1.0e-3}}}}},
+            {"constitutive", constitutive},
+            {"element_options", {{"quadrature", "full"}}},
+            {"name", "cube"},
+            {"visualisation", {{"fields", {"displacement"}}}}};
+}
+
+/// Assemble the tangent stiffness matrix of \p mesh into \p K which must
+/// already have the sparsity pattern computed
+template <typename MeshType>
+void assemble_stiffness(MeshType const& mesh, sparse_matrix& K)
+{
+    K.coeffs() = 0.0;
+
+    for (auto const& submesh : mesh.meshes())
+    {
+        for (std::int64_t element{0}; element < submesh.elements(); ++element)
+        {
+            auto const& [dofs, ke] = submesh.tangent_stiffness(element);
+
+            for (std::int64_t b{0}; b < dofs.size(); b++)
+            {
+                for (std::int64_t a{0}; a < dofs.size(); a++)
+                {
+                    K.coeffRef(dofs(a), dofs(b)) += ke(a, b);
+                }
+            }
+        }
+    }
+}
+
+/// Element topologies available from the cube mesh fixture
+inline std::vector<std::string> const topologies{"hexahedron", "prism", "tetrahedron"};
+
+/// Element topologies available from the square mesh fixture
+inline std::vector<std::string> const plane_topologies{"quadrilateral", "triangle"};
+
+/// Benchmark the constitutive updates and the element routines
+void constitutive_benchmarks(report& results);
+
+/// Benchmark the plane constitutive updates and the element routines
+void plane_benchmarks(report& results);
+
+/// Benchmark the beam section update and the element stiffness
+void beam_benchmarks(report& results);
+
+/// Benchmark the heat diffusion element routines
+void diffusion_benchmarks(report& results);
+
+/// Benchmark the sparsity pattern, assembly strategies and Dirichlet enforcement
+void assembly_benchmarks(report& results);
+
+/// Benchmark the linear and eigenvalue solvers
+void solver_benchmarks(report& results);
+}
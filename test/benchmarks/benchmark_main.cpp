@@ -0,0 +1,88 @@
+
+#include "benchmark.hpp"
+
+#include <fstream>
+#include <iostream>
+#include <thread>
+
+/// \file benchmark_main.cpp
+/// Entry point for neon_benchmarks.  Usage:
+///     neon_benchmarks [--output results.json] [--divisions n] [--repetitions n] [--filter name]
+
+int main(int argc, char* argv[])
+{
+    using namespace neon::benchmark;
+
+    options settings;
+    std::string output_file{"neon_benchmarks.json"};
+
+    for (int i{1}; i < argc; ++i)
+    {
+        std::string const argument{argv[i]};
+
+        if (i + 1 == argc)
+        {
+            std::cerr << "Missing value for " << argument << "\n";
+            return 1;
+        }
+
+        if (argument == "--output")
+        {
+            output_file = argv[++i];
+        }
+        else if (argument == "--divisions")
+        {
+            settings.divisions = std::stoi(argv[++i]);
+        }
+        else if (argument == "--repetitions")
+        {
+            settings.repetitions = std::stoi(argv[++i]);
+        }
+        else if (argument == "--filter")
+        {
+            settings.filter = argv[++i];
+        }
+        else
+        {
+            std::cerr << "Unrecognised option " << argument << "\n";
+            return 1;
+        }
+    }
+
+    if (settings.divisions < 1)
+    {
+        std::cerr << "--divisions must be at least 1\n";
+        return 1;
+    }
+    if (settings.repetitions < 1)
+    {
+        std::cerr << "--repetitions must be at least 1\n";
+        return 1;
+    }
+
+    report results(settings);
+
+    constitutive_benchmarks(results);
+    plane_benchmarks(results);
+    beam_benchmarks(results);
+    diffusion_benchmarks(results);
+    assembly_benchmarks(results);
+    solver_benchmarks(results);
+
+    neon::json const output{{"context",
+                             {{"divisions", settings.divisions},
+                              {"repetitions", settings.repetitions},
+                              {"hardware_threads", std::thread::hardware_concurrency()}}},
+                            {"benchmarks", results.results()}};
+
+    std::ofstream file(output_file);
+
+    if (!file.is_open())
+    {
+        std::cerr << "Unable to open " << output_file << " for writing\n";
+        return 1;
+    }
+    file << output.dump(4) << "\n";
+
+    return 0;
+}
@@ -0,0 +1,99 @@
+
+#include "benchmark.hpp"
+
+#include "fixtures/cube_mesh.hpp"
+
+#include <cstdlib>
+#include <utility>
+
+namespace neon::benchmark
+{
+namespace
+{
+/// Material and constitutive input for each of the solid constitutive models
+std::vector<std::pair<json, json>> const models{
+    {json::parse("{\"name\" : \"rubber\", \"elastic_modulus\" : 10.0e6, \"poissons_ratio\" : 0.45}"),
+     json::parse("{\"name\" : \"neohooke\"}")},
+    {json::parse("{\"name\" : \"steel\", \"elastic_modulus\" : 200.0e9, \"poissons_ratio\" : 0.3}"),
+     json::parse("{\"name\" : \"isotropic_linear_elasticity\"}")},
+    {json::parse("{\"name\" : \"steel\", \"elastic_modulus\" : 200.0e9, \"poissons_ratio\" : 0.3, "
+                 "\"yield_stress\" : 200.0e6, \"isotropic_hardening_modulus\" : 400.0e6}"),
+     json::parse("{\"name\" : \"J2_plasticity\", \"finite_strain\" : false}")},
+    {json::parse("{\"name\" : \"steel\", \"elastic_modulus\" : 200.0e9, \"poissons_ratio\" : 0.3, "
+                 "\"yield_stress\" : 200.0e6, \"isotropic_hardening_modulus\" : 400.0e6}"),
+     json::parse("{\"name\" : \"J2_plasticity\", \"finite_strain\" : true}")},
+    {json::parse("{\"name\" : \"steel\", \"elastic_modulus\" : 134.0e3, \"poissons_ratio\" : 0.3, "
+                 "\"yield_stress\" : 85, \"kinematic_hardening_modulus\" : 5500, "
+                 "\"softening_multiplier\" : 250, \"plasticity_viscous_exponent\" : 2.5, "
+                 "\"plasticity_viscous_denominator\" : 1220, \"damage_viscous_exponent\" : 2, "
+                 "\"damage_viscous_denominator\" : 0.6}"),
+     json::parse("{\"name\" : \"J2_plasticity\", \"damage\" : \"isotropic_chaboche\", "
+                 "\"finite_strain\" : false}")},
+    {json::parse("{\"name\" : \"rubber\", \"elastic_modulus\" : 10.0e6, \"poissons_ratio\" : 0.45, "
+                 "\"segments_per_chain\" : 50}"),
+     json::parse("{\"name\" : \"microsphere\", \"type\" : \"affine\", \"statistics\" : "
+                 "\"gaussian\", \"quadrature\" : \"BO21\"}")},
+    {json::parse("{\"name\" : \"rubber\", \"elastic_modulus\" : 10.0e6, \"poissons_ratio\" : 0.45, "
+                 "\"segments_per_chain\" : 50}"),
+     json::parse("{\"name\" : \"microsphere\", \"type\" : \"affine\", \"statistics\" : "
+                 "\"langevin\", \"quadrature\" : \"BO21\"}")},
+    {json::parse("{\"name\" : \"rubber\", \"elastic_modulus\" : 10.0e6, \"poissons_ratio\" : 0.45, "
+                 "\"nonaffine_stretch_parameter\" : 1.0, \"segments_per_chain\" : 50}"),
+     json::parse("{\"name\" : \"microsphere\", \"type\" : \"nonaffine\", \"quadrature\" : "
+                 "\"BO21\"}")},
+    {json::parse("{\"name\" : \"rubber\", \"shear_modulus\" : 2.0e6, \"bulk_modulus\" : 100e6, "
+                 "\"segments_per_chain\" : 50, \"scission_probability\" : 1.0e-5, "
+                 "\"recombination_probability\" : 1.0e-5}"),
+     json::parse("{\"name\" : \"microsphere\", \"type\" : \"affine\", \"statistics\" : "
+                 "\"gaussian\", \"quadrature\" : \"BO21\", \"ageing\" : \"BAND\"}")}};
+}
+
+void constitutive_benchmarks(report& results)
+{
+    auto const divisions = results.configuration().divisions;
+
+    for (auto const& topology : topologies)
+    {
+        basic_mesh reference_mesh(json::parse(json_cube_mesh(divisions, topology)));
+
+        for (auto const& [material_data, constitutive_data] : models)
+        {
+            auto const simulation_data = cube_simulation_data(constitutive_data);
+
+            mechanics::solid::mesh mesh(reference_mesh, material_data, simulation_data, 1.0);
+
+            json const parameters{{"topology", topology},
+                                  {"divisions", divisions},
+                                  {"constitutive", constitutive_data}};
+
+            // Small displacement field to exercise the kinematics
+            std::srand(0);
+            vector const displacement = 1.0e-4 * vector::Random(mesh.active_dofs());
+
+            results.measure("update_internal_variables", parameters, [&]() {
+                mesh.update_internal_variables(displacement, 1.0);
+            });
+
+            results.measure("tangent_stiffness", parameters, [&]() {
+                for (auto const& submesh : mesh.meshes())
+                {
+                    for (std::int64_t element{0}; element < submesh.elements(); ++element)
+                    {
+                        static_cast<void>(submesh.tangent_stiffness(element));
+                    }
+                }
+            });
+
+            results.measure("internal_force", parameters, [&]() {
+                for (auto const& submesh : mesh.meshes())
+                {
+                    for (std::int64_t element{0}; element < submesh.elements(); ++element)
+                    {
+                        static_cast<void>(submesh.internal_force(element));
+                    }
+                }
+            });
+        }
+    }
+}
+}
@@ -0,0 +1,64 @@
+
+#include "benchmark.hpp"
+
+#include "mesh/diffusion/heat/mesh.hpp"
+
+#include "fixtures/cube_mesh.hpp"
+
+namespace neon::benchmark
+{
+void diffusion_benchmarks(report& results)
+{
+    auto const divisions = results.configuration().divisions;
+
+    json const material_data = json::parse("{\"name\" : \"steel\", \"conductivity\" : 386.0, "
+                                           "\"density\" : 7800.0, \"specific_heat\" : 390.0}");
+
+    json const simulation_data{{"boundaries",
+                                {{{"name", "bottom"},
+                                  {"type", "temperature"},
+                                  {"time", {0.0, 1.0}},
+                                  {"value", {0.0, 0.0}}},
+                                 {{"name", "top"},
+                                  {"type", "temperature"},
+                                  {"time", {0.0, 1.0}},
+                                  {"value", {0.0, 100.0}}}}},
+                               {"constitutive", {{"name", "isotropic_diffusion"}}},
+                               {"element_options", {{"quadrature", "full"}}},
+                               {"name", "cube"},
+                               {"visualisation", {{"fields", {"temperature"}}}}};
+
+    for (auto const& topology : topologies)
+    {
+        basic_mesh reference_mesh(json::parse(json_cube_mesh(divisions, topology)));
+
+        diffusion::mesh mesh(reference_mesh, material_data, simulation_data);
+
+        mesh.update_internal_variables(vector::Zero(mesh.active_dofs()), 1.0);
+
+        json const parameters{{"topology", topology},
+                              {"divisions", divisions},
+                              {"dofs", mesh.active_dofs()}};
+
+        results.measure("diffusion_tangent_stiffness", parameters, [&]() {
+            for (auto const& submesh : mesh.meshes())
+            {
+                for (std::int64_t element{0}; element < submesh.elements(); ++element)
+                {
+                    static_cast<void>(submesh.tangent_stiffness(element));
+                }
+            }
+        });
+
+        results.measure("diffusion_consistent_mass", parameters, [&]() {
+            for (auto const& submesh : mesh.meshes())
+            {
+                for (std::int64_t element{0}; element < submesh.elements(); ++element)
+                {
+                    static_cast<void>(submesh.consistent_mass(element));
+                }
+            }
+        });
+    }
+}
+}
@@ -0,0 +1,97 @@
+
+#include "benchmark.hpp"
+
+#include "mesh/mechanics/plane/mesh.hpp"
+
+#include "fixtures/cube_mesh.hpp"
+
+#include <cstdlib>
+#include <utility>
+
+namespace neon::benchmark
+{
+namespace
+{
+/// Material and constitutive input for each of the plane constitutive models
+std::vector<std::pair<json, json>> const models{
+    {json::parse("{\"name\" : \"steel\", \"elastic_modulus\" : 200.0e9, \"poissons_ratio\" : 0.3}"),
+     json::parse("{\"name\" : \"plane_strain\"}")},
+    {json::parse("{\"name\" : \"steel\", \"elastic_modulus\" : 200.0e9, \"poissons_ratio\" : 0.3}"),
+     json::parse("{\"name\" : \"plane_stress\"}")},
+    {json::parse("{\"name\" : \"steel\", \"elastic_modulus\" : 200.0e9, \"poissons_ratio\" : 0.3, "
+                 "\"yield_stress\" : 200.0e6, \"isotropic_hardening_modulus\" : 400.0e6}"),
+     json::parse("{\"name\" : \"J2_plasticity\", \"finite_strain\" : false}")},
+    {json::parse("{\"name\" : \"steel\", \"elastic_modulus\" : 200.0e9, \"poissons_ratio\" : 0.3, "
+                 "\"yield_stress\" : 200.0e6, \"isotropic_hardening_modulus\" : 400.0e6}"),
+     json::parse("{\"name\" : \"J2_plasticity\", \"finite_strain\" : true}")}};
+
+/// Simulation input for a square clamped on the bottom edge and stretched on
+/// the top edge using the constitutive model in \p constitutive
+json square_simulation_data(json const& constitutive)
+{
+    return {{"boundaries",
+             {{{"name", "bottom"},
+               {"type", "displacement"},
+               {"time", {0.0, 1.0}},
+               {"x", {0.0, 0.0}},
+               {"y", {0.0, 0.0}}},
+              {{"name", "top"},
+               {"type", "displacement"},
+               {"time", {0.0, 1.0}},
+               {"y", {0.0, 1.0e-3}}}}},
+            {"constitutive", constitutive},
+            {"element_options", {{"quadrature", "full"}}},
+            {"name", "square"},
+            {"visualisation", {{"fields", {"displacement"}}}}};
+}
+}
+
+void plane_benchmarks(report& results)
+{
+    auto const divisions = results.configuration().divisions;
+
+    for (auto const& topology : plane_topologies)
+    {
+        basic_mesh reference_mesh(json::parse(json_square_mesh(divisions, topology)));
+
+        for (auto const& [material_data, constitutive_data] : models)
+        {
+            auto const simulation_data = square_simulation_data(constitutive_data);
+
+            mechanics::plane::mesh mesh(reference_mesh, material_data, simulation_data, 1.0);
+
+            json const parameters{{"topology", topology},
+                                  {"divisions", divisions},
+                                  {"constitutive", constitutive_data}};
+
+            // Small displacement field to exercise the kinematics
+            std::srand(0);
+            vector const displacement = 1.0e-4 * vector::Random(mesh.active_dofs());
+
+            results.measure("plane_update_internal_variables", parameters, [&]() {
+                mesh.update_internal_variables(displacement, 1.0);
+            });
+
+            results.measure("plane_tangent_stiffness", parameters, [&]() {
+                for (auto const& submesh : mesh.meshes())
+                {
+                    for (std::int64_t element{0}; element < submesh.elements(); ++element)
+                    {
+                        static_cast<void>(submesh.tangent_stiffness(element));
+                    }
+                }
+            });
+
+            results.measure("plane_internal_force", parameters, [&]() {
+                for (auto const& submesh : mesh.meshes())
+                {
+                    for (std::int64_t element{0}; element < submesh.elements(); ++element)
+                    {
+                        static_cast<void>(submesh.internal_force(element));
+                    }
+                }
+            });
+        }
+    }
+}
+}
@@ -0,0 +1,67 @@
+
+#include "benchmark.hpp"
+
+#include "assembler/homogeneous_dirichlet.hpp"
+#include "assembler/sparsity_pattern.hpp"
+#include "solver/eigen/eigen_solver_factory.hpp"
+#include "solver/linear/linear_solver_factory.hpp"
+
+#include "fixtures/cube_mesh.hpp"
+
+namespace neon::benchmark
+{
+void solver_benchmarks(report& results)
+{
+    auto const divisions = results.configuration().divisions;
+
+    basic_mesh reference_mesh(json::parse(json_cube_mesh(divisions, "hexahedron")));
+
+    auto const simulation_data = cube_simulation_data(json::parse("{\"name\" : "
+                                                                  "\"isotropic_linear_"
+                                                                  "elasticity\"}"));
+
+    mechanics::solid::mesh mesh(reference_mesh,
+                                json::parse("{\"name\" : \"steel\", \"elastic_modulus\" : 200.0e9, "
+                                            "\"poissons_ratio\" : 0.3}"),
+                                simulation_data,
+                                1.0);
+
+    mesh.update_internal_variables(vector::Zero(mesh.active_dofs()), 1.0);
+
+    sparse_matrix K;
+    fem::compute_sparsity_pattern(K, mesh);
+    assemble_stiffness(mesh, K);
+
+    vector x = vector::Zero(K.rows());
+    vector b = vector::Zero(K.rows());
+
+    apply_dirichlet_conditions(K, x, b, mesh);
+
+    for (auto const& type : {"direct", "iterative", "PaStiX", "MUMPS"})
+    {
+        auto const solver = make_linear_solver(json{{"type", type}}, mesh.is_symmetric());
+
+        json const parameters{{"solver", type}, {"divisions", divisions}, {"dofs", K.rows()}};
+
+        results.measure("linear_solver", parameters, [&]() {
+            x.setZero();
+            solver->solve(K, x, b);
+        });
+    }
+
+#ifdef ENABLE_OPENCL
+    auto const eigen_solvers = {"arpack", "power_iteration", "lanczos"};
+#else
+    auto const eigen_solvers = {"arpack", "power_iteration"};
+#endif
+
+    for (auto const& type : eigen_solvers)
+    {
+        auto const solver = make_eigen_solver(json{{"type", type}, {"eigenvalues", 5}});
+
+        json const parameters{{"solver", type}, {"divisions", divisions}, {"dofs", K.rows()}};
+
+        results.measure("eigen_solver", parameters, [&]() { solver->solve(K); });
+    }
+}
+}
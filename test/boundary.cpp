@@ -11,6 +11,7 @@
 
 #include "fixtures/cube_mesh.hpp"
 
+#include <algorithm>
 #include <memory>
 
 using namespace neon;
@@ -176,6 +177,29 @@ TEST_CASE("Pressure test for triangle")
 
         REQUIRE((dof_list.col(0) - dofs).sum() == 0);
     }
+    SECTION("Reference load")
+    {
+        pressure pressure_patch(std::make_unique<triangle3>(triangle_quadrature::point::one),
+                                nodal_connectivity,
+                                dof_list,
+                                mesh_coordinates,
+                                json::parse("[0.0, 1.0]"),
+                                json::parse("[0.0, -2.0]"));
+
+        auto const [dofs, reference_load] = pressure_patch.assemble_reference_load();
+
+        REQUIRE(dofs.size() == 9);
+        REQUIRE(std::is_sorted(begin(dofs), end(dofs)));
+
+        // The external force is the scaled reference load for every time
+        for (auto const time : {0.25, 0.5, 1.0})
+        {
+            auto const& [element_dofs, f_ext] = pressure_patch.external_force(0, time);
+
+            REQUIRE((f_ext - pressure_patch.interpolate_prescribed_load(time) * reference_load).norm()
+                    == Approx(0.0).margin(ZERO_MARGIN));
+        }
+    }
 }
 TEST_CASE("Traction test for mixed mesh")
 {
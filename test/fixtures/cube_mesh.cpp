@@ -1,6 +1,11 @@
 
 #include "cube_mesh.hpp"
 
+#include <array>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
 // A collection of functions that can be used to test a cube mesh
 // including a mesh and input data
 std::string json_cube_mesh()
@@ -230,3 +235,258 @@ std::string solver_data_json()
     return "{\"type\" : \"iterative\", \"maximum_iterations\" : 1000, "
            " \"tolerance\" : 1e-6 }";
 }
+
+namespace
+{
+using node_list = std::vector<std::int64_t>;
+
+std::string to_json(std::vector<node_list> const& connectivity)
+{
+    std::string output = "[";
+    for (std::size_t element{0}; element < connectivity.size(); ++element)
+    {
+        output += element == 0 ? "[" : ",[";
+        for (std::size_t node{0}; node < connectivity[element].size(); ++node)
+        {
+            output += (node == 0 ? "" : ",") + std::to_string(connectivity[element][node]);
+        }
+        output += "]";
+    }
+    return output + "]";
+}
+
+std::string element_group(std::string const& name,
+                          std::int32_t const type,
+                          std::vector<node_list> const& connectivity,
+                          std::int64_t& element_index)
+{
+    std::string indices = "[";
+    for (std::size_t element{0}; element < connectivity.size(); ++element)
+    {
+        indices += (element == 0 ? "" : ",") + std::to_string(element_index++);
+    }
+    indices += "]";
+
+    return "{\"Indices\" : " + indices + ", \"Name\" : \"" + name
+           + "\", \"NodalConnectivity\" : " + to_json(connectivity)
+           + ", \"Type\" : " + std::to_string(type) + "}";
+}
+}
+
+std::string json_cube_mesh(std::int32_t const divisions, std::string const& topology)
+{
+    if (divisions < 1)
+    {
+        throw std::domain_error("A cube mesh requires at least one division");
+    }
+    if (topology != "hexahedron" && topology != "prism" && topology != "tetrahedron")
+    {
+        throw std::domain_error("Cube mesh topology must be \"hexahedron\", \"prism\" or "
+                                "\"tetrahedron\"");
+    }
+
+    std::int64_t const n = divisions + 1;
+
+    auto const node = [n](std::int64_t i, std::int64_t j, std::int64_t k) {
+        return i + n * (j + n * k);
+    };
+
+    std::vector<node_list> volume, bottom, top;
+
+    for (std::int64_t k{0}; k < divisions; ++k)
+    {
+        for (std::int64_t j{0}; j < divisions; ++j)
+        {
+            for (std::int64_t i{0}; i < divisions; ++i)
+            {
+                // Vertices of the hexahedron in gmsh ordering
+                std::array<std::int64_t, 8> const v = {node(i, j, k),
+                                                       node(i + 1, j, k),
+                                                       node(i + 1, j + 1, k),
+                                                       node(i, j + 1, k),
+                                                       node(i, j, k + 1),
+                                                       node(i + 1, j, k + 1),
+                                                       node(i + 1, j + 1, k + 1),
+                                                       node(i, j + 1, k + 1)};
+                if (topology == "hexahedron")
+                {
+                    volume.push_back({v[0], v[1], v[2], v[3], v[4], v[5], v[6], v[7]});
+                }
+                else if (topology == "prism")
+                {
+                    volume.push_back({v[0], v[1], v[2], v[4], v[5], v[6]});
+                    volume.push_back({v[0], v[2], v[3], v[4], v[6], v[7]});
+                }
+                else
+                {
+                    // Conforming decomposition about the main diagonal v0 - v6
+                    volume.push_back({v[0], v[1], v[2], v[6]});
+                    volume.push_back({v[0], v[2], v[3], v[6]});
+                    volume.push_back({v[0], v[3], v[7], v[6]});
+                    volume.push_back({v[0], v[7], v[4], v[6]});
+                    volume.push_back({v[0], v[4], v[5], v[6]});
+                    volume.push_back({v[0], v[5], v[1], v[6]});
+                }
+            }
+        }
+    }
+
+    for (std::int64_t j{0}; j < divisions; ++j)
+    {
+        for (std::int64_t i{0}; i < divisions; ++i)
+        {
+            for (auto const& [k, faces] : {std::pair(std::int64_t{0}, &bottom),
+                                          std::pair(std::int64_t{divisions}, &top)})
+            {
+                if (topology == "hexahedron")
+                {
+                    faces->push_back({node(i, j, k),
+                                      node(i + 1, j, k),
+                                      node(i + 1, j + 1, k),
+                                      node(i, j + 1, k)});
+                }
+                else
+                {
+                    faces->push_back({node(i, j, k), node(i + 1, j, k), node(i + 1, j + 1, k)});
+                    faces->push_back({node(i, j, k), node(i + 1, j + 1, k), node(i, j + 1, k)});
+                }
+            }
+        }
+    }
+
+    auto const volume_type = topology == "hexahedron" ? 5 : topology == "prism" ? 6 : 4;
+    auto const face_type = topology == "hexahedron" ? 3 : 2;
+
+    std::int64_t element_index{0};
+
+    std::string const elements = element_group("bottom", face_type, bottom, element_index) + ","
+                                 + element_group("cube", volume_type, volume, element_index) + ","
+                                 + element_group("top", face_type, top, element_index);
+
+    std::string coordinates = "[", indices = "[";
+
+    for (std::int64_t k{0}; k < n; ++k)
+    {
+        for (std::int64_t j{0}; j < n; ++j)
+        {
+            for (std::int64_t i{0}; i < n; ++i)
+            {
+                auto const separator = node(i, j, k) == 0 ? "" : ",";
+
+                coordinates += separator + ("[" + std::to_string(double(i) / divisions) + ","
+                                            + std::to_string(double(j) / divisions) + ","
+                                            + std::to_string(double(k) / divisions) + "]");
+
+                indices += separator + std::to_string(node(i, j, k));
+            }
+        }
+    }
+    coordinates += "]";
+    indices += "]";
+
+    return "{\"Elements\" : [" + elements + "], \"Nodes\" : [{\"Coordinates\" : " + coordinates
+           + ", \"Indices\" : " + indices + "}]}";
+}
+
+std::string json_square_mesh(std::int32_t const divisions, std::string const& topology)
+{
+    if (divisions < 1)
+    {
+        throw std::domain_error("A square mesh requires at least one division");
+    }
+    if (topology != "quadrilateral" && topology != "triangle")
+    {
+        throw std::domain_error("Square mesh topology must be \"quadrilateral\" or \"triangle\"");
+    }
+
+    std::int64_t const n = divisions + 1;
+
+    auto const node = [n](std::int64_t i, std::int64_t j) { return i + n * j; };
+
+    std::vector<node_list> surface, bottom, top;
+
+    for (std::int64_t j{0}; j < divisions; ++j)
+    {
+        for (std::int64_t i{0}; i < divisions; ++i)
+        {
+            if (topology == "quadrilateral")
+            {
+                surface.push_back({node(i, j), node(i + 1, j), node(i + 1, j + 1), node(i, j + 1)});
+            }
+            else
+            {
+                surface.push_back({node(i, j), node(i + 1, j), node(i + 1, j + 1)});
+                surface.push_back({node(i, j), node(i + 1, j + 1), node(i, j + 1)});
+            }
+        }
+    }
+
+    for (std::int64_t i{0}; i < divisions; ++i)
+    {
+        bottom.push_back({node(i, 0), node(i + 1, 0)});
+        top.push_back({node(i, divisions), node(i + 1, divisions)});
+    }
+
+    auto const surface_type = topology == "quadrilateral" ? 3 : 2;
+
+    std::int64_t element_index{0};
+
+    std::string const elements = element_group("bottom", 1, bottom, element_index) + ","
+                                 + element_group("square", surface_type, surface, element_index)
+                                 + "," + element_group("top", 1, top, element_index);
+
+    std::string coordinates = "[", indices = "[";
+
+    for (std::int64_t j{0}; j < n; ++j)
+    {
+        for (std::int64_t i{0}; i < n; ++i)
+        {
+            auto const separator = node(i, j) == 0 ? "" : ",";
+
+            coordinates += separator + ("[" + std::to_string(double(i) / divisions) + ","
+                                        + std::to_string(double(j) / divisions) + ",0]");
+
+            indices += separator + std::to_string(node(i, j));
+        }
+    }
+    coordinates += "]";
+    indices += "]";
+
+    return "{\"Elements\" : [" + elements + "], \"Nodes\" : [{\"Coordinates\" : " + coordinates
+           + ", \"Indices\" : " + indices + "}]}";
+}
+
+std::string json_line_mesh(std::int32_t const divisions)
+{
+    if (divisions < 1)
+    {
+        throw std::domain_error("A line mesh requires at least one division");
+    }
+
+    std::vector<node_list> line;
+
+    for (std::int64_t i{0}; i < divisions; ++i)
+    {
+        line.push_back({i, i + 1});
+    }
+
+    std::int64_t element_index{0};
+
+    std::string const elements = element_group("beam", 1, line, element_index);
+
+    std::string coordinates = "[", indices = "[";
+
+    for (std::int64_t i{0}; i <= divisions; ++i)
+    {
+        auto const separator = i == 0 ? "" : ",";
+
+        coordinates += separator + ("[" + std::to_string(double(i) / divisions) + ",0,0]");
+
+        indices += separator + std::to_string(i);
+    }
+    coordinates += "]";
+    indices += "]";
+
+    return "{\"Elements\" : [" + elements + "], \"Nodes\" : [{\"Coordinates\" : " + coordinates
+           + ", \"Indices\" : " + indices + "}]}";
+}
@@ -1,11 +1,27 @@
 
 #pragma once
 
+#include <cstdint>
 #include <string>
 
 // A cube mesh in the input mesh format
 std::string json_cube_mesh();
 
+// A unit cube mesh in the input mesh format with \p divisions elements along
+// each edge.  The \p topology is "hexahedron", "prism" or "tetrahedron" and
+// the "bottom" and "top" boundaries are the z = 0 and z = 1 faces
+std::string json_cube_mesh(std::int32_t const divisions, std::string const& topology);
+
+// A unit square mesh in the z = 0 plane in the input mesh format with
+// \p divisions elements along each edge.  The \p topology is "quadrilateral"
+// or "triangle" and the "bottom" and "top" boundaries are the y = 0 and y = 1
+// edges
+std::string json_square_mesh(std::int32_t const divisions, std::string const& topology);
+
+// A unit line mesh along the x axis in the input mesh format with \p divisions
+// two node elements in the "beam" group
+std::string json_line_mesh(std::int32_t const divisions);
+
 std::string material_data_json();
 
 std::string simulation_data_json();
@@ -6,6 +6,9 @@
 #include "constitutive/mechanics/solid/compressible_neohooke.hpp"
 #include "constitutive/mechanics/plane/isotropic_linear_elasticity.hpp"
 #include "constitutive/constitutive_model_factory.hpp"
+#include "constitutive/mechanics/detail/isotropic_surrogate.hpp"
+#include "constitutive/mechanics/detail/microsphere.hpp"
+#include "constitutive/mechanics/detail/microsphere_kernel.hpp"
 
 #include "exceptions.hpp"
 #include "io/json.hpp"
@@ -32,7 +35,7 @@ TEST_CASE("Neo-Hookean model")
     auto variables = std::make_shared<internal_variables_t>(internal_variable_size);
 
     // Add the required variables for an updated Lagrangian formulation
-    variables->add(variable::second::deformation_gradient, variable::second::cauchy_stress);
+    variables->add(variable::second::deformation_gradient, variable::symmetric::cauchy_stress);
     variables->add(variable::scalar::DetF);
 
     auto neo_hooke = make_constitutive_model(variables,
@@ -41,8 +44,8 @@ TEST_CASE("Neo-Hookean model")
                                                          "\"neohooke\"} }"));
 
     // Get the tensor variables
-    auto [F_list, cauchy_stresses] = variables->get(variable::second::deformation_gradient,
-                                                    variable::second::cauchy_stress);
+    auto& F_list = variables->get(variable::second::deformation_gradient);
+    auto& cauchy_stresses = variables->get(variable::symmetric::cauchy_stress);
 
     auto& J_list = variables->get(variable::scalar::DetF);
 
@@ -74,10 +77,12 @@ TEST_CASE("Neo-Hookean model")
     SECTION("Check of material tangent")
     {
         // Get the matrix variable
-        auto& material_tangents = variables->get(variable::fourth::tangent_operator);
+        auto& material_tangents = variables->get(variable::major_symmetric::tangent_operator);
 
-        for (auto const& material_tangent : material_tangents)
+        for (auto const& packed_tangent : material_tangents)
         {
+            auto const material_tangent = voigt::major_symmetric::view(packed_tangent);
+
             // Check a few of the numerical values
             REQUIRE(material_tangent(0, 0) == Approx(material_tangent(1, 1)));
             REQUIRE(material_tangent(0, 1) == Approx(material_tangent(0, 2)));
@@ -94,6 +99,31 @@ TEST_CASE("Neo-Hookean model")
             REQUIRE((eigen_solver.eigenvalues().real().array() > 0.0).all());
         }
     }
+    SECTION("Pointwise tangent operator")
+    {
+        REQUIRE(neo_hooke->has_pointwise_tangent());
+
+        auto const& material_tangents = variables->get(variable::major_symmetric::tangent_operator);
+
+        for (std::size_t l{0}; l < material_tangents.size(); ++l)
+        {
+            REQUIRE((neo_hooke->tangent_operator(l)
+                     - voigt::major_symmetric::view(material_tangents[l]))
+                        .norm()
+                    == Approx(0.0).margin(ZERO_MARGIN));
+        }
+
+        neo_hooke->evaluate_tangent_in_assembly();
+
+        REQUIRE_FALSE(neo_hooke->stores_tangent());
+        REQUIRE_FALSE(variables->has(variable::fourth::tangent_operator));
+        REQUIRE_FALSE(variables->has(variable::major_symmetric::tangent_operator));
+
+        // The stresses are still updated without the stored tangent
+        neo_hooke->update_internal_variables(1.0);
+
+        REQUIRE(cauchy_stresses.front().norm() == Approx(0.0).margin(ZERO_MARGIN));
+    }
 }
 TEST_CASE("microsphere model error test")
 {
@@ -136,7 +166,7 @@ TEST_CASE("Gaussian affine microsphere")
     auto variables = std::make_shared<internal_variables_t>(internal_variable_size);
 
     // Add the required variables for an updated Lagrangian formulation
-    variables->add(variable::second::deformation_gradient, variable::second::cauchy_stress);
+    variables->add(variable::second::deformation_gradient, variable::symmetric::cauchy_stress);
 
     variables->add(variable::scalar::DetF);
 
@@ -150,14 +180,14 @@ TEST_CASE("Gaussian affine microsphere")
                                                       ": \"affine\", \"statistics\":\"gaussian\",  "
                                                       "\"quadrature\" : \"BO21\"}}"));
 
-    auto [F_list, cauchy_stresses] = variables->get(variable::second::deformation_gradient,
-                                                    variable::second::cauchy_stress);
+    auto& F_list = variables->get(variable::second::deformation_gradient);
+    auto& cauchy_stresses = variables->get(variable::symmetric::cauchy_stress);
 
     auto& J_list = variables->get(variable::scalar::DetF);
 
     for (auto& J : J_list) J = 1.0;
 
-    auto& material_tangents = variables->get(variable::fourth::tangent_operator);
+    auto& material_tangents = variables->get(variable::major_symmetric::tangent_operator);
 
     Eigen::EigenSolver<Eigen::MatrixXd> eigen_solver;
 
@@ -174,8 +204,10 @@ TEST_CASE("Gaussian affine microsphere")
 
         affine->update_internal_variables(1.0);
 
-        for (auto const& material_tangent : material_tangents)
+        for (auto const& packed_tangent : material_tangents)
         {
+            auto const material_tangent = voigt::major_symmetric::view(packed_tangent);
+
             REQUIRE((material_tangent - material_tangent.transpose()).norm()
                     == Approx(0.0).margin(ZERO_MARGIN));
 
@@ -199,8 +231,10 @@ TEST_CASE("Gaussian affine microsphere")
 
         affine->update_internal_variables(1.0);
 
-        for (auto const& material_tangent : material_tangents)
+        for (auto const& packed_tangent : material_tangents)
         {
+            auto const material_tangent = voigt::major_symmetric::view(packed_tangent);
+
             REQUIRE((material_tangent - material_tangent.transpose()).norm()
                     == Approx(0.0).margin(ZERO_MARGIN));
 
@@ -221,7 +255,7 @@ TEST_CASE("Affine microsphere")
     auto variables = std::make_shared<internal_variables_t>(internal_variable_size);
 
     // Add the required variables for an updated Lagrangian formulation
-    variables->add(variable::second::deformation_gradient, variable::second::cauchy_stress);
+    variables->add(variable::second::deformation_gradient, variable::symmetric::cauchy_stress);
 
     variables->add(variable::scalar::DetF);
 
@@ -235,14 +269,14 @@ TEST_CASE("Affine microsphere")
                                                       ": \"affine\", \"statistics\":\"langevin\", "
                                                       "\"quadrature\" : \"BO21\"}}"));
 
-    auto [F_list, cauchy_stresses] = variables->get(variable::second::deformation_gradient,
-                                                    variable::second::cauchy_stress);
+    auto& F_list = variables->get(variable::second::deformation_gradient);
+    auto& cauchy_stresses = variables->get(variable::symmetric::cauchy_stress);
 
     auto& J_list = variables->get(variable::scalar::DetF);
 
     for (auto& J : J_list) J = 1.0;
 
-    auto& material_tangents = variables->get(variable::fourth::tangent_operator);
+    auto& material_tangents = variables->get(variable::major_symmetric::tangent_operator);
 
     Eigen::EigenSolver<Eigen::MatrixXd> eigen_solver;
 
@@ -259,8 +293,10 @@ TEST_CASE("Affine microsphere")
 
         affine->update_internal_variables(1.0);
 
-        for (auto const& material_tangent : material_tangents)
+        for (auto const& packed_tangent : material_tangents)
         {
+            auto const material_tangent = voigt::major_symmetric::view(packed_tangent);
+
             REQUIRE((material_tangent - material_tangent.transpose()).norm()
                     == Approx(0.0).margin(ZERO_MARGIN));
 
@@ -284,8 +320,10 @@ TEST_CASE("Affine microsphere")
 
         affine->update_internal_variables(1.0);
 
-        for (auto const& material_tangent : material_tangents)
+        for (auto const& packed_tangent : material_tangents)
         {
+            auto const material_tangent = voigt::major_symmetric::view(packed_tangent);
+
             REQUIRE((material_tangent - material_tangent.transpose()).norm()
                     == Approx(0.0).margin(ZERO_MARGIN));
 
@@ -298,6 +336,43 @@ TEST_CASE("Affine microsphere")
             REQUIRE(cauchy_stress.norm() > 0.0);
         }
     }
+    SECTION("affine model with tabulated response")
+    {
+        auto tabulated = make_constitutive_model(variables,
+                                                 json::parse("{\"name\" : \"rubber\", "
+                                                             "\"elastic_modulus\" : 10.0e6, "
+                                                             "\"poissons_ratio\" : 0.45, "
+                                                             "\"segments_per_chain\" : 50}"),
+                                                 json::parse("{\"constitutive\" : {\"name\": "
+                                                             "\"microsphere\", \"type\" "
+                                                             ": \"affine\", \"statistics\":"
+                                                             "\"langevin\", \"quadrature\" : "
+                                                             "\"BO21\", \"surrogate\" : "
+                                                             "{\"maximum_stretch\" : 1.5, "
+                                                             "\"tolerance\" : 1.0e-4}}}"));
+        for (auto& F : F_list)
+        {
+            F << 1.1, 0.05, 0.0, 0.02, 0.95, 0.01, 0.0, 0.03, 0.96;
+        }
+
+        affine->update_internal_variables(1.0);
+
+        std::vector<vector6> const exact_stresses = cauchy_stresses;
+        auto const exact_tangents = material_tangents;
+
+        tabulated->update_internal_variables(1.0);
+
+        for (std::size_t l{0}; l < cauchy_stresses.size(); ++l)
+        {
+            REQUIRE((cauchy_stresses[l] - exact_stresses[l]).norm() / exact_stresses[l].norm()
+                    == Approx(0.0).margin(1.0e-3));
+            matrix6 const exact_tangent = voigt::major_symmetric::view(exact_tangents[l]);
+
+            REQUIRE((voigt::major_symmetric::view(material_tangents[l]) - exact_tangent).norm()
+                        / exact_tangent.norm()
+                    == Approx(0.0).margin(1.0e-3));
+        }
+    }
 }
 TEST_CASE("Nonaffine microsphere")
 {
@@ -306,7 +381,7 @@ TEST_CASE("Nonaffine microsphere")
     auto variables = std::make_shared<internal_variables_t>(internal_variable_size);
 
     // Add the required variables for an updated Lagrangian formulation
-    variables->add(variable::second::deformation_gradient, variable::second::cauchy_stress);
+    variables->add(variable::second::deformation_gradient, variable::symmetric::cauchy_stress);
     variables->add(variable::scalar::DetF);
 
     auto affine = make_constitutive_model(variables,
@@ -321,14 +396,14 @@ TEST_CASE("Nonaffine microsphere")
                                                       "\"BO21\"}}"));
 
     // Get the tensor variables
-    auto [F_list, cauchy_stresses] = variables->get(variable::second::deformation_gradient,
-                                                    variable::second::cauchy_stress);
+    auto& F_list = variables->get(variable::second::deformation_gradient);
+    auto& cauchy_stresses = variables->get(variable::symmetric::cauchy_stress);
 
     auto& J_list = variables->get(variable::scalar::DetF);
 
     for (auto& J : J_list) J = 1.0;
 
-    auto& material_tangents = variables->get(variable::fourth::tangent_operator);
+    auto& material_tangents = variables->get(variable::major_symmetric::tangent_operator);
 
     Eigen::EigenSolver<Eigen::MatrixXd> eigen_solver;
 
@@ -362,8 +437,10 @@ TEST_CASE("Nonaffine microsphere")
 
         affine->update_internal_variables(1.0);
 
-        for (auto const& material_tangent : material_tangents)
+        for (auto const& packed_tangent : material_tangents)
         {
+            auto const material_tangent = voigt::major_symmetric::view(packed_tangent);
+
             // Ensure symmetry is correct
             REQUIRE((material_tangent - material_tangent.transpose()).norm()
                     == Approx(0.0).margin(ZERO_MARGIN));
@@ -388,8 +465,10 @@ TEST_CASE("Nonaffine microsphere")
 
         affine->update_internal_variables(1.0);
 
-        for (auto const& material_tangent : material_tangents)
+        for (auto const& packed_tangent : material_tangents)
         {
+            auto const material_tangent = voigt::major_symmetric::view(packed_tangent);
+
             // Ensure symmetry is correct
             REQUIRE((material_tangent - material_tangent.transpose()).norm()
                     == Approx(0.0).margin(ZERO_MARGIN));
@@ -404,3 +483,208 @@ TEST_CASE("Nonaffine microsphere")
         }
     }
 }
+TEST_CASE("Microsphere kernel")
+{
+    using namespace neon::mechanics;
+
+    using batch_array = microsphere_kernel::batch_array;
+
+    unit_sphere_quadrature unit_sphere(unit_sphere_quadrature::point::BO33);
+
+    microsphere_kernel kernel(unit_sphere);
+
+    auto const N = 50.0;
+
+    matrix3 F;
+    F << 1.1, 0.1, 0.02, -0.05, 0.95, 0.03, 0.01, 0.02, 0.97;
+
+    matrix3 const F_bar = unimodular(F);
+
+    SECTION("Moments")
+    {
+        matrix3 const M2 = unit_sphere.integrate(matrix3::Zero().eval(),
+                                                 [](auto const& coordinates, auto) -> matrix3 {
+                                                     auto const& [r, _] = coordinates;
+                                                     return r * r.transpose();
+                                                 });
+
+        matrix6 const M4 = unit_sphere.integrate(matrix6::Zero().eval(),
+                                                 [](auto const& coordinates, auto) -> matrix6 {
+                                                     auto const& [r, _] = coordinates;
+                                                     matrix3 const rr = r * r.transpose();
+                                                     return outer_product(rr, rr);
+                                                 });
+
+        REQUIRE(kernel.points() == unit_sphere.points());
+        REQUIRE((kernel.second_moment() - M2).norm() == Approx(0.0).margin(ZERO_MARGIN));
+        REQUIRE((kernel.fourth_moment() - M4).norm() == Approx(0.0).margin(ZERO_MARGIN));
+    }
+    SECTION("Stress and moduli")
+    {
+        matrix3 const stress = unit_sphere.integrate(matrix3::Zero().eval(),
+                                                     [&](auto const& coordinates, auto) -> matrix3 {
+                                                         auto const& [r, _] = coordinates;
+                                                         vector3 const t = F_bar * r;
+                                                         return pade_first(t.norm(), N)
+                                                                * outer_product(t, t);
+                                                     });
+
+        matrix6 const moduli = unit_sphere.integrate(matrix6::Zero().eval(),
+                                                     [&](auto const& coordinates, auto) -> matrix6 {
+                                                         auto const& [r, _] = coordinates;
+                                                         vector3 const t = F_bar * r;
+                                                         return std::pow(t.norm(), -3)
+                                                                * outer_product(t, t, t, t);
+                                                     });
+
+        auto const [kernel_stress, kernel_moduli] = kernel.stress_and_moduli(
+            F_bar,
+            [&](batch_array const& stretch, auto) -> batch_array { return pade_first(stretch, N); },
+            [&](batch_array const& stretch, auto) -> batch_array { return stretch.cube().inverse(); });
+
+        REQUIRE((kernel_stress - stress).norm() == Approx(0.0).margin(ZERO_MARGIN));
+        REQUIRE((kernel_moduli - moduli).norm() == Approx(0.0).margin(ZERO_MARGIN));
+        REQUIRE((kernel_moduli - kernel_moduli.transpose()).norm()
+                == Approx(0.0).margin(ZERO_MARGIN));
+    }
+    SECTION("Nonaffine integrals")
+    {
+        // Integrands of the non-affine model before the single sweep evaluation
+        auto const o_dot_product = [](vector3 const& n) -> matrix6 {
+            // clang-format off
+            return (matrix6() << 2.0 * n(0) * n(0),               0.0,               0.0,                               0.0,                       n(0) * n(2), n(0) * n(1),       //
+                                               0.0, 2.0 * n(1) * n(1),               0.0,                       n(1) * n(2),                               0.0, n(0) * n(1),       //
+                                               0.0,               0.0, 2.0 * n(2) * n(2),                       n(1) * n(2),                       n(0) * n(2), 0.0,               //
+                                               0.0,       n(1) * n(2),       n(1) * n(2), 0.5 * (n(1) * n(1) + n(2) * n(2)),                 0.5 * n(0) * n(1), 0.5 * n(0) * n(2), //
+                                       n(0) * n(2),               0.0,       n(0) * n(2),                 0.5 * n(0) * n(1), 0.5 * (n(0) * n(0) + n(2) * n(2)), 0.5 * n(2) * n(1), //
+                                       n(0) * n(1),       n(0) * n(1),               0.0,                 0.5 * n(0) * n(2),                 0.5 * n(2) * n(1), 0.5 * (n(0) * n(0) + n(1) * n(1))).finished();
+            // clang-format on
+        };
+
+        auto const tangent = [&](vector3 const& r) -> vector3 { return F_bar * r; };
+        auto const normal = [&](vector3 const& r) -> vector3 {
+            return F_bar.inverse().transpose() * r;
+        };
+
+        auto const p = 9.0;
+
+        for (auto const q : {1.0, 3.0})
+        {
+            auto const stretch = std::pow(unit_sphere.integrate(0.0,
+                                                                [&](auto const& coordinates, auto) {
+                                                                    auto const& [r, _] = coordinates;
+                                                                    return std::pow(tangent(r).norm(),
+                                                                                    p);
+                                                                }),
+                                          1.0 / p);
+
+            matrix3 const h = unit_sphere.integrate(matrix3::Zero().eval(),
+                                                    [&](auto const& coordinates, auto) -> matrix3 {
+                                                        auto const& [r, _] = coordinates;
+                                                        vector3 const t = tangent(r);
+                                                        return std::pow(t.norm(), p - 2.0)
+                                                               * outer_product(t, t);
+                                                    });
+
+            matrix6 const H = unit_sphere.integrate(matrix6::Zero().eval(),
+                                                    [&](auto const& coordinates, auto) -> matrix6 {
+                                                        auto const& [r, _] = coordinates;
+                                                        vector3 const t = tangent(r);
+                                                        return (p - 2.0) * std::pow(t.norm(), p - 4.0)
+                                                               * outer_product(t, t, t, t);
+                                                    });
+
+            matrix3 const k = unit_sphere.integrate(matrix3::Zero().eval(),
+                                                    [&](auto const& coordinates, auto) -> matrix3 {
+                                                        auto const& [r, _] = coordinates;
+                                                        vector3 const n = normal(r);
+                                                        return q * std::pow(n.norm(), q - 2.0)
+                                                               * outer_product(n, n);
+                                                    });
+
+            matrix6 const K = unit_sphere.integrate(matrix6::Zero().eval(),
+                                                    [&](auto const& coordinates, auto) -> matrix6 {
+                                                        auto const& [r, _] = coordinates;
+                                                        vector3 const n = normal(r);
+                                                        return q * (q - 2.0)
+                                                               * std::pow(n.norm(), q - 4.0)
+                                                               * outer_product(n, n, n, n);
+                                                    });
+
+            matrix6 const G = unit_sphere.integrate(matrix6::Zero().eval(),
+                                                    [&](auto const& coordinates, auto) -> matrix6 {
+                                                        auto const& [r, _] = coordinates;
+                                                        vector3 const n = normal(r);
+                                                        return 2.0 * q * std::pow(n.norm(), q - 2.0)
+                                                               * o_dot_product(n);
+                                                    });
+
+            auto const integrals = kernel.nonaffine(F_bar, p, q);
+
+            REQUIRE(integrals.stretch == Approx(stretch));
+            REQUIRE((integrals.h - h).norm() / h.norm() == Approx(0.0).margin(ZERO_MARGIN));
+            REQUIRE((integrals.H - H).norm() / H.norm() == Approx(0.0).margin(ZERO_MARGIN));
+            REQUIRE((integrals.k - k).norm() / k.norm() == Approx(0.0).margin(ZERO_MARGIN));
+            REQUIRE((integrals.K - K).norm() / K.norm() == Approx(0.0).margin(ZERO_MARGIN));
+            REQUIRE((integrals.G - G).norm() / G.norm() == Approx(0.0).margin(ZERO_MARGIN));
+            REQUIRE((integrals.G - integrals.G.transpose()).norm()
+                    == Approx(0.0).margin(ZERO_MARGIN));
+        }
+    }
+}
+TEST_CASE("Isotropic surrogate")
+{
+    using namespace neon::mechanics;
+
+    using batch_array = microsphere_kernel::batch_array;
+
+    unit_sphere_quadrature unit_sphere(unit_sphere_quadrature::point::BO21);
+
+    microsphere_kernel kernel(unit_sphere);
+
+    auto const N = 25.0;
+
+    auto const response = [&](matrix3 const& F_unimodular) {
+        return kernel.stress_and_moduli(
+            F_unimodular,
+            [&](batch_array const& stretch, auto) -> batch_array { return pade_first(stretch, N); },
+            [&](batch_array const& stretch, auto) -> batch_array {
+                return (pade_second(stretch, N) - pade_first(stretch, N)) / stretch.square();
+            });
+    };
+
+    isotropic_surrogate surrogate(response, 2.0, 1.0e-3);
+
+    SECTION("Tolerance")
+    {
+        REQUIRE(surrogate.error() <= 1.0e-3);
+        REQUIRE(surrogate.intervals() > 0);
+
+        REQUIRE_THROWS_AS(isotropic_surrogate(response, 1.0, 1.0e-3), std::domain_error);
+        REQUIRE_THROWS_AS(isotropic_surrogate(response, 2.0, 0.0), std::domain_error);
+    }
+    SECTION("Rotated deformation")
+    {
+        matrix3 F;
+        F << 1.3, 0.2, 0.05, -0.1, 0.85, 0.07, 0.02, 0.1, 0.93;
+
+        matrix3 const F_bar = unimodular(F);
+
+        auto const [stress, moduli] = response(F_bar);
+
+        auto const tabulated = surrogate.evaluate(F_bar);
+
+        REQUIRE(tabulated.has_value());
+        REQUIRE((tabulated->first - stress).norm() / stress.norm() == Approx(0.0).margin(1.0e-3));
+        REQUIRE((tabulated->second - moduli).norm() / moduli.norm()
+                == Approx(0.0).margin(1.0e-3));
+        REQUIRE((tabulated->second - tabulated->second.transpose()).norm()
+                == Approx(0.0).margin(ZERO_MARGIN));
+    }
+    SECTION("Outside the table")
+    {
+        matrix3 const F = vector3(3.0, 1.0 / std::sqrt(3.0), 1.0 / std::sqrt(3.0)).asDiagonal();
+
+        REQUIRE_FALSE(surrogate.evaluate(F).has_value());
+    }
+}
@@ -2,6 +2,7 @@
 #include <catch2/catch.hpp>
 
 #include "solver/linear/linear_solver_factory.hpp"
+#include "telemetry.hpp"
 
 #include <stdexcept>
 
@@ -208,10 +209,235 @@ TEST_CASE("Linear solver test suite")
         REQUIRE((x - solution()).norm() == Approx(0.0).margin(ZERO_MARGIN));
         REQUIRE((A * x - b).norm() == Approx(0.0).margin(ZERO_MARGIN));
     }
+    SECTION("Mixed precision LLT")
+    {
+        json solver_data{{"type", "direct"}, {"precision", "mixed"}};
+
+        auto linear_solver = make_linear_solver(solver_data);
+
+        linear_solver->solve(A, x, b);
+
+        REQUIRE((x - solution()).norm() == Approx(0.0).margin(1.0e-9));
+        REQUIRE((A * x - b).norm() == Approx(0.0).margin(1.0e-9));
+    }
+    SECTION("Mixed precision LU")
+    {
+        json solver_data{{"type", "direct"}, {"precision", "mixed"}, {"tolerance", 1.0e-12}};
+
+        auto linear_solver = make_linear_solver(solver_data, false);
+
+        linear_solver->solve(A, x, b);
+
+        REQUIRE((x - solution()).norm() == Approx(0.0).margin(1.0e-11));
+        REQUIRE((A * x - b).norm() == Approx(0.0).margin(1.0e-11));
+    }
+    SECTION("Mixed precision reused factorisation")
+    {
+        json solver_data{{"type", "direct"}, {"precision", "mixed"}};
+
+        auto linear_solver = make_linear_solver(solver_data);
+
+        linear_solver->solve(A, x, b);
+
+        linear_solver->reuse_factorisation();
+
+        linear_solver->solve(A, x, 2.0 * b);
+
+        REQUIRE((x - 2.0 * solution()).norm() == Approx(0.0).margin(1.0e-9));
+    }
     SECTION("Error")
     {
         json solver_data{{"type", "PurpleMonkey"}};
 
         REQUIRE_THROWS_AS(make_linear_solver(solver_data), std::domain_error);
     }
+    SECTION("Precision error")
+    {
+        json solver_data{{"type", "direct"}, {"precision", "half"}};
+
+        REQUIRE_THROWS_AS(make_linear_solver(solver_data), std::domain_error);
+    }
+}
+TEST_CASE("Mixed precision refinement")
+{
+    // One dimensional Laplacian with a condition number of order n^2
+    std::int32_t constexpr n = 500;
+
+    std::vector<Eigen::Triplet<double>> triplets;
+
+    for (std::int32_t i{0}; i < n; ++i)
+    {
+        triplets.emplace_back(i, i, 2.0);
+        if (i > 0) triplets.emplace_back(i, i - 1, -1.0);
+        if (i < n - 1) triplets.emplace_back(i, i + 1, -1.0);
+    }
+
+    sparse_matrix A(n, n);
+    A.setFromTriplets(std::begin(triplets), std::end(triplets));
+
+    vector const x_exact = vector::LinSpaced(n, 1.0, 2.0);
+    vector const b = A * x_exact;
+    vector x;
+
+    SECTION("Symmetric")
+    {
+        make_linear_solver(json{{"type", "direct"}, {"precision", "mixed"}})->solve(A, x, b);
+
+        REQUIRE((A * x - b).norm() / b.norm() < 1.0e-10);
+        REQUIRE((x - x_exact).norm() / x_exact.norm() < 1.0e-6);
+    }
+    SECTION("Unsymmetric")
+    {
+        make_linear_solver(json{{"type", "direct"}, {"precision", "mixed"}}, false)->solve(A, x, b);
+
+        REQUIRE((A * x - b).norm() / b.norm() < 1.0e-10);
+        REQUIRE((x - x_exact).norm() / x_exact.norm() < 1.0e-6);
+    }
+}
+
+TEST_CASE("Blocked right hand sides")
+{
+    sparse_matrix A = create_sparse_matrix();
+
+    // Scaled copies of the right hand side have scaled solutions
+    col_matrix B(3, 3);
+    B << create_right_hand_side(), 2.0 * create_right_hand_side(), -create_right_hand_side();
+
+    col_matrix X;
+
+    for (auto const& solver_data : {json{{"type", "direct"}},
+                                    json{{"type", "direct"}, {"precision", "mixed"}},
+                                    json{{"type", "iterative"}}})
+    {
+        for (auto const is_symmetric : {true, false})
+        {
+            make_linear_solver(solver_data, is_symmetric)->block_solve(A, X, B);
+
+            REQUIRE(X.cols() == 3);
+            REQUIRE((X.col(0) - solution()).norm() == Approx(0.0).margin(ZERO_MARGIN));
+            REQUIRE((X.col(1) - 2.0 * solution()).norm() == Approx(0.0).margin(ZERO_MARGIN));
+            REQUIRE((X.col(2) + solution()).norm() == Approx(0.0).margin(ZERO_MARGIN));
+        }
+    }
+}
+
+TEST_CASE("Krylov subspace recycling")
+{
+    // Two dimensional Laplacian on a square grid
+    std::int32_t constexpr m = 40, n = m * m;
+
+    std::vector<Eigen::Triplet<double>> triplets;
+
+    for (std::int32_t i{0}; i < m; ++i)
+    {
+        for (std::int32_t j{0}; j < m; ++j)
+        {
+            auto const row = i * m + j;
+
+            triplets.emplace_back(row, row, 4.0);
+            if (i > 0) triplets.emplace_back(row, row - m, -1.0);
+            if (i < m - 1) triplets.emplace_back(row, row + m, -1.0);
+            if (j > 0) triplets.emplace_back(row, row - 1, -1.0);
+            if (j < m - 1) triplets.emplace_back(row, row + 1, -1.0);
+        }
+    }
+
+    sparse_matrix A(n, n);
+    A.setFromTriplets(std::begin(triplets), std::end(triplets));
+
+    vector const linear = vector::LinSpaced(n, 1.0, 2.0);
+
+    // Solutions of a sequence of load steps with a moving localised feature
+    auto const load_step = [&](std::int32_t const step) -> vector {
+        vector x = (1.0 + 0.1 * step) * linear;
+
+        for (std::int32_t i{0}; i < m; ++i)
+        {
+            for (std::int32_t j{0}; j < m; ++j)
+            {
+                auto const distance = std::pow(i - 10.0 - step, 2) + std::pow(j - 20.0, 2);
+
+                x(i * m + j) += std::exp(-distance / 20.0);
+            }
+        }
+        return x;
+    };
+
+    telemetry::configure(json{{"telemetry", {{"verbosity", "quiet"}}}});
+
+    // Total iterations for the sequence and the largest relative error
+    auto const solve_sequence = [&](json const& solver_data) {
+        auto const linear_solver = make_linear_solver(solver_data);
+
+        auto const start = telemetry::summary()["counters"].value("Linear solver iterations", 0);
+
+        double error{0.0};
+
+        for (std::int32_t step{0}; step < 10; ++step)
+        {
+            vector x = vector::Zero(n);
+
+            linear_solver->solve(A, x, A * load_step(step));
+
+            error = std::max(error, (x - load_step(step)).norm() / load_step(step).norm());
+        }
+
+        auto const end = telemetry::summary()["counters"]["Linear solver iterations"].get<int>();
+
+        return std::make_pair(end - start, error);
+    };
+
+    SECTION("Warm start")
+    {
+        auto linear_solver = make_linear_solver(json{{"type", "iterative"},
+                                                     {"tolerance", 1.0e-10}});
+
+        vector x = vector::Zero(n);
+        linear_solver->solve(A, x, A * linear);
+
+        auto const iterations = telemetry::summary()["counters"]["Linear solver iterations"];
+
+        // A converged initial guess does not require further iterations
+        linear_solver->solve(A, x, A * linear);
+
+        REQUIRE(telemetry::summary()["counters"]["Linear solver iterations"] == iterations);
+        REQUIRE((x - linear).norm() / linear.norm() < 1.0e-6);
+    }
+    SECTION("Deflated conjugate gradient")
+    {
+        auto const [cg_iterations, cg_error] = solve_sequence(json{{"type", "iterative"},
+                                                                   {"tolerance", 1.0e-8}});
+
+        auto const [iterations, error] = solve_sequence(json{{"type", "iterative"},
+                                                             {"tolerance", 1.0e-8},
+                                                             {"recycling", true},
+                                                             {"deflation_vectors", 16}});
+
+        REQUIRE(cg_error < 1.0e-6);
+        REQUIRE(error < 1.0e-6);
+        // The recycled subspace improves over the sequence
+        REQUIRE(4 * iterations < 3 * cg_iterations);
+    }
+    SECTION("Deflation vectors error")
+    {
+        REQUIRE_THROWS_AS(make_linear_solver(json{{"type", "iterative"},
+                                                  {"recycling", true},
+                                                  {"deflation_vectors", 0}}),
+                          std::domain_error);
+    }
+    SECTION("Change of system size")
+    {
+        auto linear_solver = make_linear_solver(json{{"type", "iterative"}, {"recycling", true}});
+
+        vector x;
+        linear_solver->solve(A, x, A * linear);
+
+        REQUIRE((x - linear).norm() / linear.norm() < 1.0e-4);
+
+        sparse_matrix const B = create_sparse_matrix();
+
+        linear_solver->solve(B, x, create_right_hand_side());
+
+        REQUIRE((x - solution()).norm() == Approx(0.0).margin(ZERO_MARGIN));
+    }
 }
@@ -5,12 +5,21 @@
 #include "mesh/material_coordinates.hpp"
 #include "assembler/mechanics/latin_matrix.hpp"
 #include "mesh/mechanics/solid/mesh.hpp"
+#include "mesh/mechanics/plane/mesh.hpp"
 #include "assembler/mechanics/static_matrix.hpp"
+#include "assembler/mechanics/load_case_matrix.hpp"
 #include "numeric/doublet.hpp"
 #include "io/json.hpp"
+#include "telemetry.hpp"
 
 #include "fixtures/cube_mesh.hpp"
 
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <utility>
+
 using neon::json;
 
 TEST_CASE("Doublet class")
@@ -65,10 +74,324 @@ TEST_CASE("Nonlinear system equilibrium solver test")
         matrix.solve();
     }
 }
+TEST_CASE("Inherited equilibrium solver test")
+{
+    using fem_mesh = neon::mechanics::solid::mesh;
+    using static_matrix = neon::mechanics::static_matrix<fem_mesh>;
+
+    neon::basic_mesh basic_mesh(json::parse(json_cube_mesh()));
+
+    auto simulation_data = json::parse(simulation_data_json());
+
+    fem_mesh mesh(basic_mesh,
+                  json::parse(material_data_json()),
+                  simulation_data,
+                  simulation_data["time"]["increments"]["initial"]);
+
+    static_matrix matrix(mesh, simulation_data);
+    matrix.solve();
+
+    auto const loaded_displacement = mesh.geometry().displacement();
+
+    REQUIRE(loaded_displacement.maxCoeff() == Approx(1.0e-3));
+
+    SECTION("Unload from the inherited state")
+    {
+        // Halve the prescribed displacement on the top of the cube
+        auto unload_data = simulation_data;
+        unload_data["boundaries"][1]["z"] = {1.0e-3, 5.0e-4};
+
+        fem_mesh continued_mesh(std::move(mesh),
+                                basic_mesh,
+                                unload_data,
+                                unload_data["time"]["increments"]["initial"]);
+
+        REQUIRE((continued_mesh.geometry().displacement() - loaded_displacement).norm()
+                == Approx(0.0).margin(1.0e-12));
+
+        static_matrix continued_matrix(continued_mesh, unload_data, std::move(matrix));
+        continued_matrix.solve();
+
+        REQUIRE(continued_mesh.geometry().displacement().maxCoeff() == Approx(5.0e-4));
+    }
+    SECTION("Reload with a different linear solver")
+    {
+        auto reload_data = simulation_data;
+        reload_data["linear_solver"] = {{"type", "direct"}};
+        reload_data["boundaries"][1]["z"] = {1.0e-3, 2.0e-3};
+
+        fem_mesh continued_mesh(std::move(mesh),
+                                basic_mesh,
+                                reload_data,
+                                reload_data["time"]["increments"]["initial"]);
+
+        static_matrix continued_matrix(continued_mesh, reload_data, std::move(matrix));
+        continued_matrix.solve();
+
+        REQUIRE(continued_mesh.geometry().displacement().maxCoeff() == Approx(2.0e-3));
+    }
+}
+namespace
+{
+/// Interruption of a simulation at a given time step
+struct interruption
+{
+};
+
+/// Solid mesh which interrupts the simulation before writing a time step
+class interrupted_mesh : public neon::mechanics::solid::mesh
+{
+public:
+    using neon::mechanics::solid::mesh::mesh;
+
+    void write(std::int32_t const time_step, double const current_time)
+    {
+        if (time_step == interrupt_step) throw interruption{};
+
+        written_displacements.push_back(geometry().displacement());
+
+        neon::mechanics::solid::mesh::write(time_step, current_time);
+    }
+
+    std::int32_t interrupt_step{-1};
+
+    /// Displacements of the time steps which were written
+    std::vector<neon::vector> written_displacements;
+};
+
+/// Nonlinear solver with access to the state restored from a checkpoint
+template <class MeshType>
+class restarted_matrix : public neon::mechanics::static_matrix<MeshType>
+{
+public:
+    using neon::mechanics::static_matrix<MeshType>::static_matrix;
+
+    auto const& predictor_increment() const noexcept { return this->last_increment; }
+
+    auto predictor_load_increment() const noexcept { return this->last_load_increment; }
+
+    auto const& resolved_cycles() const noexcept { return this->cycle_states; }
+};
+
+/// Load case solution with access to the displacements of every load case
+template <class MeshType>
+class load_case_solutions : public neon::mechanics::load_case_matrix<MeshType>
+{
+public:
+    using neon::mechanics::load_case_matrix<MeshType>::load_case_matrix;
+
+    /// \return the displacements of each load case as the columns
+    auto const& solutions() const noexcept { return this->displacements; }
+};
+}
+TEST_CASE("Checkpoint restart solver test")
+{
+    using fem_mesh = neon::mechanics::solid::mesh;
+    using neon::variable::scalar;
+    using neon::variable::symmetric;
+
+    neon::basic_mesh basic_mesh(json::parse(json_cube_mesh()));
+
+    auto material_data = json::parse(material_data_json());
+    material_data["elastic_modulus"] = 200.0e9;
+    material_data["poissons_ratio"] = 0.3;
+    material_data["yield_stress"] = 200.0e6;
+    material_data["isotropic_hardening_modulus"] = 400.0e6;
+
+    auto simulation_data = json::parse(simulation_data_json());
+
+    simulation_data["constitutive"] = {{"name", "J2_plasticity"}, {"finite_strain", false}};
+    simulation_data["linear_solver"] = {{"type", "direct"}};
+    simulation_data["boundaries"][1]["z"] = {0.0, 1.0e-2};
+    simulation_data["time"]["increments"]["initial"] = 0.25;
+    simulation_data["time"]["increments"]["maximum"] = 0.25;
+    simulation_data["time"]["cycle_jump"] = {{"period", 0.5}, {"tolerance", 1.0e-3}};
+
+    // Solve without an interruption and keep the converged state
+    neon::vector expected_displacement;
+    std::vector<std::vector<double>> expected_plastic_strains;
+    std::vector<std::vector<neon::vector6>> expected_stresses;
+    {
+        fem_mesh mesh(basic_mesh, material_data, simulation_data, 0.25);
+
+        neon::mechanics::static_matrix<fem_mesh> matrix(mesh, simulation_data);
+        matrix.solve();
+
+        expected_displacement = mesh.geometry().displacement();
+
+        for (auto const& submesh : mesh.meshes())
+        {
+            auto const& variables = submesh.internal_variables();
+
+            expected_plastic_strains.push_back(variables.get_old(scalar::effective_plastic_strain));
+            expected_stresses.push_back(variables.get_old(symmetric::cauchy_stress));
+        }
+    }
+
+    // Interrupt after two time steps with a checkpoint written every time step
+    simulation_data["checkpoint"] = {{"write_every", 1}, {"restart", true}};
+
+    std::remove("cube.checkpoint");
+
+    // Displacement increment of the second time step
+    neon::vector expected_increment;
+    {
+        interrupted_mesh mesh(basic_mesh, material_data, simulation_data, 0.25);
+        mesh.interrupt_step = 3;
+
+        neon::mechanics::static_matrix<interrupted_mesh> matrix(mesh, simulation_data);
+
+        REQUIRE_THROWS_AS(matrix.solve(), interruption);
+
+        // The initial state and the first two time steps
+        REQUIRE(mesh.written_displacements.size() == 3);
+
+        expected_increment = mesh.written_displacements[2] - mesh.written_displacements[1];
+    }
+
+    REQUIRE(std::ifstream("cube.checkpoint").good());
+
+    // Restart from the checkpoint of the second time step
+    {
+        fem_mesh mesh(basic_mesh, material_data, simulation_data, 0.25);
+
+        restarted_matrix<fem_mesh> matrix(mesh, simulation_data);
+
+        // The predictor continues from the increment of the second time step
+        REQUIRE((matrix.predictor_increment() - expected_increment).norm()
+                == Approx(0.0).margin(1.0e-14));
+        REQUIRE(matrix.predictor_load_increment() == Approx(0.25));
+
+        // The first cycle is resolved at the checkpoint
+        REQUIRE(matrix.resolved_cycles().size() == 1);
+
+        for (std::size_t index{0}; index < mesh.meshes().size(); ++index)
+        {
+            REQUIRE(matrix.resolved_cycles().front()[index]
+                    == mesh.meshes()[index].checkpoint_internal_variables());
+        }
+
+        matrix.solve();
+
+        REQUIRE((mesh.geometry().displacement() - expected_displacement).norm()
+                    / expected_displacement.norm()
+                == Approx(0.0).margin(1.0e-10));
+
+        for (std::size_t index{0}; index < mesh.meshes().size(); ++index)
+        {
+            auto const& variables = mesh.meshes()[index].internal_variables();
+
+            auto const& plastic_strain = variables.get_old(scalar::effective_plastic_strain);
+            auto const& expected_plastic_strain = expected_plastic_strains[index];
+
+            REQUIRE(*std::max_element(begin(expected_plastic_strain),
+                                      end(expected_plastic_strain))
+                    > 0.0);
+
+            for (std::size_t l{0}; l < plastic_strain.size(); ++l)
+            {
+                REQUIRE(plastic_strain[l] == Approx(expected_plastic_strain[l]).margin(1.0e-12));
+            }
+
+            auto const& stress = variables.get_old(symmetric::cauchy_stress);
+            auto const& expected_stress = expected_stresses[index];
+
+            for (std::size_t l{0}; l < stress.size(); ++l)
+            {
+                REQUIRE((stress[l] - expected_stress[l]).norm() / expected_stress[l].norm()
+                        == Approx(0.0).margin(1.0e-10));
+            }
+        }
+    }
+    std::remove("cube.checkpoint");
+
+    // The time history keeps the time steps before the checkpoint
+    std::ifstream pvd_file("cube.pvd");
+
+    std::int32_t entries{0};
+    for (std::string line; std::getline(pvd_file, line);)
+    {
+        if (line.find("<DataSet") != std::string::npos) ++entries;
+    }
+    // The initial state and each of the four time steps
+    REQUIRE(entries == 5);
+}
+TEST_CASE("Constant tangent solver test")
+{
+    using fem_mesh = neon::mechanics::solid::mesh;
+    using static_matrix = neon::mechanics::static_matrix<fem_mesh>;
+
+    neon::telemetry::configure(json{{"telemetry", {{"verbosity", "quiet"}}}});
+
+    neon::basic_mesh basic_mesh(json::parse(json_cube_mesh()));
+
+    auto simulation_data = json::parse(simulation_data_json());
+
+    simulation_data["constitutive"] = {{"name", "isotropic_linear_elasticity"}};
+    simulation_data["linear_solver"] = {{"type", "direct"}};
+    simulation_data["time"]["increments"]["initial"] = 0.25;
+    simulation_data["time"]["increments"]["maximum"] = 0.25;
+
+    // Release the lateral constraint of the top after the second time step
+    auto lateral_boundary = simulation_data["boundaries"][1];
+    lateral_boundary.erase("z");
+    lateral_boundary["time"] = {0.0, 0.5};
+    lateral_boundary["x"] = {0.0, 0.0};
+    lateral_boundary["y"] = {0.0, 0.0};
+
+    simulation_data["boundaries"].push_back(lateral_boundary);
+
+    auto const factorisations = [] {
+        return neon::telemetry::summary()["counters"].value("Constant tangent factorisations", 0);
+    };
+    auto const iterations = [] {
+        return neon::telemetry::summary()["counters"].value("Newton-Raphson iterations", 0);
+    };
+
+    fem_mesh mesh(basic_mesh, json::parse(material_data_json()), simulation_data, 0.25);
+
+    REQUIRE(mesh.is_tangent_constant());
+
+    auto const initial_factorisations = factorisations();
+    auto const initial_iterations = iterations();
+
+    static_matrix matrix(mesh, simulation_data);
+    matrix.solve();
+
+    // The factorisation of the first step is reused until the lateral
+    // constraint is released and is then reused for the remaining steps
+    REQUIRE(factorisations() - initial_factorisations == 2);
+    REQUIRE(iterations() - initial_iterations > 4);
+
+    // Compare with the full Newton-Raphson path for the same elastic response
+    auto material_data = json::parse(material_data_json());
+    material_data["yield_stress"] = 1.0e20;
+    material_data["isotropic_hardening_modulus"] = 0.0;
+
+    auto newton_data = simulation_data;
+    newton_data["constitutive"] = {{"name", "J2_plasticity"}, {"finite_strain", false}};
+
+    fem_mesh newton_mesh(basic_mesh, material_data, newton_data, 0.25);
+
+    REQUIRE_FALSE(newton_mesh.is_tangent_constant());
+
+    auto const newton_factorisations = factorisations();
+
+    static_matrix newton_matrix(newton_mesh, newton_data);
+    newton_matrix.solve();
+
+    REQUIRE(factorisations() == newton_factorisations);
+
+    auto const displacement = newton_mesh.geometry().displacement();
+
+    REQUIRE((mesh.geometry().displacement() - displacement).norm() / displacement.norm()
+            < 1.0e-8);
+}
 TEST_CASE("LATIN solver test")
 {
     using fem_mesh = neon::mechanics::solid::mesh;
     using latin_matrix = neon::mechanics::latin_matrix<fem_mesh>;
+    using static_matrix = neon::mechanics::static_matrix<fem_mesh>;
 
     // Read in a cube mesh from the json input file and use this to
     // test the functionality of the basic mesh
@@ -88,5 +411,200 @@ TEST_CASE("LATIN solver test")
         // Create the system and solve it
         latin_matrix matrix(mesh, json::parse(simulation_data_json()));
         matrix.solve();
+
+        auto const latin_displacement = mesh.geometry().displacement();
+
+        // Compare with the incremental solution of the same problem
+        fem_mesh incremental_mesh(basic_mesh,
+                                  json::parse(material_data_json()),
+                                  simulation_data,
+                                  simulation_data["time"]["increments"]["initial"]);
+
+        static_matrix incremental_matrix(incremental_mesh, simulation_data);
+        incremental_matrix.solve();
+
+        auto const displacement = incremental_mesh.geometry().displacement();
+
+        // Equal to the tolerance of the LATIN iterations
+        REQUIRE((latin_displacement - displacement).norm() / displacement.norm()
+                < simulation_data["nonlinear_options"]["residual_tolerance"].get<double>());
+    }
+    SECTION("Iteration limit")
+    {
+        // A single iteration can not show convergence of the correction
+        simulation_data["nonlinear_options"]["latin_iterations"] = 1;
+
+        latin_matrix matrix(mesh, simulation_data);
+
+        REQUIRE_THROWS_AS(matrix.solve(), neon::computational_error);
+    }
+}
+TEST_CASE("Load case solver test")
+{
+    using fem_mesh = neon::mechanics::solid::mesh;
+    using load_case_matrix = neon::mechanics::load_case_matrix<fem_mesh>;
+    using static_matrix = neon::mechanics::static_matrix<fem_mesh>;
+
+    neon::basic_mesh basic_mesh(json::parse(json_cube_mesh()));
+
+    auto simulation_data = json::parse(simulation_data_json());
+
+    simulation_data["constitutive"] = {{"name", "isotropic_linear_elasticity"}};
+    simulation_data["linear_solver"] = {{"type", "direct"}};
+
+    // The bottom is fixed in every load case
+    auto const top_boundary = simulation_data["boundaries"][1];
+    simulation_data["boundaries"].erase(1);
+
+    auto compression = top_boundary;
+    compression["z"] = {0.0, -1.0e-3};
+
+    auto extension = top_boundary;
+    extension["z"] = {0.0, 2.0e-3};
+
+    simulation_data["load_cases"] = {{{"name", "compression"}, {"boundaries", {compression}}},
+                                     {{"name", "extension"}, {"boundaries", {extension}}}};
+
+    SECTION("Single factorisation")
+    {
+        fem_mesh mesh(basic_mesh,
+                      json::parse(material_data_json()),
+                      simulation_data,
+                      simulation_data["time"]["increments"]["initial"]);
+
+        REQUIRE(mesh.load_cases().size() == 2);
+        REQUIRE(mesh.load_cases().front().name == "compression");
+
+        load_case_matrix matrix(mesh, simulation_data);
+        matrix.solve();
+
+        // The last load case remains in the mesh
+        auto const displacement = mesh.geometry().displacement();
+
+        REQUIRE(displacement.maxCoeff() == Approx(2.0e-3));
+
+        // Compare with the solution of the last load case as a single step
+        auto single_data = simulation_data;
+        single_data.erase("load_cases");
+        single_data["boundaries"].push_back(extension);
+
+        fem_mesh single_mesh(basic_mesh,
+                             json::parse(material_data_json()),
+                             single_data,
+                             single_data["time"]["increments"]["initial"]);
+
+        static_matrix single_matrix(single_mesh, single_data);
+        single_matrix.solve();
+
+        // Equal to the tolerance of the nonlinear solution
+        REQUIRE((single_mesh.geometry().displacement() - displacement).norm() / displacement.norm()
+                < 1.0e-3);
+    }
+    SECTION("Different constraints")
+    {
+        extension["x"] = {0.0, 0.0};
+        simulation_data["load_cases"][1]["boundaries"] = {extension};
+
+        fem_mesh mesh(basic_mesh,
+                      json::parse(material_data_json()),
+                      simulation_data,
+                      simulation_data["time"]["increments"]["initial"]);
+
+        load_case_matrix matrix(mesh, simulation_data);
+
+        REQUIRE_THROWS_AS(matrix.solve(), std::domain_error);
+    }
+    SECTION("Nonlinear material")
+    {
+        simulation_data["constitutive"] = {{"name", "neohooke"}};
+
+        fem_mesh mesh(basic_mesh,
+                      json::parse(material_data_json()),
+                      simulation_data,
+                      simulation_data["time"]["increments"]["initial"]);
+
+        REQUIRE_THROWS_AS(load_case_matrix(mesh, simulation_data), std::domain_error);
+    }
+}
+TEST_CASE("Plane strain load case solver test")
+{
+    using fem_mesh = neon::mechanics::plane::mesh;
+    using static_matrix = neon::mechanics::static_matrix<fem_mesh>;
+
+    neon::basic_mesh basic_mesh(json::parse(json_square_mesh(4, "quadrilateral")));
+
+    auto const material_data = json::parse(material_data_json());
+
+    json simulation_data{{"boundaries",
+                          {{{"name", "bottom"},
+                            {"type", "displacement"},
+                            {"time", {0.0, 1.0}},
+                            {"x", {0.0, 0.0}},
+                            {"y", {0.0, 0.0}}}}},
+                         {"constitutive", {{"name", "plane_strain"}}},
+                         {"element_options", {{"quadrature", "full"}}},
+                         {"name", "square"},
+                         {"visualisation", {{"fields", {"displacement"}}}},
+                         {"linear_solver", {{"type", "direct"}}},
+                         {"nonlinear_options",
+                          {{"displacement_tolerance", 1.0e-8}, {"residual_tolerance", 1.0e-8}}},
+                         {"time",
+                          {{"period", 1.0},
+                           {"increments",
+                            {{"initial", 1.0},
+                             {"minimum", 0.1},
+                             {"maximum", 1.0},
+                             {"adaptive", false}}}}}};
+
+    // The load cases constrain the same degrees of freedom on the top edge
+    json const compression{{"name", "top"},
+                           {"type", "displacement"},
+                           {"time", {0.0, 1.0}},
+                           {"x", {0.0, 0.0}},
+                           {"y", {0.0, -1.0e-3}}};
+
+    json const shear{{"name", "top"},
+                     {"type", "displacement"},
+                     {"time", {0.0, 1.0}},
+                     {"x", {0.0, 2.0e-3}},
+                     {"y", {0.0, 0.0}}};
+
+    simulation_data["load_cases"] = {{{"name", "compression"}, {"boundaries", {compression}}},
+                                     {{"name", "shear"}, {"boundaries", {shear}}}};
+
+    fem_mesh mesh(basic_mesh, material_data, simulation_data, 1.0);
+
+    REQUIRE(mesh.load_cases().size() == 2);
+
+    load_case_solutions<fem_mesh> matrix(mesh, simulation_data);
+    matrix.solve();
+
+    auto const& displacements = matrix.solutions();
+
+    REQUIRE(displacements.cols() == 2);
+
+    // Compare each load case with the solution of a single step
+    for (auto const& [index, boundary] : {std::pair{0, compression}, std::pair{1, shear}})
+    {
+        auto single_data = simulation_data;
+        single_data.erase("load_cases");
+        single_data["boundaries"].push_back(boundary);
+
+        fem_mesh single_mesh(basic_mesh, material_data, single_data, 1.0);
+
+        static_matrix single_matrix(single_mesh, single_data);
+        single_matrix.solve();
+
+        // The mesh displacements include the out of plane component
+        neon::vector const single_displacement = single_mesh.geometry().displacement();
+        neon::vector const displacement = displacements.col(index);
+
+        auto const nodes = displacement.size() / 2;
+
+        Eigen::Map<Eigen::MatrixXd const> const single_xy(single_displacement.data(), 3, nodes);
+        Eigen::Map<Eigen::MatrixXd const> const case_xy(displacement.data(), 2, nodes);
+
+        // The single step includes the change in geometry of the deformed mesh
+        REQUIRE((single_xy.topRows(2) - case_xy).norm() / case_xy.norm() < 1.0e-3);
     }
 }
@@ -7,12 +7,29 @@
 #include "mesh/material_coordinates.hpp"
 #include "mesh/mechanics/solid/mesh.hpp"
 #include "mesh/mechanics/solid/submesh.hpp"
+#include "mesh/mechanics/plane/mesh.hpp"
+#include "io/file_output.hpp"
+#include "io/file_output_factory.hpp"
 #include "io/json.hpp"
+#include "io/post/quadrature_variables.hpp"
 
 #include "fixtures/cube_mesh.hpp"
 
 #include <range/v3/view.hpp>
 
+#include <Eigen/Eigenvalues>
+
+#include <vtkDataArray.h>
+#include <vtkPointData.h>
+#include <vtkSmartPointer.h>
+#include <vtkUnstructuredGrid.h>
+#include <vtkXMLUnstructuredGridReader.h>
+
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <thread>
+
 using namespace neon;
 using namespace ranges;
 
@@ -157,8 +174,12 @@ TEST_CASE("Solid submesh test")
         // Check the standard ones are used
         REQUIRE(internal_vars.has(variable::second::displacement_gradient));
         REQUIRE(internal_vars.has(variable::second::deformation_gradient));
-        REQUIRE(internal_vars.has(variable::second::cauchy_stress));
+        REQUIRE(internal_vars.has(variable::symmetric::cauchy_stress));
         REQUIRE(internal_vars.has(variable::scalar::DetF));
+
+        // The hyperelastic tangent is evaluated during the assembly
+        REQUIRE_FALSE(internal_vars.has(variable::fourth::tangent_operator));
+        REQUIRE_FALSE(internal_vars.has(variable::major_symmetric::tangent_operator));
     }
     SECTION("Tangent stiffness")
     {
@@ -197,6 +218,116 @@ TEST_CASE("Solid submesh test")
             REQUIRE(mass_c.row(i).sum() == Approx(mass_d(i)));
         }
     }
+    SECTION("Checkpoint and restore internal variables")
+    {
+        fem_submesh.save_internal_variables(true);
+
+        auto const state = fem_submesh.checkpoint_internal_variables();
+
+        matrix3 const F = internal_vars.get(variable::second::deformation_gradient).front();
+
+        mesh_coordinates->update_current_configuration(0.01 * vector::Random(number_of_dofs));
+
+        fem_submesh.update_internal_variables();
+        fem_submesh.save_internal_variables(true);
+
+        REQUIRE((internal_vars.get(variable::second::deformation_gradient).front() - F).norm()
+                != Approx(0.0).margin(ZERO_MARGIN));
+
+        fem_submesh.restore_internal_variables(state);
+
+        REQUIRE((internal_vars.get(variable::second::deformation_gradient).front() - F).norm()
+                == Approx(0.0).margin(ZERO_MARGIN));
+        REQUIRE((internal_vars.get_old(variable::second::deformation_gradient).front() - F).norm()
+                == Approx(0.0).margin(ZERO_MARGIN));
+    }
+    SECTION("Extrapolate internal variables")
+    {
+        fem_submesh.save_internal_variables(true);
+
+        auto const first = fem_submesh.checkpoint_internal_variables();
+
+        matrix3 const F_0 = internal_vars.get(variable::second::deformation_gradient).front();
+
+        mesh_coordinates->update_current_configuration(2.0 * displacement);
+
+        fem_submesh.update_internal_variables();
+        fem_submesh.save_internal_variables(true);
+
+        auto const second = fem_submesh.checkpoint_internal_variables();
+
+        matrix3 const F_1 = internal_vars.get(variable::second::deformation_gradient).front();
+
+        auto const [rate, error] = internal_vars.cycle_variation(first, first, second);
+
+        REQUIRE(rate > 0.0);
+        REQUIRE(error > 0.0);
+
+        fem_submesh.extrapolate_internal_variables(first, second, 2.0);
+
+        matrix3 const F_extrapolated = F_1 + 2.0 * (F_1 - F_0);
+
+        REQUIRE((internal_vars.get(variable::second::deformation_gradient).front() - F_extrapolated)
+                    .norm()
+                == Approx(0.0).margin(ZERO_MARGIN));
+        REQUIRE((internal_vars.get_old(variable::second::deformation_gradient).front()
+                 - F_extrapolated)
+                    .norm()
+                == Approx(0.0).margin(ZERO_MARGIN));
+    }
+    SECTION("Nodal averaged variables")
+    {
+        mesh_coordinates->update_current_configuration(vector::Zero(number_of_dofs));
+
+        fem_submesh.update_internal_variables();
+
+        auto const [value, count] = fem_submesh.nodal_averaged_variable(
+            variable::second::deformation_gradient);
+
+        REQUIRE(value.size() == number_of_nodes * 9);
+        REQUIRE(count.size() == number_of_nodes * 9);
+        REQUIRE(count.minCoeff() >= 1.0);
+
+        vector const average = value.cwiseQuotient(count);
+
+        matrix3 const identity = matrix3::Identity();
+
+        for (std::int64_t node{0}; node < number_of_nodes; ++node)
+        {
+            REQUIRE((average.segment<9>(node * 9) - vector::Map(identity.data(), 9)).norm()
+                    == Approx(0.0).margin(ZERO_MARGIN));
+        }
+    }
+    SECTION("Nodal averaged non-uniform variable")
+    {
+        auto state = fem_submesh.checkpoint_internal_variables();
+
+        auto& J_list = std::get<0>(state).at(variable::scalar::DetF);
+
+        auto const points = J_list.size() / fem_submesh.elements();
+
+        // A constant value of one more than the element index in each element
+        for (std::size_t l{0}; l < J_list.size(); ++l) J_list[l] = l / points + 1.0;
+
+        fem_submesh.restore_internal_variables(state);
+
+        auto const [value, count] = fem_submesh.nodal_averaged_variable(variable::scalar::DetF);
+
+        REQUIRE(value.size() == number_of_nodes);
+        REQUIRE(count.size() == number_of_nodes);
+
+        vector const average = value.cwiseQuotient(count);
+
+        // Corner node of element 1
+        REQUIRE(count(6) == Approx(1.0));
+        REQUIRE(average(6) == Approx(2.0));
+        // Edge node between elements 1 and 2
+        REQUIRE(count(29) == Approx(2.0));
+        REQUIRE(average(29) == Approx((2.0 + 3.0) / 2.0));
+        // Interior node of the elements 0, 1, 2, 4, 5, 10, 11 and 13
+        REQUIRE(count(63) == Approx(8.0));
+        REQUIRE(average(63) == Approx((1.0 + 2.0 + 3.0 + 5.0 + 6.0 + 11.0 + 12.0 + 14.0) / 8.0));
+    }
 }
 TEST_CASE("Solid mesh test")
 {
@@ -233,6 +364,36 @@ TEST_CASE("Solid mesh test")
         REQUIRE(local_dofs.size() == number_of_local_dofs);
     }
 
+    SECTION("Internal force of each thread")
+    {
+        auto const& fem_submesh = fem_mesh.meshes().front();
+
+        vector const* const buffer = &fem_submesh.internal_force(0).second;
+        vector const* thread_buffer{nullptr};
+
+        std::thread([&]() { thread_buffer = &fem_submesh.internal_force(0).second; }).join();
+
+        // Each thread assembles the element force into its own buffer
+        REQUIRE(buffer != thread_buffer);
+    }
+    SECTION("Quadrature point variables")
+    {
+        auto const [values, components] = quadrature_internal_variable(
+            fem_mesh.meshes(), "deformation_gradient", variable::second::deformation_gradient);
+
+        auto const& fem_submesh = fem_mesh.meshes().front();
+
+        auto const& F_list = fem_submesh.internal_variables().get(
+            variable::second::deformation_gradient);
+
+        REQUIRE(components == 9 * F_list.size() / fem_submesh.elements());
+        REQUIRE(values.size() == 9 * F_list.size());
+
+        // Components are stored in row major order
+        REQUIRE(values(1) == Approx(F_list.front()(0, 1)));
+        REQUIRE(values(3) == Approx(F_list.front()(1, 0)));
+        REQUIRE(values(9) == Approx(F_list[1](0, 0)));
+    }
     SECTION("Check Dirichlet boundaries")
     {
         auto const& map = fem_mesh.dirichlet_boundaries();
@@ -259,3 +420,533 @@ TEST_CASE("Solid mesh test")
         }
     }
 }
+TEST_CASE("Solid submeshes of different topologies")
+{
+    using mechanics::solid::mesh;
+
+    auto const material_data = json::parse(material_data_json());
+    auto const simulation_data = json::parse(simulation_data_json());
+
+    // The element buffers of this thread are reused for each topology
+    for (auto const& [topology, nodes] : {std::pair{"hexahedron", 8},
+                                          std::pair{"tetrahedron", 4},
+                                          std::pair{"hexahedron", 8}})
+    {
+        basic_mesh topology_mesh(json::parse(json_cube_mesh(1, topology)));
+
+        mesh fem_mesh(topology_mesh, material_data, simulation_data, 1.0);
+
+        auto const& fem_submesh = fem_mesh.meshes().front();
+
+        auto const [stiffness_dofs, stiffness] = fem_submesh.tangent_stiffness(0);
+        auto const [force_dofs, internal_force] = fem_submesh.internal_force(0);
+
+        REQUIRE(stiffness.rows() == nodes * 3);
+        REQUIRE(stiffness.cols() == nodes * 3);
+        REQUIRE(internal_force.size() == nodes * 3);
+    }
+}
+namespace
+{
+/// Simulation input for a square clamped on the bottom edge and stretched on
+/// the top edge using the constitutive model in \p constitutive
+json square_simulation_data(json const& constitutive)
+{
+    return {{"boundaries",
+             {{{"name", "bottom"},
+               {"type", "displacement"},
+               {"time", {0.0, 1.0}},
+               {"x", {0.0, 0.0}},
+               {"y", {0.0, 0.0}}},
+              {{"name", "top"},
+               {"type", "displacement"},
+               {"time", {0.0, 1.0}},
+               {"y", {0.0, 1.0e-3}}}}},
+            {"constitutive", constitutive},
+            {"element_options", {{"quadrature", "full"}}},
+            {"name", "square"},
+            {"visualisation", {{"fields", {"displacement"}}}}};
+}
+}
+TEST_CASE("Plane mesh test")
+{
+    using mechanics::plane::mesh;
+
+    auto const material_data = json::parse(material_data_json());
+
+    basic_mesh basic_mesh(json::parse(json_square_mesh(2, "quadrilateral")));
+
+    auto simulation_data = square_simulation_data({{"name", "plane_strain"}});
+
+    SECTION("Check Dirichlet boundaries")
+    {
+        mesh fem_mesh(basic_mesh, material_data, simulation_data, 1.0);
+
+        REQUIRE(fem_mesh.active_dofs() == 18);
+
+        auto const& map = fem_mesh.dirichlet_boundaries();
+
+        REQUIRE(map.find("bottom") != map.end());
+        REQUIRE(map.find("top") != map.end());
+
+        // Both components are fixed on the bottom edge
+        REQUIRE(map.find("bottom")->second.size() == 2);
+
+        for (auto const& fixed_bottom : map.find("bottom")->second)
+        {
+            REQUIRE(fixed_bottom.value_view(1.0) == Approx(0.0).margin(ZERO_MARGIN));
+            REQUIRE(fixed_bottom.dof_view().size() == 3);
+        }
+
+        REQUIRE(map.find("top")->second.size() == 1);
+
+        for (auto const& disp_driven : map.find("top")->second)
+        {
+            REQUIRE(disp_driven.value_view(1.0) == Approx(0.001));
+            REQUIRE(disp_driven.dof_view().size() == 3);
+        }
+    }
+    SECTION("Boundary without a time")
+    {
+        simulation_data["boundaries"][1].erase("time");
+
+        REQUIRE_THROWS_AS(mesh(basic_mesh, material_data, simulation_data, 1.0), std::domain_error);
+    }
+}
+TEST_CASE("Plane submesh test")
+{
+    using mechanics::plane::mesh;
+
+    auto const material_data = json::parse(material_data_json());
+
+    basic_mesh basic_mesh(json::parse(json_square_mesh(2, "quadrilateral")));
+
+    mesh fem_mesh(basic_mesh,
+                  material_data,
+                  square_simulation_data({{"name", "plane_strain"}}),
+                  1.0);
+
+    auto const& fem_submesh = fem_mesh.meshes().front();
+
+    int constexpr number_of_local_dofs = 4 * 2;
+
+    SECTION("Tangent stiffness")
+    {
+        auto const [local_dofs, stiffness] = fem_submesh.tangent_stiffness(0);
+
+        REQUIRE(local_dofs.size() == number_of_local_dofs);
+        REQUIRE(stiffness.rows() == number_of_local_dofs);
+        REQUIRE(stiffness.cols() == number_of_local_dofs);
+
+        REQUIRE((stiffness - stiffness.transpose()).norm()
+                == Approx(0.0).margin(1.0e-10 * stiffness.norm()));
+
+        // Only the two translations and the rotation are free of strain
+        Eigen::SelfAdjointEigenSolver<matrix> eigen_solver(stiffness);
+
+        auto const& eigenvalues = eigen_solver.eigenvalues();
+
+        REQUIRE((eigenvalues.head<3>().array().abs() < 1.0e-10 * eigenvalues.maxCoeff()).all());
+        REQUIRE((eigenvalues.tail<5>().array() > 1.0e-3 * eigenvalues.maxCoeff()).all());
+    }
+    SECTION("Submeshes of different topologies")
+    {
+        // The element buffers of this thread are reused for each topology
+        for (auto const& [topology, nodes] : {std::pair{"quadrilateral", 4},
+                                              std::pair{"triangle", 3},
+                                              std::pair{"quadrilateral", 4}})
+        {
+            neon::basic_mesh topology_mesh(json::parse(json_square_mesh(2, topology)));
+
+            mesh topology_fem_mesh(topology_mesh,
+                                   material_data,
+                                   square_simulation_data({{"name", "plane_strain"}}),
+                                   1.0);
+
+            auto const& topology_submesh = topology_fem_mesh.meshes().front();
+
+            auto const [stiffness_dofs, stiffness] = topology_submesh.tangent_stiffness(0);
+            auto const [force_dofs, internal_force] = topology_submesh.internal_force(0);
+
+            REQUIRE(stiffness.rows() == nodes * 2);
+            REQUIRE(stiffness.cols() == nodes * 2);
+            REQUIRE(internal_force.size() == nodes * 2);
+        }
+    }
+    SECTION("Repeated finite strain tangent stiffness")
+    {
+        auto const plastic_material_data = json::parse(R"({"name" : "steel",
+                                                           "elastic_modulus" : 200.0e9,
+                                                           "poissons_ratio" : 0.3,
+                                                           "yield_stress" : 200.0e6,
+                                                           "isotropic_hardening_modulus" : 400.0e6})");
+
+        mesh finite_mesh(basic_mesh,
+                         plastic_material_data,
+                         square_simulation_data({{"name", "J2_plasticity"}, {"finite_strain", true}}),
+                         1.0);
+
+        finite_mesh.update_internal_variables(1.0e-3 * vector::Random(finite_mesh.active_dofs()), 1.0);
+
+        auto const& finite_submesh = finite_mesh.meshes().front();
+
+        // The geometric stiffness depends on the stress and must not accumulate
+        auto const [first_dofs, first_stiffness] = finite_submesh.tangent_stiffness(0);
+        auto const [second_dofs, second_stiffness] = finite_submesh.tangent_stiffness(0);
+
+        REQUIRE((first_stiffness - second_stiffness).norm()
+                == Approx(0.0).margin(1.0e-10 * first_stiffness.norm()));
+    }
+}
+
+TEST_CASE("File output frequency")
+{
+    auto const visualisation_data = json::parse(
+        R"({"fields" : [], "write_every" : 2, "write_interval" : 1.0})");
+
+    io::vtk_file_output writer("frequency", visualisation_data);
+
+    REQUIRE(writer.is_write_required(0, 0.0));
+    // Not a multiple of the write frequency
+    REQUIRE_FALSE(writer.is_write_required(1, 1.0));
+    // Within the write interval
+    REQUIRE_FALSE(writer.is_write_required(2, 0.5));
+    REQUIRE(writer.is_write_required(4, 1.0));
+    REQUIRE_FALSE(writer.is_write_required(6, 1.5));
+    REQUIRE(writer.is_write_required(8, 2.5));
+}
+
+namespace
+{
+/// \return the point field of a VTK file
+std::vector<double> read_vtk_field(std::string const& file_name, std::string const& name)
+{
+    auto reader = vtkSmartPointer<vtkXMLUnstructuredGridReader>::New();
+
+    reader->SetFileName(file_name.c_str());
+    reader->Update();
+
+    auto* const field = reader->GetOutput()->GetPointData()->GetArray(name.c_str());
+
+    if (field == nullptr) return {};
+
+    std::vector<double> values;
+    for (vtkIdType tuple{0}; tuple < field->GetNumberOfTuples(); ++tuple)
+    {
+        for (int component{0}; component < field->GetNumberOfComponents(); ++component)
+        {
+            values.push_back(field->GetComponent(tuple, component));
+        }
+    }
+    return values;
+}
+}
+
+TEST_CASE("VTK file output")
+{
+    basic_mesh basic_mesh(json::parse(json_cube_mesh()));
+
+    matrix3x const& coordinates = basic_mesh.coordinates();
+
+    // A different nodal vector field for each time step
+    auto const displacement = [&](auto const time_step) -> vector {
+        return 1.0e-3 * (time_step + 1) * vector::LinSpaced(coordinates.size(), 0.0, 1.0);
+    };
+
+    auto const matches = [](std::vector<double> const& values, vector const& expected) {
+        return values.size() == static_cast<std::size_t>(expected.size())
+               && (vector::Map(values.data(), values.size()) - expected).norm()
+                      == Approx(0.0).margin(1.0e-12 * expected.norm());
+    };
+
+    for (auto time_step = 0; time_step < 4; ++time_step)
+    {
+        std::remove(("visualisation/vtk_cube_" + std::to_string(time_step) + ".vtu").c_str());
+    }
+
+    SECTION("Queued snapshots")
+    {
+        {
+            io::vtk_file_output writer("vtk_cube",
+                                       json::parse(R"({"fields" : ["displacement"],
+                                                       "write_queue_size" : 2})"));
+
+            writer.coordinates(coordinates);
+            writer.add_mesh(basic_mesh, {"cube"});
+
+            // Change the field after each snapshot is queued
+            for (auto time_step = 0; time_step < 4; ++time_step)
+            {
+                writer.field("displacement", displacement(time_step), 3);
+                writer.write(time_step, time_step);
+            }
+        }
+        // The destructor writes the remaining snapshots
+        for (auto time_step = 0; time_step < 4; ++time_step)
+        {
+            REQUIRE(matches(read_vtk_field("visualisation/vtk_cube_" + std::to_string(time_step)
+                                               + ".vtu",
+                                           "displacement"),
+                            displacement(time_step)));
+        }
+    }
+    SECTION("Bounded queue")
+    {
+        io::vtk_file_output writer("vtk_cube",
+                                   json::parse(R"({"fields" : ["displacement"],
+                                                   "write_queue_size" : 1})"));
+
+        writer.coordinates(coordinates);
+        writer.add_mesh(basic_mesh, {"cube"});
+
+        for (auto time_step = 0; time_step < 4; ++time_step)
+        {
+            writer.field("displacement", displacement(time_step), 3);
+            writer.write(time_step, time_step);
+
+            // Queuing a snapshot waits until the previous snapshot is written
+            if (time_step > 0)
+            {
+                REQUIRE(matches(read_vtk_field("visualisation/vtk_cube_"
+                                                   + std::to_string(time_step - 1) + ".vtu",
+                                               "displacement"),
+                                displacement(time_step - 1)));
+            }
+        }
+    }
+    SECTION("Writer thread error")
+    {
+        // The file names of the snapshots are in a directory which does not exist
+        io::vtk_file_output writer("visualisation/../vtk_cube",
+                                   json::parse(R"({"fields" : ["displacement"],
+                                                   "write_queue_size" : 1})"));
+
+        writer.coordinates(coordinates);
+        writer.add_mesh(basic_mesh, {"cube"});
+        writer.field("displacement", displacement(0), 3);
+
+        writer.write(0, 0.0);
+
+        REQUIRE_THROWS_AS(writer.write(1, 1.0), std::domain_error);
+    }
+    SECTION("Invalid queue size")
+    {
+        REQUIRE_THROWS_AS(io::vtk_file_output("vtk_cube",
+                                              json::parse(R"({"fields" : [],
+                                                              "write_queue_size" : 0})")),
+                          std::domain_error);
+    }
+}
+
+TEST_CASE("XDMF file output")
+{
+    basic_mesh basic_mesh(json::parse(json_cube_mesh()));
+
+    matrix3x const& coordinates = basic_mesh.coordinates();
+
+    // A nodal vector field distinct from the coordinates
+    vector const displacement = 1.0e-3 * vector::LinSpaced(coordinates.size(), 0.0, 1.0);
+
+    {
+        io::xdmf_file_output writer("xdmf_cube", json::parse(R"({"fields" : ["displacement"]})"));
+
+        writer.coordinates(coordinates);
+        writer.add_mesh(basic_mesh, {"cube"});
+        writer.field("displacement", displacement, 3);
+        writer.write(0, 0.0);
+    }
+
+    std::ifstream xdmf_file("xdmf_cube.xdmf");
+    REQUIRE(xdmf_file.is_open());
+
+    std::stringstream buffer;
+    buffer << xdmf_file.rdbuf();
+    auto const index = buffer.str();
+
+    // Read the dimensions and the offset of the data item after the tag
+    auto const data_item = [&index](std::string const& tag) {
+        auto const start = index.find("Dimensions=\"", index.find(tag)) + 12;
+        auto const dimensions = index.substr(start, index.find('"', start) - start);
+
+        auto const seek = index.find("Seek=\"", start) + 6;
+        auto const offset = std::stoll(index.substr(seek, index.find('"', seek) - seek));
+
+        std::vector<std::int64_t> sizes;
+        std::istringstream dimension_stream(dimensions);
+        for (std::int64_t size; dimension_stream >> size;) sizes.push_back(size);
+
+        return std::make_pair(sizes, offset);
+    };
+
+    std::ifstream binary_file("visualisation/xdmf_cube.bin", std::ios::binary);
+    REQUIRE(binary_file.is_open());
+
+    // Read the values from the binary file at the offset
+    auto const read = [&binary_file](auto* const data,
+                                     std::int64_t const size,
+                                     std::int64_t const offset) {
+        binary_file.seekg(offset);
+        binary_file.read(reinterpret_cast<char*>(data), size * sizeof(*data));
+        return static_cast<bool>(binary_file);
+    };
+
+    SECTION("Coordinates")
+    {
+        auto const [dimensions, offset] = data_item("<Geometry");
+
+        REQUIRE(dimensions == std::vector<std::int64_t>{coordinates.cols(), 3});
+
+        matrix3x values(3, coordinates.cols());
+        REQUIRE(read(values.data(), values.size(), offset));
+
+        REQUIRE((values - coordinates).norm() == Approx(0.0).margin(ZERO_MARGIN));
+    }
+    SECTION("Connectivity")
+    {
+        auto const [dimensions, offset] = data_item("<Topology");
+
+        auto const& submesh = basic_mesh.meshes("cube").front();
+
+        indices const nodes = convert_to_vtk(submesh.all_node_indices(), submesh.topology());
+
+        REQUIRE(index.find("NumberOfElements=\"" + std::to_string(nodes.cols()) + "\"")
+                != std::string::npos);
+        REQUIRE(dimensions == std::vector<std::int64_t>{nodes.cols() * (nodes.rows() + 1)});
+
+        std::vector<std::int64_t> values(dimensions.front());
+        REQUIRE(read(values.data(), values.size(), offset));
+
+        // Each cell is the cell type followed by the nodes
+        for (std::int64_t element{0}; element < nodes.cols(); ++element)
+        {
+            auto const cell = element * (nodes.rows() + 1);
+
+            REQUIRE(values[cell] == to_xdmf(submesh.topology()));
+
+            for (std::int64_t node{0}; node < nodes.rows(); ++node)
+            {
+                REQUIRE(values[cell + 1 + node] == nodes(node, element));
+            }
+        }
+    }
+    SECTION("Nodal field")
+    {
+        REQUIRE(index.find("<Attribute Name=\"displacement\" AttributeType=\"Vector\" "
+                           "Center=\"Node\">")
+                != std::string::npos);
+
+        auto const [dimensions, offset] = data_item("<Attribute Name=\"displacement\"");
+
+        REQUIRE(dimensions == std::vector<std::int64_t>{coordinates.cols(), 3});
+
+        vector values(displacement.size());
+        REQUIRE(read(values.data(), values.size(), offset));
+
+        REQUIRE((values - displacement).norm() == Approx(0.0).margin(ZERO_MARGIN));
+    }
+}
+
+TEST_CASE("Element set file output")
+{
+    basic_mesh basic_mesh(json::parse(json_cube_mesh()));
+
+    matrix3x const& coordinates = basic_mesh.coordinates();
+
+    vector const displacement = vector::LinSpaced(coordinates.size(), 0.0, 1.0);
+
+    SECTION("Nodes of the element set")
+    {
+        {
+            io::xdmf_file_output writer("xdmf_top",
+                                        json::parse(R"({"fields" : ["displacement"],
+                                                        "element_sets" : ["top"]})"));
+
+            writer.coordinates(coordinates);
+            writer.add_mesh(basic_mesh, {"cube"});
+            writer.field("displacement", displacement, 3);
+            writer.write(0, 0.0);
+        }
+
+        std::ifstream xdmf_file("xdmf_top.xdmf");
+        std::stringstream buffer;
+        buffer << xdmf_file.rdbuf();
+        auto const index = buffer.str();
+
+        // Only the sixteen nodes of the top face are written
+        REQUIRE(index.find("NumberOfElements=\"9\"") != std::string::npos);
+        REQUIRE(index.find("Dimensions=\"16 3\"") != std::string::npos);
+        REQUIRE(index.find("Dimensions=\"" + std::to_string(coordinates.cols()))
+                == std::string::npos);
+
+        auto const offset = [&index](std::string const& tag) {
+            auto const seek = index.find("Seek=\"", index.find(tag)) + 6;
+            return std::stoll(index.substr(seek, index.find('"', seek) - seek));
+        };
+
+        std::ifstream binary_file("visualisation/xdmf_top.bin", std::ios::binary);
+
+        matrix3x output_coordinates(3, 16);
+        binary_file.seekg(offset("<Geometry"));
+        binary_file.read(reinterpret_cast<char*>(output_coordinates.data()),
+                         output_coordinates.size() * sizeof(double));
+
+        vector output_displacement(3 * 16);
+        binary_file.seekg(offset("<Attribute"));
+        binary_file.read(reinterpret_cast<char*>(output_displacement.data()),
+                         output_displacement.size() * sizeof(double));
+
+        REQUIRE(binary_file);
+
+        // The field values are written for the same nodes as the coordinates
+        for (std::int64_t node{0}; node < 16; ++node)
+        {
+            REQUIRE(output_coordinates(2, node) == Approx(1.0));
+
+            for (std::int64_t mesh_node{0}; mesh_node < coordinates.cols(); ++mesh_node)
+            {
+                if ((coordinates.col(mesh_node) - output_coordinates.col(node)).norm() < 1.0e-12)
+                {
+                    REQUIRE((output_displacement.segment<3>(3 * node)
+                             - displacement.segment<3>(3 * mesh_node))
+                                .norm()
+                            == Approx(0.0).margin(ZERO_MARGIN));
+                }
+            }
+        }
+    }
+    SECTION("Unknown element set")
+    {
+        io::xdmf_file_output writer("xdmf_missing",
+                                    json::parse(R"({"fields" : ["displacement"],
+                                                    "element_sets" : ["lid"]})"));
+
+        writer.coordinates(coordinates);
+
+        REQUIRE_THROWS_AS(writer.add_mesh(basic_mesh, {"cube"}), std::domain_error);
+    }
+}
+
+TEST_CASE("File output factory")
+{
+    SECTION("VTK by default")
+    {
+        auto const writer = io::make_file_output("factory_vtk", json::parse(R"({"fields" : []})"));
+
+        REQUIRE(dynamic_cast<io::vtk_file_output*>(writer.get()) != nullptr);
+    }
+    SECTION("XDMF from the format")
+    {
+        auto const writer = io::make_file_output("factory_xdmf",
+                                                 json::parse(R"({"fields" : [],
+                                                                 "format" : "xdmf"})"));
+
+        REQUIRE(dynamic_cast<io::xdmf_file_output*>(writer.get()) != nullptr);
+    }
+    SECTION("Unknown format")
+    {
+        REQUIRE_THROWS_AS(io::make_file_output("factory_unknown",
+                                               json::parse(R"({"fields" : [],
+                                                               "format" : "hdf5"})")),
+                          std::domain_error);
+    }
+}
@@ -0,0 +1,216 @@
+
+#include <catch2/catch.hpp>
+
+#include "solver/linear/ordering_cache.hpp"
+#include "solver/linear/linear_solver_factory.hpp"
+#include "assembler/sparsity_pattern.hpp"
+#include "io/json.hpp"
+#include "telemetry.hpp"
+
+#include <cstdio>
+#include <numeric>
+#include <vector>
+
+using namespace neon;
+
+namespace
+{
+/// Chain of two noded elements with the minimal interface of a mesh
+struct chain_submesh
+{
+    std::int64_t elements() const { return size - 1; }
+
+    Eigen::Matrix<std::int64_t, 2, 1> local_dof_view(std::int64_t const element) const
+    {
+        return {element, element + 1};
+    }
+
+    std::int64_t size;
+};
+
+struct chain_mesh
+{
+    std::int64_t active_dofs() const { return submeshes.front().size; }
+
+    std::vector<chain_submesh> const& meshes() const { return submeshes; }
+
+    std::vector<chain_submesh> submeshes;
+};
+
+/// One dimensional Laplacian
+sparse_matrix create_laplacian(std::int32_t const n)
+{
+    std::vector<Eigen::Triplet<double>> triplets;
+
+    for (std::int32_t i{0}; i < n; ++i)
+    {
+        triplets.emplace_back(i, i, 2.0);
+        if (i > 0) triplets.emplace_back(i, i - 1, -1.0);
+        if (i < n - 1) triplets.emplace_back(i, i + 1, -1.0);
+    }
+
+    sparse_matrix A(n, n);
+    A.setFromTriplets(std::begin(triplets), std::end(triplets));
+    return A;
+}
+
+/// \return the number of entries read from the cache
+std::int64_t cache_reads(char const* const name)
+{
+    return telemetry::summary()["counters"].value(name, 0);
+}
+
+/// Solve the Laplacian with a solver built twice from \p solver_data, storing
+/// the ordering on the first solve and reading it on the second.  Orderings
+/// already in the file must not be read by the first solve
+void check_cached_ordering(std::string const& file_name,
+                           json const& solver_data,
+                           bool const is_symmetric)
+{
+    auto const A = create_laplacian(200);
+
+    vector const x_exact = vector::LinSpaced(A.rows(), 1.0, 2.0);
+    vector const b = A * x_exact;
+
+    {
+        ordering_cache cache(file_name);
+
+        auto const reads = cache_reads("Cached orderings");
+
+        vector x;
+        make_linear_solver(solver_data, is_symmetric)->solve(A, x, b);
+
+        REQUIRE((x - x_exact).norm() / x_exact.norm() < 1.0e-10);
+        REQUIRE(cache_reads("Cached orderings") == reads);
+
+        cache.save();
+    }
+
+    ordering_cache cache(file_name);
+
+    auto const stored_entries = cache.size();
+    auto const reads = cache_reads("Cached orderings");
+
+    REQUIRE(stored_entries >= 1);
+
+    vector x;
+    make_linear_solver(solver_data, is_symmetric)->solve(A, x, b);
+
+    REQUIRE((x - x_exact).norm() / x_exact.norm() < 1.0e-10);
+    REQUIRE(cache_reads("Cached orderings") == reads + 1);
+    REQUIRE(cache.size() == stored_entries);
+}
+}
+
+TEST_CASE("Ordering cache")
+{
+    std::string const file_name = "ordering_cache_test.ordering_cache";
+
+    std::remove(file_name.c_str());
+
+    REQUIRE(ordering_cache::get() == nullptr);
+
+    SECTION("Hashing")
+    {
+        std::vector<std::int32_t> const values = {1, 2, 3};
+        std::vector<std::int32_t> const permuted = {1, 3, 2};
+
+        REQUIRE(ordering_cache::hash(values.data(), values.size())
+                == ordering_cache::hash(values.data(), values.size()));
+        REQUIRE(ordering_cache::hash(values.data(), values.size())
+                != ordering_cache::hash(permuted.data(), permuted.size()));
+
+        auto const A = create_laplacian(10);
+        auto const B = create_laplacian(11);
+
+        REQUIRE(ordering_cache::pattern_hash(A) == ordering_cache::pattern_hash(A));
+        REQUIRE(ordering_cache::pattern_hash(A) != ordering_cache::pattern_hash(B));
+    }
+    SECTION("Sparsity pattern")
+    {
+        chain_mesh const mesh{{{50}}};
+
+        sparse_matrix A, B;
+        {
+            ordering_cache cache(file_name);
+
+            REQUIRE(ordering_cache::get() == &cache);
+
+            fem::compute_sparsity_pattern(A, mesh);
+
+            REQUIRE(cache.size() == 1);
+
+            cache.save();
+        }
+        REQUIRE(ordering_cache::get() == nullptr);
+
+        ordering_cache cache(file_name);
+
+        REQUIRE(cache.size() == 1);
+
+        auto const reads = cache_reads("Cached sparsity patterns");
+
+        fem::compute_sparsity_pattern(B, mesh);
+
+        REQUIRE(cache_reads("Cached sparsity patterns") == reads + 1);
+
+        REQUIRE(B.rows() == A.rows());
+        REQUIRE(B.nonZeros() == A.nonZeros());
+        REQUIRE(ordering_cache::pattern_hash(B) == ordering_cache::pattern_hash(A));
+        REQUIRE(B.coeffs().abs().maxCoeff() == Approx(0.0));
+
+        // A different connectivity is not restored from the cache
+        chain_mesh const coarse_mesh{{{40}}};
+
+        fem::compute_sparsity_pattern(B, coarse_mesh);
+
+        REQUIRE(B.rows() == 40);
+        REQUIRE(cache.size() == 2);
+        REQUIRE(cache_reads("Cached sparsity patterns") == reads + 1);
+    }
+    SECTION("Fill-reducing ordering")
+    {
+        check_cached_ordering(file_name, json{{"type", "direct"}}, true);
+
+        // Both factorisations use the minimum degree ordering of the same pattern
+        std::remove(file_name.c_str());
+
+        check_cached_ordering(file_name, json{{"type", "direct"}}, false);
+    }
+    SECTION("Stored ordering")
+    {
+        auto const A = create_laplacian(200);
+
+        vector const x_exact = vector::LinSpaced(A.rows(), 1.0, 2.0);
+        vector const b = A * x_exact;
+
+        ordering_cache cache(file_name);
+
+        // A reversed ordering is not computed by the minimum degree ordering
+        std::vector<std::int32_t> reversed(A.rows());
+        std::iota(rbegin(reversed), rend(reversed), 0);
+
+        cache.store_ordering("amd", ordering_cache::pattern_hash(A), reversed);
+
+        auto const reads = cache_reads("Cached orderings");
+
+        vector x;
+        make_linear_solver(json{{"type", "direct"}}, true)->solve(A, x, b);
+
+        REQUIRE((x - x_exact).norm() / x_exact.norm() < 1.0e-10);
+        REQUIRE(cache_reads("Cached orderings") == reads + 1);
+        REQUIRE(*cache.find_ordering("amd", ordering_cache::pattern_hash(A), A.rows())
+                == reversed);
+    }
+    SECTION("PaStiX ordering")
+    {
+        check_cached_ordering(file_name, json{{"type", "PaStiX"}}, true);
+        check_cached_ordering(file_name, json{{"type", "PaStiX"}}, false);
+    }
+    SECTION("MUMPS ordering")
+    {
+        check_cached_ordering(file_name, json{{"type", "MUMPS"}}, true);
+        check_cached_ordering(file_name, json{{"type", "MUMPS"}}, false);
+    }
+    std::remove(file_name.c_str());
+}
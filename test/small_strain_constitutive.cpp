@@ -9,6 +9,7 @@
 
 #include "exceptions.hpp"
 #include "numeric/dense_matrix.hpp"
+#include "numeric/stress_routines.hpp"
 #include "io/json.hpp"
 
 #include <Eigen/Eigenvalues>
@@ -44,7 +45,7 @@ TEST_CASE("Plane stress elasticity")
 
     // Add the required variables for an updated Lagrangian formulation
     variables->add(variable::second::displacement_gradient,
-                   variable::second::cauchy_stress,
+                   variable::symmetric::cauchy_stress,
                    variable::scalar::DetF);
 
     auto elastic_model = make_constitutive_model(variables,
@@ -55,13 +56,12 @@ TEST_CASE("Plane stress elasticity")
                                                              "\"plane_stress\"}}"));
 
     // Get the tensor variables
-    auto [displacement_gradients,
-          cauchy_stresses] = variables->get(variable::second::displacement_gradient,
-                                            variable::second::cauchy_stress);
+    auto& displacement_gradients = variables->get(variable::second::displacement_gradient);
+    auto& cauchy_stresses = variables->get(variable::symmetric::cauchy_stress);
 
     auto& J_list = variables->get(variable::scalar::DetF);
 
-    auto& material_tangents = variables->get(variable::fourth::tangent_operator);
+    auto& material_tangents = variables->get(variable::major_symmetric::tangent_operator);
 
     for (auto& H : displacement_gradients) H = internal_variables_t::second_tensor_type::Zero();
     for (auto& J : J_list) J = 1.0;
@@ -72,20 +72,23 @@ TEST_CASE("Plane stress elasticity")
     {
         REQUIRE(elastic_model->is_symmetric());
         REQUIRE(elastic_model->is_finite_deformation() == false);
+        REQUIRE(elastic_model->is_tangent_constant());
         REQUIRE(elastic_model->intrinsic_material().name() == "steel");
 
         REQUIRE(variables->has(variable::scalar::von_mises_stress));
-        REQUIRE(variables->has(variable::second::cauchy_stress));
-        REQUIRE(variables->has(variable::second::linearised_strain));
-        REQUIRE(variables->has(variable::fourth::tangent_operator));
+        REQUIRE(variables->has(variable::symmetric::cauchy_stress));
+        REQUIRE(variables->has(variable::symmetric::linearised_strain));
+        REQUIRE(variables->has(variable::major_symmetric::tangent_operator));
     }
     SECTION("No load")
     {
         elastic_model->update_internal_variables(1.0);
 
         // Ensure symmetry is correct
-        for (auto const& material_tangent : material_tangents)
+        for (auto const& packed_tangent : material_tangents)
         {
+            auto const material_tangent = voigt::major_symmetric::view(packed_tangent);
+
             REQUIRE(material_tangent(0, 0) == Approx(219780.21978022));
             REQUIRE(material_tangent(1, 1) == Approx(219780.21978022));
             REQUIRE(material_tangent(2, 2) == Approx(76923.0769230769));
@@ -119,8 +122,10 @@ TEST_CASE("Plane stress elasticity")
               accumulated_plastic_strains] = variables->get(variable::scalar::von_mises_stress,
                                                             variable::scalar::effective_plastic_strain);
 
-        for (auto const& material_tangent : material_tangents)
+        for (auto const& packed_tangent : material_tangents)
         {
+            auto const material_tangent = voigt::major_symmetric::view(packed_tangent);
+
             REQUIRE(material_tangent(0, 0) == Approx(219780.21978022));
             REQUIRE(material_tangent(1, 1) == Approx(219780.21978022));
             REQUIRE(material_tangent(2, 2) == Approx(76923.0769230769));
@@ -140,8 +145,10 @@ TEST_CASE("Plane stress elasticity")
             REQUIRE((eigen_solver.eigenvalues().real().array() > 0.0).all());
         }
 
-        for (auto const& cauchy_stress : cauchy_stresses)
+        for (auto const& packed_stress : cauchy_stresses)
         {
+            auto const cauchy_stress = voigt::kinetic::view(packed_stress);
+
             REQUIRE(cauchy_stress.norm() != Approx(0.0).margin(ZERO_MARGIN));
 
             // Shear components should be close to zero
@@ -164,7 +171,7 @@ TEST_CASE("Plane strain elasticity")
 
     // Add the required variables for an updated Lagrangian formulation
     variables->add(variable::second::displacement_gradient,
-                   variable::second::cauchy_stress,
+                   variable::symmetric::cauchy_stress,
                    variable::scalar::DetF);
 
     auto elastic_model = make_constitutive_model(variables,
@@ -175,13 +182,12 @@ TEST_CASE("Plane strain elasticity")
                                                              "\"plane_strain\"}}"));
 
     // Get the tensor variables
-    auto [displacement_gradients,
-          cauchy_stresses] = variables->get(variable::second::displacement_gradient,
-                                            variable::second::cauchy_stress);
+    auto& displacement_gradients = variables->get(variable::second::displacement_gradient);
+    auto& cauchy_stresses = variables->get(variable::symmetric::cauchy_stress);
 
     auto& J_list = variables->get(variable::scalar::DetF);
 
-    auto& material_tangents = variables->get(variable::fourth::tangent_operator);
+    auto& material_tangents = variables->get(variable::major_symmetric::tangent_operator);
 
     for (auto& H : displacement_gradients) H = internal_variables_t::second_tensor_type::Zero();
     for (auto& J : J_list) J = 1.0;
@@ -195,17 +201,19 @@ TEST_CASE("Plane strain elasticity")
         REQUIRE(elastic_model->intrinsic_material().name() == "steel");
 
         REQUIRE(variables->has(variable::scalar::von_mises_stress));
-        REQUIRE(variables->has(variable::second::cauchy_stress));
-        REQUIRE(variables->has(variable::second::linearised_strain));
-        REQUIRE(variables->has(variable::fourth::tangent_operator));
+        REQUIRE(variables->has(variable::symmetric::cauchy_stress));
+        REQUIRE(variables->has(variable::symmetric::linearised_strain));
+        REQUIRE(variables->has(variable::major_symmetric::tangent_operator));
     }
     SECTION("No load")
     {
         elastic_model->update_internal_variables(1.0);
 
         // Ensure symmetry is correct
-        for (auto const& material_tangent : material_tangents)
+        for (auto const& packed_tangent : material_tangents)
         {
+            auto const material_tangent = voigt::major_symmetric::view(packed_tangent);
+
             REQUIRE(material_tangent(0, 0) == Approx(269230.769230769));
             REQUIRE(material_tangent(1, 1) == Approx(269230.769230769));
             REQUIRE(material_tangent(2, 2) == Approx(76923.0769230769));
@@ -238,8 +246,10 @@ TEST_CASE("Plane strain elasticity")
               accumulated_plastic_strains] = variables->get(variable::scalar::von_mises_stress,
                                                             variable::scalar::effective_plastic_strain);
 
-        for (auto const& material_tangent : material_tangents)
+        for (auto const& packed_tangent : material_tangents)
         {
+            auto const material_tangent = voigt::major_symmetric::view(packed_tangent);
+
             REQUIRE(material_tangent(0, 0) == Approx(269230.769230769));
             REQUIRE(material_tangent(1, 1) == Approx(269230.769230769));
             REQUIRE(material_tangent(2, 2) == Approx(76923.0769230769));
@@ -258,8 +268,10 @@ TEST_CASE("Plane strain elasticity")
             REQUIRE((eigen_solver.eigenvalues().real().array() > 0.0).all());
         }
 
-        for (auto const& cauchy_stress : cauchy_stresses)
+        for (auto const& packed_stress : cauchy_stresses)
         {
+            auto const cauchy_stress = voigt::kinetic::view(packed_stress);
+
             REQUIRE(cauchy_stress.norm() != Approx(0.0).margin(ZERO_MARGIN));
 
             // Shear components should be close to zero
@@ -282,7 +294,7 @@ TEST_CASE("Solid mechanics elasticity model")
 
     // Add the required variables for an updated Lagrangian formulation
     variables->add(variable::second::displacement_gradient,
-                   variable::second::cauchy_stress,
+                   variable::symmetric::cauchy_stress,
                    variable::scalar::DetF);
 
     auto elastic_model = make_constitutive_model(variables,
@@ -293,13 +305,12 @@ TEST_CASE("Solid mechanics elasticity model")
                                                              "\"isotropic_linear_elasticity\"}}"));
 
     // Get the tensor variables
-    auto [displacement_gradients,
-          cauchy_stresses] = variables->get(variable::second::displacement_gradient,
-                                            variable::second::cauchy_stress);
+    auto& displacement_gradients = variables->get(variable::second::displacement_gradient);
+    auto& cauchy_stresses = variables->get(variable::symmetric::cauchy_stress);
 
     auto& J_list = variables->get(variable::scalar::DetF);
 
-    auto& material_tangents = variables->get(variable::fourth::tangent_operator);
+    auto& material_tangents = variables->get(variable::major_symmetric::tangent_operator);
 
     for (auto& H : displacement_gradients) H = internal_variables_t::second_tensor_type::Zero();
     for (auto& J : J_list) J = 1.0;
@@ -313,17 +324,19 @@ TEST_CASE("Solid mechanics elasticity model")
         REQUIRE(elastic_model->intrinsic_material().name() == "steel");
 
         REQUIRE(variables->has(variable::scalar::von_mises_stress));
-        REQUIRE(variables->has(variable::second::cauchy_stress));
-        REQUIRE(variables->has(variable::second::linearised_strain));
-        REQUIRE(variables->has(variable::fourth::tangent_operator));
+        REQUIRE(variables->has(variable::symmetric::cauchy_stress));
+        REQUIRE(variables->has(variable::symmetric::linearised_strain));
+        REQUIRE(variables->has(variable::major_symmetric::tangent_operator));
     }
     SECTION("No load")
     {
         elastic_model->update_internal_variables(1.0);
 
         // Ensure symmetry is correct
-        for (auto const& material_tangent : material_tangents)
+        for (auto const& packed_tangent : material_tangents)
         {
+            auto const material_tangent = voigt::major_symmetric::view(packed_tangent);
+
             REQUIRE(material_tangent(0, 0) == Approx(269230.769230769));
             REQUIRE(material_tangent(1, 1) == Approx(269230.769230769));
             REQUIRE(material_tangent(2, 2) == Approx(269230.769230769));
@@ -375,8 +388,10 @@ TEST_CASE("Solid mechanics elasticity model")
               accumulated_plastic_strains] = variables->get(variable::scalar::von_mises_stress,
                                                             variable::scalar::effective_plastic_strain);
 
-        for (auto const& material_tangent : material_tangents)
+        for (auto const& packed_tangent : material_tangents)
         {
+            auto const material_tangent = voigt::major_symmetric::view(packed_tangent);
+
             REQUIRE(material_tangent(0, 0) == Approx(269230.769230769));
             REQUIRE(material_tangent(1, 1) == Approx(269230.769230769));
             REQUIRE(material_tangent(2, 2) == Approx(269230.769230769));
@@ -414,8 +429,10 @@ TEST_CASE("Solid mechanics elasticity model")
             REQUIRE((eigen_solver.eigenvalues().real().array() > 0.0).all());
         }
 
-        for (auto const& cauchy_stress : cauchy_stresses)
+        for (auto const& packed_stress : cauchy_stresses)
         {
+            auto const cauchy_stress = voigt::kinetic::view(packed_stress);
+
             REQUIRE(cauchy_stress.norm() != Approx(0.0).margin(ZERO_MARGIN));
 
             // Shear components should be close to zero
@@ -465,7 +482,7 @@ TEST_CASE("Solid mechanics J2 plasticity")
     auto variables = std::make_shared<internal_variables_t>(internal_variable_size);
 
     // Add the required variables for an updated Lagrangian formulation
-    variables->add(variable::second::displacement_gradient, variable::second::cauchy_stress);
+    variables->add(variable::second::displacement_gradient, variable::symmetric::cauchy_stress);
     variables->add(variable::scalar::DetF);
 
     auto const material_data = json::parse("{\"name\": \"steel\", "
@@ -483,13 +500,12 @@ TEST_CASE("Solid mechanics J2 plasticity")
                                                               constitutive_data);
 
     // Get the tensor variables
-    auto [displacement_gradients,
-          cauchy_stresses] = variables->get(variable::second::displacement_gradient,
-                                            variable::second::cauchy_stress);
+    auto& displacement_gradients = variables->get(variable::second::displacement_gradient);
+    auto& cauchy_stresses = variables->get(variable::symmetric::cauchy_stress);
 
     auto& J_list = variables->get(variable::scalar::DetF);
 
-    auto& material_tangents = variables->get(variable::fourth::tangent_operator);
+    auto& material_tangents = variables->get(variable::major_symmetric::tangent_operator);
 
     for (auto& H : displacement_gradients) H = neon::matrix3::Zero();
     for (auto& J : J_list) J = 1.0;
@@ -500,13 +516,14 @@ TEST_CASE("Solid mechanics J2 plasticity")
     {
         REQUIRE(small_strain_J2_plasticity->is_symmetric());
         REQUIRE(small_strain_J2_plasticity->is_finite_deformation() == false);
+        REQUIRE(small_strain_J2_plasticity->is_tangent_constant() == false);
         REQUIRE(small_strain_J2_plasticity->intrinsic_material().name() == "steel");
 
         REQUIRE(variables->has(variable::scalar::von_mises_stress));
         REQUIRE(variables->has(variable::scalar::effective_plastic_strain));
-        REQUIRE(variables->has(variable::second::linearised_strain));
-        REQUIRE(variables->has(variable::second::linearised_plastic_strain));
-        REQUIRE(variables->has(variable::fourth::tangent_operator));
+        REQUIRE(variables->has(variable::symmetric::linearised_strain));
+        REQUIRE(variables->has(variable::symmetric::linearised_plastic_strain));
+        REQUIRE(variables->has(variable::major_symmetric::tangent_operator));
     }
     SECTION("Helper function")
     {
@@ -520,8 +537,10 @@ TEST_CASE("Solid mechanics J2 plasticity")
         small_strain_J2_plasticity->update_internal_variables(1.0);
 
         // Ensure symmetry is correct
-        for (auto const& material_tangent : material_tangents)
+        for (auto const& packed_tangent : material_tangents)
         {
+            auto const material_tangent = voigt::major_symmetric::view(packed_tangent);
+
             REQUIRE((material_tangent - material_tangent.transpose()).norm()
                     == Approx(0.0).margin(ZERO_MARGIN));
 
@@ -544,8 +563,10 @@ TEST_CASE("Solid mechanics J2 plasticity")
               accumulated_plastic_strains] = variables->get(variable::scalar::von_mises_stress,
                                                             variable::scalar::effective_plastic_strain);
 
-        for (auto const& material_tangent : material_tangents)
+        for (auto const& packed_tangent : material_tangents)
         {
+            auto const material_tangent = voigt::major_symmetric::view(packed_tangent);
+
             // Ensure symmetry is correct
             REQUIRE((material_tangent - material_tangent.transpose()).norm()
                     == Approx(0.0).margin(ZERO_MARGIN));
@@ -554,8 +575,10 @@ TEST_CASE("Solid mechanics J2 plasticity")
             REQUIRE((eigen_solver.eigenvalues().real().array() > 0.0).all());
         }
 
-        for (auto const& cauchy_stress : cauchy_stresses)
+        for (auto const& packed_stress : cauchy_stresses)
         {
+            auto const cauchy_stress = voigt::kinetic::view(packed_stress);
+
             REQUIRE(cauchy_stress.norm() != Approx(0.0).margin(ZERO_MARGIN));
 
             // Shear components should be close to zero
@@ -587,8 +610,10 @@ TEST_CASE("Solid mechanics J2 plasticity")
               accumulated_plastic_strains] = variables->get(variable::scalar::von_mises_stress,
                                                             variable::scalar::effective_plastic_strain);
 
-        for (auto const& material_tangent : material_tangents)
+        for (auto const& packed_tangent : material_tangents)
         {
+            auto const material_tangent = voigt::major_symmetric::view(packed_tangent);
+
             // Ensure symmetry is correct
             REQUIRE((material_tangent - material_tangent.transpose()).norm()
                     == Approx(0.0).margin(ZERO_MARGIN));
@@ -597,8 +622,10 @@ TEST_CASE("Solid mechanics J2 plasticity")
             REQUIRE((eigen_solver.eigenvalues().real().array() > 0.0).all());
         }
 
-        for (auto& cauchy_stress : cauchy_stresses)
+        for (auto const& packed_stress : cauchy_stresses)
         {
+            auto const cauchy_stress = voigt::kinetic::view(packed_stress);
+
             REQUIRE(cauchy_stress.norm() != Approx(0.0).margin(ZERO_MARGIN));
 
             // Shear components should be close to zero
@@ -615,6 +642,17 @@ TEST_CASE("Solid mechanics J2 plasticity")
             REQUIRE(accumulated_plastic_strain > 0.0);
         }
 
+        auto const& plastic_strains = variables->get(variable::symmetric::linearised_plastic_strain);
+
+        // Plastic strains are stored in Voigt notation and are isochoric
+        for (auto const& plastic_strain : plastic_strains)
+        {
+            REQUIRE(plastic_strain.size() == 6);
+            REQUIRE(plastic_strain(2) > 0.0);
+            REQUIRE(plastic_strain.head<3>().sum() == Approx(0.0).margin(ZERO_MARGIN));
+            REQUIRE(plastic_strain.tail<3>().norm() == Approx(0.0).margin(ZERO_MARGIN));
+        }
+
         for (auto& von_mises_stress : von_mises_stresses)
         {
             // Should experience hardening
@@ -622,6 +660,132 @@ TEST_CASE("Solid mechanics J2 plasticity")
             REQUIRE(von_mises_stress > 200.0e6);
         }
     }
+    SECTION("Elastic tangent restored after plastic step")
+    {
+        for (auto& H : displacement_gradients) H(2, 2) = 0.001;
+
+        small_strain_J2_plasticity->update_internal_variables(1.0);
+
+        neon::matrix6 const C_e = voigt::major_symmetric::view(material_tangents.front());
+
+        for (auto& H : displacement_gradients) H(2, 2) = 0.003;
+
+        small_strain_J2_plasticity->update_internal_variables(1.0);
+
+        for (auto const& packed_tangent : material_tangents)
+        {
+            auto const material_tangent = voigt::major_symmetric::view(packed_tangent);
+
+            REQUIRE((material_tangent - C_e).norm() > 1.0);
+        }
+
+        // Discard the plastic step and reload elastically
+        variables->revert();
+
+        for (auto& H : displacement_gradients) H(2, 2) = 0.001;
+
+        small_strain_J2_plasticity->update_internal_variables(1.0);
+
+        for (auto const& packed_tangent : material_tangents)
+        {
+            auto const material_tangent = voigt::major_symmetric::view(packed_tangent);
+
+            REQUIRE((material_tangent - C_e).norm() == Approx(0.0).margin(ZERO_MARGIN));
+        }
+    }
+    SECTION("Screened elastic update")
+    {
+        auto& von_mises_stresses = variables->get(variable::scalar::von_mises_stress);
+
+        // Load through elastic states with the stress updated from the increment
+        for (auto const strain : {0.0005, 0.001, 0.001, 0.003})
+        {
+            for (auto& H : displacement_gradients) H(2, 2) = strain;
+
+            small_strain_J2_plasticity->update_internal_variables(1.0);
+        }
+
+        std::vector<neon::vector6> const stresses(begin(cauchy_stresses), end(cauchy_stresses));
+        std::vector<double> const von_mises(begin(von_mises_stresses), end(von_mises_stresses));
+
+        // Load directly to the final state with the full trial state
+        variables->revert();
+
+        for (auto& H : displacement_gradients) H(2, 2) = 0.003;
+
+        small_strain_J2_plasticity->update_internal_variables(1.0);
+
+        for (std::size_t l{0}; l < stresses.size(); ++l)
+        {
+            REQUIRE((cauchy_stresses[l] - stresses[l]).norm()
+                    == Approx(0.0).margin(1.0e-6 * stresses[l].norm()));
+            REQUIRE(von_mises_stresses[l] == Approx(von_mises[l]));
+        }
+    }
+    SECTION("Cycle jump next to the yield surface")
+    {
+        auto [von_mises_stresses,
+              accumulated_plastic_strains] = variables->get(variable::scalar::von_mises_stress,
+                                                            variable::scalar::effective_plastic_strain);
+
+        using neon::mechanics::von_mises_stress;
+
+        neon::isotropic_elastic_plastic material{material_data};
+
+        // Shear strain at half of the yield stress
+        auto const shear_strain = 0.5 * 200.0e6 / (2.0 * std::sqrt(3.0) * material.shear_modulus());
+
+        // Two elastic states with the same von Mises stress in different planes
+        for (auto& H : displacement_gradients) H(0, 1) = H(1, 0) = shear_strain;
+
+        small_strain_J2_plasticity->update_internal_variables(1.0);
+        variables->commit();
+
+        auto const first = variables->checkpoint();
+
+        for (auto& H : displacement_gradients)
+        {
+            H = neon::matrix3::Zero();
+            H(0, 2) = H(2, 0) = shear_strain;
+        }
+
+        small_strain_J2_plasticity->update_internal_variables(1.0);
+        variables->commit();
+
+        auto const second = variables->checkpoint();
+
+        for (auto const von_mises : von_mises_stresses) REQUIRE(von_mises == Approx(100.0e6));
+
+        // The extrapolated stress is outside of the yield surface while the
+        // linear extrapolation of the von Mises stress is not
+        variables->extrapolate(first, second, 1.0);
+        small_strain_J2_plasticity->update_derived_variables();
+        variables->commit();
+
+        for (std::size_t l{0}; l < cauchy_stresses.size(); ++l)
+        {
+            REQUIRE(von_mises_stresses[l] == Approx(von_mises_stress(cauchy_stresses[l])));
+            REQUIRE(von_mises_stresses[l] == Approx(std::sqrt(5.0) * 100.0e6));
+        }
+
+        // Reload with the extrapolated strain which has no elastic increment
+        for (auto& H : displacement_gradients)
+        {
+            H = neon::matrix3::Zero();
+            H(0, 2) = H(2, 0) = 2.0 * shear_strain;
+            H(0, 1) = H(1, 0) = -shear_strain;
+        }
+
+        small_strain_J2_plasticity->update_internal_variables(1.0);
+
+        for (std::size_t l{0}; l < cauchy_stresses.size(); ++l)
+        {
+            REQUIRE(accumulated_plastic_strains[l] > 0.0);
+            REQUIRE(von_mises_stresses[l] == Approx(von_mises_stress(cauchy_stresses[l])));
+            REQUIRE(von_mises_stresses[l]
+                    == Approx(200.0e6 + 400.0e6 * accumulated_plastic_strains[l]));
+        }
+    }
 }
 TEST_CASE("Solid mechanics J2 plasticity damage")
 {
@@ -629,7 +793,7 @@ TEST_CASE("Solid mechanics J2 plasticity damage")
 
     auto variables = std::make_shared<internal_variables_t>(internal_variable_size);
 
-    variables->add(variable::second::displacement_gradient, variable::second::cauchy_stress);
+    variables->add(variable::second::displacement_gradient, variable::symmetric::cauchy_stress);
     variables->add(variable::scalar::DetF);
 
     auto const material_input{"{\"name\":\"steel\","
@@ -654,9 +818,8 @@ TEST_CASE("Solid mechanics J2 plasticity damage")
                                                                      json::parse(constitutive_input));
 
     // Get the tensor variables
-    auto [displacement_gradients,
-          cauchy_stresses] = variables->get(variable::second::displacement_gradient,
-                                            variable::second::cauchy_stress);
+    auto& displacement_gradients = variables->get(variable::second::displacement_gradient);
+    auto& cauchy_stresses = variables->get(variable::symmetric::cauchy_stress);
 
     auto [J_list, damage_list] = variables->get(variable::scalar::DetF, variable::scalar::damage);
 
@@ -676,13 +839,43 @@ TEST_CASE("Solid mechanics J2 plasticity damage")
 
         REQUIRE(variables->has(variable::scalar::von_mises_stress));
         REQUIRE(variables->has(variable::scalar::effective_plastic_strain));
-        REQUIRE(variables->has(variable::second::linearised_strain));
-        REQUIRE(variables->has(variable::second::linearised_plastic_strain));
+        REQUIRE(variables->has(variable::symmetric::linearised_strain));
+        REQUIRE(variables->has(variable::symmetric::linearised_plastic_strain));
         REQUIRE(variables->has(variable::fourth::tangent_operator));
         REQUIRE(variables->has(variable::scalar::damage));
         REQUIRE(variables->has(variable::scalar::energy_release_rate));
-        REQUIRE(variables->has(variable::second::kinematic_hardening));
-        REQUIRE(variables->has(variable::second::back_stress));
+        REQUIRE(variables->has(variable::symmetric::kinematic_hardening));
+        REQUIRE(variables->has(variable::symmetric::back_stress));
+    }
+    SECTION("Cycle jump limits the irreversible variables")
+    {
+        auto& accumulated_plastic_strains = variables->get(variable::scalar::effective_plastic_strain);
+
+        for (auto& damage : damage_list) damage = 0.6;
+        for (auto& accumulated_plastic_strain : accumulated_plastic_strains)
+        {
+            accumulated_plastic_strain = 0.02;
+        }
+        variables->commit();
+
+        auto const first = variables->checkpoint();
+
+        for (auto& damage : damage_list) damage = 0.9;
+        for (auto& accumulated_plastic_strain : accumulated_plastic_strains)
+        {
+            accumulated_plastic_strain = 0.01;
+        }
+        variables->commit();
+
+        auto const second = variables->checkpoint();
+
+        variables->extrapolate(first, second, 2.0);
+
+        for (auto const damage : damage_list) REQUIRE(damage == Approx(1.0));
+        for (auto const accumulated_plastic_strain : accumulated_plastic_strains)
+        {
+            REQUIRE(accumulated_plastic_strain == Approx(0.01));
+        }
     }
     SECTION("Uniaxial elastic load")
     {
@@ -704,8 +897,10 @@ TEST_CASE("Solid mechanics J2 plasticity damage")
             REQUIRE((eigen_solver.eigenvalues().real().array() > 0.0).all());
         }
 
-        for (auto& cauchy_stress : cauchy_stresses)
+        for (auto const& packed_stress : cauchy_stresses)
         {
+            auto const cauchy_stress = voigt::kinetic::view(packed_stress);
+
             REQUIRE(cauchy_stress.norm() != Approx(0.0).margin(ZERO_MARGIN));
 
             // Shear components should be close to zero
@@ -737,8 +932,10 @@ TEST_CASE("Solid mechanics J2 plasticity damage")
               accumulated_plastic_strains] = variables->get(variable::scalar::von_mises_stress,
                                                             variable::scalar::effective_plastic_strain);
 
-        for (auto const& cauchy_stress : cauchy_stresses)
+        for (auto const& packed_stress : cauchy_stresses)
         {
+            auto const cauchy_stress = voigt::kinetic::view(packed_stress);
+
             REQUIRE(cauchy_stress.norm() != Approx(0.0).margin(ZERO_MARGIN));
 
             // Shear components should be close to zero
@@ -0,0 +1,119 @@
+
+#include <catch2/catch.hpp>
+
+#include "telemetry.hpp"
+#include "io/json.hpp"
+
+#include <tbb/parallel_for.h>
+
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+
+using namespace neon;
+
+TEST_CASE("Telemetry")
+{
+    telemetry::configure(json::parse("{\"name\" : \"telemetry_test\", "
+                                     "\"telemetry\" : {\"verbosity\" : \"quiet\", "
+                                     "\"trace\" : true, "
+                                     "\"summary\" : \"csv\"}}"));
+
+    REQUIRE(telemetry::console() == telemetry::verbosity::quiet);
+
+    SECTION("Scoped timers and counters")
+    {
+        {
+            telemetry::scoped_timer timer("Assembly");
+            REQUIRE(timer.elapsed() >= 0.0);
+        }
+        telemetry::count("Newton-Raphson iterations", 3);
+
+        telemetry::complete_step(1, 0.5);
+
+        telemetry::count("Newton-Raphson iterations");
+
+        telemetry::complete_step(2, 1.0);
+
+        auto const summary = telemetry::summary();
+
+        REQUIRE(summary["timers"]["Assembly"]["calls"] == 1);
+        REQUIRE(summary["counters"]["Newton-Raphson iterations"] == 4);
+
+        REQUIRE(summary["steps"].size() == 2);
+        REQUIRE(summary["steps"][0]["step"] == 1);
+        REQUIRE(summary["steps"][0]["counters"]["Newton-Raphson iterations"] == 3);
+        REQUIRE(summary["steps"][1]["counters"]["Newton-Raphson iterations"] == 1);
+        REQUIRE(summary["steps"][1]["timers"].empty());
+    }
+    SECTION("Counters from several threads")
+    {
+        tbb::parallel_for(0, 100, [](auto const) { telemetry::count("Bytes written", 8); });
+
+        telemetry::complete_step(1, 1.0);
+
+        REQUIRE(telemetry::summary()["counters"]["Bytes written"] == 800);
+    }
+    SECTION("Trace and summary export")
+    {
+        {
+            telemetry::scoped_timer timer("Linear solver");
+        }
+        telemetry::complete_step(1, 1.0);
+
+        telemetry::write();
+
+        json trace;
+        std::ifstream("telemetry_test.trace.json") >> trace;
+
+        REQUIRE(trace["traceEvents"].size() == 1);
+        REQUIRE(trace["traceEvents"][0]["name"] == "Linear solver");
+        REQUIRE(trace["traceEvents"][0]["ph"] == "X");
+
+        std::ifstream csv("telemetry_test_telemetry.csv");
+
+        std::string header, row;
+        std::getline(csv, header);
+        std::getline(csv, row);
+
+        REQUIRE(header == "step,time,name,calls,seconds,value");
+        REQUIRE(row.find("\"Linear solver\",1,") != std::string::npos);
+
+        std::remove("telemetry_test.trace.json");
+        std::remove("telemetry_test_telemetry.csv");
+    }
+    SECTION("Detailed console output")
+    {
+        telemetry::configure(json::parse("{\"telemetry\" : {\"verbosity\" : \"detailed\"}}"));
+
+        std::ostringstream output;
+        auto const buffer = std::cout.rdbuf(output.rdbuf());
+        {
+            telemetry::scoped_timer timer("Assembly");
+        }
+        {
+            telemetry::scoped_timer timer("Equilibrium iteration",
+                                          telemetry::timer_output::required);
+        }
+        {
+            telemetry::scoped_timer timer("Linear solver", telemetry::timer_output::silent);
+        }
+        std::cout.rdbuf(buffer);
+
+        REQUIRE(output.str().find("Assembly took ") != std::string::npos);
+        REQUIRE(output.str().find("Equilibrium iteration required ") != std::string::npos);
+        REQUIRE(output.str().find("Linear solver") == std::string::npos);
+
+        REQUIRE(telemetry::summary()["timers"]["Linear solver"]["calls"] == 1);
+    }
+    SECTION("Invalid configuration")
+    {
+        REQUIRE_THROWS_AS(telemetry::configure(
+                              json::parse("{\"telemetry\" : {\"verbosity\" : \"loud\"}}")),
+                          std::domain_error);
+        REQUIRE_THROWS_AS(telemetry::configure(
+                              json::parse("{\"telemetry\" : {\"summary\" : \"xml\"}}")),
+                          std::domain_error);
+    }
+}
@@ -51,6 +51,69 @@ TEST_CASE("Mandel notation")
                 == Approx(9.0 * std::sqrt(2.0)).margin(ZERO_MARGIN));
     }
 }
+TEST_CASE("Kinetic Voigt notation view")
+{
+    SECTION("Three dimensional tensor")
+    {
+        vector6 packed;
+        packed << 1.0, 2.0, 3.0, 4.0, 5.0, 6.0;
+
+        auto const tensor = voigt::kinetic::view(packed);
+
+        REQUIRE((tensor - voigt::kinetic::from(packed)).norm() == Approx(0.0).margin(ZERO_MARGIN));
+        REQUIRE((tensor - tensor.transpose()).norm() == Approx(0.0).margin(ZERO_MARGIN));
+
+        // The view reads the current components of the packed tensor
+        packed(3) = 7.0;
+
+        REQUIRE(tensor(1, 2) == Approx(7.0));
+        REQUIRE(tensor(2, 1) == Approx(7.0));
+    }
+    SECTION("Two dimensional tensor")
+    {
+        vector3 packed;
+        packed << 1.0, 2.0, 3.0;
+
+        matrix2 const tensor = voigt::kinetic::view(packed);
+
+        REQUIRE((tensor - voigt::kinetic::from(packed)).norm() == Approx(0.0).margin(ZERO_MARGIN));
+        REQUIRE((voigt::kinetic::to(tensor) - packed).norm() == Approx(0.0).margin(ZERO_MARGIN));
+    }
+}
+TEST_CASE("Major symmetric Voigt notation view")
+{
+    SECTION("Three dimensional tangent")
+    {
+        vector6 const a = vector6::LinSpaced(6, 1.0, 6.0);
+
+        matrix6 const C = voigt::I_outer_I() + 2.0 * voigt::kinetic::fourth_order_identity()
+                          + a * a.transpose();
+
+        auto const packed = voigt::major_symmetric::to(C);
+
+        REQUIRE(packed.size() == 21);
+
+        // The upper triangle is packed row by row
+        REQUIRE(packed(0) == Approx(C(0, 0)));
+        REQUIRE(packed(5) == Approx(C(0, 5)));
+        REQUIRE(packed(6) == Approx(C(1, 1)));
+        REQUIRE(packed(20) == Approx(C(5, 5)));
+
+        REQUIRE((voigt::major_symmetric::view(packed) - C).norm() == Approx(0.0).margin(ZERO_MARGIN));
+    }
+    SECTION("Two dimensional tangent")
+    {
+        matrix3 const C = voigt::d2::I_outer_I() + matrix3::Identity();
+
+        auto const packed = voigt::major_symmetric::to(C);
+
+        REQUIRE(packed.size() == 6);
+
+        matrix3 const tangent = voigt::major_symmetric::view(packed);
+
+        REQUIRE((tangent - C).norm() == Approx(0.0).margin(ZERO_MARGIN));
+    }
+}
 TEST_CASE("Spectral decomposition")
 {
     SECTION("2x2 identity matrix")
@@ -91,6 +154,17 @@ TEST_CASE("Log symmetric tensor derivative")
         REQUIRE(dA(1, 1) == Approx(0.5).margin(ZERO_MARGIN));
         REQUIRE(dA(2, 2) == Approx(0.25).margin(ZERO_MARGIN));
     }
+    SECTION("Distinct eigenvalues")
+    {
+        matrix2 A(2, 2);
+        A << 2.0, 0.0, 0.0, 1.0;
+
+        matrix3 const dA = log_symmetric_tensor_derivative(A);
+
+        REQUIRE(dA(0, 0) == Approx(0.5).margin(ZERO_MARGIN));
+        REQUIRE(dA(1, 1) == Approx(1.0).margin(ZERO_MARGIN));
+        REQUIRE(dA(2, 2) == Approx(0.5 * std::log(2.0)).margin(ZERO_MARGIN));
+    }
     SECTION("Zero eigenvalue")
     {
         matrix3 const dA = log_symmetric_tensor_derivative(matrix2::Ones());
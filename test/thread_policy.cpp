@@ -0,0 +1,83 @@
+
+#include <catch2/catch.hpp>
+
+#include "thread_policy.hpp"
+#include "constitutive/internal_variables.hpp"
+#include "io/json.hpp"
+
+#include <omp.h>
+
+using namespace neon;
+
+TEST_CASE("Thread policy")
+{
+    SECTION("Number of threads")
+    {
+        thread_policy policy(json::parse("{\"cores\" : 2}"));
+
+        REQUIRE(policy.threads() == 2);
+        REQUIRE_FALSE(policy.is_pinned());
+
+        REQUIRE(tbb::global_control::active_value(tbb::global_control::max_allowed_parallelism)
+                == 2);
+        REQUIRE(omp_get_max_threads() == 2);
+    }
+    SECTION("Compact affinity")
+    {
+        thread_policy policy(json::parse("{\"cores\" : 1, \"affinity\" : \"compact\"}"));
+
+        REQUIRE(policy.threads() == 1);
+        REQUIRE(policy.is_pinned());
+    }
+    SECTION("Spread affinity")
+    {
+        thread_policy policy(json::parse("{\"cores\" : 1, \"affinity\" : \"spread\"}"));
+
+        REQUIRE(policy.is_pinned());
+    }
+    SECTION("Invalid input")
+    {
+        REQUIRE_THROWS_AS(thread_policy(json::parse("{\"cores\" : 0}")), std::domain_error);
+        REQUIRE_THROWS_AS(thread_policy(json::parse("{\"cores\" : 1, \"affinity\" : \"close\"}")),
+                          std::domain_error);
+        REQUIRE_THROWS_AS(thread_policy(json::parse("{\"cores\" : 2, \"affinity\" : [0]}")),
+                          std::domain_error);
+    }
+    SECTION("Distribution without a policy")
+    {
+        std::vector<double> values(1024, 1.0);
+
+        thread_policy::distribute(values);
+
+        REQUIRE(values.front() == Approx(1.0));
+        REQUIRE(values.back() == Approx(1.0));
+    }
+}
+TEST_CASE("Internal variable storage")
+{
+    internal_variables<3, 6> variables(4);
+
+    variables.add(variable::scalar::DetF, variable::symmetric::cauchy_stress);
+
+    auto const* const storage = variables.get(variable::scalar::DetF).data();
+
+    variables.get(variable::scalar::DetF).front() = 2.0;
+
+    variables.commit();
+
+    REQUIRE(variables.get_old(variable::scalar::DetF).front() == Approx(2.0));
+
+    variables.get(variable::scalar::DetF).front() = 3.0;
+
+    variables.revert();
+
+    // The storage is reused when reverting and committing
+    REQUIRE(variables.get(variable::scalar::DetF).data() == storage);
+    REQUIRE(variables.get(variable::scalar::DetF).front() == Approx(2.0));
+
+    std::size_t entries{0};
+
+    variables.for_each_storage([&entries](auto const& values) { entries += values.size(); });
+
+    REQUIRE(entries == 4 * 4);
+}
@@ -3,9 +3,14 @@
 
 #include "solver/adaptive_time_step.hpp"
 #include "solver/time_step_control.hpp"
+#include "solver/time/trapezoidal_integrator.hpp"
 
+#include "io/binary_archive.hpp"
 #include "io/json.hpp"
 
+#include <cmath>
+#include <cstdio>
+
 using namespace neon;
 
 TEST_CASE("adaptive time control")
@@ -37,6 +42,103 @@ TEST_CASE("adaptive time control")
         REQUIRE_THROWS_AS(load.update_convergence_state(false), std::domain_error);
     }
 }
+TEST_CASE("cycle jump time control")
+{
+    json time_data = {{"period", 10.0},
+                      {"increments",
+                       {{"initial", 0.25}, {"minimum", 0.25}, {"maximum", 0.25}, {"adaptive", false}}},
+                      {"cycle_jump", {{"period", 1.0}, {"tolerance", 1.0e-3}}}};
+
+    std::vector<double> mandatory_times;
+    for (auto i = 0; i <= 40; i++) mandatory_times.push_back(0.25 * i);
+
+    adaptive_time_step load(time_data, mandatory_times);
+
+    SECTION("input fuzzing")
+    {
+        time_data["cycle_jump"] = {{"period", 1.0}};
+        REQUIRE_THROWS_AS(adaptive_time_step(time_data, {0.0, 1.0}), std::domain_error);
+
+        time_data["cycle_jump"] = {{"period", 1.0}, {"tolerance", 1.0e-3}, {"resolved_cycles", 2}};
+        REQUIRE_THROWS_AS(adaptive_time_step(time_data, {0.0, 1.0}), std::domain_error);
+    }
+    SECTION("resolved cycles")
+    {
+        for (auto i = 1; i <= 12; i++)
+        {
+            load.update_convergence_state(true);
+            REQUIRE(load.is_cycle_completed() == (i % 4 == 0));
+            REQUIRE(load.is_cycle_jump_possible() == (i == 12));
+        }
+        REQUIRE(load.last_step_time() == Approx(3.0));
+    }
+    SECTION("jump size")
+    {
+        for (auto i = 0; i < 12; i++) load.update_convergence_state(true);
+
+        // Limited by the change per cycle
+        REQUIRE(load.cycle_jump(0.1, 0.0) == Approx(1.0));
+        // Limited by the extrapolation error
+        REQUIRE(load.cycle_jump(0.0, 2.0e-3) == Approx(1.0));
+        // Limited by the remaining cycles
+        REQUIRE(load.cycle_jump(1.0e-6, 1.0e-12) == Approx(4.0));
+
+        load.jump(4.0);
+
+        REQUIRE(load.last_step_time() == Approx(7.0));
+        REQUIRE(load.step_time() == Approx(7.25));
+        REQUIRE(!load.is_cycle_jump_possible());
+
+        load.update_convergence_state(true);
+        REQUIRE(load.step_time() == Approx(7.5));
+    }
+}
+TEST_CASE("Checkpoint time control")
+{
+    json time_data = {{"period", 10.0},
+                      {"increments",
+                       {{"initial", 0.25}, {"minimum", 0.25}, {"maximum", 0.25}, {"adaptive", false}}}};
+
+    std::vector<double> mandatory_times;
+    for (auto i = 0; i <= 40; i++) mandatory_times.push_back(0.25 * i);
+
+    adaptive_time_step load(time_data, mandatory_times);
+
+    for (auto i = 0; i < 7; i++) load.update_convergence_state(true);
+
+    io::binary_output_archive output_archive;
+    load.save(output_archive);
+    output_archive.write(std::make_tuple(std::vector<double>{1.0, 2.0}, vector3(1.0, 2.0, 3.0)));
+    output_archive.save("time_stepping.checkpoint");
+
+    io::binary_input_archive input_archive("time_stepping.checkpoint");
+
+    adaptive_time_step restarted_load(time_data, mandatory_times);
+    restarted_load.load(input_archive);
+
+    std::tuple<std::vector<double>, vector3> values;
+    input_archive.read(values);
+
+    std::remove("time_stepping.checkpoint");
+
+    REQUIRE(restarted_load.step() == load.step());
+    REQUIRE(restarted_load.time() == Approx(load.time()));
+    REQUIRE(std::get<0>(values).size() == 2);
+    REQUIRE(std::get<1>(values)(2) == Approx(3.0));
+
+    // Both continue along the same mandatory time points
+    while (!load.is_fully_applied())
+    {
+        load.update_convergence_state(true);
+        restarted_load.update_convergence_state(true);
+
+        REQUIRE(restarted_load.step_time() == Approx(load.step_time()));
+    }
+    REQUIRE(restarted_load.is_fully_applied());
+
+    REQUIRE_THROWS_AS(input_archive.read(std::get<1>(values)), std::domain_error);
+}
+
 TEST_CASE("Simple time control")
 {
     SECTION("input fuzzing")
@@ -63,3 +165,130 @@ TEST_CASE("Simple time control")
         REQUIRE(times.is_finished());
     }
 }
+namespace
+{
+/// Integrator with access to the local truncation error estimate
+class error_estimate_integrator : public trapezoidal_integrator
+{
+public:
+    using trapezoidal_integrator::trapezoidal_integrator;
+
+    using trapezoidal_integrator::estimate_local_error;
+};
+}
+TEST_CASE("Adaptive trapezoidal integrator")
+{
+    json time_data = {{"method", "crank_nicolson"},
+                      {"period", 10.0},
+                      {"increments",
+                       {{"initial", 1.0e-3},
+                        {"minimum", 1.0e-6},
+                        {"maximum", 0.5},
+                        {"adaptive", true},
+                        {"tolerance", 1.0e-4}}}};
+
+    SECTION("input fuzzing")
+    {
+        time_data["increments"].erase("tolerance");
+        REQUIRE_THROWS_AS(trapezoidal_integrator(time_data), std::runtime_error);
+    }
+    SECTION("Crank-Nicolson local error estimate")
+    {
+        // Constant steps which are always accepted
+        auto constexpr step_size{1.0e-3};
+        time_data["increments"] = {{"initial", step_size},
+                                   {"minimum", step_size},
+                                   {"maximum", step_size},
+                                   {"adaptive", true},
+                                   {"tolerance", 1.0e10}};
+
+        error_estimate_integrator integrator(time_data);
+
+        // Solve dx/dt = -rate * x with x(0) = 1 from the exact solution of the
+        // previous step so the error of the step is the local error
+        auto constexpr rate{10.0};
+
+        auto const exact = [&](double const t) { return vector::Constant(1, std::exp(-rate * t)); };
+
+        for (int step{0}; step < 2; ++step)
+        {
+            REQUIRE(integrator.loop());
+            REQUIRE(integrator.update_time_step(exact(integrator.current_time() - step_size),
+                                                exact(integrator.current_time())));
+        }
+        REQUIRE(integrator.loop());
+
+        vector const x_next = exact(integrator.current_time() - step_size)
+                              * (1.0 - 0.5 * rate * step_size) / (1.0 + 0.5 * rate * step_size);
+
+        vector const local_error = x_next - exact(integrator.current_time());
+
+        REQUIRE(integrator.estimate_local_error(x_next)(0)
+                == Approx(local_error(0)).epsilon(0.05));
+    }
+    SECTION("Rejected final step")
+    {
+        time_data["period"] = 1.0;
+        time_data["increments"] = {{"initial", 0.3},
+                                   {"minimum", 0.2},
+                                   {"maximum", 0.3},
+                                   {"adaptive", true},
+                                   {"tolerance", 1.0e-4}};
+
+        trapezoidal_integrator integrator(time_data);
+
+        vector const x = vector::Ones(1);
+
+        // Constant solution until the final step of 0.1 which is rejected
+        for (int step{0}; step < 3; ++step)
+        {
+            REQUIRE(integrator.loop());
+            REQUIRE(integrator.update_time_step(x, x));
+        }
+        REQUIRE(integrator.loop());
+        REQUIRE(integrator.current_time_step_size() == Approx(0.1));
+
+        REQUIRE_THROWS_AS(integrator.update_time_step(x, 2.0 * x), std::domain_error);
+        REQUIRE(integrator.current_time() <= 1.0);
+    }
+    for (auto const method : {"crank_nicolson", "implicit_euler"})
+    {
+        SECTION(std::string("start-up transient using ") + method)
+        {
+            time_data["method"] = method;
+
+            trapezoidal_integrator integrator(time_data);
+
+            // Solve dx/dt = rate * (1 - x) with x(0) = 0
+            auto constexpr rate{10.0};
+
+            auto const theta = integrator.implicit_factor();
+
+            vector x = vector::Zero(1), x_next;
+
+            while (integrator.loop())
+            {
+                do
+                {
+                    auto const dt = integrator.current_time_step_size();
+
+                    x_next = (x * (1.0 - (1.0 - theta) * rate * dt) + vector::Constant(1, rate * dt))
+                             / (1.0 + theta * rate * dt);
+
+                } while (!integrator.update_time_step(x, x_next));
+
+                x = x_next;
+
+                if (integrator.current_time() < 0.5)
+                {
+                    REQUIRE(x(0)
+                            == Approx(1.0 - std::exp(-rate * integrator.current_time())).epsilon(0.01));
+                }
+            }
+            REQUIRE(integrator.current_time() == Approx(10.0));
+            // A fixed step size requires ten thousand steps
+            REQUIRE(integrator.iteration() < 1000);
+            REQUIRE(x(0) == Approx(1.0));
+        }
+    }
+}